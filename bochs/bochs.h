@@ -154,8 +154,8 @@ Bit32u crc32(const Bit8u *buf, int len);
 void print_tree(bx_param_c *node, int level = 0, bool xml = false);
 
 #if BX_ENABLE_STATISTICS
-// print statistics
-void print_statistics_tree(bx_param_c *node, int level = 0);
+// print statistics and clear them, only clear if fp is NULL
+void print_statistics_tree(bx_param_c *node, int level = 0, FILE *fp = stdout);
 #define INC_STAT(stat) (++(stat))
 #else
 #define INC_STAT(stat)
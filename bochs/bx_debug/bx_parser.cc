@@ -958,18 +958,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  357
+#define YYFINAL  359
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   2619
+#define YYLAST   2667
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  145
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  70
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  340
+#define YYNRULES  342
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  662
+#define YYNSTATES  667
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   383
@@ -1044,28 +1044,28 @@ static const yytype_int16 yyrline[] =
      403,   408,   413,   418,   423,   428,   433,   438,   443,   451,
      456,   461,   466,   474,   479,   487,   492,   500,   508,   516,
      521,   529,   534,   539,   544,   552,   560,   568,   575,   580,
-     585,   589,   593,   597,   601,   605,   609,   613,   620,   625,
+     585,   590,   594,   598,   602,   606,   610,   614,   618,   625,
      630,   635,   640,   645,   650,   655,   660,   665,   670,   675,
-     680,   688,   696,   701,   709,   714,   719,   724,   729,   734,
+     680,   685,   693,   701,   706,   714,   719,   724,   729,   734,
      739,   744,   749,   754,   759,   764,   769,   774,   779,   784,
-     789,   797,   798,   801,   809,   817,   825,   833,   841,   849,
-     857,   865,   873,   881,   889,   897,   904,   912,   920,   925,
-     930,   935,   943,   951,   959,   967,   975,   983,   991,   996,
-    1001,  1006,  1011,  1019,  1024,  1029,  1034,  1039,  1044,  1049,
-    1054,  1062,  1068,  1073,  1081,  1089,  1097,  1102,  1108,  1115,
-    1120,  1125,  1131,  1137,  1143,  1148,  1153,  1158,  1163,  1168,
-    1173,  1178,  1184,  1190,  1196,  1204,  1209,  1214,  1219,  1224,
+     789,   794,   799,   807,   808,   811,   819,   827,   835,   843,
+     851,   859,   867,   875,   883,   891,   899,   907,   914,   922,
+     930,   935,   940,   945,   953,   961,   969,   977,   985,   993,
+    1001,  1006,  1011,  1016,  1021,  1029,  1034,  1039,  1044,  1049,
+    1054,  1059,  1064,  1072,  1078,  1083,  1091,  1099,  1107,  1112,
+    1118,  1125,  1130,  1135,  1141,  1147,  1153,  1158,  1163,  1168,
+    1173,  1178,  1183,  1188,  1194,  1200,  1206,  1214,  1219,  1224,
     1229,  1234,  1239,  1244,  1249,  1254,  1259,  1264,  1269,  1274,
-    1279,  1284,  1289,  1294,  1299,  1304,  1309,  1314,  1319,  1329,
-    1340,  1346,  1359,  1364,  1375,  1380,  1396,  1412,  1424,  1436,
-    1441,  1447,  1452,  1457,  1462,  1470,  1479,  1488,  1496,  1504,
-    1514,  1515,  1516,  1517,  1518,  1519,  1520,  1521,  1522,  1523,
-    1524,  1525,  1526,  1527,  1528,  1529,  1530,  1531,  1532,  1533,
-    1534,  1535,  1536,  1537,  1538,  1539,  1545,  1546,  1547,  1548,
-    1549,  1550,  1551,  1552,  1553,  1554,  1555,  1556,  1557,  1558,
+    1279,  1284,  1289,  1294,  1299,  1304,  1309,  1314,  1319,  1324,
+    1329,  1339,  1350,  1356,  1369,  1374,  1386,  1391,  1408,  1424,
+    1436,  1448,  1453,  1459,  1464,  1469,  1474,  1482,  1491,  1500,
+    1508,  1516,  1526,  1527,  1528,  1529,  1530,  1531,  1532,  1533,
+    1534,  1535,  1536,  1537,  1538,  1539,  1540,  1541,  1542,  1543,
+    1544,  1545,  1546,  1547,  1548,  1549,  1550,  1551,  1557,  1558,
     1559,  1560,  1561,  1562,  1563,  1564,  1565,  1566,  1567,  1568,
     1569,  1570,  1571,  1572,  1573,  1574,  1575,  1576,  1577,  1578,
-    1579
+    1579,  1580,  1581,  1582,  1583,  1584,  1585,  1586,  1587,  1588,
+    1589,  1590,  1591
 };
 #endif
 
@@ -1150,12 +1150,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-200)
+#define YYPACT_NINF (-201)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-339)
+#define YYTABLE_NINF (-341)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -1164,73 +1164,73 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     623,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,    -8,  1415,   -12,  -116,   345,  -103,  1372,
-     307,   333,   -65,   -47,   -41,  1421,   -92,  -200,  -200,   -40,
+     627,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,    -8,  1443,   -12,  -116,   348,  -103,  1585,
+     309,  1170,   -65,   -47,   -41,  1600,   -92,  -201,  -201,   -40,
      -70,   -66,   -64,   -59,   -51,   -43,     4,   -42,   -18,   -10,
-    1135,    23,    55,    60,  1415,  1415,    90,   189,  1415,  1111,
-       8,  -200,  1415,  1415,    44,    44,    44,    18,  1415,  1415,
-      21,    25,   -68,   -67,   162,  1166,  1415,    -7,   -23,   -69,
-     -62,   -33,    27,  1415,  -200,  1415,  1562,  1415,    92,    29,
-      48,  -200,  -200,  -200,  -200,  1415,  1415,  -200,  1415,  1415,
-    1415,   481,  -200,    54,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  2433,  1415,  -200,   899,
-      89,   -57,  -200,  -200,    58,    59,    65,    66,    86,    88,
-      44,    99,   102,   103,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  1557,  -200,  1557,
-    1557,  -200,  2453,    -6,  -200,   -17,  1415,  -200,   696,    56,
-      91,   105,   112,   122,   123,  1415,  1415,  1415,  1415,   125,
-     126,   128,   -32,   -58,  -200,   132,  -200,  -200,  -200,  -200,
-    -200,  -200,   133,  -200,  -200,  -200,  1191,  -200,  1575,   154,
-    1415,  1415,   969,   969,   134,   -54,   135,   136,   137,  1601,
-    1218,   138,   140,  -200,    20,   139,   163,   164,  1627,   969,
-    -200,  -200,   166,   170,   184,  -200,  1653,  1679,  -200,  -200,
-     185,  -200,   186,  -200,   187,  1415,   188,  1415,  1415,  -200,
-    -200,  1705,  1731,   190,   191,   -45,   192,  -200,  1360,   253,
-     193,  -200,   194,  -200,   195,  -200,  -200,  1757,  1783,   196,
-     197,   221,   239,   240,   241,   242,   250,   254,   266,   267,
-     268,   271,   272,   274,   275,   276,   277,   278,   280,   281,
-     282,   283,   284,   285,   286,   287,   288,   289,   290,   295,
-     297,   298,   305,   306,   308,   309,   312,   315,   316,   321,
-     323,   324,   325,   326,   328,   329,   338,   340,   341,   342,
-     344,   358,   359,   360,   366,   384,  -200,   387,  1809,   388,
-    -200,  -200,   389,   389,   389,   870,   389,  -200,  -200,  -200,
-    1415,  1415,  1415,  1415,  1415,  1415,  1415,  1415,  1415,  1415,
-    1415,  1415,  1415,  1415,  1415,  1415,  1415,  1835,  -200,   390,
-     392,  -200,  1415,  1415,  1415,  1415,  1415,  1415,   393,  1415,
-    1415,  1415,  -200,  -200,   119,  1557,  1557,  1557,  1557,  1557,
-    1557,  1557,  1557,  1557,  1557,  1557,   453,  -200,   458,  -200,
-     -13,   463,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  1415,
-    2433,  1415,  1415,  1415,  -200,  -200,  -200,   400,  -200,   -20,
-     -19,  -200,  -200,  -200,  -200,  1861,  -200,   406,   969,  1887,
-    1415,  1415,   969,  1913,  -200,   408,  -200,  -200,  -200,  -200,
-    -200,  -200,   165,  -200,   444,  -200,  1939,  -200,  -200,  -200,
-    -200,  1965,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-     765,  -200,   796,   938,  -200,  -200,  -200,  -200,   411,  -200,
-    -200,  -200,  1991,  1384,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-      63,    63,    63,   389,   389,   389,   389,   478,   478,   478,
-     478,   478,   478,    63,    63,    63,  2433,  -200,  -200,  -200,
-    2017,  2043,  2069,  2095,  2121,  2147,  -200,  2173,  2199,  2225,
-    -200,  -200,  -200,  -200,    74,    74,    74,    74,  -200,  -200,
-    -200,   716,   412,   413,   482,  -200,   424,   425,   435,   436,
-     442,  -200,   450,  -200,   462,  -200,  -200,  -200,  2251,  -200,
-    2479,    81,  2277,  -200,  -200,  -200,  2303,   464,  -200,  -200,
-    -200,  2329,  -200,  2355,  -200,  2381,  -200,  -200,  -200,  2407,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,   508,
-    -200,  -200,  -200,   469,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,   471,
-    -200,  -200
+    1139,    23,    55,    81,  1443,  1443,    91,   126,  1443,  1115,
+       8,  -201,  1443,  1443,    44,    44,    44,    21,  1443,  1443,
+      25,    31,   -68,   -67,   165,  1195,  1443,    -7,   -23,   -69,
+     -62,   -33,    46,  1443,  -201,  1443,  1722,  1443,   108,    61,
+      62,  -201,  -201,  -201,  -201,  1443,  1443,  -201,  1443,  1443,
+    1443,   485,  -201,    67,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  2527,  1443,  -201,   873,
+     102,   -57,  -201,  -201,    71,    88,    92,   100,   104,   105,
+      44,    44,   106,   113,   117,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  1597,  -201,
+    1597,  1597,  -201,  1343,    -6,  -201,   -17,  1443,  -201,   210,
+     122,   123,   124,   125,   127,   128,  1443,  1443,  1443,  1443,
+     130,   134,   135,   -32,   -58,   136,  -201,   137,  -201,  -201,
+    -201,  -201,  -201,  -201,   138,  -201,  -201,  -201,  1222,  -201,
+     902,   111,  1443,  1443,   973,   973,   139,   -54,   140,   141,
+     143,  1546,  1364,   164,   120,  -201,    20,   166,   168,   172,
+    1721,   973,  -201,  -201,   186,   194,   195,  -201,  1747,  1773,
+    -201,  -201,   196,  -201,   197,  -201,   207,  1443,   208,  1443,
+    1443,  -201,  -201,  1799,  1825,   209,   211,   -45,   241,  -201,
+    1388,   156,   242,  -201,   243,  -201,   244,  -201,  -201,  1851,
+    1877,   252,   253,   257,   269,   270,   271,   272,   274,   276,
+     277,   278,   279,   280,   281,   283,   284,   285,   286,   287,
+     288,   289,   290,   291,   292,   297,   299,   300,   301,   302,
+     305,   310,   311,   314,   316,   317,   319,   320,   321,   322,
+     323,   325,   326,   327,   328,   329,   330,   331,   332,   335,
+     337,   340,   341,   342,   343,   344,   345,   346,  -201,   362,
+    1903,   363,  -201,  -201,   368,   368,   368,   729,   368,  -201,
+    -201,  -201,  1443,  1443,  1443,  1443,  1443,  1443,  1443,  1443,
+    1443,  1443,  1443,  1443,  1443,  1443,  1443,  1443,  1443,  1929,
+    -201,   364,   388,  -201,  1443,  1443,  1443,  1443,  1443,  1443,
+     391,   392,  1443,  1443,  1443,  -201,  -201,   121,  1597,  1597,
+    1597,  1597,  1597,  1597,  1597,  1597,  1597,  1597,  1597,   412,
+    -201,   457,  -201,   -13,   458,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  1443,  2527,  1443,  1443,  1443,  -201,  -201,  -201,
+     395,  -201,   -20,   -19,  -201,  -201,  -201,  -201,  -201,  1955,
+    -201,   396,   973,  1981,  1443,  1443,   973,  2007,  -201,   397,
+    -201,  -201,  -201,  -201,  -201,  -201,   167,  -201,   432,  -201,
+    2033,  -201,  -201,  -201,  -201,  2059,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,   769,  -201,   800,   942,  -201,  -201,
+    -201,  -201,   403,  -201,  -201,  -201,  2085,  1419,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,    47,    47,    47,   368,   368,   368,
+     368,   482,   482,   482,   482,   482,   482,    47,    47,    47,
+    2527,  -201,  -201,  -201,  2111,  2137,  2163,  2189,  2215,  2241,
+    -201,  -201,  2267,  2293,  2319,  -201,  -201,  -201,  -201,    75,
+      75,    75,    75,  -201,  -201,  -201,   700,   404,   410,   476,
+    -201,   414,   415,   416,   417,   422,  -201,   428,  -201,   429,
+    -201,  -201,  -201,  2345,  -201,   624,    83,  2371,  -201,  -201,
+    -201,  2397,   439,  -201,  -201,  -201,  2423,  -201,  2449,  -201,
+    2475,  -201,  -201,  -201,  2501,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,   504,  -201,  -201,  -201,   446,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,   448,  -201,  -201
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -1238,16 +1238,16 @@ static const yytype_int16 yypact[] =
    means the default is an error.  */
 static const yytype_int16 yydefact[] =
 {
-      66,   309,   308,   310,   311,   312,    72,    73,    74,    75,
-      76,    77,   313,     0,     0,     0,     0,     0,     0,     0,
+      66,   311,   310,   312,   313,   314,    72,    73,    74,    75,
+      76,    77,   315,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,    70,    71,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   307,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   309,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   306,     0,     0,     0,     0,     0,
-       0,   315,   316,   317,   318,     0,     0,    67,     0,     0,
-       0,     0,     3,     0,   314,    45,    46,    47,    55,    53,
+       0,     0,     0,     0,   308,     0,     0,     0,     0,     0,
+       0,   317,   318,   319,   320,     0,     0,    67,     0,     0,
+       0,     0,     3,     0,   316,    45,    46,    47,    55,    53,
       54,    44,    41,    42,    43,    48,    49,    52,    56,    50,
       51,    57,    58,     4,     5,     6,     7,     9,     8,    10,
       23,    24,    11,    12,    13,    14,    15,    16,    17,    18,
@@ -1255,80 +1255,80 @@ static const yytype_int16 yydefact[] =
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
       59,    60,    61,    62,    63,    64,    65,     0,   119,     0,
        0,     0,   121,   125,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   151,   283,   282,   284,   285,   286,
-     287,   281,   280,   289,   290,   291,   292,     0,   138,     0,
-       0,   288,     0,   307,   141,     0,     0,   146,     0,     0,
-       0,     0,     0,     0,     0,   171,   171,   171,   171,     0,
-       0,     0,     0,     0,   187,     0,   174,   175,   176,   177,
-     178,   179,     0,   183,   182,   181,     0,   191,     0,     0,
+       0,     0,     0,     0,     0,   152,   285,   284,   286,   287,
+     288,   289,   283,   282,   291,   292,   293,   294,     0,   139,
+       0,     0,   290,     0,   309,   142,     0,     0,   147,     0,
+       0,     0,     0,     0,     0,     0,   173,   173,   173,   173,
+       0,     0,     0,     0,     0,     0,   189,     0,   176,   177,
+     178,   179,   180,   181,     0,   185,   184,   183,     0,   193,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   203,     0,     0,     0,     0,     0,     0,
-      68,    69,     0,     0,     0,    90,     0,     0,    80,    81,
-       0,    94,     0,    96,     0,     0,     0,     0,     0,   100,
-     107,     0,     0,     0,     0,     0,     0,    87,     0,     0,
-       0,   113,     0,   115,     0,   152,   117,     0,     0,     0,
+       0,     0,     0,     0,     0,   205,     0,     0,     0,     0,
+       0,     0,    68,    69,     0,     0,     0,    90,     0,     0,
+      80,    81,     0,    94,     0,    96,     0,     0,     0,     0,
+       0,   100,   107,     0,     0,     0,     0,     0,     0,    87,
+       0,     0,     0,   113,     0,   115,     0,   153,   117,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   274,     0,     0,     0,
-     277,   278,   337,   338,   336,     0,   339,     1,     2,   173,
+       0,     0,     0,     0,     0,     0,     0,     0,   276,     0,
+       0,     0,   279,   280,   339,   340,   338,     0,   341,     1,
+       2,   175,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   279,     0,
-       0,   122,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   304,   303,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   144,     0,   142,
-     338,     0,   147,   184,   185,   186,   162,   154,   155,   171,
-     172,   171,   171,   171,   161,   160,   163,     0,   164,     0,
-       0,   166,   127,   180,   189,     0,   190,     0,     0,     0,
-       0,     0,     0,     0,   197,     0,   198,   200,   201,   202,
-      89,   206,     0,   209,     0,   204,     0,   212,   211,   213,
-     214,     0,    91,    92,    93,    79,    78,    95,    97,    99,
-       0,    98,     0,     0,   108,   126,    84,    83,     0,    85,
-      82,   109,     0,     0,   114,   116,   153,   118,    88,   217,
-     218,   219,   263,   227,   221,   222,   223,   224,   225,   226,
-     265,   216,   245,   246,   247,   248,   249,   250,   253,   252,
-     251,   261,   234,   254,   255,   256,   257,   258,   262,   230,
-     231,   232,   233,   235,   237,   236,   228,   229,   238,   239,
-     259,   260,   220,   266,   240,   241,   242,   243,   271,   264,
-     273,   267,   268,   269,   270,   272,   244,   275,   276,   340,
-     324,   325,   326,   332,   333,   334,   335,   320,   321,   327,
-     328,   331,   330,   322,   323,   329,   319,   120,   123,   124,
-       0,     0,     0,     0,     0,     0,   128,     0,     0,     0,
-     305,   297,   298,   299,   293,   294,   300,   301,   295,   296,
-     302,     0,     0,     0,     0,   149,     0,     0,     0,     0,
-       0,   165,     0,   169,     0,   167,   188,   192,     0,   194,
-     321,   322,     0,   196,   199,   207,     0,     0,   205,   215,
-     101,     0,   102,     0,   103,     0,    86,   110,   111,     0,
-     131,   130,   132,   133,   134,   129,   135,   136,   137,     0,
-     139,   145,   143,     0,   148,   156,   157,   158,   159,   170,
-     168,   193,   195,   208,   210,   104,   105,   106,   112,     0,
-     150,   140
+     281,     0,     0,   122,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   306,   305,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     145,     0,   143,   340,     0,   148,   186,   187,   188,   163,
+     155,   156,   173,   174,   173,   173,   173,   162,   161,   164,
+       0,   165,     0,     0,   168,   167,   127,   182,   191,     0,
+     192,     0,     0,     0,     0,     0,     0,     0,   199,     0,
+     200,   202,   203,   204,    89,   208,     0,   211,     0,   206,
+       0,   214,   213,   215,   216,     0,    91,    92,    93,    79,
+      78,    95,    97,    99,     0,    98,     0,     0,   108,   126,
+      84,    83,     0,    85,    82,   109,     0,     0,   114,   116,
+     154,   118,    88,   219,   220,   221,   265,   229,   223,   224,
+     225,   226,   227,   228,   267,   218,   247,   248,   249,   250,
+     251,   252,   255,   254,   253,   263,   236,   256,   257,   258,
+     259,   260,   264,   232,   233,   234,   235,   237,   239,   238,
+     230,   231,   240,   241,   261,   262,   222,   268,   242,   243,
+     244,   245,   273,   266,   275,   269,   270,   271,   272,   274,
+     246,   277,   278,   342,   326,   327,   328,   334,   335,   336,
+     337,   322,   323,   329,   330,   333,   332,   324,   325,   331,
+     321,   120,   123,   124,     0,     0,     0,     0,     0,     0,
+     128,   129,     0,     0,     0,   307,   299,   300,   301,   295,
+     296,   302,   303,   297,   298,   304,     0,     0,     0,     0,
+     150,     0,     0,     0,     0,     0,   166,     0,   171,     0,
+     169,   190,   194,     0,   196,   323,   324,     0,   198,   201,
+     209,     0,     0,   207,   217,   101,     0,   102,     0,   103,
+       0,    86,   110,   111,     0,   132,   131,   133,   134,   135,
+     130,   136,   137,   138,     0,   140,   146,   144,     0,   149,
+     157,   158,   159,   160,   172,   170,   195,   197,   210,   212,
+     104,   105,   106,   112,     0,   151,   141
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -200,  -200,   510,   -37,   538,    -2,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -199,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,
-    -200,  -200,  -200,  -200,  -200,  -200,  -200,  -200,  -186,     0
+    -201,  -201,   501,   -37,   528,    -2,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -200,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
+    -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -187,     0
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-       0,    91,    92,   252,    93,    94,    95,    96,    97,    98,
+       0,    91,    92,   254,    93,    94,    95,    96,    97,    98,
       99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
      109,   110,   111,   112,   113,   114,   115,   116,   117,   118,
-     119,   120,   121,   122,   419,   123,   124,   125,   126,   127,
+     119,   120,   121,   122,   422,   123,   124,   125,   126,   127,
      128,   129,   130,   131,   132,   133,   134,   135,   136,   137,
      138,   139,   140,   141,   142,   143,   144,   145,   146,   147,
-     148,   149,   150,   151,   152,   153,   154,   155,   192,   420
+     148,   149,   150,   151,   152,   153,   154,   155,   193,   423
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -1336,273 +1336,278 @@ static const yytype_int16 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-     156,   392,   408,   393,   394,   280,   594,   421,   422,   423,
-     273,   157,   282,   406,   159,   173,   429,   191,   253,   254,
-     195,   198,   163,     1,     2,     3,     4,     5,     6,     7,
-       8,     9,    10,    11,    12,   174,   260,   262,   160,   199,
-     228,   284,   427,   274,   232,   233,   214,   380,   239,   244,
-     445,   278,   248,   249,   602,   604,   430,   200,   256,   257,
-     250,   251,   478,   201,   215,   271,   272,   275,   216,   281,
-     261,   263,   217,   287,   218,   288,   283,   348,   279,   219,
-     431,   381,   245,   246,   446,   352,   353,   220,   354,   355,
-     356,   156,   161,   479,    51,   221,   223,   229,   360,   361,
-     362,   363,   364,   365,   366,   285,   428,   276,   222,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,   603,   605,
-     224,   409,   247,   376,    74,   595,   162,   376,   225,   230,
-     158,   277,   407,   388,   231,   360,   361,   362,   363,   364,
-     365,   366,    81,    82,    83,    84,   367,   440,   369,   370,
-     371,   372,   441,   374,   375,   234,   255,   377,   455,   258,
-     376,    88,    89,   259,    90,   286,   349,   350,     1,     2,
-       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-     264,   363,   364,   365,   366,   191,   351,   191,   191,   395,
-     396,   397,   359,   379,   413,   265,   410,   382,   383,  -338,
-    -338,  -338,  -338,   376,   384,   385,   402,   403,   404,   581,
-     582,   583,   584,   585,   586,   587,   588,   589,   590,   591,
-     597,   376,   598,   599,   600,   386,   435,   387,   437,   414,
-     438,   439,   442,   443,   395,   396,   397,   266,   389,    51,
-     452,   390,   391,   415,   456,   398,   399,   400,   401,   461,
-     416,   402,   403,   404,   267,   268,   235,   236,   237,   238,
-     417,   418,   580,   424,   425,   470,   426,   472,   473,    74,
-     432,   433,   444,   447,   448,   449,   453,   457,   482,   454,
-     360,   361,   362,   363,   364,   365,   366,    81,    82,    83,
-      84,   367,   440,   369,   370,   371,   372,   441,   374,   375,
-     269,   458,   459,   615,   462,   376,    88,    89,   463,    90,
+     156,   395,   411,   396,   397,   282,   599,   424,   425,   426,
+     275,   157,   284,   409,   159,   174,   432,   192,   255,   256,
+     196,   199,   163,     1,     2,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,   175,   262,   264,   160,   200,
+     230,   286,   430,   276,   234,   235,   216,   382,   241,   246,
+     449,   280,   250,   251,   607,   609,   433,   201,   258,   259,
+     252,   253,   482,   202,   217,   273,   274,   277,   218,   283,
+     263,   265,   219,   289,   220,   290,   285,   350,   281,   221,
+     434,   383,   247,   248,   450,   354,   355,   222,   356,   357,
+     358,   156,   161,   483,    51,   223,   225,   231,   362,   363,
+     364,   365,   366,   367,   368,   287,   431,   278,   224,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,   608,   610,
+     226,   412,   249,   378,    74,   600,   162,   378,   227,   232,
+     158,   279,   410,   390,   391,   362,   363,   364,   365,   366,
+     367,   368,    81,    82,    83,    84,   369,   444,   371,   372,
+     373,   374,   445,   376,   377,   233,   236,   379,   459,   257,
+     378,    88,    89,   260,    90,   365,   366,   367,   368,   261,
        1,     2,     3,     4,     5,     6,     7,     8,     9,    10,
-      11,    12,   464,   467,   468,   469,   471,   483,   476,   477,
-     480,   484,   485,   486,   489,   490,     1,     2,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,   164,   165,
-     166,   167,   168,     6,     7,     8,     9,    10,    11,   491,
-     550,   551,   552,   553,   554,   555,   556,   557,   558,   559,
-     560,   561,   562,   563,   564,   565,   566,   492,   493,   494,
-     495,   193,   570,   571,   572,   573,   574,   575,   496,   577,
-     578,   579,   497,   191,   191,   191,   191,   191,   191,   191,
-     191,   191,   191,   191,   498,   499,   500,    51,   169,   501,
-     502,    74,   503,   504,   505,   506,   507,   170,   508,   509,
-     510,   511,   512,   513,   514,   515,   516,   517,   518,    81,
-      82,    83,    84,   519,    85,   520,   521,    74,   608,    86,
-     610,   611,   612,   522,   523,   194,   524,   525,    88,    89,
-     526,    90,   616,   527,   528,    81,    82,    83,    84,   529,
-      85,   530,   531,   532,   533,   196,   534,   535,   171,   172,
-     621,   197,   623,   625,    88,    89,   536,    90,   537,   538,
-     539,   357,   540,   629,     1,     2,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,   541,   542,   543,    13,
-      14,    15,    16,    17,   544,    18,    19,    20,    21,    22,
-      23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
-      33,    34,   545,    35,    36,   546,   548,   592,   568,   376,
-     569,   576,   593,    37,    38,    39,    40,   596,   601,    41,
-      42,    43,    44,    45,   607,    46,   614,    47,   617,   626,
-     641,   642,    48,    49,    50,    51,   643,    52,    53,    54,
-      55,    56,   644,   645,    57,    58,    59,    60,    61,    62,
-      63,    64,    65,   646,   647,    66,    67,    68,    69,    70,
-     648,    71,   659,    72,    73,    74,    75,    76,   649,    77,
-      78,    79,    80,   360,   361,   362,   363,   364,   365,   366,
-     650,   358,   654,    81,    82,    83,    84,   660,    85,   661,
-     373,   374,   375,    86,   347,     0,     0,     0,   376,    87,
-       0,     0,    88,    89,     0,    90,     1,     2,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,     0,     0,
-       0,    13,    14,    15,    16,    17,     0,    18,    19,    20,
-      21,    22,    23,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,    33,    34,     0,    35,    36,     0,     0,     0,
-       0,     0,     0,     0,     0,    37,    38,    39,    40,     0,
-       0,    41,    42,    43,    44,    45,     0,    46,     0,    47,
-       0,     0,     0,     0,    48,    49,    50,    51,     0,    52,
-      53,    54,    55,    56,     0,     0,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,   411,     0,    66,    67,    68,
-      69,    70,     0,    71,     0,    72,    73,    74,    75,    76,
-       0,    77,    78,    79,    80,   639,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    81,    82,    83,    84,     0,
-      85,     0,     0,     0,     0,    86,     0,     0,     0,     0,
-       0,    87,     0,     0,    88,    89,     0,    90,     1,     2,
+      11,    12,   351,   266,   288,   441,   192,   378,   192,   192,
+     398,   399,   400,   237,   238,   239,   240,   413,   267,   352,
+     353,  -340,  -340,  -340,  -340,   361,   381,   405,   406,   407,
+     384,   586,   587,   588,   589,   590,   591,   592,   593,   594,
+     595,   596,   602,   378,   603,   604,   605,   385,   439,   414,
+     487,   386,   442,   443,   446,   447,   398,   399,   400,   387,
+     268,    51,   456,   388,   389,   392,   460,   401,   402,   403,
+     404,   465,   393,   405,   406,   407,   394,   269,   270,   458,
+     416,   417,   418,   419,   585,   420,   421,   474,   427,   476,
+     477,    74,   428,   429,   435,   436,   437,   448,   451,   452,
+     486,   453,   362,   363,   364,   365,   366,   367,   368,    81,
+      82,    83,    84,   369,   444,   371,   372,   373,   374,   445,
+     376,   377,   457,   271,   461,   620,   462,   378,    88,    89,
+     463,    90,     1,     2,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,   466,   362,   363,   364,   365,   366,
+     367,   368,   467,   468,   471,   472,   369,   370,   371,   372,
+     373,   374,   375,   376,   377,   473,   475,   480,   415,   481,
+     378,   164,   165,   166,   167,   168,     6,     7,     8,     9,
+      10,    11,   554,   555,   556,   557,   558,   559,   560,   561,
+     562,   563,   564,   565,   566,   567,   568,   569,   570,   484,
+     488,   489,   490,   194,   574,   575,   576,   577,   578,   579,
+     493,   494,   582,   583,   584,   495,   192,   192,   192,   192,
+     192,   192,   192,   192,   192,   192,   192,   496,   497,   498,
+     499,   169,   500,    74,   501,   502,   503,   504,   505,   506,
+     170,   507,   508,   509,   510,   511,   512,   513,   514,   515,
+     516,    81,    82,    83,    84,   517,    85,   518,   519,   520,
+     521,    86,   613,   522,   615,   616,   617,   195,   523,   524,
+      88,    89,   525,    90,   526,   527,   621,   528,   529,   530,
+     531,   532,   171,   533,   534,   535,   536,   537,   538,   539,
+     540,   172,   173,   541,   626,   542,   628,   630,   543,   544,
+     545,   546,   547,   548,   549,   359,   597,   634,     1,     2,
        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
+     550,   552,   572,    13,    14,    15,    16,    17,   378,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,   573,    35,    36,   580,
+     581,   598,   601,   606,   612,   619,   622,    37,    38,    39,
+      40,   631,   646,    41,    42,    43,    44,    45,   647,    46,
+     648,    47,   649,   650,   651,   652,    48,    49,    50,    51,
+     653,    52,    53,    54,    55,    56,   654,   655,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,   659,   664,    66,
+      67,    68,    69,    70,   665,    71,   666,    72,    73,    74,
+      75,    76,   360,    77,    78,    79,    80,   362,   363,   364,
+     365,   366,   367,   368,   349,     0,     0,    81,    82,    83,
+      84,     0,    85,     0,   375,   376,   377,    86,     0,     0,
+       0,     0,   378,    87,     0,     0,    88,    89,     0,    90,
+       1,     2,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,     0,     0,     0,    13,    14,    15,    16,    17,
+       0,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,     0,    35,
+      36,     0,     0,     0,     0,     0,     0,     0,     0,    37,
+      38,    39,    40,     0,     0,    41,    42,    43,    44,    45,
+       0,    46,     0,    47,     0,     0,     0,     0,    48,    49,
+      50,    51,     0,    52,    53,    54,    55,    56,     0,     0,
+      57,    58,    59,    60,    61,    62,    63,    64,    65,   644,
+       0,    66,    67,    68,    69,    70,     0,    71,     0,    72,
+      73,    74,    75,    76,     0,    77,    78,    79,    80,  -339,
+    -339,  -339,  -339,  -339,  -339,  -339,     0,     0,     0,    81,
+      82,    83,    84,     0,    85,     0,  -339,  -339,  -339,    86,
+       0,     0,     0,     0,   378,    87,     0,     0,    88,    89,
+       0,    90,     1,     2,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     1,
-       2,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,   360,   361,   362,   363,   364,   365,   366,     0,     0,
-       0,     0,   367,   368,   369,   370,   371,   372,   373,   374,
-     375,   395,   396,   397,   412,     0,   376,     0,     0,    51,
-       0,     0,   398,   399,   400,   401,     0,     0,   402,   403,
-     404,     0,     0,     0,   640,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    74,
-      51,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-     360,   361,   362,   363,   364,   365,   366,    81,    82,    83,
-      84,   367,   440,   369,   370,   371,   372,   441,   374,   375,
-      74,     0,     0,   620,     0,   376,    88,    89,     0,    90,
-       0,   360,   361,   362,   363,   364,   365,   366,    81,    82,
-      83,    84,   367,   440,   369,   370,   371,   372,   441,   374,
-     375,     0,     0,     0,   622,     0,   376,    88,    89,     0,
-      90,     1,     2,     3,     4,     5,     6,     7,     8,     9,
-      10,    11,    12,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     1,     2,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,   398,   399,   400,     0,     0,
+       0,     0,     0,     0,     0,     0,   401,   402,   403,   404,
+       0,     0,   405,   406,   407,     0,     0,     0,   645,     0,
+       0,     0,     0,    51,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,     0,     0,   378,
+       0,     0,   553,    74,    51,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   362,   363,   364,   365,   366,   367,
+     368,    81,    82,    83,    84,   369,   444,   371,   372,   373,
+     374,   445,   376,   377,    74,     0,     0,   625,     0,   378,
+      88,    89,     0,    90,     0,   362,   363,   364,   365,   366,
+     367,   368,    81,    82,    83,    84,   369,   444,   371,   372,
+     373,   374,   445,   376,   377,     0,     0,     0,   627,     0,
+     378,    88,    89,     0,    90,     1,     2,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   380,     0,   378,     0,     0,    51,   362,   363,   364,
+     365,   366,   367,   368,     0,     0,     0,     0,   369,   370,
+     371,   372,   373,   374,   375,   376,   377,     0,     0,     0,
+     440,     0,   378,     0,     0,     0,    74,    51,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   362,   363,   364,
+     365,   366,   367,   368,    81,    82,    83,    84,   369,   444,
+     371,   372,   373,   374,   445,   376,   377,    74,     0,     0,
+     629,     0,   378,    88,    89,     0,    90,     0,   362,   363,
+     364,   365,   366,   367,   368,    81,    82,    83,    84,   369,
+     444,   371,   372,   373,   374,   445,   376,   377,     0,     0,
+       0,     0,     0,   378,    88,    89,     0,    90,     1,     2,
+       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     1,     2,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,     0,   360,   361,   362,   363,   364,
-     365,   366,     0,     0,     0,     0,   367,   368,   369,   370,
-     371,   372,   373,   374,   375,     0,     0,     0,     0,     0,
-     376,     0,    51,   549,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   378,     0,   376,
-       0,     0,    74,    51,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   360,   361,   362,   363,   364,   365,   366,
-      81,    82,    83,    84,   367,   440,   369,   370,   371,   372,
-     441,   374,   375,    74,     0,     0,   624,     0,   376,    88,
-      89,     0,    90,     0,   360,   361,   362,   363,   364,   365,
-     366,    81,    82,    83,    84,   367,   440,   369,   370,   371,
-     372,   441,   374,   375,     0,     0,     0,     0,     0,   376,
-      88,    89,     0,    90,     1,     2,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     1,     2,
+       9,    10,    11,    12,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   242,     1,     2,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,     0,     0,     0,     0,    51,
+       0,     0,     0,     0,     0,   228,   243,   244,     1,     2,
        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
+       0,     0,     0,    51,     0,     0,     0,     0,     0,    74,
+       0,     0,     0,     0,     0,     1,     2,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    81,    82,    83,
+      84,     0,    85,    74,    51,     0,     0,    86,     0,     0,
+       0,     0,     0,   245,     0,     0,    88,    89,     0,    90,
+       0,    81,    82,    83,    84,     0,    85,     0,     0,    51,
+       0,    86,     0,     0,    74,     0,     0,   229,     0,     0,
+      88,    89,     0,    90,     0,     0,     0,     0,     0,     0,
+       0,     0,    81,    82,    83,    84,    51,    85,     0,    74,
+       0,     0,   197,     0,     0,     0,     0,     0,   198,     0,
+       0,    88,    89,     0,    90,     0,     0,    81,    82,    83,
+      84,     0,    85,     0,     0,     0,    74,    86,     0,     0,
+       0,     0,     0,   272,     0,     0,    88,    89,     0,    90,
+       0,     0,     0,     0,    81,    82,    83,    84,     0,    85,
+       0,     0,     0,     0,    86,     0,     0,     0,     0,     0,
+     438,     0,     0,    88,    89,     0,    90,     1,     2,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   240,     1,
-       2,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,     0,     0,     0,     0,    51,     0,     0,     0,     0,
-       0,   226,   241,   242,     1,     2,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,     0,     0,     0,    51,
-       0,     0,     0,     0,     0,    74,     0,     0,     0,     0,
        0,     1,     2,     3,     4,     5,     6,     7,     8,     9,
-      10,    11,    12,    81,    82,    83,    84,     0,    85,    74,
-      51,     0,     0,    86,     0,     0,     0,     0,     0,   243,
-       0,     0,    88,    89,     0,    90,     0,    81,    82,    83,
-      84,     0,    85,     0,     0,    51,     0,    86,     0,     0,
-      74,     0,     0,   227,     0,     0,    88,    89,     0,    90,
-       0,     0,     0,     0,     0,     0,     0,     0,    81,    82,
-      83,    84,    51,    85,     0,    74,     0,     0,    86,     0,
-       0,     0,     0,     0,   270,     0,     0,    88,    89,     0,
-      90,     0,     0,    81,    82,    83,    84,     0,    85,     0,
-       0,     0,    74,    86,     0,     0,     0,     0,     0,   434,
-       0,     0,    88,    89,     0,    90,     0,     0,     0,     0,
-      81,    82,    83,    84,     0,    85,     0,     0,     0,     0,
-      86,     0,     0,     0,     0,     0,   451,     0,     0,    88,
-      89,     0,    90,     1,     2,     3,     4,     5,     6,     7,
-       8,     9,    10,    11,    12,   175,   176,   177,   178,   179,
-       6,     7,     8,     9,    10,    11,   180,     1,     2,     3,
-       4,     5,     6,     7,     8,     9,    10,    11,    12,     0,
+      10,    11,    12,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     1,     2,
-       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-       0,     0,     0,     0,    51,     0,   202,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   181,     0,   203,     0,
-       0,     0,     0,     0,     0,     0,   204,     0,    51,     0,
-       0,     0,     0,     0,    74,   205,   206,   207,   208,   209,
-     210,     0,   211,     0,     0,     0,   182,     0,     0,     0,
-       0,     0,    81,    82,    83,    84,     0,    85,    74,    51,
-       0,     0,    86,     0,   183,   184,   185,   186,   481,   187,
-       0,    88,    89,     0,    90,     0,    81,    82,    83,    84,
-     188,    85,     0,   189,   190,     0,    86,     0,     0,    74,
-     212,     0,   628,     0,     0,    88,    89,     0,    90,     0,
-       0,     0,     0,     0,   213,     0,     0,    81,    82,    83,
-      84,     0,    85,     0,     0,     0,     0,    86,     0,     0,
-       0,     0,     0,     0,     0,     0,    88,    89,     0,    90,
-     175,   176,   177,   178,   179,     6,     7,     8,     9,    10,
-      11,   180,     0,     0,     0,     0,     0,     0,     0,     0,
-     289,     0,   290,   291,   292,     0,   293,   294,   295,   296,
-     297,   298,   299,   300,   301,    27,    28,     0,   302,   303,
-     304,   305,   306,     0,   307,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   308,   309,   310,   311,     0,     0,
-     312,   313,   314,   315,   316,     0,     0,     0,     0,     0,
-       0,   181,     0,     0,   317,   318,     0,     0,     0,   319,
-     320,   321,   322,     0,     0,   323,   324,   325,   326,   327,
-     328,   329,   330,   331,     0,     0,   332,   333,   334,   335,
-     336,   182,   337,     0,     0,   338,     0,   339,   340,     0,
-     341,   342,   343,   344,   345,     0,     0,     0,     0,   183,
-     184,   185,   186,     0,   187,     0,     0,     0,     0,     0,
-     360,   361,   362,   363,   364,   365,   366,     0,   189,   190,
-     346,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   436,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   450,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   460,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   465,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   466,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   474,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   475,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   487,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   488,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   547,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   567,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   606,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   609,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   613,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   618,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   619,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   627,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   630,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   631,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   632,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   633,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   634,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   635,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   636,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   637,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   638,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   651,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   652,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,     0,     0,
-       0,   653,     0,   376,   360,   361,   362,   363,   364,   365,
-     366,     0,     0,     0,     0,   367,   368,   369,   370,   371,
-     372,   373,   374,   375,     0,     0,     0,   655,     0,   376,
-     360,   361,   362,   363,   364,   365,   366,     0,     0,     0,
-       0,   367,   368,   369,   370,   371,   372,   373,   374,   375,
-       0,     0,     0,   656,     0,   376,   360,   361,   362,   363,
-     364,   365,   366,     0,     0,     0,     0,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,     0,     0,     0,   657,
-       0,   376,   360,   361,   362,   363,   364,   365,   366,     0,
-       0,     0,     0,   367,   368,   369,   370,   371,   372,   373,
-     374,   375,     0,     0,     0,   658,     0,   376,   360,   361,
-     362,   363,   364,   365,   366,     0,     0,     0,     0,   367,
-     368,   369,   370,   371,   372,   373,   374,   375,   395,   396,
-     397,     0,     0,   376,     0,     0,     0,     0,     0,   398,
-     399,   400,   401,     0,     0,   402,   403,   404,     0,     0,
-       0,     0,     0,   405,  -337,  -337,  -337,  -337,  -337,  -337,
-    -337,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,  -337,  -337,  -337,     0,     0,     0,     0,     0,   376
+       0,     0,     1,     2,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,     0,     0,     0,     0,    51,     0,
+       0,     0,     0,     0,     0,     0,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,   398,   399,
+     400,     0,    51,     0,     0,     0,     0,     0,    74,   401,
+     402,   403,   404,     0,     0,   405,   406,   407,     0,     0,
+       0,     0,     0,   408,     0,     0,    81,    82,    83,    84,
+       0,    85,    74,    51,     0,     0,    86,     0,     0,     0,
+       0,     0,   455,     0,     0,    88,    89,     0,    90,     0,
+      81,    82,    83,    84,     0,    85,     0,    51,     0,     0,
+      86,     0,     0,    74,     0,     0,   485,     0,     0,    88,
+      89,     0,    90,     0,     0,     0,     0,     0,     0,     0,
+       0,    81,    82,    83,    84,     0,    85,    74,     0,     0,
+       0,    86,     0,     0,     0,     0,     0,   633,     0,     0,
+      88,    89,     0,    90,     0,    81,    82,    83,    84,     0,
+      85,     0,     0,     0,     0,    86,     0,     0,     0,     0,
+       0,     0,     0,     0,    88,    89,     0,    90,   176,   177,
+     178,   179,   180,     6,     7,     8,     9,    10,    11,   181,
+     176,   177,   178,   179,   180,     6,     7,     8,     9,    10,
+      11,   181,     0,     0,     0,   203,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   204,     0,     0,
+       0,     0,     0,     0,     0,   205,     0,     0,     0,     0,
+       0,     0,     0,     0,   206,   207,   208,   209,   210,   211,
+       0,   212,     0,     0,     0,     0,     0,     0,     0,   182,
+       0,   362,   363,   364,   365,   366,   367,   368,     0,     0,
+       0,   182,   369,   370,   371,   372,   373,   374,   375,   376,
+     377,     0,     0,     0,   454,     0,   378,     0,     0,   183,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   213,
+       0,   183,     0,     0,     0,     0,     0,   184,   185,   186,
+     187,     0,   188,   214,   215,     0,     0,     0,     0,   184,
+     185,   186,   187,   189,   188,     0,   190,   191,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   190,   191,
+     291,     0,   292,   293,   294,     0,   295,   296,   297,   298,
+     299,   300,   301,   302,   303,    27,    28,     0,   304,   305,
+     306,   307,   308,     0,   309,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   310,   311,   312,   313,     0,     0,
+     314,   315,   316,   317,   318,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   319,   320,     0,     0,     0,   321,
+     322,   323,   324,     0,     0,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,     0,     0,   334,   335,   336,   337,
+     338,     0,   339,     0,     0,   340,     0,   341,   342,     0,
+     343,   344,   345,   346,   347,     0,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   464,
+     348,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   469,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   470,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   478,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   479,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   491,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   492,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   551,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   571,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   611,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   614,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   618,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   623,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   624,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   632,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   635,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   636,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   637,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   638,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   639,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   640,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   641,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   642,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   643,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   656,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   657,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,   658,     0,   378,   362,   363,
+     364,   365,   366,   367,   368,     0,     0,     0,     0,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,     0,     0,
+       0,   660,     0,   378,   362,   363,   364,   365,   366,   367,
+     368,     0,     0,     0,     0,   369,   370,   371,   372,   373,
+     374,   375,   376,   377,     0,     0,     0,   661,     0,   378,
+     362,   363,   364,   365,   366,   367,   368,     0,     0,     0,
+       0,   369,   370,   371,   372,   373,   374,   375,   376,   377,
+       0,     0,     0,   662,     0,   378,   362,   363,   364,   365,
+     366,   367,   368,     0,     0,     0,     0,   369,   370,   371,
+     372,   373,   374,   375,   376,   377,     0,     0,     0,   663,
+       0,   378,   362,   363,   364,   365,   366,   367,   368,     0,
+       0,     0,     0,   369,   370,   371,   372,   373,   374,   375,
+     376,   377,     0,     0,     0,     0,     0,   378
 };
 
 static const yytype_int16 yycheck[] =
 {
-       0,   187,    19,   189,   190,    74,    19,   206,   207,   208,
+       0,   188,    19,   190,   191,    74,    19,   207,   208,   209,
       17,    19,    74,    19,    14,    17,    74,    19,    55,    56,
       20,    21,   138,     3,     4,     5,     6,     7,     8,     9,
       10,    11,    12,    13,    14,   138,   104,   104,    50,   104,
@@ -1615,168 +1620,180 @@ static const yytype_int16 yycheck[] =
      117,   118,   119,   120,   121,   138,   138,   114,   104,   126,
      127,   128,   129,   130,   131,   132,   133,   134,   138,   138,
      138,   138,   114,   140,   104,   138,   138,   140,   138,    74,
-     138,   138,   138,   170,    74,   115,   116,   117,   118,   119,
+     138,   138,   138,   170,   171,   115,   116,   117,   118,   119,
      120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
-     130,   131,   132,   133,   134,    65,   138,   157,   138,   138,
-     140,   141,   142,   138,   144,   138,    74,   138,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      18,   118,   119,   120,   121,   187,   138,   189,   190,   115,
-     116,   117,   138,   104,   138,    33,   196,   139,   139,   118,
-     119,   120,   121,   140,   139,   139,   132,   133,   134,   395,
-     396,   397,   398,   399,   400,   401,   402,   403,   404,   405,
-     419,   140,   421,   422,   423,   139,   226,   139,    74,   138,
-     230,   231,   232,   233,   115,   116,   117,    75,   139,    74,
-     240,   139,   139,   138,   244,   126,   127,   128,   129,   249,
-     138,   132,   133,   134,    92,    93,    67,    68,    69,    70,
-     138,   138,   143,   138,   138,   265,   138,   267,   268,   104,
-     138,   138,   138,   138,   138,   138,   138,   138,   278,   139,
-     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
-     125,   126,   127,   128,   129,   130,   131,   132,   133,   134,
-     138,   138,   138,   138,   138,   140,   141,   142,   138,   144,
+     130,   131,   132,   133,   134,    74,    65,   157,   138,   138,
+     140,   141,   142,   138,   144,   118,   119,   120,   121,   138,
        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-      13,    14,   138,   138,   138,   138,   138,    74,   138,   138,
-     138,   138,   138,   138,   138,   138,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    14,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,   138,
-     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,   376,   138,   138,   138,
-     138,    74,   382,   383,   384,   385,   386,   387,   138,   389,
-     390,   391,   138,   395,   396,   397,   398,   399,   400,   401,
-     402,   403,   404,   405,   138,   138,   138,    74,    63,   138,
-     138,   104,   138,   138,   138,   138,   138,    72,   138,   138,
-     138,   138,   138,   138,   138,   138,   138,   138,   138,   122,
-     123,   124,   125,   138,   127,   138,   138,   104,   438,   132,
-     440,   441,   442,   138,   138,   138,   138,   138,   141,   142,
-     138,   144,   452,   138,   138,   122,   123,   124,   125,   138,
-     127,   138,   138,   138,   138,   132,   138,   138,   123,   124,
-     470,   138,   472,   473,   141,   142,   138,   144,   138,   138,
-     138,     0,   138,   483,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,   138,   138,   138,    18,
-      19,    20,    21,    22,   138,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,   138,    42,    43,   138,   138,    74,   138,   140,
-     138,   138,    74,    52,    53,    54,    55,    74,   138,    58,
-      59,    60,    61,    62,   138,    64,   138,    66,   104,   138,
-     138,   138,    71,    72,    73,    74,    74,    76,    77,    78,
-      79,    80,   138,   138,    83,    84,    85,    86,    87,    88,
-      89,    90,    91,   138,   138,    94,    95,    96,    97,    98,
-     138,   100,    74,   102,   103,   104,   105,   106,   138,   108,
-     109,   110,   111,   115,   116,   117,   118,   119,   120,   121,
-     138,    91,   138,   122,   123,   124,   125,   138,   127,   138,
-     132,   133,   134,   132,    76,    -1,    -1,    -1,   140,   138,
-      -1,    -1,   141,   142,    -1,   144,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    14,    -1,    -1,
-      -1,    18,    19,    20,    21,    22,    -1,    24,    25,    26,
-      27,    28,    29,    30,    31,    32,    33,    34,    35,    36,
-      37,    38,    39,    40,    -1,    42,    43,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    52,    53,    54,    55,    -1,
-      -1,    58,    59,    60,    61,    62,    -1,    64,    -1,    66,
-      -1,    -1,    -1,    -1,    71,    72,    73,    74,    -1,    76,
-      77,    78,    79,    80,    -1,    -1,    83,    84,    85,    86,
-      87,    88,    89,    90,    91,    19,    -1,    94,    95,    96,
-      97,    98,    -1,   100,    -1,   102,   103,   104,   105,   106,
-      -1,   108,   109,   110,   111,    19,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,   122,   123,   124,   125,    -1,
-     127,    -1,    -1,    -1,    -1,   132,    -1,    -1,    -1,    -1,
-      -1,   138,    -1,    -1,   141,   142,    -1,   144,     3,     4,
+      13,    14,    74,    18,   138,    74,   188,   140,   190,   191,
+     115,   116,   117,    67,    68,    69,    70,   197,    33,   138,
+     138,   118,   119,   120,   121,   138,   104,   132,   133,   134,
+     139,   398,   399,   400,   401,   402,   403,   404,   405,   406,
+     407,   408,   422,   140,   424,   425,   426,   139,   228,    19,
+      74,   139,   232,   233,   234,   235,   115,   116,   117,   139,
+      75,    74,   242,   139,   139,   139,   246,   126,   127,   128,
+     129,   251,   139,   132,   133,   134,   139,    92,    93,   139,
+     138,   138,   138,   138,   143,   138,   138,   267,   138,   269,
+     270,   104,   138,   138,   138,   138,   138,   138,   138,   138,
+     280,   138,   115,   116,   117,   118,   119,   120,   121,   122,
+     123,   124,   125,   126,   127,   128,   129,   130,   131,   132,
+     133,   134,   138,   138,   138,   138,   138,   140,   141,   142,
+     138,   144,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    14,   138,   115,   116,   117,   118,   119,
+     120,   121,   138,   138,   138,   138,   126,   127,   128,   129,
+     130,   131,   132,   133,   134,   138,   138,   138,   138,   138,
+     140,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,   375,   376,   377,   378,   138,
+     138,   138,   138,    74,   384,   385,   386,   387,   388,   389,
+     138,   138,   392,   393,   394,   138,   398,   399,   400,   401,
+     402,   403,   404,   405,   406,   407,   408,   138,   138,   138,
+     138,    63,   138,   104,   138,   138,   138,   138,   138,   138,
+      72,   138,   138,   138,   138,   138,   138,   138,   138,   138,
+     138,   122,   123,   124,   125,   138,   127,   138,   138,   138,
+     138,   132,   442,   138,   444,   445,   446,   138,   138,   138,
+     141,   142,   138,   144,   138,   138,   456,   138,   138,   138,
+     138,   138,   114,   138,   138,   138,   138,   138,   138,   138,
+     138,   123,   124,   138,   474,   138,   476,   477,   138,   138,
+     138,   138,   138,   138,   138,     0,    74,   487,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+     138,   138,   138,    18,    19,    20,    21,    22,   140,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,   138,    42,    43,   138,
+     138,    74,    74,   138,   138,   138,   104,    52,    53,    54,
+      55,   138,   138,    58,    59,    60,    61,    62,   138,    64,
+      74,    66,   138,   138,   138,   138,    71,    72,    73,    74,
+     138,    76,    77,    78,    79,    80,   138,   138,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,   138,    74,    94,
+      95,    96,    97,    98,   138,   100,   138,   102,   103,   104,
+     105,   106,    91,   108,   109,   110,   111,   115,   116,   117,
+     118,   119,   120,   121,    76,    -1,    -1,   122,   123,   124,
+     125,    -1,   127,    -1,   132,   133,   134,   132,    -1,    -1,
+      -1,    -1,   140,   138,    -1,    -1,   141,   142,    -1,   144,
+       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
+      13,    14,    -1,    -1,    -1,    18,    19,    20,    21,    22,
+      -1,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    -1,    42,
+      43,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    52,
+      53,    54,    55,    -1,    -1,    58,    59,    60,    61,    62,
+      -1,    64,    -1,    66,    -1,    -1,    -1,    -1,    71,    72,
+      73,    74,    -1,    76,    77,    78,    79,    80,    -1,    -1,
+      83,    84,    85,    86,    87,    88,    89,    90,    91,    19,
+      -1,    94,    95,    96,    97,    98,    -1,   100,    -1,   102,
+     103,   104,   105,   106,    -1,   108,   109,   110,   111,   115,
+     116,   117,   118,   119,   120,   121,    -1,    -1,    -1,   122,
+     123,   124,   125,    -1,   127,    -1,   132,   133,   134,   132,
+      -1,    -1,    -1,    -1,   140,   138,    -1,    -1,   141,   142,
+      -1,   144,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    14,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,     3,
-       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
-      14,   115,   116,   117,   118,   119,   120,   121,    -1,    -1,
-      -1,    -1,   126,   127,   128,   129,   130,   131,   132,   133,
-     134,   115,   116,   117,   138,    -1,   140,    -1,    -1,    74,
-      -1,    -1,   126,   127,   128,   129,    -1,    -1,   132,   133,
-     134,    -1,    -1,    -1,   138,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   104,
-      74,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
-     125,   126,   127,   128,   129,   130,   131,   132,   133,   134,
-     104,    -1,    -1,   138,    -1,   140,   141,   142,    -1,   144,
-      -1,   115,   116,   117,   118,   119,   120,   121,   122,   123,
-     124,   125,   126,   127,   128,   129,   130,   131,   132,   133,
-     134,    -1,    -1,    -1,   138,    -1,   140,   141,   142,    -1,
-     144,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,    13,    14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,     3,     4,     5,     6,     7,     8,     9,    10,
-      11,    12,    13,    14,    -1,   115,   116,   117,   118,   119,
-     120,   121,    -1,    -1,    -1,    -1,   126,   127,   128,   129,
-     130,   131,   132,   133,   134,    -1,    -1,    -1,    -1,    -1,
-     140,    -1,    74,   143,   115,   116,   117,   118,   119,   120,
+      -1,    -1,    -1,     3,     4,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,    14,   115,   116,   117,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,   126,   127,   128,   129,
+      -1,    -1,   132,   133,   134,    -1,    -1,    -1,   138,    -1,
+      -1,    -1,    -1,    74,   115,   116,   117,   118,   119,   120,
      121,    -1,    -1,    -1,    -1,   126,   127,   128,   129,   130,
-     131,   132,   133,   134,    -1,    -1,    -1,   138,    -1,   140,
-      -1,    -1,   104,    74,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,   115,   116,   117,   118,   119,   120,   121,
-     122,   123,   124,   125,   126,   127,   128,   129,   130,   131,
-     132,   133,   134,   104,    -1,    -1,   138,    -1,   140,   141,
-     142,    -1,   144,    -1,   115,   116,   117,   118,   119,   120,
-     121,   122,   123,   124,   125,   126,   127,   128,   129,   130,
      131,   132,   133,   134,    -1,    -1,    -1,    -1,    -1,   140,
-     141,   142,    -1,   144,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,     3,     4,
+      -1,    -1,   143,   104,    74,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   115,   116,   117,   118,   119,   120,
+     121,   122,   123,   124,   125,   126,   127,   128,   129,   130,
+     131,   132,   133,   134,   104,    -1,    -1,   138,    -1,   140,
+     141,   142,    -1,   144,    -1,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
+     130,   131,   132,   133,   134,    -1,    -1,    -1,   138,    -1,
+     140,   141,   142,    -1,   144,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,     3,     4,     5,     6,
+       7,     8,     9,    10,    11,    12,    13,    14,   115,   116,
+     117,   118,   119,   120,   121,    -1,    -1,    -1,    -1,   126,
+     127,   128,   129,   130,   131,   132,   133,   134,    -1,    -1,
+      -1,   138,    -1,   140,    -1,    -1,    74,   115,   116,   117,
+     118,   119,   120,   121,    -1,    -1,    -1,    -1,   126,   127,
+     128,   129,   130,   131,   132,   133,   134,    -1,    -1,    -1,
+     138,    -1,   140,    -1,    -1,    -1,   104,    74,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   115,   116,   117,
+     118,   119,   120,   121,   122,   123,   124,   125,   126,   127,
+     128,   129,   130,   131,   132,   133,   134,   104,    -1,    -1,
+     138,    -1,   140,   141,   142,    -1,   144,    -1,   115,   116,
+     117,   118,   119,   120,   121,   122,   123,   124,   125,   126,
+     127,   128,   129,   130,   131,   132,   133,   134,    -1,    -1,
+      -1,    -1,    -1,   140,   141,   142,    -1,   144,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    57,     3,
-       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
-      14,    -1,    -1,    -1,    -1,    74,    -1,    -1,    -1,    -1,
-      -1,    56,    81,    82,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,    -1,    -1,    -1,    74,
-      -1,    -1,    -1,    -1,    -1,   104,    -1,    -1,    -1,    -1,
-      -1,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,    13,    14,   122,   123,   124,   125,    -1,   127,   104,
-      74,    -1,    -1,   132,    -1,    -1,    -1,    -1,    -1,   138,
-      -1,    -1,   141,   142,    -1,   144,    -1,   122,   123,   124,
-     125,    -1,   127,    -1,    -1,    74,    -1,   132,    -1,    -1,
-     104,    -1,    -1,   138,    -1,    -1,   141,   142,    -1,   144,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   122,   123,
-     124,   125,    74,   127,    -1,   104,    -1,    -1,   132,    -1,
-      -1,    -1,    -1,    -1,   138,    -1,    -1,   141,   142,    -1,
-     144,    -1,    -1,   122,   123,   124,   125,    -1,   127,    -1,
-      -1,    -1,   104,   132,    -1,    -1,    -1,    -1,    -1,   138,
-      -1,    -1,   141,   142,    -1,   144,    -1,    -1,    -1,    -1,
-     122,   123,   124,   125,    -1,   127,    -1,    -1,    -1,    -1,
-     132,    -1,    -1,    -1,    -1,    -1,   138,    -1,    -1,   141,
-     142,    -1,   144,     3,     4,     5,     6,     7,     8,     9,
-      10,    11,    12,    13,    14,     3,     4,     5,     6,     7,
-       8,     9,    10,    11,    12,    13,    14,     3,     4,     5,
+      -1,    -1,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    14,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    57,     3,     4,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,    14,    -1,    -1,    -1,    -1,    74,
+      -1,    -1,    -1,    -1,    -1,    56,    81,    82,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      -1,    -1,    -1,    74,    -1,    -1,    -1,    -1,    -1,   104,
+      -1,    -1,    -1,    -1,    -1,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,   122,   123,   124,
+     125,    -1,   127,   104,    74,    -1,    -1,   132,    -1,    -1,
+      -1,    -1,    -1,   138,    -1,    -1,   141,   142,    -1,   144,
+      -1,   122,   123,   124,   125,    -1,   127,    -1,    -1,    74,
+      -1,   132,    -1,    -1,   104,    -1,    -1,   138,    -1,    -1,
+     141,   142,    -1,   144,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   122,   123,   124,   125,    74,   127,    -1,   104,
+      -1,    -1,   132,    -1,    -1,    -1,    -1,    -1,   138,    -1,
+      -1,   141,   142,    -1,   144,    -1,    -1,   122,   123,   124,
+     125,    -1,   127,    -1,    -1,    -1,   104,   132,    -1,    -1,
+      -1,    -1,    -1,   138,    -1,    -1,   141,   142,    -1,   144,
+      -1,    -1,    -1,    -1,   122,   123,   124,   125,    -1,   127,
+      -1,    -1,    -1,    -1,   132,    -1,    -1,    -1,    -1,    -1,
+     138,    -1,    -1,   141,   142,    -1,   144,     3,     4,     5,
        6,     7,     8,     9,    10,    11,    12,    13,    14,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,     3,     4,
+      -1,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    14,    -1,    -1,    -1,    -1,    74,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,     3,     4,     5,     6,
+       7,     8,     9,    10,    11,    12,    13,    14,   115,   116,
+     117,    -1,    74,    -1,    -1,    -1,    -1,    -1,   104,   126,
+     127,   128,   129,    -1,    -1,   132,   133,   134,    -1,    -1,
+      -1,    -1,    -1,   140,    -1,    -1,   122,   123,   124,   125,
+      -1,   127,   104,    74,    -1,    -1,   132,    -1,    -1,    -1,
+      -1,    -1,   138,    -1,    -1,   141,   142,    -1,   144,    -1,
+     122,   123,   124,   125,    -1,   127,    -1,    74,    -1,    -1,
+     132,    -1,    -1,   104,    -1,    -1,   138,    -1,    -1,   141,
+     142,    -1,   144,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   122,   123,   124,   125,    -1,   127,   104,    -1,    -1,
+      -1,   132,    -1,    -1,    -1,    -1,    -1,   138,    -1,    -1,
+     141,   142,    -1,   144,    -1,   122,   123,   124,   125,    -1,
+     127,    -1,    -1,    -1,    -1,   132,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   141,   142,    -1,   144,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      -1,    -1,    -1,    -1,    74,    -1,    15,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    74,    -1,    27,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    35,    -1,    74,    -1,
-      -1,    -1,    -1,    -1,   104,    44,    45,    46,    47,    48,
-      49,    -1,    51,    -1,    -1,    -1,   104,    -1,    -1,    -1,
-      -1,    -1,   122,   123,   124,   125,    -1,   127,   104,    74,
-      -1,    -1,   132,    -1,   122,   123,   124,   125,   138,   127,
-      -1,   141,   142,    -1,   144,    -1,   122,   123,   124,   125,
-     138,   127,    -1,   141,   142,    -1,   132,    -1,    -1,   104,
-      99,    -1,   138,    -1,    -1,   141,   142,    -1,   144,    -1,
-      -1,    -1,    -1,    -1,   113,    -1,    -1,   122,   123,   124,
-     125,    -1,   127,    -1,    -1,    -1,    -1,   132,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,   141,   142,    -1,   144,
        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-      13,    14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      13,    14,    -1,    -1,    -1,    15,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    27,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    35,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    44,    45,    46,    47,    48,    49,
+      -1,    51,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    74,
+      -1,   115,   116,   117,   118,   119,   120,   121,    -1,    -1,
+      -1,    74,   126,   127,   128,   129,   130,   131,   132,   133,
+     134,    -1,    -1,    -1,   138,    -1,   140,    -1,    -1,   104,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    99,
+      -1,   104,    -1,    -1,    -1,    -1,    -1,   122,   123,   124,
+     125,    -1,   127,   113,   114,    -1,    -1,    -1,    -1,   122,
+     123,   124,   125,   138,   127,    -1,   141,   142,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   141,   142,
       18,    -1,    20,    21,    22,    -1,    24,    25,    26,    27,
       28,    29,    30,    31,    32,    33,    34,    -1,    36,    37,
       38,    39,    40,    -1,    42,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    52,    53,    54,    55,    -1,    -1,
       58,    59,    60,    61,    62,    -1,    -1,    -1,    -1,    -1,
-      -1,    74,    -1,    -1,    72,    73,    -1,    -1,    -1,    77,
+      -1,    -1,    -1,    -1,    72,    73,    -1,    -1,    -1,    77,
       78,    79,    80,    -1,    -1,    83,    84,    85,    86,    87,
       88,    89,    90,    91,    -1,    -1,    94,    95,    96,    97,
-      98,   104,   100,    -1,    -1,   103,    -1,   105,   106,    -1,
-     108,   109,   110,   111,   112,    -1,    -1,    -1,    -1,   122,
-     123,   124,   125,    -1,   127,    -1,    -1,    -1,    -1,    -1,
-     115,   116,   117,   118,   119,   120,   121,    -1,   141,   142,
-     138,   126,   127,   128,   129,   130,   131,   132,   133,   134,
-      -1,    -1,    -1,   138,    -1,   140,   115,   116,   117,   118,
+      98,    -1,   100,    -1,    -1,   103,    -1,   105,   106,    -1,
+     108,   109,   110,   111,   112,    -1,   115,   116,   117,   118,
      119,   120,   121,    -1,    -1,    -1,    -1,   126,   127,   128,
      129,   130,   131,   132,   133,   134,    -1,    -1,    -1,   138,
-      -1,   140,   115,   116,   117,   118,   119,   120,   121,    -1,
+     138,   140,   115,   116,   117,   118,   119,   120,   121,    -1,
       -1,    -1,    -1,   126,   127,   128,   129,   130,   131,   132,
      133,   134,    -1,    -1,    -1,   138,    -1,   140,   115,   116,
      117,   118,   119,   120,   121,    -1,    -1,    -1,    -1,   126,
@@ -1856,14 +1873,7 @@ static const yytype_int16 yycheck[] =
      129,   130,   131,   132,   133,   134,    -1,    -1,    -1,   138,
       -1,   140,   115,   116,   117,   118,   119,   120,   121,    -1,
       -1,    -1,    -1,   126,   127,   128,   129,   130,   131,   132,
-     133,   134,    -1,    -1,    -1,   138,    -1,   140,   115,   116,
-     117,   118,   119,   120,   121,    -1,    -1,    -1,    -1,   126,
-     127,   128,   129,   130,   131,   132,   133,   134,   115,   116,
-     117,    -1,    -1,   140,    -1,    -1,    -1,    -1,    -1,   126,
-     127,   128,   129,    -1,    -1,   132,   133,   134,    -1,    -1,
-      -1,    -1,    -1,   140,   115,   116,   117,   118,   119,   120,
-     121,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,   132,   133,   134,    -1,    -1,    -1,    -1,    -1,   140
+     133,   134,    -1,    -1,    -1,    -1,    -1,   140
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -1887,56 +1897,56 @@ static const yytype_uint8 yystos[] =
      197,   198,   199,   200,   201,   202,   203,   204,   205,   206,
      207,   208,   209,   210,   211,   212,   214,    19,   138,   214,
       50,   104,   138,   138,     3,     4,     5,     6,     7,    63,
-      72,   123,   124,   150,   138,     3,     4,     5,     6,     7,
-      14,    74,   104,   122,   123,   124,   125,   127,   138,   141,
-     142,   150,   213,    74,   138,   214,   132,   138,   214,   104,
-     104,   104,    15,    27,    35,    44,    45,    46,    47,    48,
-      49,    51,    99,   113,   138,   104,   138,   138,   138,   138,
-     138,   138,   104,   138,   138,   138,    56,   138,   214,    74,
-      74,    74,   214,   214,    65,    67,    68,    69,    70,   214,
-      57,    81,    82,   138,   214,    74,    75,   114,   214,   214,
-      16,    17,   148,   148,   148,   138,   214,   214,   138,   138,
-     104,   138,   104,   138,    18,    33,    75,    92,    93,   138,
-     138,   214,   214,    17,    50,    74,   114,   138,    74,   101,
-      74,   138,    74,   138,    74,   138,   138,   214,   214,    18,
-      20,    21,    22,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,    36,    37,    38,    39,    40,    42,    52,    53,
-      54,    55,    58,    59,    60,    61,    62,    72,    73,    77,
-      78,    79,    80,    83,    84,    85,    86,    87,    88,    89,
-      90,    91,    94,    95,    96,    97,    98,   100,   103,   105,
-     106,   108,   109,   110,   111,   112,   138,   149,   214,    74,
-     138,   138,   214,   214,   214,   214,   214,     0,   147,   138,
-     115,   116,   117,   118,   119,   120,   121,   126,   127,   128,
-     129,   130,   131,   132,   133,   134,   140,   214,   138,   104,
-     104,   138,   139,   139,   139,   139,   139,   139,   148,   139,
-     139,   139,   213,   213,   213,   115,   116,   117,   126,   127,
-     128,   129,   132,   133,   134,   140,    19,   138,    19,   138,
-     214,    19,   138,   138,   138,   138,   138,   138,   138,   179,
-     214,   179,   179,   179,   138,   138,   138,    74,   138,    74,
-     114,   138,   138,   138,   138,   214,   138,    74,   214,   214,
-     127,   132,   214,   214,   138,   104,   138,   138,   138,   138,
-     138,   138,   214,   138,   139,   138,   214,   138,   138,   138,
-     138,   214,   138,   138,   138,   138,   138,   138,   138,   138,
-     214,   138,   214,   214,   138,   138,   138,   138,   107,   138,
-     138,   138,   214,    74,   138,   138,   138,   138,   138,   138,
+      72,   114,   123,   124,   150,   138,     3,     4,     5,     6,
+       7,    14,    74,   104,   122,   123,   124,   125,   127,   138,
+     141,   142,   150,   213,    74,   138,   214,   132,   138,   214,
+     104,   104,   104,    15,    27,    35,    44,    45,    46,    47,
+      48,    49,    51,    99,   113,   114,   138,   104,   138,   138,
+     138,   138,   138,   138,   104,   138,   138,   138,    56,   138,
+     214,    74,    74,    74,   214,   214,    65,    67,    68,    69,
+      70,   214,    57,    81,    82,   138,   214,    74,    75,   114,
+     214,   214,    16,    17,   148,   148,   148,   138,   214,   214,
+     138,   138,   104,   138,   104,   138,    18,    33,    75,    92,
+      93,   138,   138,   214,   214,    17,    50,    74,   114,   138,
+      74,   101,    74,   138,    74,   138,    74,   138,   138,   214,
+     214,    18,    20,    21,    22,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    36,    37,    38,    39,    40,    42,
+      52,    53,    54,    55,    58,    59,    60,    61,    62,    72,
+      73,    77,    78,    79,    80,    83,    84,    85,    86,    87,
+      88,    89,    90,    91,    94,    95,    96,    97,    98,   100,
+     103,   105,   106,   108,   109,   110,   111,   112,   138,   149,
+     214,    74,   138,   138,   214,   214,   214,   214,   214,     0,
+     147,   138,   115,   116,   117,   118,   119,   120,   121,   126,
+     127,   128,   129,   130,   131,   132,   133,   134,   140,   214,
+     138,   104,   104,   138,   139,   139,   139,   139,   139,   139,
+     148,   148,   139,   139,   139,   213,   213,   213,   115,   116,
+     117,   126,   127,   128,   129,   132,   133,   134,   140,    19,
+     138,    19,   138,   214,    19,   138,   138,   138,   138,   138,
+     138,   138,   179,   214,   179,   179,   179,   138,   138,   138,
+      74,   138,    74,   114,   138,   138,   138,   138,   138,   214,
+     138,    74,   214,   214,   127,   132,   214,   214,   138,   104,
+     138,   138,   138,   138,   138,   138,   214,   138,   139,   138,
+     214,   138,   138,   138,   138,   214,   138,   138,   138,   138,
+     138,   138,   138,   138,   214,   138,   214,   214,   138,   138,
+     138,   138,   107,   138,   138,   138,   214,    74,   138,   138,
+     138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
      138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
      138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
      138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
      138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
      138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
-     138,   138,   138,   138,   138,   138,   138,   138,   138,   143,
+     138,   138,   138,   143,   214,   214,   214,   214,   214,   214,
      214,   214,   214,   214,   214,   214,   214,   214,   214,   214,
-     214,   214,   214,   214,   214,   214,   214,   138,   138,   138,
-     214,   214,   214,   214,   214,   214,   138,   214,   214,   214,
-     143,   213,   213,   213,   213,   213,   213,   213,   213,   213,
-     213,   213,    74,    74,    19,   138,    74,   179,   179,   179,
-     179,   138,    74,   138,    74,   138,   138,   138,   214,   138,
-     214,   214,   214,   138,   138,   138,   214,   104,   138,   138,
-     138,   214,   138,   214,   138,   214,   138,   138,   138,   214,
-     138,   138,   138,   138,   138,   138,   138,   138,   138,    19,
-     138,   138,   138,    74,   138,   138,   138,   138,   138,   138,
-     138,   138,   138,   138,   138,   138,   138,   138,   138,    74,
-     138,   138
+     214,   138,   138,   138,   214,   214,   214,   214,   214,   214,
+     138,   138,   214,   214,   214,   143,   213,   213,   213,   213,
+     213,   213,   213,   213,   213,   213,   213,    74,    74,    19,
+     138,    74,   179,   179,   179,   179,   138,    74,   138,    74,
+     138,   138,   138,   214,   138,   214,   214,   214,   138,   138,
+     138,   214,   104,   138,   138,   138,   214,   138,   214,   138,
+     214,   138,   138,   138,   214,   138,   138,   138,   138,   138,
+     138,   138,   138,   138,    19,   138,   138,   138,    74,   138,
+     138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
+     138,   138,   138,   138,    74,   138,   138
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
@@ -1955,28 +1965,28 @@ static const yytype_uint8 yyr1[] =
      163,   163,   163,   163,   163,   163,   163,   163,   163,   164,
      164,   164,   164,   165,   165,   166,   166,   167,   168,   169,
      169,   170,   170,   170,   170,   171,   172,   173,   174,   174,
-     174,   174,   174,   174,   174,   174,   174,   174,   175,   175,
+     174,   174,   174,   174,   174,   174,   174,   174,   174,   175,
      175,   175,   175,   175,   175,   175,   175,   175,   175,   175,
-     175,   176,   177,   177,   178,   178,   178,   178,   178,   178,
+     175,   175,   176,   177,   177,   178,   178,   178,   178,   178,
      178,   178,   178,   178,   178,   178,   178,   178,   178,   178,
-     178,   179,   179,   180,   181,   182,   183,   184,   185,   186,
-     187,   188,   189,   190,   191,   192,   193,   194,   195,   195,
-     195,   195,   196,   197,   198,   199,   200,   201,   202,   202,
-     202,   202,   202,   203,   203,   203,   203,   203,   203,   203,
-     203,   204,   204,   204,   205,   206,   207,   207,   207,   207,
+     178,   178,   178,   179,   179,   180,   181,   182,   183,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193,   194,
+     195,   195,   195,   195,   196,   197,   198,   199,   200,   201,
+     202,   202,   202,   202,   202,   203,   203,   203,   203,   203,
+     203,   203,   203,   204,   204,   204,   205,   206,   207,   207,
      207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
      207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
      207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
      207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
      207,   207,   207,   207,   207,   207,   207,   207,   207,   207,
-     207,   207,   207,   207,   207,   208,   209,   210,   211,   212,
-     213,   213,   213,   213,   213,   213,   213,   213,   213,   213,
+     207,   207,   207,   207,   207,   207,   207,   208,   209,   210,
+     211,   212,   213,   213,   213,   213,   213,   213,   213,   213,
      213,   213,   213,   213,   213,   213,   213,   213,   213,   213,
-     213,   213,   213,   213,   213,   213,   214,   214,   214,   214,
+     213,   213,   213,   213,   213,   213,   213,   213,   214,   214,
      214,   214,   214,   214,   214,   214,   214,   214,   214,   214,
      214,   214,   214,   214,   214,   214,   214,   214,   214,   214,
      214,   214,   214,   214,   214,   214,   214,   214,   214,   214,
-     214
+     214,   214,   214
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -1994,29 +2004,29 @@ static const yytype_int8 yyr2[] =
        2,     3,     3,     3,     2,     3,     2,     3,     3,     3,
        2,     4,     4,     4,     5,     5,     5,     2,     3,     3,
        4,     4,     5,     2,     3,     2,     3,     2,     3,     2,
-       4,     2,     3,     4,     4,     2,     3,     3,     4,     5,
-       5,     5,     5,     5,     5,     5,     5,     5,     2,     5,
-       7,     2,     3,     5,     3,     5,     2,     3,     5,     4,
-       6,     2,     2,     3,     3,     3,     5,     5,     5,     5,
-       3,     3,     3,     3,     3,     4,     3,     4,     5,     4,
-       5,     0,     1,     2,     2,     2,     2,     2,     2,     2,
-       3,     2,     2,     2,     3,     3,     3,     2,     4,     3,
-       3,     2,     4,     5,     4,     5,     4,     3,     3,     4,
-       3,     3,     3,     2,     3,     4,     3,     4,     5,     3,
-       5,     3,     3,     3,     3,     4,     3,     3,     3,     3,
+       4,     2,     3,     4,     4,     2,     3,     3,     4,     4,
+       5,     5,     5,     5,     5,     5,     5,     5,     5,     2,
+       5,     7,     2,     3,     5,     3,     5,     2,     3,     5,
+       4,     6,     2,     2,     3,     3,     3,     5,     5,     5,
+       5,     3,     3,     3,     3,     3,     4,     3,     3,     4,
+       5,     4,     5,     0,     1,     2,     2,     2,     2,     2,
+       2,     2,     3,     2,     2,     2,     3,     3,     3,     2,
+       4,     3,     3,     2,     4,     5,     4,     5,     4,     3,
+       3,     4,     3,     3,     3,     2,     3,     4,     3,     4,
+       5,     3,     5,     3,     3,     3,     3,     4,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     2,     3,     3,     2,     2,     3,
+       3,     3,     3,     3,     3,     3,     2,     3,     3,     2,
+       2,     3,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     2,     2,     3,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     2,     2,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     2,     2,     2,     2,
-       3
+       1,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     2,     2,
+       2,     2,     3
 };
 
 
@@ -2482,32 +2492,32 @@ yyreduce:
   case 65: /* command: expression  */
 #line 227 "bx_parser.y"
                  { eval_value = (yyvsp[0].uval); }
-#line 2486 "y.tab.c"
+#line 2496 "y.tab.c"
     break;
 
   case 67: /* command: '\n'  */
 #line 230 "bx_parser.y"
       {
       }
-#line 2493 "y.tab.c"
+#line 2503 "y.tab.c"
     break;
 
   case 69: /* BX_TOKEN_TOGGLE_ON_OFF: BX_TOKEN_OFF  */
 #line 237 "bx_parser.y"
     { (yyval.bval)=(yyvsp[0].bval); }
-#line 2499 "y.tab.c"
+#line 2509 "y.tab.c"
     break;
 
   case 71: /* BX_TOKEN_REGISTERS: BX_TOKEN_REGS  */
 #line 243 "bx_parser.y"
     { (yyval.sval)=(yyvsp[0].sval); }
-#line 2505 "y.tab.c"
+#line 2515 "y.tab.c"
     break;
 
   case 77: /* BX_TOKEN_SEGREG: BX_TOKEN_GS  */
 #line 253 "bx_parser.y"
     { (yyval.uval)=(yyvsp[0].uval); }
-#line 2511 "y.tab.c"
+#line 2521 "y.tab.c"
     break;
 
   case 78: /* timebp_command: BX_TOKEN_TIMEBP expression '\n'  */
@@ -2516,7 +2526,7 @@ yyreduce:
           bx_dbg_timebp_command(0, (yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2520 "y.tab.c"
+#line 2530 "y.tab.c"
     break;
 
   case 79: /* timebp_command: BX_TOKEN_TIMEBP_ABSOLUTE expression '\n'  */
@@ -2525,7 +2535,7 @@ yyreduce:
           bx_dbg_timebp_command(1, (yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2529 "y.tab.c"
+#line 2539 "y.tab.c"
     break;
 
   case 80: /* modebp_command: BX_TOKEN_MODEBP '\n'  */
@@ -2534,7 +2544,7 @@ yyreduce:
           bx_dbg_modebp_command();
           free((yyvsp[-1].sval));
       }
-#line 2538 "y.tab.c"
+#line 2548 "y.tab.c"
     break;
 
   case 81: /* vmexitbp_command: BX_TOKEN_VMEXITBP '\n'  */
@@ -2543,7 +2553,7 @@ yyreduce:
           bx_dbg_vmexitbp_command();
           free((yyvsp[-1].sval));
       }
-#line 2547 "y.tab.c"
+#line 2557 "y.tab.c"
     break;
 
   case 82: /* show_command: BX_TOKEN_SHOW BX_TOKEN_GENERIC '\n'  */
@@ -2552,7 +2562,7 @@ yyreduce:
           bx_dbg_show_command((yyvsp[-1].sval));
           free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2556 "y.tab.c"
+#line 2566 "y.tab.c"
     break;
 
   case 83: /* show_command: BX_TOKEN_SHOW BX_TOKEN_ALL '\n'  */
@@ -2561,7 +2571,7 @@ yyreduce:
           bx_dbg_show_command("all");
           free((yyvsp[-2].sval));
       }
-#line 2565 "y.tab.c"
+#line 2575 "y.tab.c"
     break;
 
   case 84: /* show_command: BX_TOKEN_SHOW BX_TOKEN_OFF '\n'  */
@@ -2570,7 +2580,7 @@ yyreduce:
           bx_dbg_show_command("off");
           free((yyvsp[-2].sval));
       }
-#line 2574 "y.tab.c"
+#line 2584 "y.tab.c"
     break;
 
   case 85: /* show_command: BX_TOKEN_SHOW BX_TOKEN_STRING '\n'  */
@@ -2579,7 +2589,7 @@ yyreduce:
           bx_dbg_show_param_command((yyvsp[-1].sval), 0);
           free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2583 "y.tab.c"
+#line 2593 "y.tab.c"
     break;
 
   case 86: /* show_command: BX_TOKEN_SHOW BX_TOKEN_STRING BX_TOKEN_XML '\n'  */
@@ -2588,7 +2598,7 @@ yyreduce:
           bx_dbg_show_param_command((yyvsp[-2].sval), 1);
           free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2592 "y.tab.c"
+#line 2602 "y.tab.c"
     break;
 
   case 87: /* show_command: BX_TOKEN_SHOW '\n'  */
@@ -2597,7 +2607,7 @@ yyreduce:
           bx_dbg_show_command(0);
           free((yyvsp[-1].sval));
       }
-#line 2601 "y.tab.c"
+#line 2611 "y.tab.c"
     break;
 
   case 88: /* page_command: BX_TOKEN_PAGE expression '\n'  */
@@ -2606,7 +2616,7 @@ yyreduce:
           bx_dbg_xlate_address((yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2610 "y.tab.c"
+#line 2620 "y.tab.c"
     break;
 
   case 89: /* tlb_command: BX_TOKEN_TLB expression '\n'  */
@@ -2615,7 +2625,7 @@ yyreduce:
           bx_dbg_tlb_lookup((yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2619 "y.tab.c"
+#line 2629 "y.tab.c"
     break;
 
   case 90: /* ptime_command: BX_TOKEN_PTIME '\n'  */
@@ -2624,7 +2634,7 @@ yyreduce:
           bx_dbg_ptime_command();
           free((yyvsp[-1].sval));
       }
-#line 2628 "y.tab.c"
+#line 2638 "y.tab.c"
     break;
 
   case 91: /* trace_command: BX_TOKEN_TRACE BX_TOKEN_TOGGLE_ON_OFF '\n'  */
@@ -2633,7 +2643,7 @@ yyreduce:
           bx_dbg_trace_command((yyvsp[-1].bval));
           free((yyvsp[-2].sval));
       }
-#line 2637 "y.tab.c"
+#line 2647 "y.tab.c"
     break;
 
   case 92: /* trace_reg_command: BX_TOKEN_TRACEREG BX_TOKEN_TOGGLE_ON_OFF '\n'  */
@@ -2642,7 +2652,7 @@ yyreduce:
           bx_dbg_trace_reg_command((yyvsp[-1].bval));
           free((yyvsp[-2].sval));
       }
-#line 2646 "y.tab.c"
+#line 2656 "y.tab.c"
     break;
 
   case 93: /* trace_mem_command: BX_TOKEN_TRACEMEM BX_TOKEN_TOGGLE_ON_OFF '\n'  */
@@ -2651,7 +2661,7 @@ yyreduce:
           bx_dbg_trace_mem_command((yyvsp[-1].bval));
           free((yyvsp[-2].sval));
       }
-#line 2655 "y.tab.c"
+#line 2665 "y.tab.c"
     break;
 
   case 94: /* print_stack_command: BX_TOKEN_PRINT_STACK '\n'  */
@@ -2660,7 +2670,7 @@ yyreduce:
           bx_dbg_print_stack_command(16);
           free((yyvsp[-1].sval));
       }
-#line 2664 "y.tab.c"
+#line 2674 "y.tab.c"
     break;
 
   case 95: /* print_stack_command: BX_TOKEN_PRINT_STACK BX_TOKEN_NUMERIC '\n'  */
@@ -2669,7 +2679,7 @@ yyreduce:
           bx_dbg_print_stack_command((yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2673 "y.tab.c"
+#line 2683 "y.tab.c"
     break;
 
   case 96: /* backtrace_command: BX_TOKEN_BT '\n'  */
@@ -2678,7 +2688,7 @@ yyreduce:
         bx_dbg_bt_command(16);
         free((yyvsp[-1].sval));
       }
-#line 2682 "y.tab.c"
+#line 2692 "y.tab.c"
     break;
 
   case 97: /* backtrace_command: BX_TOKEN_BT BX_TOKEN_NUMERIC '\n'  */
@@ -2687,7 +2697,7 @@ yyreduce:
         bx_dbg_bt_command((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 2691 "y.tab.c"
+#line 2701 "y.tab.c"
     break;
 
   case 98: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_STOP '\n'  */
@@ -2696,7 +2706,7 @@ yyreduce:
           bx_dbg_watchpoint_continue(0);
           free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2700 "y.tab.c"
+#line 2710 "y.tab.c"
     break;
 
   case 99: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_CONTINUE '\n'  */
@@ -2705,7 +2715,7 @@ yyreduce:
           bx_dbg_watchpoint_continue(1);
           free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2709 "y.tab.c"
+#line 2719 "y.tab.c"
     break;
 
   case 100: /* watch_point_command: BX_TOKEN_WATCH '\n'  */
@@ -2714,7 +2724,7 @@ yyreduce:
           bx_dbg_print_watchpoints();
           free((yyvsp[-1].sval));
       }
-#line 2718 "y.tab.c"
+#line 2728 "y.tab.c"
     break;
 
   case 101: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_R expression '\n'  */
@@ -2723,7 +2733,7 @@ yyreduce:
           bx_dbg_watch(0, (yyvsp[-1].uval), 1); /* BX_READ */
           free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2727 "y.tab.c"
+#line 2737 "y.tab.c"
     break;
 
   case 102: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_READ expression '\n'  */
@@ -2732,7 +2742,7 @@ yyreduce:
           bx_dbg_watch(0, (yyvsp[-1].uval), 1); /* BX_READ */
           free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2736 "y.tab.c"
+#line 2746 "y.tab.c"
     break;
 
   case 103: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_WRITE expression '\n'  */
@@ -2741,7 +2751,7 @@ yyreduce:
           bx_dbg_watch(1, (yyvsp[-1].uval), 1); /* BX_WRITE */
           free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2745 "y.tab.c"
+#line 2755 "y.tab.c"
     break;
 
   case 104: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_R expression expression '\n'  */
@@ -2750,7 +2760,7 @@ yyreduce:
           bx_dbg_watch(0, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_READ */
           free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 2754 "y.tab.c"
+#line 2764 "y.tab.c"
     break;
 
   case 105: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_READ expression expression '\n'  */
@@ -2759,7 +2769,7 @@ yyreduce:
           bx_dbg_watch(0, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_READ */
           free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 2763 "y.tab.c"
+#line 2773 "y.tab.c"
     break;
 
   case 106: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_WRITE expression expression '\n'  */
@@ -2768,7 +2778,7 @@ yyreduce:
           bx_dbg_watch(1, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_WRITE */
           free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 2772 "y.tab.c"
+#line 2782 "y.tab.c"
     break;
 
   case 107: /* watch_point_command: BX_TOKEN_UNWATCH '\n'  */
@@ -2777,7 +2787,7 @@ yyreduce:
           bx_dbg_unwatch_all();
           free((yyvsp[-1].sval));
       }
-#line 2781 "y.tab.c"
+#line 2791 "y.tab.c"
     break;
 
   case 108: /* watch_point_command: BX_TOKEN_UNWATCH expression '\n'  */
@@ -2786,7 +2796,7 @@ yyreduce:
           bx_dbg_unwatch((yyvsp[-1].uval));
           free((yyvsp[-2].sval));
       }
-#line 2790 "y.tab.c"
+#line 2800 "y.tab.c"
     break;
 
   case 109: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_STRING '\n'  */
@@ -2795,7 +2805,7 @@ yyreduce:
         bx_dbg_symbol_command((yyvsp[-1].sval), 0, 0);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2799 "y.tab.c"
+#line 2809 "y.tab.c"
     break;
 
   case 110: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_STRING expression '\n'  */
@@ -2804,7 +2814,7 @@ yyreduce:
         bx_dbg_symbol_command((yyvsp[-2].sval), 0, (yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2808 "y.tab.c"
+#line 2818 "y.tab.c"
     break;
 
   case 111: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_GLOBAL BX_TOKEN_STRING '\n'  */
@@ -2813,7 +2823,7 @@ yyreduce:
         bx_dbg_symbol_command((yyvsp[-1].sval), 1, 0);
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2817 "y.tab.c"
+#line 2827 "y.tab.c"
     break;
 
   case 112: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_GLOBAL BX_TOKEN_STRING expression '\n'  */
@@ -2822,7 +2832,7 @@ yyreduce:
         bx_dbg_symbol_command((yyvsp[-2].sval), 1, (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2826 "y.tab.c"
+#line 2836 "y.tab.c"
     break;
 
   case 113: /* set_magic_break_points_command: BX_TOKEN_SET_MAGIC_BREAK_POINTS '\n'  */
@@ -2831,7 +2841,7 @@ yyreduce:
         bx_dbg_set_magic_bp_mask(0);
         free((yyvsp[-1].sval));
       }
-#line 2835 "y.tab.c"
+#line 2845 "y.tab.c"
     break;
 
   case 114: /* set_magic_break_points_command: BX_TOKEN_SET_MAGIC_BREAK_POINTS BX_TOKEN_STRING '\n'  */
@@ -2840,7 +2850,7 @@ yyreduce:
         bx_dbg_set_magic_bp_mask(bx_dbg_get_magic_bp_mask_from_str((yyvsp[-1].sval)));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2844 "y.tab.c"
+#line 2854 "y.tab.c"
     break;
 
   case 115: /* clr_magic_break_points_command: BX_TOKEN_CLEAR_MAGIC_BREAK_POINTS '\n'  */
@@ -2849,7 +2859,7 @@ yyreduce:
         bx_dbg_set_magic_bp_mask(0);
         free((yyvsp[-1].sval));
       }
-#line 2853 "y.tab.c"
+#line 2863 "y.tab.c"
     break;
 
   case 116: /* clr_magic_break_points_command: BX_TOKEN_CLEAR_MAGIC_BREAK_POINTS BX_TOKEN_STRING '\n'  */
@@ -2858,7 +2868,7 @@ yyreduce:
         bx_dbg_clr_magic_bp_mask(bx_dbg_get_magic_bp_mask_from_str((yyvsp[-1].sval)));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 2862 "y.tab.c"
+#line 2872 "y.tab.c"
     break;
 
   case 117: /* where_command: BX_TOKEN_WHERE '\n'  */
@@ -2867,7 +2877,7 @@ yyreduce:
         bx_dbg_where_command();
         free((yyvsp[-1].sval));
       }
-#line 2871 "y.tab.c"
+#line 2881 "y.tab.c"
     break;
 
   case 118: /* print_string_command: BX_TOKEN_PRINT_STRING expression '\n'  */
@@ -2876,7 +2886,7 @@ yyreduce:
         bx_dbg_print_string_command((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 2880 "y.tab.c"
+#line 2890 "y.tab.c"
     break;
 
   case 119: /* continue_command: BX_TOKEN_CONTINUE '\n'  */
@@ -2885,7 +2895,7 @@ yyreduce:
         bx_dbg_continue_command(1);
         free((yyvsp[-1].sval));
       }
-#line 2889 "y.tab.c"
+#line 2899 "y.tab.c"
     break;
 
   case 120: /* continue_command: BX_TOKEN_CONTINUE BX_TOKEN_IF expression '\n'  */
@@ -2894,7 +2904,7 @@ yyreduce:
         bx_dbg_continue_command((yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2898 "y.tab.c"
+#line 2908 "y.tab.c"
     break;
 
   case 121: /* stepN_command: BX_TOKEN_STEPN '\n'  */
@@ -2903,7 +2913,7 @@ yyreduce:
         bx_dbg_stepN_command(dbg_cpu, 1);
         free((yyvsp[-1].sval));
       }
-#line 2907 "y.tab.c"
+#line 2917 "y.tab.c"
     break;
 
   case 122: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_NUMERIC '\n'  */
@@ -2912,7 +2922,7 @@ yyreduce:
         bx_dbg_stepN_command(dbg_cpu, (yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 2916 "y.tab.c"
+#line 2926 "y.tab.c"
     break;
 
   case 123: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_ALL BX_TOKEN_NUMERIC '\n'  */
@@ -2921,7 +2931,7 @@ yyreduce:
         bx_dbg_stepN_command(-1, (yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2925 "y.tab.c"
+#line 2935 "y.tab.c"
     break;
 
   case 124: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_NUMERIC BX_TOKEN_NUMERIC '\n'  */
@@ -2930,7 +2940,7 @@ yyreduce:
         bx_dbg_stepN_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval));
       }
-#line 2934 "y.tab.c"
+#line 2944 "y.tab.c"
     break;
 
   case 125: /* step_over_command: BX_TOKEN_STEP_OVER '\n'  */
@@ -2939,7 +2949,7 @@ yyreduce:
         bx_dbg_step_over_command();
         free((yyvsp[-1].sval));
       }
-#line 2943 "y.tab.c"
+#line 2953 "y.tab.c"
     break;
 
   case 126: /* run_to_laddr_command: BX_TOKEN_RUN_TO_LADDR expression '\n'  */
@@ -2948,7 +2958,7 @@ yyreduce:
         bx_dbg_run_to_laddr((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 2952 "y.tab.c"
+#line 2962 "y.tab.c"
     break;
 
   case 127: /* cpu_command: BX_TOKEN_CPU BX_TOKEN_NUMERIC '\n'  */
@@ -2957,7 +2967,7 @@ yyreduce:
         bx_dbg_set_symbol_command("$cpu", (yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 2961 "y.tab.c"
+#line 2971 "y.tab.c"
     break;
 
   case 128: /* set_command: BX_TOKEN_SET BX_TOKEN_DISASM BX_TOKEN_TOGGLE_ON_OFF '\n'  */
@@ -2966,945 +2976,963 @@ yyreduce:
         bx_dbg_set_auto_disassemble((yyvsp[-1].bval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 2970 "y.tab.c"
+#line 2980 "y.tab.c"
     break;
 
-  case 129: /* set_command: BX_TOKEN_SET BX_TOKEN_SYMBOLNAME '=' expression '\n'  */
+  case 129: /* set_command: BX_TOKEN_SET BX_TOKEN_GENERIC BX_TOKEN_TOGGLE_ON_OFF '\n'  */
 #line 581 "bx_parser.y"
+      {
+        bx_dbg_set_toggle_command((yyvsp[-2].sval), (yyvsp[-1].bval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
+      }
+#line 2989 "y.tab.c"
+    break;
+
+  case 130: /* set_command: BX_TOKEN_SET BX_TOKEN_SYMBOLNAME '=' expression '\n'  */
+#line 586 "bx_parser.y"
       {
         bx_dbg_set_symbol_command((yyvsp[-3].sval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 2979 "y.tab.c"
+#line 2998 "y.tab.c"
     break;
 
-  case 130: /* set_command: BX_TOKEN_SET BX_TOKEN_8BL_REG '=' expression '\n'  */
-#line 586 "bx_parser.y"
+  case 131: /* set_command: BX_TOKEN_SET BX_TOKEN_8BL_REG '=' expression '\n'  */
+#line 591 "bx_parser.y"
       {
         bx_dbg_set_reg8l_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 2987 "y.tab.c"
+#line 3006 "y.tab.c"
     break;
 
-  case 131: /* set_command: BX_TOKEN_SET BX_TOKEN_8BH_REG '=' expression '\n'  */
-#line 590 "bx_parser.y"
+  case 132: /* set_command: BX_TOKEN_SET BX_TOKEN_8BH_REG '=' expression '\n'  */
+#line 595 "bx_parser.y"
       {
         bx_dbg_set_reg8h_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 2995 "y.tab.c"
+#line 3014 "y.tab.c"
     break;
 
-  case 132: /* set_command: BX_TOKEN_SET BX_TOKEN_16B_REG '=' expression '\n'  */
-#line 594 "bx_parser.y"
+  case 133: /* set_command: BX_TOKEN_SET BX_TOKEN_16B_REG '=' expression '\n'  */
+#line 599 "bx_parser.y"
       {
         bx_dbg_set_reg16_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 3003 "y.tab.c"
+#line 3022 "y.tab.c"
     break;
 
-  case 133: /* set_command: BX_TOKEN_SET BX_TOKEN_32B_REG '=' expression '\n'  */
-#line 598 "bx_parser.y"
+  case 134: /* set_command: BX_TOKEN_SET BX_TOKEN_32B_REG '=' expression '\n'  */
+#line 603 "bx_parser.y"
       {
         bx_dbg_set_reg32_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 3011 "y.tab.c"
+#line 3030 "y.tab.c"
     break;
 
-  case 134: /* set_command: BX_TOKEN_SET BX_TOKEN_64B_REG '=' expression '\n'  */
-#line 602 "bx_parser.y"
+  case 135: /* set_command: BX_TOKEN_SET BX_TOKEN_64B_REG '=' expression '\n'  */
+#line 607 "bx_parser.y"
       {
         bx_dbg_set_reg64_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 3019 "y.tab.c"
+#line 3038 "y.tab.c"
     break;
 
-  case 135: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_EIP '=' expression '\n'  */
-#line 606 "bx_parser.y"
+  case 136: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_EIP '=' expression '\n'  */
+#line 611 "bx_parser.y"
       {
         bx_dbg_set_rip_value((yyvsp[-1].uval));
       }
-#line 3027 "y.tab.c"
+#line 3046 "y.tab.c"
     break;
 
-  case 136: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_RIP '=' expression '\n'  */
-#line 610 "bx_parser.y"
+  case 137: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_RIP '=' expression '\n'  */
+#line 615 "bx_parser.y"
       {
         bx_dbg_set_rip_value((yyvsp[-1].uval));
       }
-#line 3035 "y.tab.c"
+#line 3054 "y.tab.c"
     break;
 
-  case 137: /* set_command: BX_TOKEN_SET BX_TOKEN_SEGREG '=' expression '\n'  */
-#line 614 "bx_parser.y"
+  case 138: /* set_command: BX_TOKEN_SET BX_TOKEN_SEGREG '=' expression '\n'  */
+#line 619 "bx_parser.y"
       {
         bx_dbg_load_segreg((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
-#line 3043 "y.tab.c"
+#line 3062 "y.tab.c"
     break;
 
-  case 138: /* breakpoint_command: BX_TOKEN_VBREAKPOINT '\n'  */
-#line 621 "bx_parser.y"
+  case 139: /* breakpoint_command: BX_TOKEN_VBREAKPOINT '\n'  */
+#line 626 "bx_parser.y"
       {
         bx_dbg_vbreakpoint_command(bkAtIP, 0, 0, NULL);
         free((yyvsp[-1].sval));
       }
-#line 3052 "y.tab.c"
+#line 3071 "y.tab.c"
     break;
 
-  case 139: /* breakpoint_command: BX_TOKEN_VBREAKPOINT vexpression ':' vexpression '\n'  */
-#line 626 "bx_parser.y"
+  case 140: /* breakpoint_command: BX_TOKEN_VBREAKPOINT vexpression ':' vexpression '\n'  */
+#line 631 "bx_parser.y"
       {
         bx_dbg_vbreakpoint_command(bkRegular, (yyvsp[-3].uval), (yyvsp[-1].uval), NULL);
         free((yyvsp[-4].sval));
       }
-#line 3061 "y.tab.c"
+#line 3080 "y.tab.c"
     break;
 
-  case 140: /* breakpoint_command: BX_TOKEN_VBREAKPOINT vexpression ':' vexpression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
-#line 631 "bx_parser.y"
+  case 141: /* breakpoint_command: BX_TOKEN_VBREAKPOINT vexpression ':' vexpression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
+#line 636 "bx_parser.y"
       {
         bx_dbg_vbreakpoint_command(bkRegular, (yyvsp[-5].uval), (yyvsp[-3].uval), (yyvsp[-1].sval));
         free((yyvsp[-6].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3070 "y.tab.c"
+#line 3089 "y.tab.c"
     break;
 
-  case 141: /* breakpoint_command: BX_TOKEN_LBREAKPOINT '\n'  */
-#line 636 "bx_parser.y"
+  case 142: /* breakpoint_command: BX_TOKEN_LBREAKPOINT '\n'  */
+#line 641 "bx_parser.y"
       {
         bx_dbg_lbreakpoint_command(bkAtIP, 0, NULL);
         free((yyvsp[-1].sval));
       }
-#line 3079 "y.tab.c"
+#line 3098 "y.tab.c"
     break;
 
-  case 142: /* breakpoint_command: BX_TOKEN_LBREAKPOINT expression '\n'  */
-#line 641 "bx_parser.y"
+  case 143: /* breakpoint_command: BX_TOKEN_LBREAKPOINT expression '\n'  */
+#line 646 "bx_parser.y"
       {
         bx_dbg_lbreakpoint_command(bkRegular, (yyvsp[-1].uval), NULL);
         free((yyvsp[-2].sval));
       }
-#line 3088 "y.tab.c"
+#line 3107 "y.tab.c"
     break;
 
-  case 143: /* breakpoint_command: BX_TOKEN_LBREAKPOINT expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
-#line 646 "bx_parser.y"
+  case 144: /* breakpoint_command: BX_TOKEN_LBREAKPOINT expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
+#line 651 "bx_parser.y"
       {
         bx_dbg_lbreakpoint_command(bkRegular, (yyvsp[-3].uval), (yyvsp[-1].sval));
         free((yyvsp[-4].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3097 "y.tab.c"
+#line 3116 "y.tab.c"
     break;
 
-  case 144: /* breakpoint_command: BX_TOKEN_LBREAKPOINT BX_TOKEN_STRING '\n'  */
-#line 651 "bx_parser.y"
+  case 145: /* breakpoint_command: BX_TOKEN_LBREAKPOINT BX_TOKEN_STRING '\n'  */
+#line 656 "bx_parser.y"
       {
         bx_dbg_lbreakpoint_symbol_command((yyvsp[-1].sval), NULL);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3106 "y.tab.c"
+#line 3125 "y.tab.c"
     break;
 
-  case 145: /* breakpoint_command: BX_TOKEN_LBREAKPOINT BX_TOKEN_STRING BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
-#line 656 "bx_parser.y"
+  case 146: /* breakpoint_command: BX_TOKEN_LBREAKPOINT BX_TOKEN_STRING BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
+#line 661 "bx_parser.y"
       {
         bx_dbg_lbreakpoint_symbol_command((yyvsp[-3].sval), (yyvsp[-1].sval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3115 "y.tab.c"
+#line 3134 "y.tab.c"
     break;
 
-  case 146: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '\n'  */
-#line 661 "bx_parser.y"
+  case 147: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '\n'  */
+#line 666 "bx_parser.y"
       {
         bx_dbg_pbreakpoint_command(bkAtIP, 0, NULL);
         free((yyvsp[-1].sval));
       }
-#line 3124 "y.tab.c"
+#line 3143 "y.tab.c"
     break;
 
-  case 147: /* breakpoint_command: BX_TOKEN_PBREAKPOINT expression '\n'  */
-#line 666 "bx_parser.y"
+  case 148: /* breakpoint_command: BX_TOKEN_PBREAKPOINT expression '\n'  */
+#line 671 "bx_parser.y"
       {
         bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-1].uval), NULL);
         free((yyvsp[-2].sval));
       }
-#line 3133 "y.tab.c"
+#line 3152 "y.tab.c"
     break;
 
-  case 148: /* breakpoint_command: BX_TOKEN_PBREAKPOINT expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
-#line 671 "bx_parser.y"
+  case 149: /* breakpoint_command: BX_TOKEN_PBREAKPOINT expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
+#line 676 "bx_parser.y"
       {
         bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-3].uval), (yyvsp[-1].sval));
         free((yyvsp[-4].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3142 "y.tab.c"
+#line 3161 "y.tab.c"
     break;
 
-  case 149: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '*' expression '\n'  */
-#line 676 "bx_parser.y"
+  case 150: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '*' expression '\n'  */
+#line 681 "bx_parser.y"
       {
         bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-1].uval), NULL);
         free((yyvsp[-3].sval));
       }
-#line 3151 "y.tab.c"
+#line 3170 "y.tab.c"
     break;
 
-  case 150: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '*' expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
-#line 681 "bx_parser.y"
+  case 151: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '*' expression BX_TOKEN_IF BX_TOKEN_STRING '\n'  */
+#line 686 "bx_parser.y"
       {
         bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-3].uval), (yyvsp[-1].sval));
         free((yyvsp[-5].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3160 "y.tab.c"
+#line 3179 "y.tab.c"
     break;
 
-  case 151: /* blist_command: BX_TOKEN_LIST_BREAK '\n'  */
-#line 689 "bx_parser.y"
+  case 152: /* blist_command: BX_TOKEN_LIST_BREAK '\n'  */
+#line 694 "bx_parser.y"
       {
         bx_dbg_info_bpoints_command();
         free((yyvsp[-1].sval));
       }
-#line 3169 "y.tab.c"
+#line 3188 "y.tab.c"
     break;
 
-  case 152: /* slist_command: BX_TOKEN_LIST_SYMBOLS '\n'  */
-#line 697 "bx_parser.y"
+  case 153: /* slist_command: BX_TOKEN_LIST_SYMBOLS '\n'  */
+#line 702 "bx_parser.y"
       {
         bx_dbg_info_symbols_command(0);
         free((yyvsp[-1].sval));
       }
-#line 3178 "y.tab.c"
+#line 3197 "y.tab.c"
     break;
 
-  case 153: /* slist_command: BX_TOKEN_LIST_SYMBOLS BX_TOKEN_STRING '\n'  */
-#line 702 "bx_parser.y"
+  case 154: /* slist_command: BX_TOKEN_LIST_SYMBOLS BX_TOKEN_STRING '\n'  */
+#line 707 "bx_parser.y"
       {
         bx_dbg_info_symbols_command((yyvsp[-1].sval));
         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
       }
-#line 3187 "y.tab.c"
+#line 3206 "y.tab.c"
     break;
 
-  case 154: /* info_command: BX_TOKEN_INFO BX_TOKEN_PBREAKPOINT '\n'  */
-#line 710 "bx_parser.y"
+  case 155: /* info_command: BX_TOKEN_INFO BX_TOKEN_PBREAKPOINT '\n'  */
+#line 715 "bx_parser.y"
       {
         bx_dbg_info_bpoints_command();
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3196 "y.tab.c"
+#line 3215 "y.tab.c"
     break;
 
-  case 155: /* info_command: BX_TOKEN_INFO BX_TOKEN_CPU '\n'  */
-#line 715 "bx_parser.y"
+  case 156: /* info_command: BX_TOKEN_INFO BX_TOKEN_CPU '\n'  */
+#line 720 "bx_parser.y"
       {
         bx_dbg_info_registers_command(-1);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3205 "y.tab.c"
+#line 3224 "y.tab.c"
     break;
 
-  case 156: /* info_command: BX_TOKEN_INFO BX_TOKEN_IDT optional_numeric optional_numeric '\n'  */
-#line 720 "bx_parser.y"
+  case 157: /* info_command: BX_TOKEN_INFO BX_TOKEN_IDT optional_numeric optional_numeric '\n'  */
+#line 725 "bx_parser.y"
       {
         bx_dbg_info_idt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3214 "y.tab.c"
+#line 3233 "y.tab.c"
     break;
 
-  case 157: /* info_command: BX_TOKEN_INFO BX_TOKEN_IVT optional_numeric optional_numeric '\n'  */
-#line 725 "bx_parser.y"
+  case 158: /* info_command: BX_TOKEN_INFO BX_TOKEN_IVT optional_numeric optional_numeric '\n'  */
+#line 730 "bx_parser.y"
       {
         bx_dbg_info_ivt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3223 "y.tab.c"
+#line 3242 "y.tab.c"
     break;
 
-  case 158: /* info_command: BX_TOKEN_INFO BX_TOKEN_GDT optional_numeric optional_numeric '\n'  */
-#line 730 "bx_parser.y"
+  case 159: /* info_command: BX_TOKEN_INFO BX_TOKEN_GDT optional_numeric optional_numeric '\n'  */
+#line 735 "bx_parser.y"
       {
         bx_dbg_info_gdt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3232 "y.tab.c"
+#line 3251 "y.tab.c"
     break;
 
-  case 159: /* info_command: BX_TOKEN_INFO BX_TOKEN_LDT optional_numeric optional_numeric '\n'  */
-#line 735 "bx_parser.y"
+  case 160: /* info_command: BX_TOKEN_INFO BX_TOKEN_LDT optional_numeric optional_numeric '\n'  */
+#line 740 "bx_parser.y"
       {
         bx_dbg_info_ldt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3241 "y.tab.c"
+#line 3260 "y.tab.c"
     break;
 
-  case 160: /* info_command: BX_TOKEN_INFO BX_TOKEN_TAB '\n'  */
-#line 740 "bx_parser.y"
+  case 161: /* info_command: BX_TOKEN_INFO BX_TOKEN_TAB '\n'  */
+#line 745 "bx_parser.y"
       {
         bx_dbg_dump_table();
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3250 "y.tab.c"
+#line 3269 "y.tab.c"
     break;
 
-  case 161: /* info_command: BX_TOKEN_INFO BX_TOKEN_TSS '\n'  */
-#line 745 "bx_parser.y"
+  case 162: /* info_command: BX_TOKEN_INFO BX_TOKEN_TSS '\n'  */
+#line 750 "bx_parser.y"
       {
         bx_dbg_info_tss_command();
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3259 "y.tab.c"
+#line 3278 "y.tab.c"
     break;
 
-  case 162: /* info_command: BX_TOKEN_INFO BX_TOKEN_FLAGS '\n'  */
-#line 750 "bx_parser.y"
+  case 163: /* info_command: BX_TOKEN_INFO BX_TOKEN_FLAGS '\n'  */
+#line 755 "bx_parser.y"
       {
         bx_dbg_info_flags();
         free((yyvsp[-2].sval));
       }
-#line 3268 "y.tab.c"
+#line 3287 "y.tab.c"
     break;
 
-  case 163: /* info_command: BX_TOKEN_INFO BX_TOKEN_LINUX '\n'  */
-#line 755 "bx_parser.y"
+  case 164: /* info_command: BX_TOKEN_INFO BX_TOKEN_LINUX '\n'  */
+#line 760 "bx_parser.y"
       {
         bx_dbg_info_linux_command();
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3277 "y.tab.c"
+#line 3296 "y.tab.c"
     break;
 
-  case 164: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS '\n'  */
-#line 760 "bx_parser.y"
+  case 165: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS '\n'  */
+#line 765 "bx_parser.y"
       {
         bx_dbg_info_symbols_command(0);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3286 "y.tab.c"
+#line 3305 "y.tab.c"
     break;
 
-  case 165: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS BX_TOKEN_STRING '\n'  */
-#line 765 "bx_parser.y"
+  case 166: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS BX_TOKEN_STRING '\n'  */
+#line 770 "bx_parser.y"
       {
         bx_dbg_info_symbols_command((yyvsp[-1].sval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3295 "y.tab.c"
+#line 3314 "y.tab.c"
     break;
 
-  case 166: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE '\n'  */
-#line 770 "bx_parser.y"
+  case 167: /* info_command: BX_TOKEN_INFO BX_TOKEN_GENERIC '\n'  */
+#line 775 "bx_parser.y"
+      {
+        bx_dbg_info_generic_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
+      }
+#line 3323 "y.tab.c"
+    break;
+
+  case 168: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE '\n'  */
+#line 780 "bx_parser.y"
       {
         bx_dbg_info_device("", "");
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3304 "y.tab.c"
+#line 3332 "y.tab.c"
     break;
 
-  case 167: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_GENERIC '\n'  */
-#line 775 "bx_parser.y"
+  case 169: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_GENERIC '\n'  */
+#line 785 "bx_parser.y"
       {
         bx_dbg_info_device((yyvsp[-1].sval), "");
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3313 "y.tab.c"
+#line 3341 "y.tab.c"
     break;
 
-  case 168: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_GENERIC BX_TOKEN_STRING '\n'  */
-#line 780 "bx_parser.y"
+  case 170: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_GENERIC BX_TOKEN_STRING '\n'  */
+#line 790 "bx_parser.y"
       {
         bx_dbg_info_device((yyvsp[-2].sval), (yyvsp[-1].sval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3322 "y.tab.c"
+#line 3350 "y.tab.c"
     break;
 
-  case 169: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING '\n'  */
-#line 785 "bx_parser.y"
+  case 171: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING '\n'  */
+#line 795 "bx_parser.y"
       {
         bx_dbg_info_device((yyvsp[-1].sval), "");
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3331 "y.tab.c"
+#line 3359 "y.tab.c"
     break;
 
-  case 170: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
-#line 790 "bx_parser.y"
+  case 172: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
+#line 800 "bx_parser.y"
       {
         bx_dbg_info_device((yyvsp[-2].sval), (yyvsp[-1].sval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3340 "y.tab.c"
+#line 3368 "y.tab.c"
     break;
 
-  case 171: /* optional_numeric: %empty  */
-#line 797 "bx_parser.y"
+  case 173: /* optional_numeric: %empty  */
+#line 807 "bx_parser.y"
                { (yyval.uval) = EMPTY_ARG; }
-#line 3346 "y.tab.c"
+#line 3374 "y.tab.c"
     break;
 
-  case 173: /* regs_command: BX_TOKEN_REGISTERS '\n'  */
-#line 802 "bx_parser.y"
+  case 175: /* regs_command: BX_TOKEN_REGISTERS '\n'  */
+#line 812 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_GENERAL_PURPOSE_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3355 "y.tab.c"
+#line 3383 "y.tab.c"
     break;
 
-  case 174: /* fpu_regs_command: BX_TOKEN_FPU '\n'  */
-#line 810 "bx_parser.y"
+  case 176: /* fpu_regs_command: BX_TOKEN_FPU '\n'  */
+#line 820 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_FPU_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3364 "y.tab.c"
+#line 3392 "y.tab.c"
     break;
 
-  case 175: /* mmx_regs_command: BX_TOKEN_MMX '\n'  */
-#line 818 "bx_parser.y"
+  case 177: /* mmx_regs_command: BX_TOKEN_MMX '\n'  */
+#line 828 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_MMX_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3373 "y.tab.c"
+#line 3401 "y.tab.c"
     break;
 
-  case 176: /* xmm_regs_command: BX_TOKEN_XMM '\n'  */
-#line 826 "bx_parser.y"
+  case 178: /* xmm_regs_command: BX_TOKEN_XMM '\n'  */
+#line 836 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_SSE_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3382 "y.tab.c"
+#line 3410 "y.tab.c"
     break;
 
-  case 177: /* ymm_regs_command: BX_TOKEN_YMM '\n'  */
-#line 834 "bx_parser.y"
+  case 179: /* ymm_regs_command: BX_TOKEN_YMM '\n'  */
+#line 844 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_YMM_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3391 "y.tab.c"
+#line 3419 "y.tab.c"
     break;
 
-  case 178: /* zmm_regs_command: BX_TOKEN_ZMM '\n'  */
-#line 842 "bx_parser.y"
+  case 180: /* zmm_regs_command: BX_TOKEN_ZMM '\n'  */
+#line 852 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_ZMM_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3400 "y.tab.c"
+#line 3428 "y.tab.c"
     break;
 
-  case 179: /* amx_regs_command: BX_TOKEN_AMX '\n'  */
-#line 850 "bx_parser.y"
+  case 181: /* amx_regs_command: BX_TOKEN_AMX '\n'  */
+#line 860 "bx_parser.y"
       {
         bx_dbg_info_registers_command(BX_INFO_AMX_REGS);
         free((yyvsp[-1].sval));
       }
-#line 3409 "y.tab.c"
+#line 3437 "y.tab.c"
     break;
 
-  case 180: /* print_tile_command: BX_TOKEN_TILE BX_TOKEN_NUMERIC '\n'  */
-#line 858 "bx_parser.y"
+  case 182: /* print_tile_command: BX_TOKEN_TILE BX_TOKEN_NUMERIC '\n'  */
+#line 868 "bx_parser.y"
       {
         bx_dbg_print_amx_tile_command((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 3418 "y.tab.c"
+#line 3446 "y.tab.c"
     break;
 
-  case 181: /* segment_regs_command: BX_TOKEN_SEGMENT_REGS '\n'  */
-#line 866 "bx_parser.y"
+  case 183: /* segment_regs_command: BX_TOKEN_SEGMENT_REGS '\n'  */
+#line 876 "bx_parser.y"
       {
         bx_dbg_info_segment_regs_command();
         free((yyvsp[-1].sval));
       }
-#line 3427 "y.tab.c"
+#line 3455 "y.tab.c"
     break;
 
-  case 182: /* control_regs_command: BX_TOKEN_CONTROL_REGS '\n'  */
-#line 874 "bx_parser.y"
+  case 184: /* control_regs_command: BX_TOKEN_CONTROL_REGS '\n'  */
+#line 884 "bx_parser.y"
       {
         bx_dbg_info_control_regs_command();
         free((yyvsp[-1].sval));
       }
-#line 3436 "y.tab.c"
+#line 3464 "y.tab.c"
     break;
 
-  case 183: /* debug_regs_command: BX_TOKEN_DEBUG_REGS '\n'  */
-#line 882 "bx_parser.y"
+  case 185: /* debug_regs_command: BX_TOKEN_DEBUG_REGS '\n'  */
+#line 892 "bx_parser.y"
       {
         bx_dbg_info_debug_regs_command();
         free((yyvsp[-1].sval));
       }
-#line 3445 "y.tab.c"
+#line 3473 "y.tab.c"
     break;
 
-  case 184: /* delete_command: BX_TOKEN_DEL_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
-#line 890 "bx_parser.y"
+  case 186: /* delete_command: BX_TOKEN_DEL_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 900 "bx_parser.y"
       {
         bx_dbg_del_breakpoint_command((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 3454 "y.tab.c"
+#line 3482 "y.tab.c"
     break;
 
-  case 185: /* bpe_command: BX_TOKEN_ENABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
-#line 898 "bx_parser.y"
+  case 187: /* bpe_command: BX_TOKEN_ENABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 908 "bx_parser.y"
       {
         bx_dbg_en_dis_breakpoint_command((yyvsp[-1].uval), 1);
         free((yyvsp[-2].sval));
       }
-#line 3463 "y.tab.c"
+#line 3491 "y.tab.c"
     break;
 
-  case 186: /* bpd_command: BX_TOKEN_DISABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
-#line 905 "bx_parser.y"
+  case 188: /* bpd_command: BX_TOKEN_DISABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 915 "bx_parser.y"
       {
         bx_dbg_en_dis_breakpoint_command((yyvsp[-1].uval), 0);
         free((yyvsp[-2].sval));
       }
-#line 3472 "y.tab.c"
+#line 3500 "y.tab.c"
     break;
 
-  case 187: /* quit_command: BX_TOKEN_QUIT '\n'  */
-#line 913 "bx_parser.y"
+  case 189: /* quit_command: BX_TOKEN_QUIT '\n'  */
+#line 923 "bx_parser.y"
       {
         bx_dbg_quit_command();
         free((yyvsp[-1].sval));
       }
-#line 3481 "y.tab.c"
+#line 3509 "y.tab.c"
     break;
 
-  case 188: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT expression '\n'  */
-#line 921 "bx_parser.y"
+  case 190: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT expression '\n'  */
+#line 931 "bx_parser.y"
       {
         bx_dbg_examine_command((yyvsp[-3].sval), (yyvsp[-2].sval),1, (yyvsp[-1].uval), 1);
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3490 "y.tab.c"
+#line 3518 "y.tab.c"
     break;
 
-  case 189: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT '\n'  */
-#line 926 "bx_parser.y"
+  case 191: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT '\n'  */
+#line 936 "bx_parser.y"
       {
         bx_dbg_examine_command((yyvsp[-2].sval), (yyvsp[-1].sval),1, 0, 0);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3499 "y.tab.c"
+#line 3527 "y.tab.c"
     break;
 
-  case 190: /* examine_command: BX_TOKEN_EXAMINE expression '\n'  */
-#line 931 "bx_parser.y"
+  case 192: /* examine_command: BX_TOKEN_EXAMINE expression '\n'  */
+#line 941 "bx_parser.y"
       {
         bx_dbg_examine_command((yyvsp[-2].sval), NULL,0, (yyvsp[-1].uval), 1);
         free((yyvsp[-2].sval));
       }
-#line 3508 "y.tab.c"
+#line 3536 "y.tab.c"
     break;
 
-  case 191: /* examine_command: BX_TOKEN_EXAMINE '\n'  */
-#line 936 "bx_parser.y"
+  case 193: /* examine_command: BX_TOKEN_EXAMINE '\n'  */
+#line 946 "bx_parser.y"
       {
         bx_dbg_examine_command((yyvsp[-1].sval), NULL,0, 0, 0);
         free((yyvsp[-1].sval));
       }
-#line 3517 "y.tab.c"
+#line 3545 "y.tab.c"
     break;
 
-  case 192: /* restore_command: BX_TOKEN_RESTORE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
-#line 944 "bx_parser.y"
+  case 194: /* restore_command: BX_TOKEN_RESTORE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
+#line 954 "bx_parser.y"
       {
         bx_dbg_restore_command((yyvsp[-2].sval), (yyvsp[-1].sval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3526 "y.tab.c"
+#line 3554 "y.tab.c"
     break;
 
-  case 193: /* writemem_command: BX_TOKEN_WRITEMEM BX_TOKEN_STRING expression expression '\n'  */
-#line 952 "bx_parser.y"
+  case 195: /* writemem_command: BX_TOKEN_WRITEMEM BX_TOKEN_STRING expression expression '\n'  */
+#line 962 "bx_parser.y"
       {
         bx_dbg_writemem_command((yyvsp[-3].sval), (yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3535 "y.tab.c"
+#line 3563 "y.tab.c"
     break;
 
-  case 194: /* loadmem_command: BX_TOKEN_LOADMEM BX_TOKEN_STRING expression '\n'  */
-#line 960 "bx_parser.y"
+  case 196: /* loadmem_command: BX_TOKEN_LOADMEM BX_TOKEN_STRING expression '\n'  */
+#line 970 "bx_parser.y"
       {
         bx_dbg_loadmem_command((yyvsp[-2].sval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3544 "y.tab.c"
+#line 3572 "y.tab.c"
     break;
 
-  case 195: /* setpmem_command: BX_TOKEN_SETPMEM expression expression expression '\n'  */
-#line 968 "bx_parser.y"
+  case 197: /* setpmem_command: BX_TOKEN_SETPMEM expression expression expression '\n'  */
+#line 978 "bx_parser.y"
       {
         bx_dbg_setpmem_command((yyvsp[-3].uval), (yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval));
       }
-#line 3553 "y.tab.c"
+#line 3581 "y.tab.c"
     break;
 
-  case 196: /* deref_command: BX_TOKEN_DEREF expression expression '\n'  */
-#line 976 "bx_parser.y"
+  case 198: /* deref_command: BX_TOKEN_DEREF expression expression '\n'  */
+#line 986 "bx_parser.y"
       {
         bx_dbg_deref_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval));
       }
-#line 3562 "y.tab.c"
+#line 3590 "y.tab.c"
     break;
 
-  case 197: /* query_command: BX_TOKEN_QUERY BX_TOKEN_PENDING '\n'  */
-#line 984 "bx_parser.y"
+  case 199: /* query_command: BX_TOKEN_QUERY BX_TOKEN_PENDING '\n'  */
+#line 994 "bx_parser.y"
       {
         bx_dbg_query_command((yyvsp[-1].sval));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3571 "y.tab.c"
+#line 3599 "y.tab.c"
     break;
 
-  case 198: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA '\n'  */
-#line 992 "bx_parser.y"
+  case 200: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA '\n'  */
+#line 1002 "bx_parser.y"
       {
         bx_dbg_take_command((yyvsp[-1].sval), 1);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3580 "y.tab.c"
+#line 3608 "y.tab.c"
     break;
 
-  case 199: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA BX_TOKEN_NUMERIC '\n'  */
-#line 997 "bx_parser.y"
+  case 201: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA BX_TOKEN_NUMERIC '\n'  */
+#line 1007 "bx_parser.y"
       {
         bx_dbg_take_command((yyvsp[-2].sval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3589 "y.tab.c"
+#line 3617 "y.tab.c"
     break;
 
-  case 200: /* take_command: BX_TOKEN_TAKE BX_TOKEN_IRQ '\n'  */
-#line 1002 "bx_parser.y"
+  case 202: /* take_command: BX_TOKEN_TAKE BX_TOKEN_IRQ '\n'  */
+#line 1012 "bx_parser.y"
       {
         bx_dbg_take_command((yyvsp[-1].sval), 1);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3598 "y.tab.c"
+#line 3626 "y.tab.c"
     break;
 
-  case 201: /* take_command: BX_TOKEN_TAKE BX_TOKEN_SMI '\n'  */
-#line 1007 "bx_parser.y"
+  case 203: /* take_command: BX_TOKEN_TAKE BX_TOKEN_SMI '\n'  */
+#line 1017 "bx_parser.y"
       {
         bx_dbg_take_command((yyvsp[-1].sval), 1);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3607 "y.tab.c"
+#line 3635 "y.tab.c"
     break;
 
-  case 202: /* take_command: BX_TOKEN_TAKE BX_TOKEN_NMI '\n'  */
-#line 1012 "bx_parser.y"
+  case 204: /* take_command: BX_TOKEN_TAKE BX_TOKEN_NMI '\n'  */
+#line 1022 "bx_parser.y"
       {
         bx_dbg_take_command((yyvsp[-1].sval), 1);
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3616 "y.tab.c"
+#line 3644 "y.tab.c"
     break;
 
-  case 203: /* disassemble_command: BX_TOKEN_DISASM '\n'  */
-#line 1020 "bx_parser.y"
+  case 205: /* disassemble_command: BX_TOKEN_DISASM '\n'  */
+#line 1030 "bx_parser.y"
       {
         bx_dbg_disassemble_current(NULL);
         free((yyvsp[-1].sval));
       }
-#line 3625 "y.tab.c"
+#line 3653 "y.tab.c"
     break;
 
-  case 204: /* disassemble_command: BX_TOKEN_DISASM expression '\n'  */
-#line 1025 "bx_parser.y"
+  case 206: /* disassemble_command: BX_TOKEN_DISASM expression '\n'  */
+#line 1035 "bx_parser.y"
       {
         bx_dbg_disassemble_command(NULL, (yyvsp[-1].uval), (yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 3634 "y.tab.c"
+#line 3662 "y.tab.c"
     break;
 
-  case 205: /* disassemble_command: BX_TOKEN_DISASM expression expression '\n'  */
-#line 1030 "bx_parser.y"
+  case 207: /* disassemble_command: BX_TOKEN_DISASM expression expression '\n'  */
+#line 1040 "bx_parser.y"
       {
         bx_dbg_disassemble_command(NULL, (yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval));
       }
-#line 3643 "y.tab.c"
+#line 3671 "y.tab.c"
     break;
 
-  case 206: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT '\n'  */
-#line 1035 "bx_parser.y"
+  case 208: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT '\n'  */
+#line 1045 "bx_parser.y"
       {
         bx_dbg_disassemble_current((yyvsp[-1].sval));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3652 "y.tab.c"
+#line 3680 "y.tab.c"
     break;
 
-  case 207: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression '\n'  */
-#line 1040 "bx_parser.y"
+  case 209: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression '\n'  */
+#line 1050 "bx_parser.y"
       {
         bx_dbg_disassemble_command((yyvsp[-2].sval), (yyvsp[-1].uval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
-#line 3661 "y.tab.c"
+#line 3689 "y.tab.c"
     break;
 
-  case 208: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression expression '\n'  */
-#line 1045 "bx_parser.y"
+  case 210: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression expression '\n'  */
+#line 1055 "bx_parser.y"
       {
         bx_dbg_disassemble_command((yyvsp[-3].sval), (yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3670 "y.tab.c"
+#line 3698 "y.tab.c"
     break;
 
-  case 209: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SWITCH_MODE '\n'  */
-#line 1050 "bx_parser.y"
+  case 211: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SWITCH_MODE '\n'  */
+#line 1060 "bx_parser.y"
       {
         bx_dbg_disassemble_switch_mode();
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3679 "y.tab.c"
+#line 3707 "y.tab.c"
     break;
 
-  case 210: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SIZE '=' BX_TOKEN_NUMERIC '\n'  */
-#line 1055 "bx_parser.y"
+  case 212: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SIZE '=' BX_TOKEN_NUMERIC '\n'  */
+#line 1065 "bx_parser.y"
       {
         bx_dbg_set_disassemble_size((yyvsp[-1].uval));
         free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
-#line 3688 "y.tab.c"
+#line 3716 "y.tab.c"
     break;
 
-  case 211: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_STOP '\n'  */
-#line 1063 "bx_parser.y"
+  case 213: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_STOP '\n'  */
+#line 1073 "bx_parser.y"
       {
         bx_dbg_instrument_command((yyvsp[-1].sval));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3697 "y.tab.c"
+#line 3725 "y.tab.c"
     break;
 
-  case 212: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_STRING '\n'  */
-#line 1069 "bx_parser.y"
+  case 214: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_STRING '\n'  */
+#line 1079 "bx_parser.y"
       {
         bx_dbg_instrument_command((yyvsp[-1].sval));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3706 "y.tab.c"
+#line 3734 "y.tab.c"
     break;
 
-  case 213: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_GENERIC '\n'  */
-#line 1074 "bx_parser.y"
+  case 215: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_GENERIC '\n'  */
+#line 1084 "bx_parser.y"
       {
         bx_dbg_instrument_command((yyvsp[-1].sval));
         free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
-#line 3715 "y.tab.c"
+#line 3743 "y.tab.c"
     break;
 
-  case 214: /* doit_command: BX_TOKEN_DOIT expression '\n'  */
-#line 1082 "bx_parser.y"
+  case 216: /* doit_command: BX_TOKEN_DOIT expression '\n'  */
+#line 1092 "bx_parser.y"
       {
         bx_dbg_doit_command((yyvsp[-1].uval));
         free((yyvsp[-2].sval));
       }
-#line 3724 "y.tab.c"
+#line 3752 "y.tab.c"
     break;
 
-  case 215: /* crc_command: BX_TOKEN_CRC expression expression '\n'  */
-#line 1090 "bx_parser.y"
+  case 217: /* crc_command: BX_TOKEN_CRC expression expression '\n'  */
+#line 1100 "bx_parser.y"
       {
         bx_dbg_crc_command((yyvsp[-2].uval), (yyvsp[-1].uval));
         free((yyvsp[-3].sval));
       }
-#line 3733 "y.tab.c"
+#line 3761 "y.tab.c"
     break;
 
-  case 216: /* help_command: BX_TOKEN_HELP BX_TOKEN_QUIT '\n'  */
-#line 1098 "bx_parser.y"
+  case 218: /* help_command: BX_TOKEN_HELP BX_TOKEN_QUIT '\n'  */
+#line 1108 "bx_parser.y"
        {
          dbg_printf("q|quit|exit - quit debugger and emulator execution\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3742 "y.tab.c"
+#line 3770 "y.tab.c"
     break;
 
-  case 217: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTINUE '\n'  */
-#line 1103 "bx_parser.y"
+  case 219: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTINUE '\n'  */
+#line 1113 "bx_parser.y"
        {
          dbg_printf("c|cont|continue - continue executing\n");
          dbg_printf("c|cont|continue if \"expression\" - continue executing only if expression is true\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3752 "y.tab.c"
+#line 3780 "y.tab.c"
     break;
 
-  case 218: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEPN '\n'  */
-#line 1109 "bx_parser.y"
+  case 220: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEPN '\n'  */
+#line 1119 "bx_parser.y"
        {
          dbg_printf("s|step [count] - execute #count instructions on current processor (default is one instruction)\n");
          dbg_printf("s|step [cpu] <count> - execute #count instructions on processor #cpu\n");
          dbg_printf("s|step all <count> - execute #count instructions on all the processors\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3763 "y.tab.c"
+#line 3791 "y.tab.c"
     break;
 
-  case 219: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEP_OVER '\n'  */
-#line 1116 "bx_parser.y"
+  case 221: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEP_OVER '\n'  */
+#line 1126 "bx_parser.y"
        {
          dbg_printf("n|next|p - execute instruction stepping over subroutines\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3772 "y.tab.c"
+#line 3800 "y.tab.c"
     break;
 
-  case 220: /* help_command: BX_TOKEN_HELP BX_TOKEN_RUN_TO_LADDR '\n'  */
-#line 1121 "bx_parser.y"
+  case 222: /* help_command: BX_TOKEN_HELP BX_TOKEN_RUN_TO_LADDR '\n'  */
+#line 1131 "bx_parser.y"
        {
          dbg_printf("rla <addr> - continue until reaching the linear address\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3781 "y.tab.c"
+#line 3809 "y.tab.c"
     break;
 
-  case 221: /* help_command: BX_TOKEN_HELP BX_TOKEN_VBREAKPOINT '\n'  */
-#line 1126 "bx_parser.y"
+  case 223: /* help_command: BX_TOKEN_HELP BX_TOKEN_VBREAKPOINT '\n'  */
+#line 1136 "bx_parser.y"
        {
          dbg_printf("vb|vbreak <seg:offset> - set a virtual address instruction breakpoint\n");
          dbg_printf("vb|vbreak <seg:offset> if \"expression\" - set a conditional virtual address instruction breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3791 "y.tab.c"
+#line 3819 "y.tab.c"
     break;
 
-  case 222: /* help_command: BX_TOKEN_HELP BX_TOKEN_LBREAKPOINT '\n'  */
-#line 1132 "bx_parser.y"
+  case 224: /* help_command: BX_TOKEN_HELP BX_TOKEN_LBREAKPOINT '\n'  */
+#line 1142 "bx_parser.y"
        {
          dbg_printf("lb|lbreak <addr> - set a linear address instruction breakpoint\n");
          dbg_printf("lb|lbreak <addr> if \"expression\" - set a conditional linear address instruction breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3801 "y.tab.c"
+#line 3829 "y.tab.c"
     break;
 
-  case 223: /* help_command: BX_TOKEN_HELP BX_TOKEN_PBREAKPOINT '\n'  */
-#line 1138 "bx_parser.y"
+  case 225: /* help_command: BX_TOKEN_HELP BX_TOKEN_PBREAKPOINT '\n'  */
+#line 1148 "bx_parser.y"
        {
          dbg_printf("b|pb|break|pbreak <addr> - set a physical address instruction breakpoint\n");
          dbg_printf("b|pb|break|pbreak <addr> if \"expression\" - set a conditional physical address instruction breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3811 "y.tab.c"
+#line 3839 "y.tab.c"
     break;
 
-  case 224: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEL_BREAKPOINT '\n'  */
-#line 1144 "bx_parser.y"
+  case 226: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEL_BREAKPOINT '\n'  */
+#line 1154 "bx_parser.y"
        {
          dbg_printf("d|del|delete <n> - delete a breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3820 "y.tab.c"
+#line 3848 "y.tab.c"
     break;
 
-  case 225: /* help_command: BX_TOKEN_HELP BX_TOKEN_ENABLE_BREAKPOINT '\n'  */
-#line 1149 "bx_parser.y"
+  case 227: /* help_command: BX_TOKEN_HELP BX_TOKEN_ENABLE_BREAKPOINT '\n'  */
+#line 1159 "bx_parser.y"
        {
          dbg_printf("bpe <n> - enable a breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3829 "y.tab.c"
+#line 3857 "y.tab.c"
     break;
 
-  case 226: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISABLE_BREAKPOINT '\n'  */
-#line 1154 "bx_parser.y"
+  case 228: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISABLE_BREAKPOINT '\n'  */
+#line 1164 "bx_parser.y"
        {
          dbg_printf("bpd <n> - disable a breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3838 "y.tab.c"
+#line 3866 "y.tab.c"
     break;
 
-  case 227: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_BREAK '\n'  */
-#line 1159 "bx_parser.y"
+  case 229: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_BREAK '\n'  */
+#line 1169 "bx_parser.y"
        {
          dbg_printf("blist - list all breakpoints (same as 'info break')\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3847 "y.tab.c"
+#line 3875 "y.tab.c"
     break;
 
-  case 228: /* help_command: BX_TOKEN_HELP BX_TOKEN_MODEBP '\n'  */
-#line 1164 "bx_parser.y"
+  case 230: /* help_command: BX_TOKEN_HELP BX_TOKEN_MODEBP '\n'  */
+#line 1174 "bx_parser.y"
        {
          dbg_printf("modebp - toggles mode switch breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3856 "y.tab.c"
+#line 3884 "y.tab.c"
     break;
 
-  case 229: /* help_command: BX_TOKEN_HELP BX_TOKEN_VMEXITBP '\n'  */
-#line 1169 "bx_parser.y"
+  case 231: /* help_command: BX_TOKEN_HELP BX_TOKEN_VMEXITBP '\n'  */
+#line 1179 "bx_parser.y"
        {
          dbg_printf("vmexitbp - toggles VMEXIT switch breakpoint\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3865 "y.tab.c"
+#line 3893 "y.tab.c"
     break;
 
-  case 230: /* help_command: BX_TOKEN_HELP BX_TOKEN_CRC '\n'  */
-#line 1174 "bx_parser.y"
+  case 232: /* help_command: BX_TOKEN_HELP BX_TOKEN_CRC '\n'  */
+#line 1184 "bx_parser.y"
        {
          dbg_printf("crc <addr1> <addr2> - show CRC32 for physical memory range addr1..addr2\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3874 "y.tab.c"
+#line 3902 "y.tab.c"
     break;
 
-  case 231: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACE '\n'  */
-#line 1179 "bx_parser.y"
+  case 233: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACE '\n'  */
+#line 1189 "bx_parser.y"
        {
          dbg_printf("trace on  - print disassembly for every executed instruction\n");
          dbg_printf("trace off - disable instruction tracing\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3884 "y.tab.c"
+#line 3912 "y.tab.c"
     break;
 
-  case 232: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEREG '\n'  */
-#line 1185 "bx_parser.y"
+  case 234: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEREG '\n'  */
+#line 1195 "bx_parser.y"
        {
          dbg_printf("trace-reg on  - print all registers before every executed instruction\n");
          dbg_printf("trace-reg off - disable registers state tracing\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3894 "y.tab.c"
+#line 3922 "y.tab.c"
     break;
 
-  case 233: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEMEM '\n'  */
-#line 1191 "bx_parser.y"
+  case 235: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEMEM '\n'  */
+#line 1201 "bx_parser.y"
        {
          dbg_printf("trace-mem on  - print all memory accesses occurred during instruction execution\n");
          dbg_printf("trace-mem off - disable memory accesses tracing\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3904 "y.tab.c"
+#line 3932 "y.tab.c"
     break;
 
-  case 234: /* help_command: BX_TOKEN_HELP BX_TOKEN_RESTORE '\n'  */
-#line 1197 "bx_parser.y"
+  case 236: /* help_command: BX_TOKEN_HELP BX_TOKEN_RESTORE '\n'  */
+#line 1207 "bx_parser.y"
        {
          dbg_printf("restore <param_name> [path] - restore bochs root param from the file\n");
          dbg_printf("for example:\n");
@@ -3912,218 +3940,218 @@ yyreduce:
          dbg_printf("restore \"cpu0\" \"/save\" - restore CPU #0 from file \"cpu0\" located in directory \"/save\"\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3916 "y.tab.c"
+#line 3944 "y.tab.c"
     break;
 
-  case 235: /* help_command: BX_TOKEN_HELP BX_TOKEN_PTIME '\n'  */
-#line 1205 "bx_parser.y"
+  case 237: /* help_command: BX_TOKEN_HELP BX_TOKEN_PTIME '\n'  */
+#line 1215 "bx_parser.y"
        {
          dbg_printf("ptime - print current time (number of ticks since start of simulation)\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3925 "y.tab.c"
+#line 3953 "y.tab.c"
     break;
 
-  case 236: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP '\n'  */
-#line 1210 "bx_parser.y"
+  case 238: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP '\n'  */
+#line 1220 "bx_parser.y"
        {
          dbg_printf("sb <delta> - insert a time breakpoint delta instructions into the future\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3934 "y.tab.c"
+#line 3962 "y.tab.c"
     break;
 
-  case 237: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP_ABSOLUTE '\n'  */
-#line 1215 "bx_parser.y"
+  case 239: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP_ABSOLUTE '\n'  */
+#line 1225 "bx_parser.y"
        {
          dbg_printf("sba <time> - insert breakpoint at specific time\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3943 "y.tab.c"
+#line 3971 "y.tab.c"
     break;
 
-  case 238: /* help_command: BX_TOKEN_HELP BX_TOKEN_PRINT_STACK '\n'  */
-#line 1220 "bx_parser.y"
+  case 240: /* help_command: BX_TOKEN_HELP BX_TOKEN_PRINT_STACK '\n'  */
+#line 1230 "bx_parser.y"
        {
          dbg_printf("print-stack [num_words] - print the num_words top 16 bit words on the stack\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3952 "y.tab.c"
+#line 3980 "y.tab.c"
     break;
 
-  case 239: /* help_command: BX_TOKEN_HELP BX_TOKEN_BT '\n'  */
-#line 1225 "bx_parser.y"
+  case 241: /* help_command: BX_TOKEN_HELP BX_TOKEN_BT '\n'  */
+#line 1235 "bx_parser.y"
        {
          dbg_printf("bt [num_entries] - prints backtrace\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3961 "y.tab.c"
+#line 3989 "y.tab.c"
     break;
 
-  case 240: /* help_command: BX_TOKEN_HELP BX_TOKEN_LOAD_SYMBOLS '\n'  */
-#line 1230 "bx_parser.y"
+  case 242: /* help_command: BX_TOKEN_HELP BX_TOKEN_LOAD_SYMBOLS '\n'  */
+#line 1240 "bx_parser.y"
        {
          dbg_printf("ldsym [global] <filename> [offset] - load symbols from file\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3970 "y.tab.c"
+#line 3998 "y.tab.c"
     break;
 
-  case 241: /* help_command: BX_TOKEN_HELP BX_TOKEN_SET_MAGIC_BREAK_POINTS '\n'  */
-#line 1235 "bx_parser.y"
+  case 243: /* help_command: BX_TOKEN_HELP BX_TOKEN_SET_MAGIC_BREAK_POINTS '\n'  */
+#line 1245 "bx_parser.y"
        {
          dbg_printf("setmagicbps \"cx dx bx sp bp si di\" - set new magic breakpoints. You can specify multiple at once. Using the setmagicbps command without any arguments will disable all of them\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3979 "y.tab.c"
+#line 4007 "y.tab.c"
     break;
 
-  case 242: /* help_command: BX_TOKEN_HELP BX_TOKEN_CLEAR_MAGIC_BREAK_POINTS '\n'  */
-#line 1240 "bx_parser.y"
+  case 244: /* help_command: BX_TOKEN_HELP BX_TOKEN_CLEAR_MAGIC_BREAK_POINTS '\n'  */
+#line 1250 "bx_parser.y"
        {
          dbg_printf("clrmagicbps \"cx dx bx sp bp si di\" - clear magic breakpoints. You can specify multiple at once. Using the clrmagicbps command without any arguments will disable all of them\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3988 "y.tab.c"
+#line 4016 "y.tab.c"
     break;
 
-  case 243: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_SYMBOLS '\n'  */
-#line 1245 "bx_parser.y"
+  case 245: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_SYMBOLS '\n'  */
+#line 1255 "bx_parser.y"
        {
          dbg_printf("slist [string] - list symbols whose preffix is string (same as 'info symbols')\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 3997 "y.tab.c"
+#line 4025 "y.tab.c"
     break;
 
-  case 244: /* help_command: BX_TOKEN_HELP BX_TOKEN_REGISTERS '\n'  */
-#line 1250 "bx_parser.y"
+  case 246: /* help_command: BX_TOKEN_HELP BX_TOKEN_REGISTERS '\n'  */
+#line 1260 "bx_parser.y"
        {
          dbg_printf("r|reg|regs|registers - list of CPU registers and their contents (same as 'info registers')\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4006 "y.tab.c"
+#line 4034 "y.tab.c"
     break;
 
-  case 245: /* help_command: BX_TOKEN_HELP BX_TOKEN_FPU '\n'  */
-#line 1255 "bx_parser.y"
+  case 247: /* help_command: BX_TOKEN_HELP BX_TOKEN_FPU '\n'  */
+#line 1265 "bx_parser.y"
        {
          dbg_printf("fp|fpu - print FPU state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4015 "y.tab.c"
+#line 4043 "y.tab.c"
     break;
 
-  case 246: /* help_command: BX_TOKEN_HELP BX_TOKEN_MMX '\n'  */
-#line 1260 "bx_parser.y"
+  case 248: /* help_command: BX_TOKEN_HELP BX_TOKEN_MMX '\n'  */
+#line 1270 "bx_parser.y"
        {
          dbg_printf("mmx - print MMX state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4024 "y.tab.c"
+#line 4052 "y.tab.c"
     break;
 
-  case 247: /* help_command: BX_TOKEN_HELP BX_TOKEN_XMM '\n'  */
-#line 1265 "bx_parser.y"
+  case 249: /* help_command: BX_TOKEN_HELP BX_TOKEN_XMM '\n'  */
+#line 1275 "bx_parser.y"
        {
          dbg_printf("xmm|sse - print SSE state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4033 "y.tab.c"
+#line 4061 "y.tab.c"
     break;
 
-  case 248: /* help_command: BX_TOKEN_HELP BX_TOKEN_YMM '\n'  */
-#line 1270 "bx_parser.y"
+  case 250: /* help_command: BX_TOKEN_HELP BX_TOKEN_YMM '\n'  */
+#line 1280 "bx_parser.y"
        {
          dbg_printf("ymm - print AVX state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4042 "y.tab.c"
+#line 4070 "y.tab.c"
     break;
 
-  case 249: /* help_command: BX_TOKEN_HELP BX_TOKEN_ZMM '\n'  */
-#line 1275 "bx_parser.y"
+  case 251: /* help_command: BX_TOKEN_HELP BX_TOKEN_ZMM '\n'  */
+#line 1285 "bx_parser.y"
        {
          dbg_printf("zmm - print AVX-512 state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4051 "y.tab.c"
+#line 4079 "y.tab.c"
     break;
 
-  case 250: /* help_command: BX_TOKEN_HELP BX_TOKEN_AMX '\n'  */
-#line 1280 "bx_parser.y"
+  case 252: /* help_command: BX_TOKEN_HELP BX_TOKEN_AMX '\n'  */
+#line 1290 "bx_parser.y"
        {
          dbg_printf("amx - print AMX state\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4060 "y.tab.c"
+#line 4088 "y.tab.c"
     break;
 
-  case 251: /* help_command: BX_TOKEN_HELP BX_TOKEN_SEGMENT_REGS '\n'  */
-#line 1285 "bx_parser.y"
+  case 253: /* help_command: BX_TOKEN_HELP BX_TOKEN_SEGMENT_REGS '\n'  */
+#line 1295 "bx_parser.y"
        {
          dbg_printf("sreg - show segment registers\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4069 "y.tab.c"
+#line 4097 "y.tab.c"
     break;
 
-  case 252: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTROL_REGS '\n'  */
-#line 1290 "bx_parser.y"
+  case 254: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTROL_REGS '\n'  */
+#line 1300 "bx_parser.y"
        {
          dbg_printf("creg - show control registers\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4078 "y.tab.c"
+#line 4106 "y.tab.c"
     break;
 
-  case 253: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEBUG_REGS '\n'  */
-#line 1295 "bx_parser.y"
+  case 255: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEBUG_REGS '\n'  */
+#line 1305 "bx_parser.y"
        {
          dbg_printf("dreg - show debug registers\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4087 "y.tab.c"
+#line 4115 "y.tab.c"
     break;
 
-  case 254: /* help_command: BX_TOKEN_HELP BX_TOKEN_WRITEMEM '\n'  */
-#line 1300 "bx_parser.y"
+  case 256: /* help_command: BX_TOKEN_HELP BX_TOKEN_WRITEMEM '\n'  */
+#line 1310 "bx_parser.y"
        {
          dbg_printf("writemem <filename> <laddr> <len> - dump 'len' bytes of virtual memory starting from the linear address 'laddr' into the file\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4096 "y.tab.c"
+#line 4124 "y.tab.c"
     break;
 
-  case 255: /* help_command: BX_TOKEN_HELP BX_TOKEN_LOADMEM '\n'  */
-#line 1305 "bx_parser.y"
+  case 257: /* help_command: BX_TOKEN_HELP BX_TOKEN_LOADMEM '\n'  */
+#line 1315 "bx_parser.y"
        {
          dbg_printf("loadmem <filename> <laddr> - load file bytes to virtual memory starting from the linear address 'laddr'\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4105 "y.tab.c"
+#line 4133 "y.tab.c"
     break;
 
-  case 256: /* help_command: BX_TOKEN_HELP BX_TOKEN_SETPMEM '\n'  */
-#line 1310 "bx_parser.y"
+  case 258: /* help_command: BX_TOKEN_HELP BX_TOKEN_SETPMEM '\n'  */
+#line 1320 "bx_parser.y"
        {
          dbg_printf("setpmem <addr> <datasize> <val> - set physical memory location of size 'datasize' to value 'val'\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4114 "y.tab.c"
+#line 4142 "y.tab.c"
     break;
 
-  case 257: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEREF '\n'  */
-#line 1315 "bx_parser.y"
+  case 259: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEREF '\n'  */
+#line 1325 "bx_parser.y"
        {
          dbg_printf("deref <addr> <deep> - pointer dereference. For example: get value of [[[rax]]] or ***rax: deref rax 3\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4123 "y.tab.c"
+#line 4151 "y.tab.c"
     break;
 
-  case 258: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISASM '\n'  */
-#line 1320 "bx_parser.y"
+  case 260: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISASM '\n'  */
+#line 1330 "bx_parser.y"
        {
          dbg_printf("u|disasm [/count] <start> <end> - disassemble instructions for given linear address\n");
          dbg_printf("    Optional 'count' is the number of disassembled instructions\n");
@@ -4133,11 +4161,11 @@ yyreduce:
          dbg_printf("       when \"disassemble\" command is used.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4137 "y.tab.c"
+#line 4165 "y.tab.c"
     break;
 
-  case 259: /* help_command: BX_TOKEN_HELP BX_TOKEN_WATCH '\n'  */
-#line 1330 "bx_parser.y"
+  case 261: /* help_command: BX_TOKEN_HELP BX_TOKEN_WATCH '\n'  */
+#line 1340 "bx_parser.y"
        {
          dbg_printf("watch - print current watch point status\n");
          dbg_printf("watch stop - stop simulation when a watchpoint is encountred\n");
@@ -4148,21 +4176,21 @@ yyreduce:
          dbg_printf("watch w|write addr <len> - insert a write watch point at physical address addr with range <len>\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4152 "y.tab.c"
+#line 4180 "y.tab.c"
     break;
 
-  case 260: /* help_command: BX_TOKEN_HELP BX_TOKEN_UNWATCH '\n'  */
-#line 1341 "bx_parser.y"
+  case 262: /* help_command: BX_TOKEN_HELP BX_TOKEN_UNWATCH '\n'  */
+#line 1351 "bx_parser.y"
        {
          dbg_printf("unwatch      - remove all watch points\n");
          dbg_printf("unwatch addr - remove a watch point\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4162 "y.tab.c"
+#line 4190 "y.tab.c"
     break;
 
-  case 261: /* help_command: BX_TOKEN_HELP BX_TOKEN_EXAMINE '\n'  */
-#line 1347 "bx_parser.y"
+  case 263: /* help_command: BX_TOKEN_HELP BX_TOKEN_EXAMINE '\n'  */
+#line 1357 "bx_parser.y"
        {
          dbg_printf("x  /nuf <addr> - examine memory at linear address\n");
          dbg_printf("xp /nuf <addr> - examine memory at physical address\n");
@@ -4175,20 +4203,20 @@ yyreduce:
          dbg_printf("    m selects an alternative output format (memory dump)\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4179 "y.tab.c"
+#line 4207 "y.tab.c"
     break;
 
-  case 262: /* help_command: BX_TOKEN_HELP BX_TOKEN_INSTRUMENT '\n'  */
-#line 1360 "bx_parser.y"
+  case 264: /* help_command: BX_TOKEN_HELP BX_TOKEN_INSTRUMENT '\n'  */
+#line 1370 "bx_parser.y"
        {
          dbg_printf("instrument <command|\"string command\"> - calls BX_INSTR_DEBUG_CMD instrumentation callback with <command|\"string command\">\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4188 "y.tab.c"
+#line 4216 "y.tab.c"
     break;
 
-  case 263: /* help_command: BX_TOKEN_HELP BX_TOKEN_SET '\n'  */
-#line 1365 "bx_parser.y"
+  case 265: /* help_command: BX_TOKEN_HELP BX_TOKEN_SET '\n'  */
+#line 1375 "bx_parser.y"
        {
          dbg_printf("set <regname> = <expr> - set register value to expression\n");
          dbg_printf("set eflags = <expr> - set eflags value to expression, not all flags can be modified\n");
@@ -4197,22 +4225,23 @@ yyreduce:
          dbg_printf("       every time execution stops\n");
          dbg_printf("set u|disasm on  - same as 'set $auto_disassemble = 1'\n");
          dbg_printf("set u|disasm off - same as 'set $auto_disassemble = 0'\n");
+         dbg_printf("set profile on|off - start or stop sampling profiler\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4203 "y.tab.c"
+#line 4232 "y.tab.c"
     break;
 
-  case 264: /* help_command: BX_TOKEN_HELP BX_TOKEN_PAGE '\n'  */
-#line 1376 "bx_parser.y"
+  case 266: /* help_command: BX_TOKEN_HELP BX_TOKEN_PAGE '\n'  */
+#line 1387 "bx_parser.y"
        {
          dbg_printf("page <laddr> - show linear to physical xlation for linear address laddr\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4212 "y.tab.c"
+#line 4241 "y.tab.c"
     break;
 
-  case 265: /* help_command: BX_TOKEN_HELP BX_TOKEN_INFO '\n'  */
-#line 1381 "bx_parser.y"
+  case 267: /* help_command: BX_TOKEN_HELP BX_TOKEN_INFO '\n'  */
+#line 1392 "bx_parser.y"
        {
          dbg_printf("info break - show information about current breakpoint status\n");
          dbg_printf("info cpu - show dump of all cpu registers\n");
@@ -4226,13 +4255,14 @@ yyreduce:
          dbg_printf("info device - show list of devices supported by this command\n");
          dbg_printf("info device [string] - show state of device specified in string\n");
          dbg_printf("info device [string] [string] - show state of device with options\n");
+         dbg_printf("info profile - show profile of executed code and write profile files\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4232 "y.tab.c"
+#line 4262 "y.tab.c"
     break;
 
-  case 266: /* help_command: BX_TOKEN_HELP BX_TOKEN_SHOW '\n'  */
-#line 1397 "bx_parser.y"
+  case 268: /* help_command: BX_TOKEN_HELP BX_TOKEN_SHOW '\n'  */
+#line 1409 "bx_parser.y"
        {
          dbg_printf("show <command> - toggles show symbolic info (calls to begin with)\n");
          dbg_printf("show - shows current show mode\n");
@@ -4248,11 +4278,11 @@ yyreduce:
          dbg_printf("show dbg_none - turn off all bx_dbg flags\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4252 "y.tab.c"
+#line 4282 "y.tab.c"
     break;
 
-  case 267: /* help_command: BX_TOKEN_HELP BX_TOKEN_CALC '\n'  */
-#line 1413 "bx_parser.y"
+  case 269: /* help_command: BX_TOKEN_HELP BX_TOKEN_CALC '\n'  */
+#line 1425 "bx_parser.y"
        {
          dbg_printf("calc|? <expr> - calculate a expression and display the result.\n");
          dbg_printf("    'expr' can reference any general-purpose, opmask and segment\n");
@@ -4264,11 +4294,11 @@ yyreduce:
          dbg_printf("    ***rax: rax$3\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4268 "y.tab.c"
+#line 4298 "y.tab.c"
     break;
 
-  case 268: /* help_command: BX_TOKEN_HELP BX_TOKEN_ADDLYT '\n'  */
-#line 1425 "bx_parser.y"
+  case 270: /* help_command: BX_TOKEN_HELP BX_TOKEN_ADDLYT '\n'  */
+#line 1437 "bx_parser.y"
        {
          dbg_printf("addlyt <file> - cause debugger to execute a script file every time execution stops.\n");
          dbg_printf("    Example of use: 1. Create a script file (script.txt) with the following content:\n");
@@ -4280,480 +4310,480 @@ yyreduce:
          dbg_printf("    Then, when you execute a step/DebugBreak... you will see: registers, stack and disasm.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4284 "y.tab.c"
+#line 4314 "y.tab.c"
     break;
 
-  case 269: /* help_command: BX_TOKEN_HELP BX_TOKEN_REMLYT '\n'  */
-#line 1437 "bx_parser.y"
+  case 271: /* help_command: BX_TOKEN_HELP BX_TOKEN_REMLYT '\n'  */
+#line 1449 "bx_parser.y"
        {
          dbg_printf("remlyt - stops debugger to execute the script file added previously with addlyt command.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4293 "y.tab.c"
+#line 4323 "y.tab.c"
     break;
 
-  case 270: /* help_command: BX_TOKEN_HELP BX_TOKEN_LYT '\n'  */
-#line 1442 "bx_parser.y"
+  case 272: /* help_command: BX_TOKEN_HELP BX_TOKEN_LYT '\n'  */
+#line 1454 "bx_parser.y"
        {
          dbg_printf("lyt - cause debugger to execute script file added previously with addlyt command.\n");
          dbg_printf("    Use it as a refresh/context.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4303 "y.tab.c"
+#line 4333 "y.tab.c"
     break;
 
-  case 271: /* help_command: BX_TOKEN_HELP BX_TOKEN_PRINT_STRING '\n'  */
-#line 1448 "bx_parser.y"
+  case 273: /* help_command: BX_TOKEN_HELP BX_TOKEN_PRINT_STRING '\n'  */
+#line 1460 "bx_parser.y"
        {
          dbg_printf("print-string <addr> - prints a null-ended string from a linear address.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4312 "y.tab.c"
+#line 4342 "y.tab.c"
     break;
 
-  case 272: /* help_command: BX_TOKEN_HELP BX_TOKEN_SOURCE '\n'  */
-#line 1453 "bx_parser.y"
+  case 274: /* help_command: BX_TOKEN_HELP BX_TOKEN_SOURCE '\n'  */
+#line 1465 "bx_parser.y"
        {
          dbg_printf("source <file> - cause debugger to execute a script file.\n");
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4321 "y.tab.c"
+#line 4351 "y.tab.c"
     break;
 
-  case 273: /* help_command: BX_TOKEN_HELP BX_TOKEN_HELP '\n'  */
-#line 1458 "bx_parser.y"
+  case 275: /* help_command: BX_TOKEN_HELP BX_TOKEN_HELP '\n'  */
+#line 1470 "bx_parser.y"
        {
          bx_dbg_print_help();
          free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
-#line 4330 "y.tab.c"
+#line 4360 "y.tab.c"
     break;
 
-  case 274: /* help_command: BX_TOKEN_HELP '\n'  */
-#line 1463 "bx_parser.y"
+  case 276: /* help_command: BX_TOKEN_HELP '\n'  */
+#line 1475 "bx_parser.y"
        {
          bx_dbg_print_help();
          free((yyvsp[-1].sval));
        }
-#line 4339 "y.tab.c"
+#line 4369 "y.tab.c"
     break;
 
-  case 275: /* calc_command: BX_TOKEN_CALC expression '\n'  */
-#line 1471 "bx_parser.y"
+  case 277: /* calc_command: BX_TOKEN_CALC expression '\n'  */
+#line 1483 "bx_parser.y"
    {
      eval_value = (yyvsp[-1].uval);
      bx_dbg_calc_command((yyvsp[-1].uval));
      free((yyvsp[-2].sval));
    }
-#line 4349 "y.tab.c"
+#line 4379 "y.tab.c"
     break;
 
-  case 276: /* addlyt_command: BX_TOKEN_ADDLYT BX_TOKEN_STRING '\n'  */
-#line 1480 "bx_parser.y"
+  case 278: /* addlyt_command: BX_TOKEN_ADDLYT BX_TOKEN_STRING '\n'  */
+#line 1492 "bx_parser.y"
    {
      bx_dbg_addlyt((yyvsp[-1].sval));
      free((yyvsp[-2].sval));
      free((yyvsp[-1].sval));
    }
-#line 4359 "y.tab.c"
+#line 4389 "y.tab.c"
     break;
 
-  case 277: /* remlyt_command: BX_TOKEN_REMLYT '\n'  */
-#line 1489 "bx_parser.y"
+  case 279: /* remlyt_command: BX_TOKEN_REMLYT '\n'  */
+#line 1501 "bx_parser.y"
    {
      bx_dbg_remlyt();
      free((yyvsp[-1].sval));
    }
-#line 4368 "y.tab.c"
+#line 4398 "y.tab.c"
     break;
 
-  case 278: /* lyt_command: BX_TOKEN_LYT '\n'  */
-#line 1497 "bx_parser.y"
+  case 280: /* lyt_command: BX_TOKEN_LYT '\n'  */
+#line 1509 "bx_parser.y"
    {
      bx_dbg_lyt();
      free((yyvsp[-1].sval));
    }
-#line 4377 "y.tab.c"
+#line 4407 "y.tab.c"
     break;
 
-  case 279: /* if_command: BX_TOKEN_IF expression '\n'  */
-#line 1505 "bx_parser.y"
+  case 281: /* if_command: BX_TOKEN_IF expression '\n'  */
+#line 1517 "bx_parser.y"
    {
      eval_value = (yyvsp[-1].uval) != 0;
      bx_dbg_calc_command((yyvsp[-1].uval));
      free((yyvsp[-2].sval));
    }
-#line 4387 "y.tab.c"
+#line 4417 "y.tab.c"
     break;
 
-  case 280: /* vexpression: BX_TOKEN_NUMERIC  */
-#line 1514 "bx_parser.y"
+  case 282: /* vexpression: BX_TOKEN_NUMERIC  */
+#line 1526 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[0].uval); }
-#line 4393 "y.tab.c"
+#line 4423 "y.tab.c"
     break;
 
-  case 281: /* vexpression: BX_TOKEN_STRING  */
-#line 1515 "bx_parser.y"
+  case 283: /* vexpression: BX_TOKEN_STRING  */
+#line 1527 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[0].sval)); free((yyvsp[0].sval));}
-#line 4399 "y.tab.c"
+#line 4429 "y.tab.c"
     break;
 
-  case 282: /* vexpression: BX_TOKEN_8BL_REG  */
-#line 1516 "bx_parser.y"
+  case 284: /* vexpression: BX_TOKEN_8BL_REG  */
+#line 1528 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[0].uval)); }
-#line 4405 "y.tab.c"
+#line 4435 "y.tab.c"
     break;
 
-  case 283: /* vexpression: BX_TOKEN_8BH_REG  */
-#line 1517 "bx_parser.y"
+  case 285: /* vexpression: BX_TOKEN_8BH_REG  */
+#line 1529 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[0].uval)); }
-#line 4411 "y.tab.c"
+#line 4441 "y.tab.c"
     break;
 
-  case 284: /* vexpression: BX_TOKEN_16B_REG  */
-#line 1518 "bx_parser.y"
+  case 286: /* vexpression: BX_TOKEN_16B_REG  */
+#line 1530 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[0].uval)); }
-#line 4417 "y.tab.c"
+#line 4447 "y.tab.c"
     break;
 
-  case 285: /* vexpression: BX_TOKEN_32B_REG  */
-#line 1519 "bx_parser.y"
+  case 287: /* vexpression: BX_TOKEN_32B_REG  */
+#line 1531 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[0].uval)); }
-#line 4423 "y.tab.c"
+#line 4453 "y.tab.c"
     break;
 
-  case 286: /* vexpression: BX_TOKEN_64B_REG  */
-#line 1520 "bx_parser.y"
+  case 288: /* vexpression: BX_TOKEN_64B_REG  */
+#line 1532 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[0].uval)); }
-#line 4429 "y.tab.c"
+#line 4459 "y.tab.c"
     break;
 
-  case 287: /* vexpression: BX_TOKEN_OPMASK_REG  */
-#line 1521 "bx_parser.y"
+  case 289: /* vexpression: BX_TOKEN_OPMASK_REG  */
+#line 1533 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_opmask_value((yyvsp[0].uval)); }
-#line 4435 "y.tab.c"
+#line 4465 "y.tab.c"
     break;
 
-  case 288: /* vexpression: BX_TOKEN_SEGREG  */
-#line 1522 "bx_parser.y"
+  case 290: /* vexpression: BX_TOKEN_SEGREG  */
+#line 1534 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[0].uval)); }
-#line 4441 "y.tab.c"
+#line 4471 "y.tab.c"
     break;
 
-  case 289: /* vexpression: BX_TOKEN_REG_IP  */
-#line 1523 "bx_parser.y"
+  case 291: /* vexpression: BX_TOKEN_REG_IP  */
+#line 1535 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_ip (); }
-#line 4447 "y.tab.c"
+#line 4477 "y.tab.c"
     break;
 
-  case 290: /* vexpression: BX_TOKEN_REG_EIP  */
-#line 1524 "bx_parser.y"
+  case 292: /* vexpression: BX_TOKEN_REG_EIP  */
+#line 1536 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_eip(); }
-#line 4453 "y.tab.c"
+#line 4483 "y.tab.c"
     break;
 
-  case 291: /* vexpression: BX_TOKEN_REG_RIP  */
-#line 1525 "bx_parser.y"
+  case 293: /* vexpression: BX_TOKEN_REG_RIP  */
+#line 1537 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_rip(); }
-#line 4459 "y.tab.c"
+#line 4489 "y.tab.c"
     break;
 
-  case 292: /* vexpression: BX_TOKEN_REG_SSP  */
-#line 1526 "bx_parser.y"
+  case 294: /* vexpression: BX_TOKEN_REG_SSP  */
+#line 1538 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_ssp(); }
-#line 4465 "y.tab.c"
+#line 4495 "y.tab.c"
     break;
 
-  case 293: /* vexpression: vexpression '+' vexpression  */
-#line 1527 "bx_parser.y"
+  case 295: /* vexpression: vexpression '+' vexpression  */
+#line 1539 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) + (yyvsp[0].uval); }
-#line 4471 "y.tab.c"
+#line 4501 "y.tab.c"
     break;
 
-  case 294: /* vexpression: vexpression '-' vexpression  */
-#line 1528 "bx_parser.y"
+  case 296: /* vexpression: vexpression '-' vexpression  */
+#line 1540 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) - (yyvsp[0].uval); }
-#line 4477 "y.tab.c"
+#line 4507 "y.tab.c"
     break;
 
-  case 295: /* vexpression: vexpression '*' vexpression  */
-#line 1529 "bx_parser.y"
+  case 297: /* vexpression: vexpression '*' vexpression  */
+#line 1541 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) * (yyvsp[0].uval); }
-#line 4483 "y.tab.c"
+#line 4513 "y.tab.c"
     break;
 
-  case 296: /* vexpression: vexpression '/' vexpression  */
-#line 1530 "bx_parser.y"
+  case 298: /* vexpression: vexpression '/' vexpression  */
+#line 1542 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) / (yyvsp[0].uval); }
-#line 4489 "y.tab.c"
+#line 4519 "y.tab.c"
     break;
 
-  case 297: /* vexpression: vexpression BX_TOKEN_DEREF_CHR vexpression  */
-#line 1531 "bx_parser.y"
+  case 299: /* vexpression: vexpression BX_TOKEN_DEREF_CHR vexpression  */
+#line 1543 "bx_parser.y"
                                                 { (yyval.uval) = bx_dbg_deref((yyvsp[-2].uval), (yyvsp[0].uval), NULL, NULL); }
-#line 4495 "y.tab.c"
+#line 4525 "y.tab.c"
     break;
 
-  case 298: /* vexpression: vexpression BX_TOKEN_RSHIFT vexpression  */
-#line 1532 "bx_parser.y"
+  case 300: /* vexpression: vexpression BX_TOKEN_RSHIFT vexpression  */
+#line 1544 "bx_parser.y"
                                              { (yyval.uval) = (yyvsp[-2].uval) >> (yyvsp[0].uval); }
-#line 4501 "y.tab.c"
+#line 4531 "y.tab.c"
     break;
 
-  case 299: /* vexpression: vexpression BX_TOKEN_LSHIFT vexpression  */
-#line 1533 "bx_parser.y"
+  case 301: /* vexpression: vexpression BX_TOKEN_LSHIFT vexpression  */
+#line 1545 "bx_parser.y"
                                              { (yyval.uval) = (yyvsp[-2].uval) << (yyvsp[0].uval); }
-#line 4507 "y.tab.c"
+#line 4537 "y.tab.c"
     break;
 
-  case 300: /* vexpression: vexpression '|' vexpression  */
-#line 1534 "bx_parser.y"
+  case 302: /* vexpression: vexpression '|' vexpression  */
+#line 1546 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) | (yyvsp[0].uval); }
-#line 4513 "y.tab.c"
+#line 4543 "y.tab.c"
     break;
 
-  case 301: /* vexpression: vexpression '^' vexpression  */
-#line 1535 "bx_parser.y"
+  case 303: /* vexpression: vexpression '^' vexpression  */
+#line 1547 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) ^ (yyvsp[0].uval); }
-#line 4519 "y.tab.c"
+#line 4549 "y.tab.c"
     break;
 
-  case 302: /* vexpression: vexpression '&' vexpression  */
-#line 1536 "bx_parser.y"
+  case 304: /* vexpression: vexpression '&' vexpression  */
+#line 1548 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) & (yyvsp[0].uval); }
-#line 4525 "y.tab.c"
+#line 4555 "y.tab.c"
     break;
 
-  case 303: /* vexpression: '!' vexpression  */
-#line 1537 "bx_parser.y"
+  case 305: /* vexpression: '!' vexpression  */
+#line 1549 "bx_parser.y"
                                      { (yyval.uval) = !(yyvsp[0].uval); }
-#line 4531 "y.tab.c"
+#line 4561 "y.tab.c"
     break;
 
-  case 304: /* vexpression: '-' vexpression  */
-#line 1538 "bx_parser.y"
+  case 306: /* vexpression: '-' vexpression  */
+#line 1550 "bx_parser.y"
                                      { (yyval.uval) = -(yyvsp[0].uval); }
-#line 4537 "y.tab.c"
+#line 4567 "y.tab.c"
     break;
 
-  case 305: /* vexpression: '(' vexpression ')'  */
-#line 1539 "bx_parser.y"
+  case 307: /* vexpression: '(' vexpression ')'  */
+#line 1551 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-1].uval); }
-#line 4543 "y.tab.c"
+#line 4573 "y.tab.c"
     break;
 
-  case 306: /* expression: BX_TOKEN_NUMERIC  */
-#line 1545 "bx_parser.y"
+  case 308: /* expression: BX_TOKEN_NUMERIC  */
+#line 1557 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[0].uval); }
-#line 4549 "y.tab.c"
+#line 4579 "y.tab.c"
     break;
 
-  case 307: /* expression: BX_TOKEN_STRING  */
-#line 1546 "bx_parser.y"
+  case 309: /* expression: BX_TOKEN_STRING  */
+#line 1558 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[0].sval)); free((yyvsp[0].sval));}
-#line 4555 "y.tab.c"
+#line 4585 "y.tab.c"
     break;
 
-  case 308: /* expression: BX_TOKEN_8BL_REG  */
-#line 1547 "bx_parser.y"
+  case 310: /* expression: BX_TOKEN_8BL_REG  */
+#line 1559 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[0].uval)); }
-#line 4561 "y.tab.c"
+#line 4591 "y.tab.c"
     break;
 
-  case 309: /* expression: BX_TOKEN_8BH_REG  */
-#line 1548 "bx_parser.y"
+  case 311: /* expression: BX_TOKEN_8BH_REG  */
+#line 1560 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[0].uval)); }
-#line 4567 "y.tab.c"
+#line 4597 "y.tab.c"
     break;
 
-  case 310: /* expression: BX_TOKEN_16B_REG  */
-#line 1549 "bx_parser.y"
+  case 312: /* expression: BX_TOKEN_16B_REG  */
+#line 1561 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[0].uval)); }
-#line 4573 "y.tab.c"
+#line 4603 "y.tab.c"
     break;
 
-  case 311: /* expression: BX_TOKEN_32B_REG  */
-#line 1550 "bx_parser.y"
+  case 313: /* expression: BX_TOKEN_32B_REG  */
+#line 1562 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[0].uval)); }
-#line 4579 "y.tab.c"
+#line 4609 "y.tab.c"
     break;
 
-  case 312: /* expression: BX_TOKEN_64B_REG  */
-#line 1551 "bx_parser.y"
+  case 314: /* expression: BX_TOKEN_64B_REG  */
+#line 1563 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[0].uval)); }
-#line 4585 "y.tab.c"
+#line 4615 "y.tab.c"
     break;
 
-  case 313: /* expression: BX_TOKEN_OPMASK_REG  */
-#line 1552 "bx_parser.y"
+  case 315: /* expression: BX_TOKEN_OPMASK_REG  */
+#line 1564 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_opmask_value((yyvsp[0].uval)); }
-#line 4591 "y.tab.c"
+#line 4621 "y.tab.c"
     break;
 
-  case 314: /* expression: BX_TOKEN_SEGREG  */
-#line 1553 "bx_parser.y"
+  case 316: /* expression: BX_TOKEN_SEGREG  */
+#line 1565 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[0].uval)); }
-#line 4597 "y.tab.c"
+#line 4627 "y.tab.c"
     break;
 
-  case 315: /* expression: BX_TOKEN_REG_IP  */
-#line 1554 "bx_parser.y"
+  case 317: /* expression: BX_TOKEN_REG_IP  */
+#line 1566 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_ip (); }
-#line 4603 "y.tab.c"
+#line 4633 "y.tab.c"
     break;
 
-  case 316: /* expression: BX_TOKEN_REG_EIP  */
-#line 1555 "bx_parser.y"
+  case 318: /* expression: BX_TOKEN_REG_EIP  */
+#line 1567 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_eip(); }
-#line 4609 "y.tab.c"
+#line 4639 "y.tab.c"
     break;
 
-  case 317: /* expression: BX_TOKEN_REG_RIP  */
-#line 1556 "bx_parser.y"
+  case 319: /* expression: BX_TOKEN_REG_RIP  */
+#line 1568 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_rip(); }
-#line 4615 "y.tab.c"
+#line 4645 "y.tab.c"
     break;
 
-  case 318: /* expression: BX_TOKEN_REG_SSP  */
-#line 1557 "bx_parser.y"
+  case 320: /* expression: BX_TOKEN_REG_SSP  */
+#line 1569 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_ssp(); }
-#line 4621 "y.tab.c"
+#line 4651 "y.tab.c"
     break;
 
-  case 319: /* expression: expression ':' expression  */
-#line 1558 "bx_parser.y"
+  case 321: /* expression: expression ':' expression  */
+#line 1570 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_get_laddr ((yyvsp[-2].uval), (yyvsp[0].uval)); }
-#line 4627 "y.tab.c"
+#line 4657 "y.tab.c"
     break;
 
-  case 320: /* expression: expression '+' expression  */
-#line 1559 "bx_parser.y"
+  case 322: /* expression: expression '+' expression  */
+#line 1571 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) + (yyvsp[0].uval); }
-#line 4633 "y.tab.c"
+#line 4663 "y.tab.c"
     break;
 
-  case 321: /* expression: expression '-' expression  */
-#line 1560 "bx_parser.y"
+  case 323: /* expression: expression '-' expression  */
+#line 1572 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) - (yyvsp[0].uval); }
-#line 4639 "y.tab.c"
+#line 4669 "y.tab.c"
     break;
 
-  case 322: /* expression: expression '*' expression  */
-#line 1561 "bx_parser.y"
+  case 324: /* expression: expression '*' expression  */
+#line 1573 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) * (yyvsp[0].uval); }
-#line 4645 "y.tab.c"
+#line 4675 "y.tab.c"
     break;
 
-  case 323: /* expression: expression '/' expression  */
-#line 1562 "bx_parser.y"
+  case 325: /* expression: expression '/' expression  */
+#line 1574 "bx_parser.y"
                                      { (yyval.uval) = ((yyvsp[0].uval) != 0) ? (yyvsp[-2].uval) / (yyvsp[0].uval) : 0; }
-#line 4651 "y.tab.c"
+#line 4681 "y.tab.c"
     break;
 
-  case 324: /* expression: expression BX_TOKEN_DEREF_CHR expression  */
-#line 1563 "bx_parser.y"
+  case 326: /* expression: expression BX_TOKEN_DEREF_CHR expression  */
+#line 1575 "bx_parser.y"
                                               { (yyval.uval) = bx_dbg_deref((yyvsp[-2].uval), (yyvsp[0].uval), NULL, NULL); }
-#line 4657 "y.tab.c"
+#line 4687 "y.tab.c"
     break;
 
-  case 325: /* expression: expression BX_TOKEN_RSHIFT expression  */
-#line 1564 "bx_parser.y"
+  case 327: /* expression: expression BX_TOKEN_RSHIFT expression  */
+#line 1576 "bx_parser.y"
                                            { (yyval.uval) = (yyvsp[-2].uval) >> (yyvsp[0].uval); }
-#line 4663 "y.tab.c"
+#line 4693 "y.tab.c"
     break;
 
-  case 326: /* expression: expression BX_TOKEN_LSHIFT expression  */
-#line 1565 "bx_parser.y"
+  case 328: /* expression: expression BX_TOKEN_LSHIFT expression  */
+#line 1577 "bx_parser.y"
                                            { (yyval.uval) = (yyvsp[-2].uval) << (yyvsp[0].uval); }
-#line 4669 "y.tab.c"
+#line 4699 "y.tab.c"
     break;
 
-  case 327: /* expression: expression '|' expression  */
-#line 1566 "bx_parser.y"
+  case 329: /* expression: expression '|' expression  */
+#line 1578 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) | (yyvsp[0].uval); }
-#line 4675 "y.tab.c"
+#line 4705 "y.tab.c"
     break;
 
-  case 328: /* expression: expression '^' expression  */
-#line 1567 "bx_parser.y"
+  case 330: /* expression: expression '^' expression  */
+#line 1579 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) ^ (yyvsp[0].uval); }
-#line 4681 "y.tab.c"
+#line 4711 "y.tab.c"
     break;
 
-  case 329: /* expression: expression '&' expression  */
-#line 1568 "bx_parser.y"
+  case 331: /* expression: expression '&' expression  */
+#line 1580 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) & (yyvsp[0].uval); }
-#line 4687 "y.tab.c"
+#line 4717 "y.tab.c"
     break;
 
-  case 330: /* expression: expression '>' expression  */
-#line 1569 "bx_parser.y"
+  case 332: /* expression: expression '>' expression  */
+#line 1581 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) > (yyvsp[0].uval); }
-#line 4693 "y.tab.c"
+#line 4723 "y.tab.c"
     break;
 
-  case 331: /* expression: expression '<' expression  */
-#line 1570 "bx_parser.y"
+  case 333: /* expression: expression '<' expression  */
+#line 1582 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-2].uval) < (yyvsp[0].uval); }
-#line 4699 "y.tab.c"
+#line 4729 "y.tab.c"
     break;
 
-  case 332: /* expression: expression BX_TOKEN_EQ expression  */
-#line 1571 "bx_parser.y"
+  case 334: /* expression: expression BX_TOKEN_EQ expression  */
+#line 1583 "bx_parser.y"
                                        { (yyval.uval) = (yyvsp[-2].uval) == (yyvsp[0].uval); }
-#line 4705 "y.tab.c"
+#line 4735 "y.tab.c"
     break;
 
-  case 333: /* expression: expression BX_TOKEN_NE expression  */
-#line 1572 "bx_parser.y"
+  case 335: /* expression: expression BX_TOKEN_NE expression  */
+#line 1584 "bx_parser.y"
                                        { (yyval.uval) = (yyvsp[-2].uval) != (yyvsp[0].uval); }
-#line 4711 "y.tab.c"
+#line 4741 "y.tab.c"
     break;
 
-  case 334: /* expression: expression BX_TOKEN_LE expression  */
-#line 1573 "bx_parser.y"
+  case 336: /* expression: expression BX_TOKEN_LE expression  */
+#line 1585 "bx_parser.y"
                                        { (yyval.uval) = (yyvsp[-2].uval) <= (yyvsp[0].uval); }
-#line 4717 "y.tab.c"
+#line 4747 "y.tab.c"
     break;
 
-  case 335: /* expression: expression BX_TOKEN_GE expression  */
-#line 1574 "bx_parser.y"
+  case 337: /* expression: expression BX_TOKEN_GE expression  */
+#line 1586 "bx_parser.y"
                                        { (yyval.uval) = (yyvsp[-2].uval) >= (yyvsp[0].uval); }
-#line 4723 "y.tab.c"
+#line 4753 "y.tab.c"
     break;
 
-  case 336: /* expression: '!' expression  */
-#line 1575 "bx_parser.y"
+  case 338: /* expression: '!' expression  */
+#line 1587 "bx_parser.y"
                                      { (yyval.uval) = !(yyvsp[0].uval); }
-#line 4729 "y.tab.c"
+#line 4759 "y.tab.c"
     break;
 
-  case 337: /* expression: '-' expression  */
-#line 1576 "bx_parser.y"
+  case 339: /* expression: '-' expression  */
+#line 1588 "bx_parser.y"
                                      { (yyval.uval) = -(yyvsp[0].uval); }
-#line 4735 "y.tab.c"
+#line 4765 "y.tab.c"
     break;
 
-  case 338: /* expression: '*' expression  */
-#line 1577 "bx_parser.y"
+  case 340: /* expression: '*' expression  */
+#line 1589 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_lin_indirect((yyvsp[0].uval)); }
-#line 4741 "y.tab.c"
+#line 4771 "y.tab.c"
     break;
 
-  case 339: /* expression: '@' expression  */
-#line 1578 "bx_parser.y"
+  case 341: /* expression: '@' expression  */
+#line 1590 "bx_parser.y"
                                      { (yyval.uval) = bx_dbg_phy_indirect((yyvsp[0].uval)); }
-#line 4747 "y.tab.c"
+#line 4777 "y.tab.c"
     break;
 
-  case 340: /* expression: '(' expression ')'  */
-#line 1579 "bx_parser.y"
+  case 342: /* expression: '(' expression ')'  */
+#line 1591 "bx_parser.y"
                                      { (yyval.uval) = (yyvsp[-1].uval); }
-#line 4753 "y.tab.c"
+#line 4783 "y.tab.c"
     break;
 
 
-#line 4757 "y.tab.c"
+#line 4787 "y.tab.c"
 
       default: break;
     }
@@ -4946,7 +4976,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1582 "bx_parser.y"
+#line 1594 "bx_parser.y"
 
 #endif  /* if BX_DEBUGGER */
 /* The #endif is appended by the makefile after running yacc. */
@@ -577,6 +577,11 @@ set_command:
         bx_dbg_set_auto_disassemble($3);
         free($1); free($2);
       }
+    | BX_TOKEN_SET BX_TOKEN_GENERIC BX_TOKEN_TOGGLE_ON_OFF '\n'
+      {
+        bx_dbg_set_toggle_command($2, $3);
+        free($1); free($2);
+      }
     | BX_TOKEN_SET BX_TOKEN_SYMBOLNAME '=' expression '\n'
       {
         bx_dbg_set_symbol_command($2, $4);
@@ -766,6 +771,11 @@ info_command:
         bx_dbg_info_symbols_command($3);
         free($1); free($2); free($3);
       }
+    | BX_TOKEN_INFO BX_TOKEN_GENERIC '\n'
+      {
+        bx_dbg_info_generic_command($2);
+        free($1); free($2);
+      }
     | BX_TOKEN_INFO BX_TOKEN_DEVICE '\n'
       {
         bx_dbg_info_device("", "");
@@ -1370,6 +1380,7 @@ help_command:
          dbg_printf("       every time execution stops\n");
          dbg_printf("set u|disasm on  - same as 'set $auto_disassemble = 1'\n");
          dbg_printf("set u|disasm off - same as 'set $auto_disassemble = 0'\n");
+         dbg_printf("set profile on|off - start or stop sampling profiler\n");
          free($1);free($2);
        }
      | BX_TOKEN_HELP BX_TOKEN_PAGE '\n'
@@ -1391,6 +1402,7 @@ help_command:
          dbg_printf("info device - show list of devices supported by this command\n");
          dbg_printf("info device [string] - show state of device specified in string\n");
          dbg_printf("info device [string] [string] - show state of device with options\n");
+         dbg_printf("info profile - show profile of executed code and write profile files\n");
          free($1);free($2);
        }
      | BX_TOKEN_HELP BX_TOKEN_SHOW '\n'
@@ -27,6 +27,7 @@ extern "C" {
 #include "param_names.h"
 #include "debug.h"
 #include "cpu/cpu.h"
+#include "cpu/profile.h"
 #include "cpu/decoder/ia_opcodes.h"
 #include "iodev/iodev.h"
 #if BX_DEBUGGER
@@ -2520,6 +2521,28 @@ void bx_dbg_set_auto_disassemble(bool enable)
   bx_debugger.auto_disassemble = enable;
 }
 
+void bx_dbg_set_toggle_command(const char *name, bool enable)
+{
+  if (!strcmp(name, "profile")) {
+    SIM->get_param_bool(BXPN_PROFILE_ENABLED)->set(enable);
+    dbg_printf("Sampling profiler %s\n", enable ? "started" : "stopped");
+  }
+  else {
+    dbg_printf("Error: unknown option '%s'\n", name);
+  }
+}
+
+void bx_dbg_info_generic_command(const char *name)
+{
+  if (!strcmp(name, "profile")) {
+    printProfile(20);
+    writeProfile();
+  }
+  else {
+    dbg_printf("Error: unknown info command '%s', try 'help info'\n", name);
+  }
+}
+
 void bx_dbg_set_disassemble_size(unsigned size)
 {
   if ((size!=16) && (size!=32) && (size!=64) && (size!=0))
@@ -125,6 +125,7 @@ void bx_dbg_continue_command(bool expression);
 void bx_dbg_stepN_command(int cpu, Bit32u count);
 int  bx_dbg_run_to_laddr(bx_address addr);
 void bx_dbg_set_auto_disassemble(bool enable);
+void bx_dbg_set_toggle_command(const char *name, bool enable);
 void bx_dbg_disassemble_switch_mode(void);
 void bx_dbg_set_disassemble_size(unsigned size);
 void bx_dbg_del_breakpoint_command(unsigned handle);
@@ -159,6 +160,7 @@ void bx_dbg_info_control_regs_command(void);
 void bx_dbg_info_segment_regs_command(void);
 void bx_dbg_info_flags(void);
 void bx_dbg_info_linux_command(void);
+void bx_dbg_info_generic_command(const char *name);
 void bx_dbg_examine_command(const char *command, const char *format, bool format_passed,
                     bx_address addr, bool addr_passed);
 Bit32u bx_dbg_lin_indirect(bx_address addr);
@@ -204,6 +206,7 @@ void bx_dbg_info_symbols_command(const char *Symbol);
 int bx_dbg_lbreakpoint_symbol_command(const char *Symbol, const char *condition);
 bx_address bx_dbg_get_symbol_value(const char *Symbol);
 const char* bx_dbg_disasm_symbolic_address(bx_address eip, bx_address base);
+const char* bx_dbg_symbol_lookup(bx_address context, bx_address laddr, bx_address *start);
 
 typedef enum {
   STOP_NO_REASON = 0,
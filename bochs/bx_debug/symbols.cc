@@ -64,6 +64,11 @@ const char* bx_dbg_disasm_symbolic_address(bx_address eip, bx_address base)
   return 0;
 }
 
+const char* bx_dbg_symbol_lookup(bx_address context, bx_address laddr, bx_address *start)
+{
+  return 0;
+}
+
 #else   /* if BX_HAVE_MAP == 1 */
 
 #if BX_HAVE_MAP
@@ -273,6 +278,26 @@ const char* bx_dbg_disasm_symbolic_address(bx_address xip, bx_address base)
   return buf;
 }
 
+// find the symbol covering linear address laddr, used by the profiler
+const char* bx_dbg_symbol_lookup(bx_address context, bx_address laddr, bx_address *start)
+{
+  symbol_entry_t* entr = 0;
+
+  // Look up this context first, then the global context
+  context_t* cntx = context_t::get_context(context);
+  if (cntx)
+    entr = cntx->get_symbol_entry(laddr);
+  if (!entr && context != 0) {
+    cntx = context_t::get_context(0);
+    if (cntx)
+      entr = cntx->get_symbol_entry(laddr);
+  }
+  if (!entr) return 0;
+
+  *start = entr->start;
+  return entr->name;
+}
+
 #include "cpu/cpu.h"
 
 int bx_dbg_symbol_command(const char* filename, bool global, bx_address offset)
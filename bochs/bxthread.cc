@@ -128,3 +128,66 @@ void BOCHSAPI_MSVCONLY bx_set_sem(bx_thread_sem_t *thread_sem)
   #endif
 #endif
 }
+
+void BOCHSAPI_MSVCONLY bx_create_barrier(bx_thread_barrier_t *barrier, unsigned count)
+{
+#if defined(WIN32)
+  InitializeCriticalSection(&barrier->lock);
+  InitializeConditionVariable(&barrier->cond);
+#else
+  pthread_mutex_init(&barrier->lock, NULL);
+  pthread_cond_init(&barrier->cond, NULL);
+#endif
+  barrier->count = count;
+  barrier->waiting = 0;
+  barrier->generation = 0;
+}
+
+void BOCHSAPI_MSVCONLY bx_destroy_barrier(bx_thread_barrier_t *barrier)
+{
+#if defined(WIN32)
+  DeleteCriticalSection(&barrier->lock);
+#else
+  pthread_cond_destroy(&barrier->cond);
+  pthread_mutex_destroy(&barrier->lock);
+#endif
+}
+
+// Block until 'count' threads reached the barrier. Returns true for exactly
+// one of them (the last one arrived), so it could do some serial work.
+bool BOCHSAPI_MSVCONLY bx_wait_barrier(bx_thread_barrier_t *barrier)
+{
+  bool last = false;
+
+#if defined(WIN32)
+  EnterCriticalSection(&barrier->lock);
+#else
+  pthread_mutex_lock(&barrier->lock);
+#endif
+  unsigned generation = barrier->generation;
+  if (++barrier->waiting == barrier->count) {
+    barrier->waiting = 0;
+    barrier->generation++;
+    last = true;
+#if defined(WIN32)
+    WakeAllConditionVariable(&barrier->cond);
+#else
+    pthread_cond_broadcast(&barrier->cond);
+#endif
+  } else {
+    while (generation == barrier->generation) {
+#if defined(WIN32)
+      SleepConditionVariableCS(&barrier->cond, &barrier->lock, INFINITE);
+#else
+      pthread_cond_wait(&barrier->cond, &barrier->lock);
+#endif
+    }
+  }
+#if defined(WIN32)
+  LeaveCriticalSection(&barrier->lock);
+#else
+  pthread_mutex_unlock(&barrier->lock);
+#endif
+
+  return last;
+}
@@ -36,6 +36,7 @@
 #define BX_UNLOCK(mutex) LeaveCriticalSection(&(mutex))
 #define BX_MUTEX(mutex) CRITICAL_SECTION mutex
 #define BX_INIT_MUTEX(mutex) InitializeCriticalSection(&(mutex))
+#define BX_INIT_RECURSIVE_MUTEX(mutex) InitializeCriticalSection(&(mutex))
 #define BX_FINI_MUTEX(mutex) DeleteCriticalSection(&(mutex))
 #define BX_MSLEEP(val) Sleep(val)
 
@@ -59,11 +60,151 @@
 #define BX_UNLOCK(mutex) pthread_mutex_unlock(&(mutex));
 #define BX_MUTEX(mutex) pthread_mutex_t mutex
 #define BX_INIT_MUTEX(mutex) pthread_mutex_init(&(mutex),NULL)
+#define BX_INIT_RECURSIVE_MUTEX(mutex) do { \
+    pthread_mutexattr_t attr; \
+    pthread_mutexattr_init(&attr); \
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE); \
+    pthread_mutex_init(&(mutex), &attr); \
+    pthread_mutexattr_destroy(&attr); \
+  } while (0)
 #define BX_FINI_MUTEX(mutex) pthread_mutex_destroy(&(mutex))
 #define BX_MSLEEP(val) usleep(val*1000)
 
 #endif
 
+// Atomic operations on memory shared between host threads
+
+#if defined(_MSC_VER)
+
+#include <intrin.h>
+
+BX_CPP_INLINE void bx_atomic_or32(Bit32u *ptr, Bit32u val)
+{
+  _InterlockedOr((volatile long *) ptr, (long) val);
+}
+
+BX_CPP_INLINE void bx_atomic_and32(Bit32u *ptr, Bit32u val)
+{
+  _InterlockedAnd((volatile long *) ptr, (long) val);
+}
+
+BX_CPP_INLINE void bx_atomic_store32(Bit32u *ptr, Bit32u val)
+{
+  _InterlockedExchange((volatile long *) ptr, (long) val);
+}
+
+BX_CPP_INLINE void bx_atomic_add64(Bit64u *ptr, Bit64u val)
+{
+  _InterlockedExchangeAdd64((volatile __int64 *) ptr, (__int64) val);
+}
+
+BX_CPP_INLINE void bx_atomic_fence(void)
+{
+  MemoryBarrier();
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit8u *ptr, Bit8u old, Bit8u val)
+{
+  return (Bit8u) _InterlockedCompareExchange8((volatile char *) ptr, (char) val, (char) old) == old;
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit16u *ptr, Bit16u old, Bit16u val)
+{
+  return (Bit16u) _InterlockedCompareExchange16((volatile short *) ptr, (short) val, (short) old) == old;
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit32u *ptr, Bit32u old, Bit32u val)
+{
+  return (Bit32u) _InterlockedCompareExchange((volatile long *) ptr, (long) val, (long) old) == old;
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit64u *ptr, Bit64u old, Bit64u val)
+{
+  return (Bit64u) _InterlockedCompareExchange64((volatile __int64 *) ptr, (__int64) val, (__int64) old) == old;
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg_ptr(void **ptr, void *old, void *val)
+{
+  return _InterlockedCompareExchangePointer(ptr, val, old) == old;
+}
+
+#if defined(_M_X64)
+#define BX_HAVE_ATOMIC_CMPXCHG128 1
+// ptr must be 16-byte aligned, ptr[0] is the low half
+BX_CPP_INLINE bool bx_atomic_cmpxchg128(Bit64u *ptr, Bit64u old_hi, Bit64u old_lo, Bit64u hi, Bit64u lo)
+{
+  __int64 cmp[2] = { (__int64) old_lo, (__int64) old_hi };
+  return _InterlockedCompareExchange128((volatile __int64 *) ptr, (__int64) hi, (__int64) lo, cmp) != 0;
+}
+#endif
+
+#else
+
+BX_CPP_INLINE void bx_atomic_or32(Bit32u *ptr, Bit32u val)
+{
+  __atomic_fetch_or(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE void bx_atomic_and32(Bit32u *ptr, Bit32u val)
+{
+  __atomic_fetch_and(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE void bx_atomic_store32(Bit32u *ptr, Bit32u val)
+{
+  __atomic_store_n(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE void bx_atomic_add64(Bit64u *ptr, Bit64u val)
+{
+  __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE void bx_atomic_fence(void)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit8u *ptr, Bit8u old, Bit8u val)
+{
+  return __atomic_compare_exchange_n(ptr, &old, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit16u *ptr, Bit16u old, Bit16u val)
+{
+  return __atomic_compare_exchange_n(ptr, &old, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit32u *ptr, Bit32u old, Bit32u val)
+{
+  return __atomic_compare_exchange_n(ptr, &old, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg(Bit64u *ptr, Bit64u old, Bit64u val)
+{
+  return __atomic_compare_exchange_n(ptr, &old, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+BX_CPP_INLINE bool bx_atomic_cmpxchg_ptr(void **ptr, void *old, void *val)
+{
+  return __atomic_compare_exchange_n(ptr, &old, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+// 16-byte compare-and-exchange is inlined only when the compiler is allowed
+// to use it (-mcx16 on x86-64), otherwise R-M-W falls back to the lock
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define BX_HAVE_ATOMIC_CMPXCHG128 1
+// ptr must be 16-byte aligned, ptr[0] is the low half
+BX_CPP_INLINE bool bx_atomic_cmpxchg128(Bit64u *ptr, Bit64u old_hi, Bit64u old_lo, Bit64u hi, Bit64u lo)
+{
+  unsigned __int128 cmp = ((unsigned __int128) old_hi << 64) | old_lo;
+  unsigned __int128 val = ((unsigned __int128) hi << 64) | lo;
+  return __sync_bool_compare_and_swap((unsigned __int128 *) ptr, cmp, val);
+}
+#endif
+
+#endif
+
 typedef struct
 {
 #if defined(WIN32)
@@ -87,6 +228,20 @@ typedef struct
 #endif
 } bx_thread_sem_t;
 
+typedef struct
+{
+#if defined(WIN32)
+  CRITICAL_SECTION lock;
+  CONDITION_VARIABLE cond;
+#else
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+#endif
+  unsigned count;
+  unsigned waiting;
+  unsigned generation;
+} bx_thread_barrier_t;
+
 void BOCHSAPI_MSVCONLY bx_create_event(bx_thread_event_t *thread_ev);
 void BOCHSAPI_MSVCONLY bx_destroy_event(bx_thread_event_t *thread_ev);
 void BOCHSAPI_MSVCONLY bx_set_event(bx_thread_event_t *thread_ev);
@@ -95,5 +250,8 @@ bool BOCHSAPI_MSVCONLY bx_create_sem(bx_thread_sem_t *thread_sem);
 void BOCHSAPI_MSVCONLY bx_destroy_sem(bx_thread_sem_t *thread_sem);
 void BOCHSAPI_MSVCONLY bx_wait_sem(bx_thread_sem_t *thread_sem);
 void BOCHSAPI_MSVCONLY bx_set_sem(bx_thread_sem_t *thread_sem);
+void BOCHSAPI_MSVCONLY bx_create_barrier(bx_thread_barrier_t *barrier, unsigned count);
+void BOCHSAPI_MSVCONLY bx_destroy_barrier(bx_thread_barrier_t *barrier);
+bool BOCHSAPI_MSVCONLY bx_wait_barrier(bx_thread_barrier_t *barrier);
 
 #endif
@@ -564,12 +564,6 @@ void bx_init_options()
       "set benchmark mode",
       0, BX_MAX_BIT32U, 0);
 
-  // dump statistics, set by command line arg
-  new bx_param_num_c(menu,
-      "dumpstats",
-      "dumpstats mode",
-      "dump statistics period",
-      0, BX_MAX_BIT32U, 0);
   // unlock disk images
   new bx_param_bool_c(menu,
       "unlock_images",
@@ -664,6 +658,42 @@ void bx_init_options()
       "Maximum amount of instructions allowed to execute before returning control to another CPU.",
       BX_SMP_QUANTUM_MIN, BX_SMP_QUANTUM_MAX,
       16);
+  new bx_param_bool_c(cpu_param,
+      "host_threads", "Run each processor in its own host thread",
+      "Run each emulated processor in a separate host thread, synchronized at quantum boundary (experimental)",
+      0);
+  new bx_param_num_c(cpu_param,
+      "host_quantum", "Quantum ticks in multi-threaded SMP simulation",
+      "Amount of instructions executed by each processor host thread before synchronizing with other processors.",
+      BX_SMP_HOST_QUANTUM_MIN, BX_SMP_HOST_QUANTUM_MAX,
+      4096);
+#endif
+  new bx_param_num_c(cpu_param,
+      "icache_size", "Trace cache size (K entries)",
+      "Number of trace cache entries in thousands, rounded down to power of two",
+      16, 1024,
+      128);
+  new bx_param_num_c(cpu_param,
+      "icache_ways", "Trace cache associativity",
+      "Trace cache associativity (1, 2 or 4 ways)",
+      1, 4,
+      4);
+  new bx_param_filename_c(cpu_param,
+      "icache_file",
+      "Trace cache file",
+      "Save decoded traces to this file on exit and preload them on the next start",
+      "", BX_PATHNAME_LEN);
+#if BX_SUPPORT_SUPERBLOCKS
+  new bx_param_bool_c(cpu_param,
+      "superblocks", "Build traces across taken branches",
+      "Continue trace building at the target of direct jumps and backward conditional branches within the same page",
+      0);
+#endif
+#if BX_SUPPORT_JIT
+  new bx_param_bool_c(cpu_param,
+      "jit", "Compile hot traces to host code",
+      "Compile frequently executed traces into native x86-64 host code",
+      0);
 #endif
   new bx_param_bool_c(cpu_param,
       "reset_on_triple_fault", "Enable CPU reset on triple fault",
@@ -736,6 +766,20 @@ void bx_init_options()
       4, 8192,
       128);
   mem_block_size->set_ask_format("Enter memory block size (KB): [%d] ");
+
+  static const char *mem_hugepages_names[] = { "none", "thp", "hugetlbfs", NULL };
+  new bx_param_enum_c(ram,
+      "hugepages",
+      "Back guest RAM with host huge pages",
+      "Map guest RAM with transparent huge pages or from the hugetlbfs pool",
+      mem_hugepages_names,
+      BX_MEM_HUGEPAGES_NONE,
+      BX_MEM_HUGEPAGES_NONE);
+  new bx_param_bool_c(ram,
+      "numa_bind",
+      "Bind guest RAM to the NUMA node",
+      "Bind every memory block to the NUMA node of the host CPU touching it first",
+      0);
   ram->set_options(ram->SERIES_ASK);
 
   path = new bx_param_filename_c(rom,
@@ -888,6 +932,10 @@ void bx_init_options()
       "rtc_sync", "Sync RTC speed with realtime",
       "If enabled, the RTC runs at realtime speed",
       0);
+  new bx_param_bool_c(clock_cmos,
+      "idle", "Skip time while idle",
+      "If enabled, the time while all processors are halted is skipped up to the next timer event",
+      0);
   deplist = new bx_list_c(NULL);
   deplist->add(rtc_sync);
   clock_sync->set_dependent_list(deplist, 0);
@@ -1633,6 +1681,83 @@ void bx_init_options()
       0);
 #endif
 
+  // sampling profiler
+  bx_list_c *profile = new bx_list_c(misc, "profile", "Sampling profiler");
+  new bx_param_bool_c(profile,
+      "enabled",
+      "Enable sampling profiler",
+      "Sample the executed traces and guest call stacks",
+      0);
+  new bx_param_num_c(profile,
+      "period",
+      "Sampling period",
+      "Number of trace entries between two samples",
+      1, BX_MAX_BIT32U,
+      10000);
+  path = new bx_param_filename_c(profile,
+      "file",
+      "Profile report file",
+      "Flat profile and call sites written on exit",
+      "", BX_PATHNAME_LEN);
+  path->set_extension("txt");
+  path = new bx_param_filename_c(profile,
+      "script",
+      "Profile call stacks file",
+      "Sampled call stacks written on exit in the 'perf script' format",
+      "", BX_PATHNAME_LEN);
+  path->set_extension("txt");
+
+  // statistics dump
+  bx_list_c *statistics = new bx_list_c(misc, "statistics", "Statistics dump");
+  statistics->set_enabled(BX_ENABLE_STATISTICS);
+  new bx_param_bool_c(statistics,
+      "enabled",
+      "Enable statistics dump",
+      "Dump the CPU and device statistics periodically",
+      0);
+  new bx_param_num_c(statistics,
+      "period",
+      "Statistics dump period",
+      "Millions of emulated ticks between two statistics dumps",
+      1, BX_MAX_BIT32U,
+      100);
+  path = new bx_param_filename_c(statistics,
+      "file",
+      "Statistics dump file",
+      "File the statistics are written to (default is stdout)",
+      "", BX_PATHNAME_LEN);
+  path->set_extension("txt");
+
+  // asynchronous disk image I/O
+  bx_list_c *disk_aio = new bx_list_c(misc, "disk_aio", "Asynchronous disk I/O");
+  new bx_param_num_c(disk_aio,
+      "threads",
+      "Disk I/O worker threads",
+      "Number of threads executing the disk image requests of DMA transfers (0 = synchronous I/O)",
+      0, 16,
+      0);
+
+  // hard disk image cache
+  bx_list_c *disk_cache = new bx_list_c(misc, "disk_cache", "Disk image cache");
+  new bx_param_num_c(disk_cache,
+      "size",
+      "Cache size (MB)",
+      "Size of the block cache of each hard disk image in megabytes (0 = no cache)",
+      0, 1024,
+      0);
+  new bx_param_num_c(disk_cache,
+      "readahead",
+      "Read ahead (KB)",
+      "Amount of data read ahead when the guest reads sequentially in kilobytes",
+      0, 256,
+      64);
+  new bx_param_num_c(disk_cache,
+      "writeback",
+      "Write-back buffer (KB)",
+      "Maximum amount of modified data held in the cache in kilobytes (0 = write-through)",
+      0, 65536,
+      1024);
+
   // GDB stub
   menu = new bx_list_c(misc, "gdbstub", "GDB Stub Options");
   menu->set_options(menu->SHOW_PARENT | menu->USE_BOX_TITLE);
@@ -1718,6 +1843,10 @@ void bx_init_options()
   misc->add(SIM->get_param(BXPN_USER_SHORTCUT));
   misc->add(SIM->get_param(BXPN_PORT_E9_HACK));
   misc->add(SIM->get_param(BXPN_PORT_E9_HACK_ALL_RINGS));
+  misc->add(SIM->get_param(BXPN_PROFILE_ENABLED));
+#if BX_ENABLE_STATISTICS
+  misc->add(SIM->get_param(BXPN_STATISTICS_ENABLED));
+#endif
   #if BX_SUPPORT_IODEBUG
   misc->add(SIM->get_param(BXPN_IODEBUG_ALL_RINGS));
   #endif
@@ -3051,6 +3180,9 @@ static int parse_line_formatted(const char *context, int num_params, char *param
       else if (!strncmp(params[i], "rtc_sync=", 9)) {
         SIM->get_param_bool(BXPN_CLOCK_RTC_SYNC)->set(atol(&params[i][9]));
       }
+      else if (!strncmp(params[i], "idle=", 5)) {
+        SIM->get_param_bool(BXPN_CLOCK_IDLE)->set(atol(&params[i][5]));
+      }
       else if (!strcmp(params[i], "time0=local")) {
         SIM->get_param_num(BXPN_CLOCK_TIME0)->set(BX_CLOCK_TIME0_LOCAL);
       }
@@ -3187,6 +3319,30 @@ static int parse_line_formatted(const char *context, int num_params, char *param
         PARSE_ERR(("%s: port_e9_hack directive malformed.", context));
       }
     }
+  } else if (!strcmp(params[0], "profile")) {
+    for (i=1; i<num_params; i++) {
+      if (bx_parse_param_from_list(context, params[i], (bx_list_c*) SIM->get_param(BXPN_PROFILE_ROOT)) < 0) {
+        PARSE_ERR(("%s: profile directive malformed.", context));
+      }
+    }
+  } else if (!strcmp(params[0], "statistics")) {
+    for (i=1; i<num_params; i++) {
+      if (bx_parse_param_from_list(context, params[i], (bx_list_c*) SIM->get_param(BXPN_STATISTICS_ROOT)) < 0) {
+        PARSE_ERR(("%s: statistics directive malformed.", context));
+      }
+    }
+  } else if (!strcmp(params[0], "disk_aio")) {
+    for (i=1; i<num_params; i++) {
+      if (bx_parse_param_from_list(context, params[i], (bx_list_c*) SIM->get_param(BXPN_DISK_AIO_ROOT)) < 0) {
+        PARSE_ERR(("%s: disk_aio directive malformed.", context));
+      }
+    }
+  } else if (!strcmp(params[0], "disk_cache")) {
+    for (i=1; i<num_params; i++) {
+      if (bx_parse_param_from_list(context, params[i], (bx_list_c*) SIM->get_param(BXPN_DISK_CACHE_ROOT)) < 0) {
+        PARSE_ERR(("%s: disk_cache directive malformed.", context));
+      }
+    }
   } else if (!strcmp(params[0], "iodebug")) {
 #if BX_SUPPORT_IODEBUG
     if (num_params != 2) {
@@ -3396,7 +3552,8 @@ int bx_write_clock_cmos_options(FILE *fp)
       fprintf(fp, ", time0=" FMT_LL "d", SIM->get_param_num(BXPN_CLOCK_TIME0)->get64());
   }
 
-  fprintf(fp, ", rtc_sync=%d\n", SIM->get_param_bool(BXPN_CLOCK_RTC_SYNC)->get());
+  fprintf(fp, ", rtc_sync=%d", SIM->get_param_bool(BXPN_CLOCK_RTC_SYNC)->get());
+  fprintf(fp, ", idle=%d\n", SIM->get_param_bool(BXPN_CLOCK_IDLE)->get());
 
   if (strlen(SIM->get_param_string(BXPN_CMOSIMAGE_PATH)->getptr()) > 0) {
     fprintf(fp, "cmosimage: file=%s, ", SIM->get_param_string(BXPN_CMOSIMAGE_PATH)->getptr());
@@ -3555,12 +3712,26 @@ int bx_write_configuration(const char *rc, int overwrite)
   }
   fprintf(fp, ", vbe_memsize=%s\n", SIM->get_param_enum(BXPN_VBE_MEMSIZE)->get_selected());
 #if BX_SUPPORT_SMP
-  fprintf(fp, "cpu: count=%u:%u:%u, ips=%u, quantum=%d, ",
+  fprintf(fp, "cpu: count=%u:%u:%u, ips=%u, quantum=%d, host_threads=%d, host_quantum=%d, ",
     SIM->get_param_num(BXPN_CPU_NPROCESSORS)->get(), SIM->get_param_num(BXPN_CPU_NCORES)->get(),
     SIM->get_param_num(BXPN_CPU_NTHREADS)->get(), SIM->get_param_num(BXPN_IPS)->get(),
-    SIM->get_param_num(BXPN_SMP_QUANTUM)->get());
+    SIM->get_param_num(BXPN_SMP_QUANTUM)->get(),
+    SIM->get_param_bool(BXPN_SMP_HOST_THREADS)->get(),
+    SIM->get_param_num(BXPN_SMP_HOST_QUANTUM)->get());
 #else
   fprintf(fp, "cpu: count=1, ips=%u, ", SIM->get_param_num(BXPN_IPS)->get());
+#endif
+  fprintf(fp, "icache_size=%d, icache_ways=%d, ",
+    SIM->get_param_num(BXPN_ICACHE_SIZE)->get(),
+    SIM->get_param_num(BXPN_ICACHE_WAYS)->get());
+  sparam = SIM->get_param_string(BXPN_ICACHE_FILE);
+  if (!sparam->isempty())
+    fprintf(fp, "icache_file=\"%s\", ", sparam->getptr());
+#if BX_SUPPORT_SUPERBLOCKS
+  fprintf(fp, "superblocks=%d, ", SIM->get_param_bool(BXPN_SUPERBLOCKS)->get());
+#endif
+#if BX_SUPPORT_JIT
+  fprintf(fp, "jit=%d, ", SIM->get_param_bool(BXPN_JIT)->get());
 #endif
   fprintf(fp, "model=%s, reset_on_triple_fault=%d, cpuid_limit_winnt=%d",
     SIM->get_param_enum(BXPN_CPU_MODEL)->get_selected(),
@@ -3582,6 +3753,12 @@ int bx_write_configuration(const char *rc, int overwrite)
   fprintf(fp, "print_timestamps: enabled=%d\n", bx_dbg.print_timestamps);
   bx_write_debugger_options(fp);
   bx_write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_PORT_E9_HACK_ROOT), NULL, 0);
+  bx_write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_PROFILE_ROOT), NULL, 0);
+#if BX_ENABLE_STATISTICS
+  bx_write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_STATISTICS_ROOT), NULL, 0);
+#endif
+  bx_write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_DISK_AIO_ROOT), NULL, 0);
+  bx_write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_DISK_CACHE_ROOT), NULL, 0);
 #if BX_SUPPORT_IODEBUG
   fprintf(fp, "iodebug: all_rings=%d\n", SIM->get_param_bool(BXPN_IODEBUG_ALL_RINGS)->get());
 #endif
@@ -543,7 +543,7 @@ BX_CPU_C::system_read_byte(bx_address laddr)
 {
   Bit8u data;
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from CPL=0
@@ -568,7 +568,7 @@ BX_CPU_C::system_read_word(bx_address laddr)
 {
   Bit16u data;
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from CPL=0
@@ -593,7 +593,7 @@ BX_CPU_C::system_read_dword(bx_address laddr)
 {
   Bit32u data;
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from CPL=0
@@ -618,7 +618,7 @@ BX_CPU_C::system_read_qword(bx_address laddr)
 {
   Bit64u data;
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from CPL=0
@@ -641,7 +641,7 @@ BX_CPU_C::system_read_qword(bx_address laddr)
   void BX_CPP_AttrRegparmN(2)
 BX_CPU_C::system_write_byte(bx_address laddr, Bit8u data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from CPL=0
@@ -664,7 +664,7 @@ BX_CPU_C::system_write_byte(bx_address laddr, Bit8u data)
   void BX_CPP_AttrRegparmN(2)
 BX_CPU_C::system_write_word(bx_address laddr, Bit16u data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from CPL=0
@@ -687,7 +687,7 @@ BX_CPU_C::system_write_word(bx_address laddr, Bit16u data)
   void BX_CPP_AttrRegparmN(2)
 BX_CPU_C::system_write_dword(bx_address laddr, Bit32u data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from CPL=0
@@ -710,7 +710,7 @@ BX_CPU_C::system_write_dword(bx_address laddr, Bit32u data)
   void BX_CPP_AttrRegparmN(2)
 BX_CPU_C::system_write_qword(bx_address laddr, Bit64u data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from CPL=0
@@ -733,7 +733,7 @@ BX_CPU_C::system_write_qword(bx_address laddr, Bit64u data)
   Bit8u* BX_CPP_AttrRegparmN(2)
 BX_CPU_C::v2h_read_byte(bx_address laddr, bool user)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access
@@ -752,7 +752,7 @@ BX_CPU_C::v2h_read_byte(bx_address laddr, bool user)
   Bit8u* BX_CPP_AttrRegparmN(2)
 BX_CPU_C::v2h_write_byte(bx_address laddr, bool user)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf)
   {
@@ -24,12 +24,14 @@
 #define NEED_CPU_REG_SHORTCUTS 1
 #include "bochs.h"
 #include "cpu.h"
+#include "pc_system.h"
+#include "cpustats.h"
 #define LOG_THIS BX_CPU_THIS_PTR
 
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_byte(unsigned s, bx_address laddr, Bit8u data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -54,9 +56,9 @@ BX_CPU_C::write_linear_word(unsigned s, bx_address laddr, Bit16u data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -81,9 +83,9 @@ BX_CPU_C::write_linear_dword(unsigned s, bx_address laddr, Bit32u data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -108,9 +110,9 @@ BX_CPU_C::write_linear_qword(unsigned s, bx_address laddr, Bit64u data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -135,7 +137,7 @@ BX_CPU_C::write_linear_qword(unsigned s, bx_address laddr, Bit64u data)
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_xmmword(unsigned s, bx_address laddr, const BxPackedXmmRegister *data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 15);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -159,7 +161,7 @@ BX_CPU_C::write_linear_xmmword(unsigned s, bx_address laddr, const BxPackedXmmRe
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_xmmword_aligned(unsigned s, bx_address laddr, const BxPackedXmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 15);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 15);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -188,7 +190,7 @@ BX_CPU_C::write_linear_xmmword_aligned(unsigned s, bx_address laddr, const BxPac
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_ymmword(unsigned s, bx_address laddr, const BxPackedYmmRegister *data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 31);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -213,7 +215,7 @@ BX_CPU_C::write_linear_ymmword(unsigned s, bx_address laddr, const BxPackedYmmRe
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_ymmword_aligned(unsigned s, bx_address laddr, const BxPackedYmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 31);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 31);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -243,7 +245,7 @@ BX_CPU_C::write_linear_ymmword_aligned(unsigned s, bx_address laddr, const BxPac
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_zmmword(unsigned s, bx_address laddr, const BxPackedZmmRegister *data)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 63);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -268,7 +270,7 @@ BX_CPU_C::write_linear_zmmword(unsigned s, bx_address laddr, const BxPackedZmmRe
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::write_linear_zmmword_aligned(unsigned s, bx_address laddr, const BxPackedZmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 63);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 63);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -300,7 +302,7 @@ BX_CPU_C::write_linear_zmmword_aligned(unsigned s, bx_address laddr, const BxPac
   void BX_CPP_AttrRegparmN(2)
 BX_CPU_C::tickle_read_linear(unsigned s, bx_address laddr)
 {
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -338,7 +340,7 @@ BX_CPU_C::read_linear_byte(unsigned s, bx_address laddr)
 {
   Bit8u data;
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -365,9 +367,9 @@ BX_CPU_C::read_linear_word(unsigned s, bx_address laddr)
 
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -394,9 +396,9 @@ BX_CPU_C::read_linear_dword(unsigned s, bx_address laddr)
 
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -423,9 +425,9 @@ BX_CPU_C::read_linear_qword(unsigned s, bx_address laddr)
 
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -451,7 +453,7 @@ BX_CPU_C::read_linear_qword(unsigned s, bx_address laddr)
 BX_CPU_C::read_linear_xmmword(unsigned s, bx_address laddr, BxPackedXmmRegister *data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 15);
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
     if (isReadOK(tlbEntry, USER_PL)) {
@@ -472,7 +474,7 @@ BX_CPU_C::read_linear_xmmword(unsigned s, bx_address laddr, BxPackedXmmRegister
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::read_linear_xmmword_aligned(unsigned s, bx_address laddr, BxPackedXmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 15);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 15);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -500,7 +502,7 @@ BX_CPU_C::read_linear_xmmword_aligned(unsigned s, bx_address laddr, BxPackedXmmR
 BX_CPU_C::read_linear_ymmword(unsigned s, bx_address laddr, BxPackedYmmRegister *data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 31);
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
     if (isReadOK(tlbEntry, USER_PL)) {
@@ -522,7 +524,7 @@ BX_CPU_C::read_linear_ymmword(unsigned s, bx_address laddr, BxPackedYmmRegister
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::read_linear_ymmword_aligned(unsigned s, bx_address laddr, BxPackedYmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 31);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 31);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -551,7 +553,7 @@ BX_CPU_C::read_linear_ymmword_aligned(unsigned s, bx_address laddr, BxPackedYmmR
 BX_CPU_C::read_linear_zmmword(unsigned s, bx_address laddr, BxPackedZmmRegister *data)
 {
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 63);
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
     if (isReadOK(tlbEntry, USER_PL)) {
@@ -573,7 +575,7 @@ BX_CPU_C::read_linear_zmmword(unsigned s, bx_address laddr, BxPackedZmmRegister
   void BX_CPP_AttrRegparmN(3)
 BX_CPU_C::read_linear_zmmword_aligned(unsigned s, bx_address laddr, BxPackedZmmRegister *data)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 63);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 63);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
@@ -605,11 +607,84 @@ BX_CPU_C::read_linear_zmmword_aligned(unsigned s, bx_address laddr, BxPackedZmmR
 // address translation info is kept across read/write calls //
 //////////////////////////////////////////////////////////////
 
+#if BX_SUPPORT_SMP
+
+// When processors run in parallel host threads the R-M-W write is done with
+// compare-and-exchange against the value seen by the read. If another
+// processor modified the memory meanwhile the instruction is restarted.
+// Misaligned data which the host might not update atomically is compared and
+// written under the device lock instead.
+template <typename T>
+static BX_CPP_INLINE bool host_RMW_update(T *hostAddr, T old, T val)
+{
+  if (((bx_ptr_equiv_t) hostAddr & (sizeof(T) - 1)) == 0)
+    return bx_atomic_cmpxchg(hostAddr, old, val);
+
+  bx_pc_system.lock_devices();
+  bool ok = (*hostAddr == old);
+  if (ok) *hostAddr = val;
+  bx_pc_system.unlock_devices();
+  return ok;
+}
+
+// R-M-W access which has no host pointer (MMIO, ROM or data crossing page
+// boundary) holds the device lock from the read until the write.
+void BX_CPU_C::lock_RMW(void)
+{
+  if (! BX_CPU_THIS_PTR rmw_locked) {
+    bx_pc_system.lock_devices();
+    BX_CPU_THIS_PTR rmw_locked = 1;
+  }
+}
+
+void BX_CPU_C::unlock_RMW(void)
+{
+  BX_CPU_THIS_PTR rmw_locked = 0;
+  bx_pc_system.unlock_devices();
+}
+
+// The read missed the TLB but the translation loaded the TLB entry with host
+// pointer, switch to compare-and-exchange so the write is atomic against the
+// processors updating the same memory through their TLBs.
+void BX_CPU_C::RMW_use_host_ptr(bx_address laddr)
+{
+  if (BX_CPU_THIS_PTR address_xlation.pages != 1) return;
+
+  bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
+  if (tlbEntry->lpf == BX_TLB_LPFOf(laddr) && isWriteOK(tlbEntry, USER_PL)) {
+    BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) (tlbEntry->hostPageAddr | PAGE_OFFSET(laddr));
+    unlock_RMW();
+  }
+}
+
+void BX_CPU_C::restart_RMW(void)
+{
+  INC_CPU_STAT(rmwRestarts);
+
+  // restore RIP/RSP to value before the instruction
+  RIP = BX_CPU_THIS_PTR prev_rip;
+  if (BX_CPU_THIS_PTR speculative_rsp) {
+    RSP = BX_CPU_THIS_PTR prev_rsp;
+#if BX_SUPPORT_CET
+    SSP = BX_CPU_THIS_PTR prev_ssp;
+#endif
+  }
+  BX_CPU_THIS_PTR speculative_rsp = false;
+
+  // the instruction didn't complete, compensate icount increment done by
+  // the main loop after longjmp
+  BX_CPU_THIS_PTR icount--;
+
+  longjmp(BX_CPU_THIS_PTR jmp_buf_env, 1); // go back to main decode loop
+}
+
+#endif
+
   Bit8u BX_CPP_AttrRegparmN(2)
 BX_CPU_C::read_RMW_linear_byte(unsigned s, bx_address laddr)
 {
   Bit8u data;
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -620,6 +695,9 @@ BX_CPU_C::read_RMW_linear_byte(unsigned s, bx_address laddr)
       Bit8u *hostAddr = (Bit8u*) (hostPageAddr | pageOffset);
       pageWriteStampTable.decWriteStamp(pAddr, 1);
       data = *hostAddr;
+#if BX_SUPPORT_SMP
+      BX_CPU_THIS_PTR address_xlation.data_lo = data;
+#endif
       BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) hostAddr;
       BX_CPU_THIS_PTR address_xlation.paddress1 = pAddr;
 #if BX_SUPPORT_MEMTYPE
@@ -630,9 +708,18 @@ BX_CPU_C::read_RMW_linear_byte(unsigned s, bx_address laddr)
     }
   }
 
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) lock_RMW();
+#endif
+
   if (access_read_linear(laddr, 1, CPL, BX_RW, 0x0, (void *) &data) < 0)
     exception(int_number(s), 0);
 
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR address_xlation.data_lo = data;
+  if (BX_CPU_THIS_PTR rmw_locked) RMW_use_host_ptr(laddr);
+#endif
+
   return data;
 }
 
@@ -642,9 +729,9 @@ BX_CPU_C::read_RMW_linear_word(unsigned s, bx_address laddr)
   Bit16u data;
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -655,6 +742,9 @@ BX_CPU_C::read_RMW_linear_word(unsigned s, bx_address laddr)
       Bit16u *hostAddr = (Bit16u*) (hostPageAddr | pageOffset);
       pageWriteStampTable.decWriteStamp(pAddr, 2);
       data = ReadHostWordFromLittleEndian(hostAddr);
+#if BX_SUPPORT_SMP
+      BX_CPU_THIS_PTR address_xlation.data_lo = data;
+#endif
       BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) hostAddr;
       BX_CPU_THIS_PTR address_xlation.paddress1 = pAddr;
 #if BX_SUPPORT_MEMTYPE
@@ -665,9 +755,18 @@ BX_CPU_C::read_RMW_linear_word(unsigned s, bx_address laddr)
     }
   }
 
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) lock_RMW();
+#endif
+
   if (access_read_linear(laddr, 2, CPL, BX_RW, 0x1, (void *) &data) < 0)
     exception(int_number(s), 0);
 
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR address_xlation.data_lo = data;
+  if (BX_CPU_THIS_PTR rmw_locked) RMW_use_host_ptr(laddr);
+#endif
+
   return data;
 }
 
@@ -677,9 +776,9 @@ BX_CPU_C::read_RMW_linear_dword(unsigned s, bx_address laddr)
   Bit32u data;
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -690,6 +789,9 @@ BX_CPU_C::read_RMW_linear_dword(unsigned s, bx_address laddr)
       Bit32u *hostAddr = (Bit32u*) (hostPageAddr | pageOffset);
       pageWriteStampTable.decWriteStamp(pAddr, 4);
       data = ReadHostDWordFromLittleEndian(hostAddr);
+#if BX_SUPPORT_SMP
+      BX_CPU_THIS_PTR address_xlation.data_lo = data;
+#endif
       BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) hostAddr;
       BX_CPU_THIS_PTR address_xlation.paddress1 = pAddr;
 #if BX_SUPPORT_MEMTYPE
@@ -700,9 +802,18 @@ BX_CPU_C::read_RMW_linear_dword(unsigned s, bx_address laddr)
     }
   }
 
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) lock_RMW();
+#endif
+
   if (access_read_linear(laddr, 4, CPL, BX_RW, 0x3, (void *) &data) < 0)
     exception(int_number(s), 0);
 
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR address_xlation.data_lo = data;
+  if (BX_CPU_THIS_PTR rmw_locked) RMW_use_host_ptr(laddr);
+#endif
+
   return data;
 }
 
@@ -712,9 +823,9 @@ BX_CPU_C::read_RMW_linear_qword(unsigned s, bx_address laddr)
   Bit64u data;
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -725,6 +836,9 @@ BX_CPU_C::read_RMW_linear_qword(unsigned s, bx_address laddr)
       Bit64u *hostAddr = (Bit64u*) (hostPageAddr | pageOffset);
       pageWriteStampTable.decWriteStamp(pAddr, 8);
       data = ReadHostQWordFromLittleEndian(hostAddr);
+#if BX_SUPPORT_SMP
+      BX_CPU_THIS_PTR address_xlation.data_lo = data;
+#endif
       BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) hostAddr;
       BX_CPU_THIS_PTR address_xlation.paddress1 = pAddr;
 #if BX_SUPPORT_MEMTYPE
@@ -735,9 +849,18 @@ BX_CPU_C::read_RMW_linear_qword(unsigned s, bx_address laddr)
     }
   }
 
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) lock_RMW();
+#endif
+
   if (access_read_linear(laddr, 8, CPL, BX_RW, 0x7, (void *) &data) < 0)
     exception(int_number(s), 0);
 
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR address_xlation.data_lo = data;
+  if (BX_CPU_THIS_PTR rmw_locked) RMW_use_host_ptr(laddr);
+#endif
+
   return data;
 }
 
@@ -750,11 +873,20 @@ BX_CPU_C::write_RMW_linear_byte(Bit8u val8)
   if (BX_CPU_THIS_PTR address_xlation.pages > 2) {
     // Pages > 2 means it stores a host address for direct access.
     Bit8u *hostAddr = (Bit8u *) BX_CPU_THIS_PTR address_xlation.pages;
+#if BX_SUPPORT_SMP
+    if (bx_pc_system.smp_threads_running) {
+      if (! host_RMW_update(hostAddr, (Bit8u) BX_CPU_THIS_PTR address_xlation.data_lo, val8)) restart_RMW();
+    }
+    else
+#endif
     *hostAddr = val8;
   }
   else {
     // address_xlation.pages must be 1
     access_write_physical(BX_CPU_THIS_PTR address_xlation.paddress1, 1, &val8);
+#if BX_SUPPORT_SMP
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
+#endif
   }
 }
 
@@ -764,6 +896,15 @@ BX_CPU_C::write_RMW_linear_word(Bit16u val16)
   if (BX_CPU_THIS_PTR address_xlation.pages > 2) {
     // Pages > 2 means it stores a host address for direct access.
     Bit16u *hostAddr = (Bit16u *) BX_CPU_THIS_PTR address_xlation.pages;
+#if BX_SUPPORT_SMP
+    if (bx_pc_system.smp_threads_running) {
+      Bit16u old16, new16;
+      WriteHostWordToLittleEndian(&old16, (Bit16u) BX_CPU_THIS_PTR address_xlation.data_lo);
+      WriteHostWordToLittleEndian(&new16, val16);
+      if (! host_RMW_update(hostAddr, old16, new16)) restart_RMW();
+    }
+    else
+#endif
     WriteHostWordToLittleEndian(hostAddr, val16);
     BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
         BX_CPU_THIS_PTR address_xlation.paddress1, 2, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype1),
@@ -794,6 +935,9 @@ BX_CPU_C::write_RMW_linear_word(Bit16u val16)
     BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
         BX_CPU_THIS_PTR address_xlation.paddress2, 1, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype2),
         BX_WRITE, 0,  (Bit8u*) &val16);
+#endif
+#if BX_SUPPORT_SMP
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
 #endif
   }
 }
@@ -804,6 +948,15 @@ BX_CPU_C::write_RMW_linear_dword(Bit32u val32)
   if (BX_CPU_THIS_PTR address_xlation.pages > 2) {
     // Pages > 2 means it stores a host address for direct access.
     Bit32u *hostAddr = (Bit32u *) BX_CPU_THIS_PTR address_xlation.pages;
+#if BX_SUPPORT_SMP
+    if (bx_pc_system.smp_threads_running) {
+      Bit32u old32, new32;
+      WriteHostDWordToLittleEndian(&old32, (Bit32u) BX_CPU_THIS_PTR address_xlation.data_lo);
+      WriteHostDWordToLittleEndian(&new32, val32);
+      if (! host_RMW_update(hostAddr, old32, new32)) restart_RMW();
+    }
+    else
+#endif
     WriteHostDWordToLittleEndian(hostAddr, val32);
     BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
         BX_CPU_THIS_PTR address_xlation.paddress1, 4, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype1),
@@ -844,6 +997,9 @@ BX_CPU_C::write_RMW_linear_dword(Bit32u val32)
         BX_CPU_THIS_PTR address_xlation.paddress2,
         BX_CPU_THIS_PTR address_xlation.len2, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype2),
         BX_WRITE, 0, (Bit8u*) &val32);
+#endif
+#if BX_SUPPORT_SMP
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
 #endif
   }
 }
@@ -854,6 +1010,15 @@ BX_CPU_C::write_RMW_linear_qword(Bit64u val64)
   if (BX_CPU_THIS_PTR address_xlation.pages > 2) {
     // Pages > 2 means it stores a host address for direct access.
     Bit64u *hostAddr = (Bit64u *) BX_CPU_THIS_PTR address_xlation.pages;
+#if BX_SUPPORT_SMP
+    if (bx_pc_system.smp_threads_running) {
+      Bit64u old64, new64;
+      WriteHostQWordToLittleEndian(&old64, (Bit64u) BX_CPU_THIS_PTR address_xlation.data_lo);
+      WriteHostQWordToLittleEndian(&new64, val64);
+      if (! host_RMW_update(hostAddr, old64, new64)) restart_RMW();
+    }
+    else
+#endif
     WriteHostQWordToLittleEndian(hostAddr, val64);
     BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
         BX_CPU_THIS_PTR address_xlation.paddress1, 8, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype1),
@@ -894,6 +1059,9 @@ BX_CPU_C::write_RMW_linear_qword(Bit64u val64)
         BX_CPU_THIS_PTR address_xlation.paddress2,
         BX_CPU_THIS_PTR address_xlation.len2, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype2),
         BX_WRITE, 0, (Bit8u*) &val64);
+#endif
+#if BX_SUPPORT_SMP
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
 #endif
   }
 }
@@ -902,7 +1070,7 @@ BX_CPU_C::write_RMW_linear_qword(Bit64u val64)
 
 void BX_CPU_C::read_RMW_linear_dqword_aligned_64(unsigned s, bx_address laddr, Bit64u *hi, Bit64u *lo)
 {
-  bx_address lpf = AlignedAccessLPFOf(laddr, 15);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 15);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -914,6 +1082,10 @@ void BX_CPU_C::read_RMW_linear_dqword_aligned_64(unsigned s, bx_address laddr, B
       pageWriteStampTable.decWriteStamp(pAddr, 16);
       *lo = ReadHostQWordFromLittleEndian(hostAddr);
       *hi = ReadHostQWordFromLittleEndian(hostAddr + 1);
+#if BX_SUPPORT_SMP
+      BX_CPU_THIS_PTR address_xlation.data_lo = *lo;
+      BX_CPU_THIS_PTR address_xlation.data_hi = *hi;
+#endif
       BX_CPU_THIS_PTR address_xlation.pages = (bx_ptr_equiv_t) hostAddr;
       BX_CPU_THIS_PTR address_xlation.paddress1 = pAddr;
 #if BX_SUPPORT_MEMTYPE
@@ -930,16 +1102,62 @@ void BX_CPU_C::read_RMW_linear_dqword_aligned_64(unsigned s, bx_address laddr, B
     exception(BX_GP_EXCEPTION, 0);
   }
 
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) lock_RMW();
+#endif
+
   BxPackedXmmRegister data;
   if (access_read_linear(laddr, 16, CPL, BX_RW, 0x0, (void *) &data) < 0)
     exception(int_number(s), 0);
 
   *lo = data.xmm64u(0);
   *hi = data.xmm64u(1);
+
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR address_xlation.data_lo = *lo;
+  BX_CPU_THIS_PTR address_xlation.data_hi = *hi;
+  if (BX_CPU_THIS_PTR rmw_locked) RMW_use_host_ptr(laddr);
+#endif
 }
 
 void BX_CPU_C::write_RMW_linear_dqword(Bit64u hi, Bit64u lo)
 {
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running) {
+    if (BX_CPU_THIS_PTR address_xlation.pages > 2) {
+      // Pages > 2 means it stores a host address for direct access
+      Bit64u *hostAddr = (Bit64u *) BX_CPU_THIS_PTR address_xlation.pages;
+      Bit64u old_lo, old_hi, new_lo, new_hi;
+      WriteHostQWordToLittleEndian(&old_lo, BX_CPU_THIS_PTR address_xlation.data_lo);
+      WriteHostQWordToLittleEndian(&old_hi, BX_CPU_THIS_PTR address_xlation.data_hi);
+      WriteHostQWordToLittleEndian(&new_lo, lo);
+      WriteHostQWordToLittleEndian(&new_hi, hi);
+#if BX_HAVE_ATOMIC_CMPXCHG128
+      if (! bx_atomic_cmpxchg128(hostAddr, old_hi, old_lo, new_hi, new_lo)) restart_RMW();
+#else
+      bx_pc_system.lock_devices();
+      bool modified = (hostAddr[0] != old_lo || hostAddr[1] != old_hi);
+      if (! modified) {
+        hostAddr[0] = new_lo;
+        hostAddr[1] = new_hi;
+      }
+      bx_pc_system.unlock_devices();
+      if (modified) restart_RMW();
+#endif
+      BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
+          BX_CPU_THIS_PTR address_xlation.paddress1, 8, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype1),
+          BX_WRITE, 0, (Bit8u*) &lo);
+      BX_DBG_PHY_MEMORY_ACCESS(BX_CPU_ID,
+          BX_CPU_THIS_PTR address_xlation.paddress1 + 8, 8, MEMTYPE(BX_CPU_THIS_PTR address_xlation.memtype1),
+          BX_WRITE, 0, (Bit8u*) &hi);
+      return;
+    }
+  }
+  // keep the device lock until both halves are written
+  bool locked = BX_CPU_THIS_PTR rmw_locked;
+  BX_CPU_THIS_PTR rmw_locked = 0;
+#endif
+
   write_RMW_linear_qword(lo);
 
   BX_CPU_THIS_PTR address_xlation.paddress1 += 8;
@@ -952,6 +1170,13 @@ void BX_CPU_C::write_RMW_linear_dqword(Bit64u hi, Bit64u lo)
   }
 
   write_RMW_linear_qword(hi);
+
+#if BX_SUPPORT_SMP
+  if (locked) {
+    BX_CPU_THIS_PTR rmw_locked = 1;
+    unlock_RMW();
+  }
+#endif
 }
 
 #endif
@@ -966,9 +1191,9 @@ void BX_CPU_C::write_new_stack_word(bx_address laddr, unsigned curr_pl, Bit16u d
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 1);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (1 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -993,9 +1218,9 @@ void BX_CPU_C::write_new_stack_dword(bx_address laddr, unsigned curr_pl, Bit32u
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (3 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -1020,9 +1245,9 @@ void BX_CPU_C::write_new_stack_qword(bx_address laddr, unsigned curr_pl, Bit64u
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 7);
 #if BX_SUPPORT_ALIGNMENT_CHECK && BX_CPU_LEVEL >= 4
-  bx_address lpf = AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, (7 & BX_CPU_THIS_PTR alignment_check_mask));
 #else
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 #endif
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -1130,7 +1355,7 @@ Bit32u BX_CPP_AttrRegparmN(2) BX_CPU_C::shadow_stack_read_dword(bx_address offse
 
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(offset, 3);
-  bx_address lpf = AlignedAccessLPFOf(offset, 3);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(offset, 3);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
     if (isShadowStackReadOK(tlbEntry, user)) {
@@ -1155,7 +1380,7 @@ Bit64u BX_CPP_AttrRegparmN(2) BX_CPU_C::shadow_stack_read_qword(bx_address offse
 
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(offset, 7);
-  bx_address lpf = AlignedAccessLPFOf(offset, 7);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(offset, 7);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us read access from this CPL
     if (isShadowStackReadOK(tlbEntry, user)) {
@@ -1178,7 +1403,7 @@ void BX_CPP_AttrRegparmN(3) BX_CPU_C::shadow_stack_write_dword(bx_address offset
 {
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(offset, 3);
-  bx_address lpf = AlignedAccessLPFOf(offset, 3);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(offset, 3);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
     if (isShadowStackWriteOK(tlbEntry, user)) {
@@ -1201,7 +1426,7 @@ void BX_CPP_AttrRegparmN(3) BX_CPU_C::shadow_stack_write_qword(bx_address offset
 {
   bool user = (curr_pl == 3);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(offset, 7);
-  bx_address lpf = AlignedAccessLPFOf(offset, 7);
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(offset, 7);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
     if (isShadowStackWriteOK(tlbEntry, user)) {
@@ -39,6 +39,8 @@ extern bool simulate_xapic;
 const unsigned BX_LAPIC_FIRST_VECTOR = 0x10;
 const unsigned BX_LAPIC_LAST_VECTOR  = 0xff;
 
+Bit32u apic_ipi_count = 0;
+
 ///////////// APIC BUS /////////////
 
 bool apic_bus_deliver_interrupt(Bit8u vector, apic_dest_t dest, Bit8u delivery_mode, bool logical_dest, bool level, bool trig_mode)
@@ -660,6 +662,8 @@ void bx_local_apic_c::send_ipi(apic_dest_t dest, Bit32u lo_cmd)
   int vector = (lo_cmd & 0xff);
   bool accepted = false;
 
+  apic_ipi_count++;
+
   if(delivery_mode == APIC_DM_INIT)
   {
     if(level == 0 && trig_mode == 1) {
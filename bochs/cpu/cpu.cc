@@ -49,8 +49,6 @@
 
 #endif
 
-jmp_buf BX_CPU_C::jmp_buf_env;
-
 #if BX_DEBUGGER
 void BX_CPU_C::cpu_loop_debugger(void)
 {
@@ -293,6 +291,44 @@ void BX_CPU_C::cpu_run_trace(void)
 #endif // BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
 }
 
+// Used when each processor runs in its own host thread: execute traces until
+// the processor consumes its quantum or gets halted. The caller synchronizes
+// emulated time with other processors at quantum boundary.
+void BX_CPU_C::cpu_run_quantum(Bit32u quantum)
+{
+  if (setjmp(BX_CPU_THIS_PTR jmp_buf_env)) {
+    // can get here only from exception function, VMEXIT or R-M-W restart
+    BX_CPU_THIS_PTR icount++;
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
+  }
+
+  while (! bx_pc_system.kill_bochs_request) {
+    // code modified by another processor
+    if (BX_CPU_THIS_PTR smc_pending_count)
+      handle_pending_smc();
+
+    // startup IPI sent by another processor
+    if (BX_CPU_THIS_PTR sipi_pending)
+      handle_pending_sipi();
+
+    // async_event could be cleared by this thread right after an event was
+    // signalled from another host thread, don't lose the event
+    if (unmasked_events_pending())
+      BX_CPU_THIS_PTR async_event |= 1;
+
+    Bit64u icount = BX_CPU_THIS_PTR icount;
+    cpu_run_trace();
+
+    // R-M-W read without the matching write (e.g. ENTER stack probe)
+    if (BX_CPU_THIS_PTR rmw_locked) unlock_RMW();
+    if (BX_CPU_THIS_PTR icount == icount)
+      break; // the CPU is halted
+
+    if ((Bit32u)(BX_CPU_THIS_PTR icount - BX_CPU_THIS_PTR icount_last_sync) >= quantum)
+      break;
+  }
+}
+
 #endif
 
 #include "decoder/ia_opcodes.h"
@@ -306,7 +342,7 @@ bxICacheEntry_c* BX_CPU_C::getICacheEntry(void)
     eipBiased = RIP + BX_CPU_THIS_PTR eipPageBias;
   }
 
-  INC_ICACHE_STAT(iCacheLookups);
+  INC_CPU_STAT(iCacheLookups);
 
   bx_phy_address pAddr = BX_CPU_THIS_PTR pAddrFetchPage + eipBiased;
   bxICacheEntry_c *entry = BX_CPU_THIS_PTR iCache.find_entry(pAddr, BX_CPU_THIS_PTR fetchModeMask);
@@ -315,7 +351,7 @@ bxICacheEntry_c* BX_CPU_C::getICacheEntry(void)
   {
     // iCache miss. No validated instruction with matching fetch parameters
     // is in the iCache.
-    INC_ICACHE_STAT(iCacheMisses);
+    INC_CPU_STAT(iCacheMisses);
     entry = serveICacheMiss((Bit32u) eipBiased, pAddr);
   }
 
@@ -331,6 +367,8 @@ bxICacheEntry_c* BX_CPU_C::getICacheEntry(void)
   }
 #endif
 
+  BX_PROFILE_TRACE_ENTRY(entry);
+
   return entry;
 }
 
@@ -356,6 +394,7 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::linkTrace(bxInstruction_c *i)
   static Bit32u linkDepth = 0;
 
   if (BX_CPU_THIS_PTR async_event || ++linkDepth > BX_HANDLERS_CHAINING_MAX_LINK_DEPTH) {
+    INC_CPU_STAT(traceLinkBreaks);
     linkDepth = 0;
     return;
   }
@@ -364,12 +403,14 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::linkTrace(bxInstruction_c *i)
 
   size_t stack_depth = BX_CPU_THIS_PTR cpuloop_stack_anchor - &stack_anchor;
   if (stack_depth > BX_HANDLERS_CHAINING_MAX_STACK_DEPTH) {
+    INC_CPU_STAT(traceLinkBreaks);
     linkDepth = 0;
     return;
   }
 
   Bit32u delta = (Bit32u) (BX_CPU_THIS_PTR icount - BX_CPU_THIS_PTR icount_last_sync);
   if(delta >= bx_pc_system.getNumCpuTicksLeftNextEvent()) {
+    INC_CPU_STAT(traceLinkBreaks);
     linkDepth = 0;
     return;
   }
@@ -378,6 +419,8 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::linkTrace(bxInstruction_c *i)
 
   bxInstruction_c *next = i->getNextTrace(BX_CPU_THIS_PTR iCache.traceLinkTimeStamp);
   if (next) {
+    INC_CPU_STAT(traceLinks);
+    BX_PROFILE_TRACE_ENTRY(NULL);
     BX_EXECUTE_INSTRUCTION(next);
     return;
   }
@@ -388,17 +431,22 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::linkTrace(bxInstruction_c *i)
     eipBiased = RIP + BX_CPU_THIS_PTR eipPageBias;
   }
 
-  INC_ICACHE_STAT(iCacheLookups);
+  INC_CPU_STAT(iCacheLookups);
 
   bx_phy_address pAddr = BX_CPU_THIS_PTR pAddrFetchPage + eipBiased;
   bxICacheEntry_c *entry = BX_CPU_THIS_PTR iCache.find_entry(pAddr, BX_CPU_THIS_PTR fetchModeMask);
 
   if (entry != NULL) // link traces - handle only hit cases
   {
+    INC_CPU_STAT(traceLinks);
     i->setNextTrace(entry->i, BX_CPU_THIS_PTR iCache.traceLinkTimeStamp);
     i = entry->i;
+    BX_PROFILE_TRACE_ENTRY(entry);
     BX_EXECUTE_INSTRUCTION(i);
   }
+  else {
+    INC_CPU_STAT(traceLinkMisses);
+  }
 }
 
 #endif
@@ -629,7 +677,7 @@ void BX_CPU_C::prefetch(void)
   bx_address laddr;
   unsigned pageOffset;
 
-  INC_ICACHE_STAT(iCachePrefetch);
+  INC_CPU_STAT(iCachePrefetch);
 
 #if BX_SUPPORT_X86_64
   if (long64_mode()) {
@@ -705,7 +753,7 @@ void BX_CPU_C::prefetch(void)
 
   BX_CPU_THIS_PTR clear_RF();
 
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_ITLB_ENTRY_OF(laddr);
   Bit8u *fetchPtr = 0;
 
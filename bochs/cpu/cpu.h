@@ -28,6 +28,10 @@
 
 #include "instrument.h"
 
+#if BX_SUPPORT_SMP
+#include "bxthread.h"
+#endif
+
 const Bit64u BX_PHY_ADDRESS_MASK = ((((Bit64u)(1)) << BX_PHY_ADDRESS_WIDTH) - 1);
 
 const Bit64u BX_PHY_ADDRESS_RESERVED_BITS = (~BX_PHY_ADDRESS_MASK);
@@ -464,6 +468,9 @@ typedef void (BX_CPU_C::*BxRepIterationPtr_tR)(bxInstruction_c *) BX_CPP_AttrReg
 #if BX_SUPPORT_SMP
 // multiprocessor simulation, we need an array of cpus and memories
 BOCHSAPI extern BX_CPU_C **bx_cpu_array;
+// processor simulated by the current host thread when each processor runs
+// in its own host thread, NULL otherwise
+extern thread_local BX_CPU_C *bx_smp_thread_cpu;
 #else
 // single processor simulation, so there's one of everything
 BOCHSAPI extern BX_CPU_C   bx_cpu;
@@ -699,6 +706,7 @@ typedef struct
 #include "lazy_flags.h"
 #include "tlb.h"
 #include "icache.h"
+#include "cpustats.h"
 
 // general purpose register
 #if BX_SUPPORT_X86_64
@@ -887,7 +895,6 @@ typedef enum dbg_show_flags_t {
 
 struct BX_SMM_State;
 struct BxOpcodeInfo_t;
-struct bx_cpu_statistics;
 class bx_cpuid_t;
 
 class BOCHSAPI BX_CPU_C : public logfunctions {
@@ -1185,13 +1192,24 @@ public: // for now...
   Bit32u  event_mask;
   Bit32u  async_event; // keep 32-bit because of BX_ASYNC_EVENT_STOP_TRACE
 
+  // Devices and other processors could signal events from another host
+  // thread, so the pending event bits are updated atomically.
   BX_SMF BX_CPP_INLINE void signal_event(Bit32u event) {
+#if BX_SUPPORT_SMP
+    bx_atomic_or32(&BX_CPU_THIS_PTR pending_event, event);
+    if (! is_masked_event(event)) bx_atomic_store32(&BX_CPU_THIS_PTR async_event, 1);
+#else
     BX_CPU_THIS_PTR pending_event |= event;
     if (! is_masked_event(event)) BX_CPU_THIS_PTR async_event = 1;
+#endif
   }
 
   BX_SMF BX_CPP_INLINE void clear_event(Bit32u event) {
+#if BX_SUPPORT_SMP
+    bx_atomic_and32(&BX_CPU_THIS_PTR pending_event, ~event);
+#else
     BX_CPU_THIS_PTR pending_event &= ~event;
+#endif
   }
 
   BX_SMF BX_CPP_INLINE void mask_event(Bit32u event) {
@@ -1218,6 +1236,11 @@ public: // for now...
   }
 
 #define BX_ASYNC_EVENT_STOP_TRACE (1<<31)
+#if BX_SUPPORT_JIT
+// set while compiled trace calls instruction handler, makes the handler
+// return to the compiled code instead of executing the next instruction
+#define BX_ASYNC_EVENT_JIT_CALL   (1<<30)
+#endif
 
   bool  in_smm;
   unsigned cpu_mode;
@@ -1253,7 +1276,7 @@ public: // for now...
   BX_SMF bool get_amx_ok();
 
   // for exceptions
-  static jmp_buf jmp_buf_env;
+  jmp_buf jmp_buf_env;
   unsigned last_exception_type;
 
 #if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
@@ -1282,8 +1305,8 @@ public: // for now...
   unsigned alignment_check_mask;
 #endif
 
-  // statistics
-  bx_cpu_statistics *stats;
+  // statistics, in their own cache line
+  bx_cpu_statistics stats BX_CPP_AlignN(64);
 
 #if BX_DEBUGGER
   bx_phy_address watchpoint;
@@ -1328,18 +1351,93 @@ public: // for now...
   TLB<BX_DTLB_SIZE> DTLB BX_CPP_AlignN(32);
   TLB<BX_ITLB_SIZE> ITLB BX_CPP_AlignN(32);
 
+#define BX_STLB_SETS 1024
+#define BX_STLB_WAYS 4
+  SecondLevelTLB<BX_STLB_SETS, BX_STLB_WAYS> STLB;
+
+  // TLB contexts by tag and the tag of the current context in the lpf position
+  struct {
+    Bit64u key;       // PCID | VPID/ASID << 12, BX_TLB_NO_CONTEXT if the tag is free
+    Bit64u serial;    // serial number of the context, identifies it in the second level TLB
+    Bit32u epoch;     // global TLB flush epoch the context was created in
+    bool live;        // false if the context was flushed
+  } tlb_context[BX_TLB_CONTEXTS];
+  bx_address tlb_context_tag;
+  Bit32u tlb_global_epoch;
+  unsigned tlb_context_next;
+  Bit64u tlb_context_serial;
+
 #if BX_CPU_LEVEL >= 6
   struct {
     Bit64u entry[4];
   } PDPTR_CACHE;
 #endif
 
+#if BX_SUPPORT_X86_64
+  PagingStructureCache PSC;
+#endif
+#if (BX_SUPPORT_VMX >= 2) || BX_SUPPORT_SVM
+  NestedWalkCache nestedWalkCache;
+#endif
+
   // An instruction cache.  Each entry should be exactly 32 bytes, and
   // this structure should be aligned on a 32-byte boundary to be friendly
   // with the host cache lines.
   bxICache_c iCache BX_CPP_AlignN(32);
   Bit32u fetchModeMask;
 
+#if BX_SUPPORT_SUPERBLOCKS
+  // Superblock side exit profile, indexed by branch linear address. Taking
+  // the side exit increases the counter, following the predicted path
+  // decreases it. Branches with the counter over the threshold are not
+  // followed when building new traces.
+#define BX_SUPERBLOCK_PROFILE_SIZE 4096 /* must be power of two */
+#define BX_SUPERBLOCK_PROFILE_HASH(rip) \
+  ((Bit32u)((rip) ^ ((rip) >> 12)) & (BX_SUPERBLOCK_PROFILE_SIZE-1))
+#define BX_SUPERBLOCK_EXIT_PENALTY   4
+#define BX_SUPERBLOCK_EXIT_THRESHOLD 32
+  Bit8u superblock_exits[BX_SUPERBLOCK_PROFILE_SIZE];
+  bool superblocks;
+#endif
+
+#if BX_SUPPORT_JIT
+  // Host code buffer of the JIT. When the buffer is full all compiled
+  // traces are reverted to interpretation and compiled again when hot.
+  Bit8u *jit_code_buffer;
+  Bit8u *jit_code_ptr;
+  bool jit;
+#endif
+
+  // Sampling profiler: trace entries left until the next sample and the
+  // table of the samples, allocated when the first sample is taken.
+  Bit32u profile_countdown;
+  class bxProfile_c *profile;
+
+#if BX_SUPPORT_SMP
+  // Self modifying code events posted by other processors running in
+  // parallel host threads. Handled before the next trace is executed,
+  // too many pending events cause the whole trace cache flush.
+#define BX_SMC_PENDING_ENTRIES 16
+  struct {
+    bx_phy_address pAddr;
+    Bit32u mask;
+  } smc_pending[BX_SMC_PENDING_ENTRIES];
+  volatile unsigned smc_pending_count;
+
+  // Startup IPI posted by a processor running in another host thread,
+  // the vector with BX_SIPI_PENDING flag set.
+#define BX_SIPI_PENDING 0x100
+  volatile unsigned sipi_pending;
+
+  // Set while R-M-W instruction accessing memory without host pointer holds
+  // the device lock between the read and the write.
+  bool rmw_locked;
+
+  // set by PAUSE instruction, hint for SMP scheduler that the processor
+  // is spinning in a wait loop
+  bool spin_wait_hint;
+#endif
+
   struct {
     bx_address rm_addr;       // The address offset after resolution
     bx_phy_address paddress1; // physical address after translation of 1st len1 bytes of data
@@ -1357,6 +1455,11 @@ public: // for now...
 #if BX_SUPPORT_MEMTYPE
     BxMemtype memtype1;       // memory type of the page 1
     BxMemtype memtype2;       // memory type of the page 2
+#endif
+#if BX_SUPPORT_SMP
+    Bit64u data_lo;           // memory contents seen by R-M-W read, the write
+    Bit64u data_hi;           // is compare-and-exchange against these values
+                              // when processors run in parallel host threads
 #endif
   } address_xlation;
 
@@ -4417,6 +4520,20 @@ public: // for now...
   BX_SMF void BxError(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
 #if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
   BX_SMF void BxEndTrace(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+#endif
+#if BX_SUPPORT_JIT
+  BX_SMF void BxJitProfile(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+  BX_SMF void BxJitBlock(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+#endif
+#if BX_SUPPORT_SUPERBLOCKS
+  BX_SMF void BxSuperblockJMP_Jw(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+  BX_SMF void BxSuperblockJMP_Jd(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+  BX_SMF void BxSuperblockJcc_Jw(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+  BX_SMF void BxSuperblockJcc_Jd(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+#if BX_SUPPORT_X86_64
+  BX_SMF void BxSuperblockJMP_Jq(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+  BX_SMF void BxSuperblockJcc_Jq(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
+#endif
 #endif
 
   BX_SMF void BxNoFPU(bxInstruction_c *) BX_CPP_AttrRegparmN(1);
@@ -4472,6 +4589,7 @@ public: // for now...
   BX_SMF bool dbg_translate_guest_physical_npt(bx_phy_address guest_paddr, bx_phy_address *phy, bool verbose = 0);
 #endif
 #if BX_LARGE_RAMFILE
+  BX_SMF bool TLB_isLiveEntry(const bx_TLB_entry *tlbEntry);
   BX_SMF bool check_addr_in_tlb_buffers(const Bit8u *addr, const Bit8u *end);
 #endif
   BX_SMF void atexit(void);
@@ -4483,9 +4601,21 @@ public: // for now...
 #endif
 #if BX_SUPPORT_SMP
   BX_SMF void cpu_run_trace(void);
+  BX_SMF void cpu_run_quantum(Bit32u quantum);
+  BX_SMF void post_smc(bx_phy_address pAddr, Bit32u mask);
+  BX_SMF void handle_pending_smc(void);
+  BX_SMF void handle_pending_sipi(void);
+  BX_SMF void lock_RMW(void);
+  BX_SMF void unlock_RMW(void);
+  BX_SMF void RMW_use_host_ptr(bx_address laddr);
+  BX_SMF void restart_RMW(void) BX_CPP_AttrNoReturn();
 #endif
   BX_SMF bool handleAsyncEvent(void);
   BX_SMF bool handleWaitForEvent(void);
+  BX_SMF bool is_wakeup_event_pending(void);
+#if BX_SUPPORT_SMP
+  BX_SMF bool is_idle(void);
+#endif
   BX_SMF void HandleExtInterrupt(void);
   BX_SMF Bit8u interrupt_acknowledge(void);
 
@@ -4493,9 +4623,32 @@ public: // for now...
 
   BX_SMF bxICacheEntry_c *serveICacheMiss(Bit32u eipBiased, bx_phy_address pAddr);
   BX_SMF bxICacheEntry_c* getICacheEntry(void);
+  BX_SMF void profileSample(bxICacheEntry_c *entry);
+  BX_SMF unsigned profileUnwind(bx_address *stack, unsigned max_depth);
+  BX_SMF bool profileReadStack(bx_address laddr, unsigned len, Bit8u *data);
   BX_SMF bool mergeTraces(bxICacheEntry_c *entry, bxInstruction_c *i, bx_phy_address pAddr);
+  BX_SMF bool fetchTraceFromFile(bxICacheEntry_c *entry, bxInstruction_c *i, bx_phy_address pAddr, unsigned maxlen);
+  BX_SMF unsigned savedTraceLength(const bxInstruction_c *i, unsigned tlen, bx_phy_address pAddr, Bit32u fetchModeMask);
 #if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS && BX_ENABLE_TRACE_LINKING
   BX_SMF void linkTrace(bxInstruction_c *i) BX_CPP_AttrRegparmN(1);
+#endif
+#if BX_SUPPORT_SUPERBLOCKS
+  BX_SMF bool superblockFollowBranch(bxInstruction_c *i, bx_address rip, bx_address *target);
+  BX_SMF void superblockSideExit(void);
+  BX_SMF BX_CPP_INLINE void superblockHit(void) {
+    Bit8u *exits = &BX_CPU_THIS_PTR superblock_exits[BX_SUPERBLOCK_PROFILE_HASH(BX_CPU_THIS_PTR prev_rip)];
+    if (*exits) (*exits)--;
+  }
+  BX_SMF BX_CPP_INLINE bool jcc_condition(unsigned cond);
+#endif
+#if BX_SUPPORT_JIT
+  BX_SMF void jitInit(void);
+  BX_SMF void jitCompile(bxInstruction_c *i);
+  BX_SMF void jitReset(void);
+  BX_SMF void jitFree(void);
+  BX_SMF BX_CPP_INLINE bool isJitHeader(const bxInstruction_c *i) {
+    return i->execute1 == &BX_CPU_C::BxJitProfile || i->execute1 == &BX_CPU_C::BxJitBlock;
+  }
 #endif
   BX_SMF void prefetch(void);
   BX_SMF void updateFetchModeMask(void);
@@ -4760,6 +4913,21 @@ public: // for now...
   BX_SMF void TLB_flushNonGlobal(void);
 #endif
   BX_SMF void TLB_flush(void);
+  BX_SMF void TLB_flushWritable(bx_phy_address start, bx_phy_address end);
+  BX_SMF Bit64u TLB_contextKey(Bit32u pcid);
+  BX_SMF Bit32u TLB_currentPCID(void);
+  BX_SMF void TLB_resetContexts(void);
+  BX_SMF void TLB_updateContextKey(void);
+  BX_SMF unsigned TLB_findContext(Bit64u key);
+  BX_SMF unsigned TLB_allocContext(Bit64u key);
+  BX_SMF void TLB_selectContext(unsigned n);
+  BX_SMF void TLB_flushContexts(bool global);
+  BX_SMF bool TLB_isValidGlobal(const bx_TLB_entry *tlbEntry);
+#if BX_CPU_LEVEL >= 6
+  BX_SMF void TLB_switchContext(bool noflush);
+  BX_SMF void TLB_flushPCID(Bit32u pcid);
+  BX_SMF void TLB_invlpgPCID(bx_address laddr, Bit32u pcid);
+#endif
   BX_SMF void TLB_invlpg(bx_address laddr);
   BX_SMF void inhibit_interrupts(unsigned mask);
   BX_SMF bool interrupts_inhibited(unsigned mask);
@@ -4779,7 +4947,7 @@ public: // for now...
 
   BX_SMF bool SetCR0(bxInstruction_c *i, bx_address val);
   BX_SMF bool check_CR0(bx_address val) BX_CPP_AttrRegparmN(1);
-  BX_SMF bool SetCR3(bx_address val) BX_CPP_AttrRegparmN(1);
+  BX_SMF bool SetCR3(bx_address val, bool noflush = false) BX_CPP_AttrRegparmN(2);
 #if BX_CPU_LEVEL >= 5
   BX_SMF bool SetCR4(bxInstruction_c *i, bx_address val);
   BX_SMF bool check_CR4(bx_address val) BX_CPP_AttrRegparmN(1);
@@ -5486,6 +5654,30 @@ BX_CPP_INLINE void BX_CPU_C::set_amx_ok() { BX_CPU_THIS_PTR cpu_state_use_ok |=
 BX_CPP_INLINE void BX_CPU_C::clear_amx_ok() { BX_CPU_THIS_PTR cpu_state_use_ok &= ~BX_FETCH_MODE_AMX_OK; }
 BX_CPP_INLINE bool BX_CPU_C::get_amx_ok() { return (BX_CPU_THIS_PTR cpu_state_use_ok & BX_FETCH_MODE_AMX_OK); }
 
+#if BX_SUPPORT_SUPERBLOCKS
+
+// evaluate Jcc condition (encoded as in the low nibble of Jcc opcode)
+BX_CPP_INLINE bool BX_CPU_C::jcc_condition(unsigned cond)
+{
+  bool taken;
+
+  switch(cond >> 1) {
+    case 0: taken = get_OF(); break;
+    case 1: taken = get_CF(); break;
+    case 2: taken = get_ZF(); break;
+    case 3: taken = get_CF() || get_ZF(); break;
+    case 4: taken = get_SF(); break;
+    case 5: taken = get_PF(); break;
+    case 6: taken = getB_SF() != getB_OF(); break;
+    default:
+      taken = get_ZF() || (getB_SF() != getB_OF()); break;
+  }
+
+  return taken ^ (cond & 1);
+}
+
+#endif
+
 //
 // updateFetchModeMask - has to be called everytime
 //   CS.L / CS.D_B / CR0.PE, CR0.TS or CR0.EM / CR4.OSFXSR / CR4.OSXSAVE changes
@@ -5878,6 +6070,12 @@ enum {
 
 class bxInstruction_c;
 
+// count the trace entry for the sampling profiler
+#define BX_PROFILE_TRACE_ENTRY(entry) {                \
+  if (--BX_CPU_THIS_PTR profile_countdown == 0)        \
+    BX_CPU_THIS_PTR profileSample(entry);              \
+}
+
 #if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
 
 #define BX_COMMIT_INSTRUCTION(i) {                     \
@@ -24,14 +24,11 @@
 #ifndef BX_CPUSTATS_H
 #define BX_CPUSTATS_H
 
-#define InstrumentICACHE 0
-#define InstrumentTLB 0
-#define InstrumentTLBFlush 0
-#define InstrumentStackPrefetch 0
-#define InstrumentSMC 0
-
-// indicate if any of the CPU statistics was compiled in
-#define InstrumentCPU (InstrumentICACHE + InstrumentTLB + InstrumentTLBFlush + InstrumentStackPrefetch + InstrumentSMC)
+// The CPU statistics are always compiled in (when statistics collection is
+// enabled in configure) and counted by every processor into its own cache
+// line aligned block. The counters are exported to the statistics tree and
+// dumped periodically only when enabled at runtime with the 'statistics'
+// option.
 
 struct bx_cpu_statistics
 {
@@ -39,6 +36,16 @@ struct bx_cpu_statistics
   Bit64u iCacheLookups;
   Bit64u iCachePrefetch;
   Bit64u iCacheMisses;
+  Bit64u iCacheSuperblockBranches;
+  Bit64u iCacheSideExitRebuilds;
+  Bit64u iCacheJitTraces;
+  Bit64u iCacheJitResets;
+  Bit64u iCacheFileTraces;
+
+  // trace linking statistics
+  Bit64u traceLinks;
+  Bit64u traceLinkMisses;
+  Bit64u traceLinkBreaks;
 
   // tlb lookup statistics
   Bit64u tlbLookups;
@@ -47,10 +54,21 @@ struct bx_cpu_statistics
   Bit64u tlbMisses;
   Bit64u tlbExecuteMisses;
   Bit64u tlbWriteMisses;
+  Bit64u stlbHits;
+  Bit64u stlbMisses;
+  Bit64u tlbWalkCacheHits;
+  Bit64u tlbNestedWalkCacheHits;
+
+  // page walk statistics
+  Bit64u pageWalks;
+  Bit64u nestedPageWalks;
 
   // tlb flush statistics
   Bit64u tlbGlobalFlushes;
   Bit64u tlbNonGlobalFlushes;
+  Bit64u tlbContextSwitches;
+  Bit64u tlbContextFlushes;
+  Bit64u tlbContextReclaims;
 
   // stack prefetch statistics
   Bit64u stackPrefetch;
@@ -58,45 +76,19 @@ struct bx_cpu_statistics
   // self modifying code statistics
   Bit64u smc;
 
-  bx_cpu_statistics():
-      iCacheLookups(0), iCachePrefetch(0), iCacheMisses(0),
-      tlbLookups(0), tlbExecuteLookups(0), tlbWriteLookups(0),
-      tlbMisses(0), tlbExecuteMisses(0), tlbWriteMisses(0),
-      tlbGlobalFlushes(0), tlbNonGlobalFlushes(0),
-      stackPrefetch(0), smc(0) {}
+  // locked R-M-W instructions restarted because another processor running
+  // in parallel host thread modified the memory
+  Bit64u rmwRestarts;
 
-};
+  // exits from the cpu loop to handle asynchronous events
+  Bit64u asyncEvents;
 
-#define INC_CPU_STAT(stat) INC_STAT(BX_CPU_THIS_PTR stats -> stat)
+  // exceptions by vector
+  Bit64u exceptions[BX_CPU_HANDLED_EXCEPTIONS];
 
-#if InstrumentICACHE
-  #define INC_ICACHE_STAT(stat) INC_CPU_STAT(stat)
-#else
-  #define INC_ICACHE_STAT(stat)
-#endif
-
-#if InstrumentTLBFlush
-  #define INC_TLBFLUSH_STAT(stat) INC_CPU_STAT(stat)
-#else
-  #define INC_TLBFLUSH_STAT(stat)
-#endif
-
-#if InstrumentTLB
-  #define INC_TLB_STAT(stat) INC_CPU_STAT(stat)
-#else
-  #define INC_TLB_STAT(stat)
-#endif
-
-#if InstrumentStackPrefetch
-  #define INC_STACK_PREFETCH_STAT(stat) INC_CPU_STAT(stat)
-#else
-  #define INC_STACK_PREFETCH_STAT(stat)
-#endif
+  bx_cpu_statistics() { memset(this, 0, sizeof(bx_cpu_statistics)); }
+};
 
-#if InstrumentSMC
-  #define INC_SMC_STAT(stat) INC_CPU_STAT(stat)
-#else
-  #define INC_SMC_STAT(stat)
-#endif
+#define INC_CPU_STAT(stat) INC_STAT(BX_CPU_THIS_PTR stats.stat)
 
 #endif
@@ -717,12 +717,14 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::MOV_CR3Rq(bxInstruction_c *i)
 #endif
 
   // allow bit 63 (hint that TLB doesn't need to be cleared) to be set when
-  // PCIDE is set, but ignore the hint if given
+  // PCIDE is set, the non-global translations of the PCID are kept then
+  bool noflush = false;
   if (BX_CPU_THIS_PTR cr4.get_PCIDE()) {
+    noflush = (val_64 >> 63) != 0;
     val_64 &= ~(BX_CONST64(1)<<63);
   }
 
-  if (! SetCR3(val_64))
+  if (! SetCR3(val_64, noflush))
     exception(BX_GP_EXCEPTION, 0);
 
   BX_INSTR_TLB_CNTRL(BX_CPU_ID, BX_INSTR_MOV_CR3, val_64);
@@ -1420,7 +1422,7 @@ bool BX_CPU_C::SetCR4(bxInstruction_c *i, bx_address val)
 }
 #endif // BX_CPU_LEVEL >= 5
 
-bool BX_CPP_AttrRegparmN(1) BX_CPU_C::SetCR3(bx_address val)
+bool BX_CPP_AttrRegparmN(2) BX_CPU_C::SetCR3(bx_address val, bool noflush)
 {
 #if BX_SUPPORT_X86_64
   if (long_mode()) {
@@ -1433,6 +1435,14 @@ bool BX_CPP_AttrRegparmN(1) BX_CPU_C::SetCR3(bx_address val)
 
   BX_CPU_THIS_PTR cr3 = val;
 
+#if BX_SUPPORT_X86_64
+  // select TLB context of the new PCID instead of flushing the TLB
+  if (BX_CPU_THIS_PTR cr4.get_PCIDE()) {
+    TLB_switchContext(noflush);
+    return true;
+  }
+#endif
+
   // flush TLB even if value does not change
 #if BX_CPU_LEVEL >= 6
   if (BX_CPU_THIS_PTR cr4.get_PGE())
@@ -215,6 +215,35 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::JMP_Jq(bxInstruction_c *i)
   BX_LINK_TRACE(i);
 }
 
+#if BX_SUPPORT_SUPERBLOCKS
+
+// JMP inside superblock, the trace continues with the branch target
+void BX_CPP_AttrRegparmN(1) BX_CPU_C::BxSuperblockJMP_Jq(bxInstruction_c *i)
+{
+  branch_near64(i);
+  BX_INSTR_UCNEAR_BRANCH(BX_CPU_ID, BX_INSTR_IS_JMP, PREV_RIP, RIP);
+
+  BX_NEXT_INSTR(i);
+}
+
+// Jcc inside superblock, the trace continues with the branch target when
+// the branch is taken, otherwise leave the trace through side exit
+void BX_CPP_AttrRegparmN(1) BX_CPU_C::BxSuperblockJcc_Jq(bxInstruction_c *i)
+{
+  if (jcc_condition(i->superblockCond())) {
+    branch_near64(i);
+    BX_INSTR_CNEAR_BRANCH_TAKEN(BX_CPU_ID, PREV_RIP, RIP);
+    superblockHit();
+    BX_NEXT_INSTR(i);
+  }
+
+  BX_INSTR_CNEAR_BRANCH_NOT_TAKEN(BX_CPU_ID, PREV_RIP);
+  superblockSideExit();
+  BX_LINK_TRACE(i);
+}
+
+#endif
+
 void BX_CPP_AttrRegparmN(1) BX_CPU_C::JO_Jq(bxInstruction_c *i)
 {
   if (get_OF()) {
@@ -464,7 +464,8 @@ char *disasm_regref(char *disbufptr, const bxInstruction_c *i, unsigned src_num,
     break;
 
   case BX_SEGREG:
-    disbufptr = dis_sprintf(disbufptr, "%s", segment_name[srcreg]);
+    // REX.R extended segment register numbers are invalid as well
+    disbufptr = dis_sprintf(disbufptr, "%s", (srcreg < 8) ? segment_name[srcreg] : "??");
     break;
 
   case BX_CREG:
@@ -498,4 +498,40 @@ const Bit64u ATTR_LAST_OPCODE = BX_CONST64(0x8000000000000000);
 
 static const Bit64u BxOpcodeGroup_ERR[] = { last_opcode(0, BX_IA_ERROR) };
 
+/* ************************************************************************ */
+/* Opcode lookup tries */
+
+// The opcode attribute lists above are compiled once at startup into
+// decision tries over the fields of the decode mask (fetchdecode_trie.cc).
+// A trie reference is either a leaf holding the opcode or a node selecting
+// its child by one field of the decode mask, so the lookup costs one table
+// load for every field the opcode really depends on, instead of matching
+// the attributes of the whole list.
+//
+// Node reference: bits 31..8 - offset of the children in BxDecodeTrie
+//                 bits  7..5 - width of the decode mask field
+//                 bits  4..0 - offset of the decode mask field
+
+const Bit32u BX_DECODE_TRIE_LEAF = 0x80000000;
+
+extern Bit32u *BxDecodeTrie;
+
+BX_CPP_INLINE Bit16u findOpcodeTrie(Bit32u ref, Bit32u decmask)
+{
+  while (! (ref & BX_DECODE_TRIE_LEAF)) {
+    Bit32u field = (decmask >> (ref & 0x1f)) & ((1 << ((ref >> 5) & 0x7)) - 1);
+    ref = BxDecodeTrie[(ref >> 8) + field];
+  }
+  return Bit16u(ref);
+}
+
+// Decode mask bits never set by the 32-bit and by the 64-bit decoder
+const Bit32u BX_DECMASK_ZERO_BITS = (1<<LOCK_PREFIX_OFFSET) | (7<<XOP_OFFSET) | (1<<3);
+const Bit32u BX_DECMASK_ZERO_BITS32 = BX_DECMASK_ZERO_BITS |
+  (1<<OS64_OFFSET) | (1<<AS64_OFFSET) | (1<<IS64_OFFSET);
+
+// Build the trie for an opcode list, the decode mask bits in 'known_mask'
+// are known to be equal to 'known_value' in all lookups.
+extern Bit32u buildDecodeTrie(const Bit64u *opMap, Bit32u known_mask, Bit32u known_value);
+
 #endif // BX_COMMON_FETCHDECODE_TABLES_H
@@ -643,6 +643,52 @@ static BxOpcodeDecodeDescriptor32 decode32_descriptor[] =
    /* 0F FF */ { &decoder_simple32, BxOpcodeTable0FFF }
 };
 
+// opcode lookup tries of the 32-bit decoder, indexed like the opcode
+// tables they are built from (see fetchdecode_trie.cc)
+static Bit32u BxOpcodeTrie32[0x400];
+#if BX_SUPPORT_AVX
+static Bit32u BxOpcodeTrieVEX32[256*4];
+static Bit32u BxOpcodeTrieXOP32[256*3];
+#endif
+#if BX_SUPPORT_EVEX
+static Bit32u BxOpcodeTrieEVEX32[256*5];
+#endif
+
+static void buildDecodeTries32(void)
+{
+  const Bit32u known_mask = BX_DECMASK_ZERO_BITS32;
+  const Bit32u known_value = 0;
+  unsigned n;
+
+  for (n=0; n < 0x200; n++) {
+    if (decode32_descriptor[n].opcode_table)
+      BxOpcodeTrie32[n] = buildDecodeTrie((const Bit64u *) decode32_descriptor[n].opcode_table, known_mask, known_value);
+    else
+      BxOpcodeTrie32[n] = BX_DECODE_TRIE_LEAF | BX_IA_ERROR;
+  }
+#if BX_CPU_LEVEL >= 6
+  for (n=0; n < 256; n++) {
+    BxOpcodeTrie32[0x200 | n] = buildDecodeTrie(BxOpcodeTable0F38[n], known_mask, known_value);
+    BxOpcodeTrie32[0x300 | n] = buildDecodeTrie(BxOpcodeTable0F3A[n], known_mask, known_value);
+  }
+#endif
+#if BX_SUPPORT_AVX
+  for (n=0; n < 256*4; n++)
+    BxOpcodeTrieVEX32[n] = buildDecodeTrie(BxOpcodeTableVEX[n], known_mask, known_value);
+  for (n=0; n < 256*3; n++)
+    BxOpcodeTrieXOP32[n] = buildDecodeTrie(BxOpcodeTableXOP[n], known_mask, known_value);
+#endif
+#if BX_SUPPORT_EVEX
+  for (n=0; n < 256*5; n++)
+    BxOpcodeTrieEVEX32[n] = buildDecodeTrie(BxOpcodeTableEVEX[n], known_mask, known_value);
+#endif
+}
+
+// the tries are built at startup, before anything gets decoded
+static struct bxDecodeTries32 {
+  bxDecodeTries32() { buildDecodeTries32(); }
+} decode_tries32;
+
 static unsigned Resolve16BaseReg[8] = {
   BX_16BIT_REG_BX,
   BX_16BIT_REG_BX,
@@ -712,7 +758,6 @@ static unsigned sreg_mod1or2_base32[8] = {
 };
 
 extern int fetchImmediate(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, Bit16u ia_opcode, bool is_64);
-extern Bit16u findOpcode(const Bit64u *opMap, Bit32u opMsk);
 
 static const Bit8u *decodeModrm32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsigned mod, unsigned nnn, unsigned rm)
 {
@@ -1455,7 +1500,7 @@ int decoder_vex32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsig
   if (i->modC0() && nnn == rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableVEX[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieVEX32[opcode_byte], decmask);
 
   bool has_immediate = (opcode_byte >= 0x70 && opcode_byte <= 0x73) || (opcode_byte >= 0xC2 && opcode_byte <= 0xC6) || (opcode_byte >= 0x200);
   if (has_immediate) {
@@ -1592,7 +1637,7 @@ int decoder_evex32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsi
   if (!opmask)
     decmask |= (1 << MASK_K0_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableEVEX[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieEVEX32[opcode_byte], decmask);
 
   bool has_immediate = (opcode_byte >= 0x70 && opcode_byte <= 0x73) || (opcode_byte >= 0xC2 && opcode_byte <= 0xC6) || (opcode_byte >= 0x200 && opcode_byte < 0x300);
   if (has_immediate) {
@@ -1679,7 +1724,7 @@ int decoder_xop32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsig
   if (i->modC0() && modrm.nnn == modrm.rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableXOP[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieXOP32[opcode_byte], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, false) < 0)
     return (-1);
@@ -1748,7 +1793,7 @@ int decoder32_modrm(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, uns
   if (i->modC0() && modrm.nnn == modrm.rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((Bit64u *) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie32[b1], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, false) < 0)
     return (-1);
@@ -1771,7 +1816,7 @@ int decoder32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsigned
   if (nnn == rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((Bit64u *) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie32[b1], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, false) < 0)
     return (-1);
@@ -1805,7 +1850,7 @@ int decoder_creg32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsi
                    (nnn << NNN_OFFSET) |
                    (rm << RRR_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((Bit64u *) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie32[b1], decmask);
 
   assign_srcs(i, ia_opcode, nnn, rm);
 
@@ -1868,24 +1913,6 @@ int decoder_ud32(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsign
   return BX_IA_ERROR;
 }
 
-Bit16u findOpcode(const Bit64u *opMap, Bit32u decmask)
-{
-  Bit16u ia_opcode = BX_IA_ERROR;
-  Bit64u op;
-
-  do {
-    op = *opMap++;
-    Bit32u ignmsk = Bit32u(op) & 0xFFFFFF;
-    Bit32u opmsk  = Bit32u(op >> 24);
-    if ((opmsk & ignmsk) == (decmask & ignmsk)) {
-      ia_opcode = Bit16u(op >> 48) & 0x7FFF; // upper bit indicates that parsing is done and doesn't belong to opcode
-      break;
-    }
-  } while(Bit64s(op) > 0);
-
-  return ia_opcode;
-}
-
 int fetchDecode32(const Bit8u *iptr, bool is_32, bxInstruction_c *i, unsigned remainingInPage)
 {
   if (remainingInPage > 15) remainingInPage = 15;
@@ -101,8 +101,6 @@ extern const Bit64u *BxOpcodeTableEVEX[];
 // table of all Bochs opcodes
 extern struct bxIAOpcodeTable BxOpcodesTable[];
 
-extern Bit16u findOpcode(const Bit64u *opMap, Bit32u opMsk);
-
 extern BxDecodeError assign_srcs(bxInstruction_c *i, unsigned ia_opcode, unsigned nnn, unsigned rm);
 #if BX_SUPPORT_AVX
 extern BxDecodeError assign_srcs(bxInstruction_c *i, unsigned ia_opcode, bool is_64, unsigned nnn, unsigned rm, unsigned vvv, unsigned vex_w, bool had_evex = false, bool displ8 = false);
@@ -649,6 +647,50 @@ static BxOpcodeDecodeDescriptor64 decode64_descriptor[] =
    /* 0F FF */ { &decoder_simple64, BxOpcodeTable0FFF }
 };
 
+// opcode lookup tries of the 64-bit decoder, indexed like the opcode
+// tables they are built from (see fetchdecode_trie.cc)
+static Bit32u BxOpcodeTrie64[0x400];
+#if BX_SUPPORT_AVX
+static Bit32u BxOpcodeTrieVEX64[256*4];
+static Bit32u BxOpcodeTrieXOP64[256*3];
+#endif
+#if BX_SUPPORT_EVEX
+static Bit32u BxOpcodeTrieEVEX64[256*5];
+#endif
+
+static void buildDecodeTries64(void)
+{
+  const Bit32u known_mask = BX_DECMASK_ZERO_BITS | (1 << IS64_OFFSET);
+  const Bit32u known_value = 1 << IS64_OFFSET;
+  unsigned n;
+
+  for (n=0; n < 0x200; n++) {
+    if (decode64_descriptor[n].opcode_table)
+      BxOpcodeTrie64[n] = buildDecodeTrie((const Bit64u *) decode64_descriptor[n].opcode_table, known_mask, known_value);
+    else
+      BxOpcodeTrie64[n] = BX_DECODE_TRIE_LEAF | BX_IA_ERROR;
+  }
+  for (n=0; n < 256; n++) {
+    BxOpcodeTrie64[0x200 | n] = buildDecodeTrie(BxOpcodeTable0F38[n], known_mask, known_value);
+    BxOpcodeTrie64[0x300 | n] = buildDecodeTrie(BxOpcodeTable0F3A[n], known_mask, known_value);
+  }
+#if BX_SUPPORT_AVX
+  for (n=0; n < 256*4; n++)
+    BxOpcodeTrieVEX64[n] = buildDecodeTrie(BxOpcodeTableVEX[n], known_mask, known_value);
+  for (n=0; n < 256*3; n++)
+    BxOpcodeTrieXOP64[n] = buildDecodeTrie(BxOpcodeTableXOP[n], known_mask, known_value);
+#endif
+#if BX_SUPPORT_EVEX
+  for (n=0; n < 256*5; n++)
+    BxOpcodeTrieEVEX64[n] = buildDecodeTrie(BxOpcodeTableEVEX[n], known_mask, known_value);
+#endif
+}
+
+// the tries are built at startup, before anything gets decoded
+static struct bxDecodeTries64 {
+  bxDecodeTries64() { buildDecodeTries64(); }
+} decode_tries64;
+
 const Bit8u *decodeModrm64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsigned mod, unsigned nnn, unsigned rm, unsigned rex_r, unsigned rex_x, unsigned rex_b)
 {
   unsigned seg = BX_SEG_REG_DS;
@@ -854,7 +896,7 @@ int decoder_vex64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsig
   if (i->modC0() && nnn == rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableVEX[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieVEX64[opcode_byte], decmask);
 
   bool has_immediate = (opcode_byte >= 0x70 && opcode_byte <= 0x73) || (opcode_byte >= 0xC2 && opcode_byte <= 0xC6) || (opcode_byte >= 0x200);
   if (has_immediate) {
@@ -1011,7 +1053,7 @@ int decoder_evex64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsi
   if (!opmask)
     decmask |= (1 << MASK_K0_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableEVEX[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieEVEX64[opcode_byte], decmask);
 
   bool has_immediate = (opcode_byte >= 0x70 && opcode_byte <= 0x73) || (opcode_byte >= 0xC2 && opcode_byte <= 0xC6) || (opcode_byte >= 0x200 && opcode_byte < 0x300);
   if (has_immediate) {
@@ -1113,7 +1155,7 @@ int decoder_xop64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsig
   if (i->modC0() && nnn == rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  ia_opcode = findOpcode(BxOpcodeTableXOP[opcode_byte], decmask);
+  ia_opcode = findOpcodeTrie(BxOpcodeTrieXOP64[opcode_byte], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, true) < 0)
     return (-1);
@@ -1197,7 +1239,7 @@ int decoder64_modrm(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, uns
   if (i->modC0() && modrm.nnn == modrm.rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((const Bit64u*) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie64[b1], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, true) < 0)
     return (-1);
@@ -1228,7 +1270,7 @@ int decoder64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsigned
   if (nnn == rm)
     decmask |= (1 << SRC_EQ_DST_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((const Bit64u*) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie64[b1], decmask);
 
   if (fetchImmediate(iptr, remain, i, ia_opcode, true) < 0)
     return (-1);
@@ -1270,7 +1312,7 @@ int decoder_creg64(const Bit8u *iptr, unsigned &remain, bxInstruction_c *i, unsi
                    ((nnn & 0x7) << NNN_OFFSET) |
                    ((rm  & 0x7) << RRR_OFFSET);
 
-  Bit16u ia_opcode = findOpcode((Bit64u *) opcode_table, decmask);
+  Bit16u ia_opcode = findOpcodeTrie(BxOpcodeTrie64[b1], decmask);
 
   assign_srcs(i, ia_opcode, nnn, rm);
 
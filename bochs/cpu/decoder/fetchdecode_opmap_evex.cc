@@ -849,21 +849,21 @@ static const Bit64u BxOpcodeGroup_EVEX_0F3819[] = {
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTF32x2_VpsWq),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0,                BX_IA_EVEX_VBROADCASTF32x2_VpsWq_Kmask),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTSD_VpdWsd),
-  form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1,                BX_IA_EVEX_VBROADCASTSD_VpdWsd_Kmask)
+  last_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1,                BX_IA_EVEX_VBROADCASTSD_VpdWsd_Kmask)
 };
 
 static const Bit64u BxOpcodeGroup_EVEX_0F381A[] = {
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0 | ATTR_MOD_MEM | ATTR_VL256_512 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTF32x4_VpsWps),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0 | ATTR_MOD_MEM | ATTR_VL256_512,                BX_IA_EVEX_VBROADCASTF32x4_VpsWps_Kmask),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL256_512 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTF64x2_VpdWpd),
-  form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL256_512,                BX_IA_EVEX_VBROADCASTF64x2_VpdWpd_Kmask),
+  last_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL256_512,                BX_IA_EVEX_VBROADCASTF64x2_VpdWpd_Kmask)
 };
 
 static const Bit64u BxOpcodeGroup_EVEX_0F381B[] = {
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0 | ATTR_MOD_MEM | ATTR_VL512 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTF32x8_VpsWps),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W0 | ATTR_MOD_MEM | ATTR_VL512,                BX_IA_EVEX_VBROADCASTF32x8_VpsWps_Kmask),
   form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL512 | ATTR_MASK_K0, BX_IA_EVEX_VBROADCASTF64x4_VpdWpd),
-  form_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL512,                BX_IA_EVEX_VBROADCASTF64x4_VpdWpd_Kmask),
+  last_opcode(ATTR_SSE_PREFIX_66 | ATTR_VEX_W1 | ATTR_MOD_MEM | ATTR_VL512,                BX_IA_EVEX_VBROADCASTF64x4_VpdWpd_Kmask)
 };
 
 static const Bit64u BxOpcodeGroup_EVEX_0F381C[] = {
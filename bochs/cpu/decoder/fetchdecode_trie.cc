@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2024  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#include "config.h"
+
+#ifndef BX_STANDALONE_DECODER
+#define BX_STANDALONE_DECODER
+#endif
+
+#include "fetchdecode.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ************************************************************************ */
+/* Opcode lookup trie builder */
+
+// The opcode lists are matched first to last, the first entry whose
+// attributes match the decode mask wins. The trie for a list is built
+// by looking at the first entry which could still match under the decode
+// mask bits already selected on the way from the root: if all attributes
+// of that entry are already known the node is a leaf, otherwise the node
+// selects on the decode mask field holding the most significant attribute
+// still unknown. Nodes with identical children are shared between all the
+// tries, most opcode lists collapse into a handful of small nodes.
+
+// all the tries live in one pool, so the references stay 32-bit
+Bit32u *BxDecodeTrie = NULL;
+
+static Bit32u trie_pool_size = 0, trie_pool_capacity = 0;
+
+// hash of all nodes in the pool: (offset << 3 | width) + 1, 0 means free
+static Bit32u *trie_node_hash = NULL;
+static Bit32u trie_node_hash_size = 0, trie_node_hash_count = 0;
+
+// the decode mask fields, a node never selects on more than 3 bits
+static const struct {
+  Bit8u offset, width;
+} decode_mask_fields[] = {
+  { OS32_OFFSET, 2 },
+  { AS32_OFFSET, 2 },
+  { SSE_PREFIX_OFFSET, 2 },
+  { LOCK_PREFIX_OFFSET, 1 },
+  { MODC0_OFFSET, 1 },
+  { IS64_OFFSET, 1 },
+  { XOP_OFFSET, 3 },
+  { VEX_VL_128_256_OFFSET, 2 },
+  { VEX_W_OFFSET, 1 },
+  { MASK_K0_OFFSET, 1 },
+  { SRC_EQ_DST_OFFSET, 1 },
+  { RRR_OFFSET, 3 },
+  { 3, 1 },
+  { NNN_OFFSET, 3 }
+};
+
+static Bit32u hash_trie_node(const Bit32u *children, unsigned width)
+{
+  Bit32u hash = width;
+  for (unsigned n=0; n < (1U << width); n++)
+    hash = (hash ^ children[n]) * 0x9E3779B1;
+  return hash ^ (hash >> 16);
+}
+
+static void insert_trie_node_hash(Bit32u entry)
+{
+  Bit32u offset = (entry - 1) >> 3, width = (entry - 1) & 0x7;
+  Bit32u slot = hash_trie_node(BxDecodeTrie + offset, width);
+  for (;; slot++) {
+    slot &= trie_node_hash_size - 1;
+    if (! trie_node_hash[slot]) break;
+  }
+  trie_node_hash[slot] = entry;
+  trie_node_hash_count++;
+}
+
+// return the pool offset of a node with the given children, adding it
+// to the pool if no such node exists yet
+static Bit32u intern_trie_node(const Bit32u *children, unsigned width)
+{
+  unsigned count = 1 << width;
+
+  if (2 * (trie_node_hash_count + 1) > trie_node_hash_size) {
+    Bit32u *old_hash = trie_node_hash;
+    Bit32u old_size = trie_node_hash_size;
+    trie_node_hash_size = old_size ? (old_size * 2) : 1024;
+    trie_node_hash = (Bit32u *) calloc(trie_node_hash_size, sizeof(Bit32u));
+    trie_node_hash_count = 0;
+    for (Bit32u n=0; n < old_size; n++) {
+      if (old_hash[n]) insert_trie_node_hash(old_hash[n]);
+    }
+    free(old_hash);
+  }
+
+  Bit32u slot = hash_trie_node(children, width);
+  for (;; slot++) {
+    slot &= trie_node_hash_size - 1;
+    Bit32u entry = trie_node_hash[slot];
+    if (! entry) break;
+    Bit32u offset = (entry - 1) >> 3;
+    if (((entry - 1) & 0x7) == width && ! memcmp(BxDecodeTrie + offset, children, count * sizeof(Bit32u)))
+      return offset;
+  }
+
+  if (trie_pool_size + count > trie_pool_capacity) {
+    trie_pool_capacity = trie_pool_capacity ? (trie_pool_capacity * 2) : 4096;
+    BxDecodeTrie = (Bit32u *) realloc(BxDecodeTrie, trie_pool_capacity * sizeof(Bit32u));
+  }
+
+  Bit32u offset = trie_pool_size;
+  memcpy(BxDecodeTrie + offset, children, count * sizeof(Bit32u));
+  trie_pool_size += count;
+  insert_trie_node_hash(((offset << 3) | width) + 1);
+
+  return offset;
+}
+
+static Bit32u build_trie_node(const Bit64u *opMap, Bit32u fixed_mask, Bit32u fixed_value)
+{
+  Bit64u op;
+
+  do {
+    op = *opMap++;
+    Bit32u ignmsk = Bit32u(op) & 0xFFFFFF;
+    Bit32u opmsk  = Bit32u(op >> 24);
+    // the entry can't match anymore
+    if ((opmsk ^ fixed_value) & ignmsk & fixed_mask)
+      continue;
+
+    Bit32u unknown = ignmsk & ~fixed_mask;
+    if (! unknown)
+      return BX_DECODE_TRIE_LEAF | (Bit16u(op >> 48) & 0x7FFF);
+
+    unsigned bit = 23;
+    while (! (unknown & (1 << bit))) bit--;
+
+    unsigned f = 0;
+    while (bit < decode_mask_fields[f].offset) f++;
+
+    // select only on the unknown bits of the field next to each other
+    unsigned lo = bit;
+    while (lo > decode_mask_fields[f].offset && ! (fixed_mask & (1 << (lo-1)))) lo--;
+    unsigned width = bit - lo + 1;
+    Bit32u field_mask = ((1 << width) - 1) << lo;
+
+    Bit32u children[8];
+    bool same = true;
+    for (unsigned n=0; n < (1U << width); n++) {
+      children[n] = build_trie_node(opMap - 1, fixed_mask | field_mask, (fixed_value & ~field_mask) | (n << lo));
+      if (children[n] != children[0]) same = false;
+    }
+    if (same)
+      return children[0];
+
+    return (intern_trie_node(children, width) << 8) | (width << 5) | lo;
+  } while(Bit64s(op) > 0);
+
+  return BX_DECODE_TRIE_LEAF | BX_IA_ERROR;
+}
+
+Bit32u buildDecodeTrie(const Bit64u *opMap, Bit32u known_mask, Bit32u known_value)
+{
+  return build_trie_node(opMap, known_mask, known_value & known_mask);
+}
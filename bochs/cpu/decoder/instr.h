@@ -59,6 +59,9 @@ public:
   union {
     BxExecutePtr_tR execute2;
     bxInstruction_c *next;
+#if BX_SUPPORT_JIT
+    const void *jitCode;
+#endif
   } handlers;
 #endif
 
@@ -407,6 +410,30 @@ public:
   }
 #endif
 
+#if BX_SUPPORT_SUPERBLOCKS && !defined(BX_STANDALONE_DECODER)
+  // superblock Jcc keeps the branch condition in unused source register field
+  BX_CPP_INLINE unsigned superblockCond() const {
+    return metaData[BX_INSTR_METADATA_SRC1];
+  }
+  BX_CPP_INLINE void setSuperblockCond(unsigned cond) {
+    metaData[BX_INSTR_METADATA_SRC1] = cond;
+  }
+#endif
+
+#if BX_SUPPORT_JIT && !defined(BX_STANDALONE_DECODER)
+  // JIT trace header counts trace executions in the immediate field and
+  // keeps pointer to the compiled host code
+  BX_CPP_INLINE Bit32u jitExecCount() { return ++modRMForm.Id; }
+  BX_CPP_INLINE const void *jitCode() const { return handlers.jitCode; }
+  BX_CPP_INLINE void setJitCode(const void *code) {
+    handlers.jitCode = code;
+    modRMForm.Id = 0;
+  }
+  BX_CPP_INLINE bool isJitCompiled() const {
+    return ilen() == 0 && handlers.jitCode != NULL;
+  }
+#endif
+
 };
 // <TAG-CLASS-INSTRUCTION-END>
 
@@ -51,13 +51,7 @@ bool BX_CPU_C::handleWaitForEvent(void)
   // an interrupt wakes up the CPU.
   while (1)
   {
-    if ((is_pending(BX_EVENT_PENDING_INTR | BX_EVENT_PENDING_LAPIC_INTR | BX_EVENT_PENDING_UINTR) && (BX_CPU_THIS_PTR get_IF() || BX_CPU_THIS_PTR activity_state == BX_ACTIVITY_STATE_MWAIT_IF)) ||
-         is_unmasked_event_pending(BX_EVENT_NMI | BX_EVENT_SMI | BX_EVENT_INIT |
-            BX_EVENT_VMX_VTPR_UPDATE |
-            BX_EVENT_VMX_VEOI_UPDATE |
-            BX_EVENT_VMX_VIRTUAL_APIC_WRITE |
-            BX_EVENT_VMX_MONITOR_TRAP_FLAG |
-            BX_EVENT_VMX_VIRTUAL_NMI))
+    if (is_wakeup_event_pending())
     {
       // interrupt ends the HALT condition
 #if BX_SUPPORT_MONITOR_MWAIT
@@ -109,16 +103,57 @@ bool BX_CPU_C::handleWaitForEvent(void)
       return 1; // Return to caller of cpu_loop.
     }
 
-    BX_TICKN(10); // when in HLT run time faster for single CPU
+    if (bx_pc_system.idle_enabled()) {
+      // nothing can wake up the CPU before the next timer event
+      bx_pc_system.idle();
+    }
+    else {
+      BX_TICKN(10); // when in HLT run time faster for single CPU
+    }
   }
 
   return 0;
 }
 
+// Check for events which end HALT / MWAIT condition
+bool BX_CPU_C::is_wakeup_event_pending(void)
+{
+  return (is_pending(BX_EVENT_PENDING_INTR | BX_EVENT_PENDING_LAPIC_INTR | BX_EVENT_PENDING_UINTR) && (BX_CPU_THIS_PTR get_IF() || BX_CPU_THIS_PTR activity_state == BX_ACTIVITY_STATE_MWAIT_IF)) ||
+          is_unmasked_event_pending(BX_EVENT_NMI | BX_EVENT_SMI | BX_EVENT_INIT |
+             BX_EVENT_VMX_VTPR_UPDATE |
+             BX_EVENT_VMX_VEOI_UPDATE |
+             BX_EVENT_VMX_VIRTUAL_APIC_WRITE |
+             BX_EVENT_VMX_MONITOR_TRAP_FLAG |
+             BX_EVENT_VMX_VIRTUAL_NMI);
+}
+
+#if BX_SUPPORT_SMP
+// The processor is waiting for event (HLT, MWAIT, wait for SIPI) and nothing
+// could wake it up yet, the SMP scheduler don't have to run it at all.
+bool BX_CPU_C::is_idle(void)
+{
+  if (BX_CPU_THIS_PTR activity_state == BX_ACTIVITY_STATE_ACTIVE)
+    return false;
+
+  if (BX_CPU_THIS_PTR activity_state == BX_ACTIVITY_STATE_WAIT_FOR_SIPI)
+    return ! BX_CPU_THIS_PTR sipi_pending;
+
+  if (is_wakeup_event_pending() || is_unmasked_event_pending(BX_EVENT_VMX_PREEMPTION_TIMER_EXPIRED))
+    return false;
+
+  // DMA is handled also when CPU is halted
+  if (BX_HRQ && BX_DBG_ASYNC_DMA)
+    return false;
+
+  return true;
+}
+#endif
+
 Bit8u BX_CPU_C::interrupt_acknowledge(void)
 {
   Bit8u vector;
 
+  BX_LOCK_DEVICES();
 #if BX_SUPPORT_APIC
   if (is_pending(BX_EVENT_PENDING_LAPIC_INTR))
     vector = BX_CPU_THIS_PTR lapic->acknowledge_int();
@@ -126,6 +161,7 @@ Bit8u BX_CPU_C::interrupt_acknowledge(void)
 #endif
     // if no local APIC, always acknowledge the PIC.
     vector = DEV_pic_iac(); // may set INTR with next interrupt
+  BX_UNLOCK_DEVICES();
 
   return vector;
 }
@@ -207,6 +243,17 @@ bool BX_CPU_C::handleAsyncEvent(void)
   //
   // This area is where we process special conditions and events.
   //
+  INC_CPU_STAT(asyncEvents);
+
+#if BX_SUPPORT_JIT
+  // left behind by an exception in instruction called from compiled trace
+#if BX_SUPPORT_SMP
+  bx_atomic_and32(&BX_CPU_THIS_PTR async_event, ~BX_ASYNC_EVENT_JIT_CALL);
+#else
+  BX_CPU_THIS_PTR async_event &= ~BX_ASYNC_EVENT_JIT_CALL;
+#endif
+#endif
+
   if (BX_CPU_THIS_PTR activity_state != BX_ACTIVITY_STATE_ACTIVE) {
     // For one processor, pass the time as quickly as possible until
     // an interrupt wakes up the CPU.
@@ -430,6 +477,13 @@ bool BX_CPU_C::handleAsyncEvent(void)
         BX_HRQ))
   {
     BX_CPU_THIS_PTR async_event = 0;
+#if BX_SUPPORT_SMP
+    // an event might be signalled from another host thread meanwhile
+    if (bx_pc_system.smp_threads_running) {
+      bx_atomic_fence();
+      if (unmasked_events_pending()) BX_CPU_THIS_PTR async_event = 1;
+    }
+#endif
   }
 
   return 0; // Continue executing cpu_loop.
@@ -454,6 +508,17 @@ bool BX_CPU_C::interrupts_inhibited(unsigned mask)
 
 void BX_CPU_C::deliver_SIPI(unsigned vector)
 {
+#if BX_SUPPORT_SMP
+  if (bx_pc_system.smp_threads_running && this != bx_smp_thread_cpu) {
+    // the processor is running in another host thread, it will start up
+    // before its next trace
+    BX_LOCK_DEVICES();
+    BX_CPU_THIS_PTR sipi_pending = BX_SIPI_PENDING | vector;
+    BX_UNLOCK_DEVICES();
+    return;
+  }
+#endif
+
   if (BX_CPU_THIS_PTR activity_state == BX_ACTIVITY_STATE_WAIT_FOR_SIPI) {
 #if BX_SUPPORT_VMX
     if (BX_CPU_THIS_PTR in_vmx_guest)
@@ -949,6 +949,8 @@ void BX_CPU_C::exception(unsigned vector, Bit16u error_code)
      BX_PANIC(("exception(%u): bad vector", vector));
   }
 
+  INC_CPU_STAT(exceptions[vector]);
+
   /* Excluding page faults and double faults, error_code may not have the
    * least significant bit set correctly. This correction is applied first
    * to make the change transparent to any instrumentation.
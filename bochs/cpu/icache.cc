@@ -29,6 +29,8 @@
 #include "gui/siminterface.h"
 #include "param_names.h"
 #include "cpustats.h"
+#include "pc_system.h"
+#include "tracefile.h"
 
 #include "decoder/ia_opcodes.h"
 
@@ -47,18 +49,139 @@ void flushICaches(void)
   }
 
   pageWriteStampTable.resetWriteStamps();
+  traceFile.resetPages();
 }
 
 void handleSMC(bx_phy_address pAddr, Bit32u mask)
 {
-  INC_SMC_STAT(smc);
+  traceFile.handleSMC(pAddr, mask);
 
   for (unsigned i=0; i<BX_SMP_PROCESSORS; i++) {
+#if BX_SUPPORT_SMP
+    if (bx_pc_system.smp_threads_running && BX_CPU(i) != bx_smp_thread_cpu) {
+      // the processor is running in another host thread, don't touch its
+      // trace cache directly
+      BX_CPU(i)->post_smc(pAddr, mask);
+      continue;
+    }
+#endif
+#if BX_ENABLE_STATISTICS && BX_SUPPORT_SMP
+    // the store may come from another host thread than the processor's one
+    bx_atomic_add64(&BX_CPU(i)->stats.smc, 1);
+#else
+    INC_STAT(BX_CPU(i)->stats.smc);
+#endif
     BX_CPU(i)->async_event |= BX_ASYNC_EVENT_STOP_TRACE;
     BX_CPU(i)->iCache.handleSMC(pAddr, mask);
   }
 }
 
+#if BX_SUPPORT_SMP
+
+void BX_CPU_C::post_smc(bx_phy_address pAddr, Bit32u mask)
+{
+  BX_LOCK_DEVICES();
+  unsigned n = BX_CPU_THIS_PTR smc_pending_count;
+  if (n < BX_SMC_PENDING_ENTRIES) {
+    BX_CPU_THIS_PTR smc_pending[n].pAddr = pAddr;
+    BX_CPU_THIS_PTR smc_pending[n].mask = mask;
+  }
+  // when the queue overflows the whole trace cache will be flushed
+  if (n <= BX_SMC_PENDING_ENTRIES)
+    BX_CPU_THIS_PTR smc_pending_count = n + 1;
+  BX_UNLOCK_DEVICES();
+}
+
+void BX_CPU_C::handle_pending_smc(void)
+{
+  BX_LOCK_DEVICES();
+  unsigned n = BX_CPU_THIS_PTR smc_pending_count;
+  if (n > BX_SMC_PENDING_ENTRIES) {
+    BX_CPU_THIS_PTR iCache.flushICacheEntries();
+  }
+  else {
+    for (unsigned i=0; i<n; i++) {
+      INC_CPU_STAT(smc);
+      BX_CPU_THIS_PTR iCache.handleSMC(BX_CPU_THIS_PTR smc_pending[i].pAddr, BX_CPU_THIS_PTR smc_pending[i].mask);
+    }
+  }
+  BX_CPU_THIS_PTR smc_pending_count = 0;
+  BX_UNLOCK_DEVICES();
+}
+
+void BX_CPU_C::handle_pending_sipi(void)
+{
+  BX_LOCK_DEVICES();
+  unsigned vector = BX_CPU_THIS_PTR sipi_pending & 0xff;
+  BX_CPU_THIS_PTR sipi_pending = 0;
+  BX_UNLOCK_DEVICES();
+
+  deliver_SIPI(vector);
+}
+
+#endif
+
+void bxICache_c::init(unsigned numEntries, unsigned numWays)
+{
+  delete [] entry;
+  delete [] mpool;
+  delete [] pageIndex;
+
+  ways = numWays;
+  sets = numEntries / numWays;
+  if (sets < BX_ICACHE_MIN_SETS) sets = BX_ICACHE_MIN_SETS;
+  setMask = sets - 1;
+
+  mpoolRegionSize = (sets * ways * BX_ICACHE_POOL_PER_ENTRY) / BX_ICACHE_POOL_REGIONS;
+  mpoolSize = mpoolRegionSize * BX_ICACHE_POOL_REGIONS;
+
+  entry = new bxICacheEntry_c[sets * ways];
+  pageIndex = new Bit32u[sets];
+  mpool = new bxInstruction_c[mpoolSize];
+
+  flushICacheEntries();
+  flushes = reclaims = evictions = 0;
+#if BX_SUPPORT_JIT
+  memset(jitSmcTraces, 0, sizeof(jitSmcTraces));
+#endif
+}
+
+// The memory pool is used as a ring buffer split into regions. When the
+// current region is exhausted, the next one is reclaimed by invalidating only
+// the traces allocated from it, instead of flushing the whole trace cache.
+void bxICache_c::reclaimPoolRegion(void)
+{
+  unsigned i;
+
+  // the space left at the end of the current region is not used, so
+  // a trace never crosses region boundary
+  mpindex = (mpend >= mpoolSize) ? 0 : mpend;
+  mpend = mpindex + mpoolRegionSize;
+
+  bxICacheEntry_c *e = entry;
+  for (i=0; i < sets*ways; i++, e++) {
+    if (e->pAddr != BX_ICACHE_INVALID_PHY_ADDRESS) {
+      unsigned index = unsigned(e->i - mpool);
+      if (index >= mpindex && index < mpend) {
+        e->pAddr = BX_ICACHE_INVALID_PHY_ADDRESS;
+        e->traceMask = 0;
+      }
+    }
+  }
+
+  for (i=0;i<BX_ICACHE_PAGE_SPLIT_ENTRIES;i++) {
+    if (pageSplitIndex[i].ppf != BX_ICACHE_INVALID_PHY_ADDRESS) {
+      if (pageSplitIndex[i].e->pAddr == BX_ICACHE_INVALID_PHY_ADDRESS)
+        pageSplitIndex[i].ppf = BX_ICACHE_INVALID_PHY_ADDRESS;
+    }
+  }
+
+  reclaims++;
+
+  // other traces could be linked into the reclaimed region
+  breakLinks();
+}
+
 void flushSMC(bxICacheEntry_c *e)
 {
   if (e->pAddr != BX_ICACHE_INVALID_PHY_ADDRESS) {
@@ -90,6 +213,18 @@ void genDummyICacheEntry(bxInstruction_c *i)
 
 #endif
 
+#if BX_SUPPORT_JIT
+
+void genJitHeader(bxInstruction_c *i)
+{
+  i->setILen(0);
+  i->setIaOpcode(BX_INSERTED_OPCODE);
+  i->execute1 = &BX_CPU_C::BxJitProfile;
+  i->setJitCode(NULL);
+}
+
+#endif
+
 bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAddr)
 {
   bxICacheEntry_c *entry = BX_CPU_THIS_PTR iCache.get_entry(pAddr, BX_CPU_THIS_PTR fetchModeMask);
@@ -110,6 +245,23 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
   Bit32u pageOffset = PAGE_OFFSET((Bit32u) pAddr);
   Bit32u traceMask = 0;
 
+#if BX_SUPPORT_SUPERBLOCKS
+  // linear address of the instruction being decoded
+  bx_address rip = eipBiased - BX_CPU_THIS_PTR eipPageBias;
+  bool superblock = BX_CPU_THIS_PTR superblocks && !bx_dbg.debugger_active;
+#endif
+
+#if BX_SUPPORT_JIT
+  // start the trace with header counting its executions, the header
+  // compiles the trace when it becomes hot
+  bool jit = BX_CPU_THIS_PTR jit && !bx_dbg.debugger_active &&
+      !BX_CPU_THIS_PTR iCache.jitSmcTraces[BX_CPU_THIS_PTR iCache.jit_smc_hash(pAddr)];
+  if (jit) {
+    genJitHeader(i++);
+    entry->tlen++;
+  }
+#endif
+
 #if BX_SUPPORT_SMP == 0
   if (PPFOf(pAddr) == BX_CPU_THIS_PTR pAddrStackPage)
     invalidate_stack_cache();
@@ -118,13 +270,27 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
   // Don't allow traces longer than cpu_loop can execute
   static unsigned quantum =
 #if BX_SUPPORT_SMP
-    (BX_SMP_PROCESSORS > 1) ? SIM->get_param_num(BXPN_SMP_QUANTUM)->get() :
+    (BX_SMP_PROCESSORS > 1 && !SIM->get_param_bool(BXPN_SMP_HOST_THREADS)->get()) ?
+        SIM->get_param_num(BXPN_SMP_QUANTUM)->get() :
 #endif
     BX_MAX_TRACE_LENGTH;
   if (bx_dbg.debugger_active)
     quantum = 1;
 
-  for (unsigned n=0;n < quantum;n++)
+  unsigned maxlen = quantum;
+#if BX_SUPPORT_JIT
+  // leave space for the trace header
+  if (jit && maxlen > BX_MAX_TRACE_LENGTH - 1)
+    maxlen = BX_MAX_TRACE_LENGTH - 1;
+#endif
+
+  // use the trace saved by the previous run when the guest code is the same
+  if (traceFile.enabled() && !bx_dbg.debugger_active) {
+    if (fetchTraceFromFile(entry, i, pAddr, maxlen))
+      return entry;
+  }
+
+  for (unsigned n=0;n < maxlen;n++)
   {
 #if BX_SUPPORT_X86_64
     if (BX_CPU_THIS_PTR cpu_mode == BX_MODE_LONG_64)
@@ -144,7 +310,7 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
       // First instruction is boundary fetch, leave the trace cache entry
       // invalid for now because boundaryFetch() can fault
       entry->pAddr = ~entry->pAddr;
-      entry->tlen = 1;
+      entry->tlen++;
       boundaryFetch(fetchPtr, remainingInPage, i);
 
       // Add the instruction to trace cache
@@ -181,12 +347,30 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
     traceMask |= 1 <<  (pageOffset >> 7);
     traceMask |= 1 << ((pageOffset + iLen - 1) >> 7);
 
-    // continue to the next instruction
-    remainingInPage -= iLen;
-    if (ret != 0 /* stop trace indication */ || remainingInPage == 0) break;
-    pAddr += iLen;
-    pageOffset += iLen;
-    fetchPtr += iLen;
+#if BX_SUPPORT_SUPERBLOCKS
+    bx_address target;
+    if (superblock && superblockFollowBranch(i-1, rip, &target)) {
+      // continue the trace at the branch target in the same page
+      Bit32u targetBiased = (Bit32u)(target + BX_CPU_THIS_PTR eipPageBias);
+      remainingInPage = BX_CPU_THIS_PTR eipPageWindowSize - targetBiased;
+      fetchPtr = BX_CPU_THIS_PTR eipFetchPtr + targetBiased;
+      pAddr = BX_CPU_THIS_PTR pAddrFetchPage + targetBiased;
+      pageOffset = PAGE_OFFSET((Bit32u) pAddr);
+      rip = target;
+    }
+    else
+#endif
+    {
+      // continue to the next instruction
+      remainingInPage -= iLen;
+      if (ret != 0 /* stop trace indication */ || remainingInPage == 0) break;
+      pAddr += iLen;
+      pageOffset += iLen;
+      fetchPtr += iLen;
+#if BX_SUPPORT_SUPERBLOCKS
+      rip += iLen;
+#endif
+    }
 
     // try to find a trace starting from current pAddr and merge
     if (!bx_dbg.debugger_active) {
@@ -194,7 +378,7 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
         if (mergeTraces(entry, i, pAddr)) {
           entry->traceMask |= traceMask;
           pageWriteStampTable.markICacheMask(pAddr, entry->traceMask);
-          BX_CPU_THIS_PTR iCache.commit_trace(entry->tlen);
+          BX_CPU_THIS_PTR iCache.commit_trace(entry);
           return entry;
         }
       }
@@ -212,22 +396,161 @@ bxICacheEntry_c* BX_CPU_C::serveICacheMiss(Bit32u eipBiased, bx_phy_address pAdd
 #endif
   }
 
-  BX_CPU_THIS_PTR iCache.commit_trace(entry->tlen);
+  BX_CPU_THIS_PTR iCache.commit_trace(entry);
 
   return entry;
 }
 
+#if BX_SUPPORT_SUPERBLOCKS
+
+#if BX_SUPPORT_X86_64
+  #define BX_SUPERBLOCK_JCC_CASES_64(cc) \
+    case BX_IA_J##cc##_Jq: case BX_IA_J##cc##_Jbq:
+#else
+  #define BX_SUPERBLOCK_JCC_CASES_64(cc)
+#endif
+
+#define BX_SUPERBLOCK_JCC_CASES(cc, cond) \
+    case BX_IA_J##cc##_Jw: case BX_IA_J##cc##_Jbw: \
+    case BX_IA_J##cc##_Jd: case BX_IA_J##cc##_Jbd: \
+    BX_SUPERBLOCK_JCC_CASES_64(cc) return (cond);
+
+#define BX_SUPERBLOCK_JMP 16
+
+// returns condition code of direct near branch, BX_SUPERBLOCK_JMP for
+// unconditional jump or -1 for any other instruction
+static int superblockBranchCondition(unsigned ia_opcode)
+{
+  switch(ia_opcode) {
+    BX_SUPERBLOCK_JCC_CASES(O,    0x0)
+    BX_SUPERBLOCK_JCC_CASES(NO,   0x1)
+    BX_SUPERBLOCK_JCC_CASES(B,    0x2)
+    BX_SUPERBLOCK_JCC_CASES(NB,   0x3)
+    BX_SUPERBLOCK_JCC_CASES(Z,    0x4)
+    BX_SUPERBLOCK_JCC_CASES(NZ,   0x5)
+    BX_SUPERBLOCK_JCC_CASES(BE,   0x6)
+    BX_SUPERBLOCK_JCC_CASES(NBE,  0x7)
+    BX_SUPERBLOCK_JCC_CASES(S,    0x8)
+    BX_SUPERBLOCK_JCC_CASES(NS,   0x9)
+    BX_SUPERBLOCK_JCC_CASES(P,    0xA)
+    BX_SUPERBLOCK_JCC_CASES(NP,   0xB)
+    BX_SUPERBLOCK_JCC_CASES(L,    0xC)
+    BX_SUPERBLOCK_JCC_CASES(NL,   0xD)
+    BX_SUPERBLOCK_JCC_CASES(LE,   0xE)
+    BX_SUPERBLOCK_JCC_CASES(NLE,  0xF)
+    BX_SUPERBLOCK_JCC_CASES(MP,   BX_SUPERBLOCK_JMP)
+    default:
+      return -1;
+  }
+}
+
+// Decide if the trace building should continue at the target of just decoded
+// branch instruction. Unconditional jumps are always followed, conditional
+// branches are predicted statically (backward taken, forward not taken) and
+// followed only when predicted taken and not found mispredicted too often by
+// the side exit profile. The branch target must stay in the current page so
+// the trace still belongs to single physical page.
+bool BX_CPU_C::superblockFollowBranch(bxInstruction_c *i, bx_address rip, bx_address *target)
+{
+  int cond = superblockBranchCondition(i->getIaOpcode());
+  if (cond < 0) return false;
+
+  bx_address next_rip = rip + i->ilen(), new_rip;
+
+#if BX_SUPPORT_X86_64
+  if (long64_mode())
+    new_rip = next_rip + (Bit32s) i->Id();
+  else
+#endif
+  if (i->os32L())
+    new_rip = (Bit32u) (next_rip + (Bit32s) i->Id());
+  else
+    new_rip = (Bit16u) (next_rip + (Bit16s) i->Iw());
+
+  if ((new_rip + BX_CPU_THIS_PTR eipPageBias) >= BX_CPU_THIS_PTR eipPageWindowSize)
+    return false;
+
+  if (cond == BX_SUPERBLOCK_JMP) {
+#if BX_SUPPORT_X86_64
+    if (long64_mode())
+      i->execute1 = &BX_CPU_C::BxSuperblockJMP_Jq;
+    else
+#endif
+    if (i->os32L())
+      i->execute1 = &BX_CPU_C::BxSuperblockJMP_Jd;
+    else
+      i->execute1 = &BX_CPU_C::BxSuperblockJMP_Jw;
+  }
+  else {
+    if (new_rip >= next_rip) return false;
+    if (BX_CPU_THIS_PTR superblock_exits[BX_SUPERBLOCK_PROFILE_HASH(rip)] >= BX_SUPERBLOCK_EXIT_THRESHOLD)
+      return false;
+
+    i->setSuperblockCond(cond);
+#if BX_SUPPORT_X86_64
+    if (long64_mode())
+      i->execute1 = &BX_CPU_C::BxSuperblockJcc_Jq;
+    else
+#endif
+    if (i->os32L())
+      i->execute1 = &BX_CPU_C::BxSuperblockJcc_Jd;
+    else
+      i->execute1 = &BX_CPU_C::BxSuperblockJcc_Jw;
+  }
+
+  INC_CPU_STAT(iCacheSuperblockBranches);
+
+  *target = new_rip;
+  return true;
+}
+
+// Conditional branch inside superblock was not taken. When this happens too
+// often, invalidate the traces containing the branch so they are rebuilt
+// without following it.
+void BX_CPU_C::superblockSideExit(void)
+{
+  Bit8u *exits = &BX_CPU_THIS_PTR superblock_exits[BX_SUPERBLOCK_PROFILE_HASH(BX_CPU_THIS_PTR prev_rip)];
+  unsigned n = *exits + BX_SUPERBLOCK_EXIT_PENALTY;
+  if (n < BX_SUPERBLOCK_EXIT_THRESHOLD) {
+    *exits = n;
+    return;
+  }
+
+  *exits = BX_SUPERBLOCK_EXIT_THRESHOLD;
+
+  bx_address eipBiased = BX_CPU_THIS_PTR prev_rip + BX_CPU_THIS_PTR eipPageBias;
+  if (eipBiased < BX_CPU_THIS_PTR eipPageWindowSize) {
+    INC_CPU_STAT(iCacheSideExitRebuilds);
+    bx_phy_address pAddr = BX_CPU_THIS_PTR pAddrFetchPage + eipBiased;
+    BX_CPU_THIS_PTR async_event |= BX_ASYNC_EVENT_STOP_TRACE;
+    // the code is not modified, only the traces are rebuilt
+    BX_CPU_THIS_PTR iCache.handleSMC(pAddr, 1 << (PAGE_OFFSET((Bit32u) pAddr) >> 7), false);
+  }
+}
+
+#endif
+
 bool BX_CPU_C::mergeTraces(bxICacheEntry_c *entry, bxInstruction_c *i, bx_phy_address pAddr)
 {
   BX_ASSERT(!bx_dbg.debugger_active);
 
   bxICacheEntry_c *e = BX_CPU_THIS_PTR iCache.find_entry(pAddr, BX_CPU_THIS_PTR fetchModeMask);
 
-  if (e != NULL)
+  // superblock branch might lead back to the start of the trace being built
+  if (e != NULL && e != entry)
   {
     // determine max amount of instruction to take from another entry
+    bxInstruction_c *src = e->i;
     unsigned max_length = e->tlen;
 
+#if BX_SUPPORT_JIT
+    // merged instructions are counted by the header of this trace
+    if (isJitHeader(src)) {
+      src++;
+      max_length--;
+    }
+#endif
+
 #if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
     if (max_length + entry->tlen > BX_MAX_TRACE_LENGTH)
         return false;
@@ -237,7 +560,7 @@ bool BX_CPU_C::mergeTraces(bxICacheEntry_c *entry, bxInstruction_c *i, bx_phy_ad
     if(max_length == 0) return false;
 #endif
 
-    memcpy(i, e->i, sizeof(bxInstruction_c)*max_length);
+    memcpy(i, src, sizeof(bxInstruction_c)*max_length);
     entry->tlen += max_length;
     BX_ASSERT(entry->tlen <= BX_MAX_TRACE_LENGTH);
 
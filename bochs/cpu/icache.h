@@ -26,26 +26,68 @@
 
 extern void handleSMC(bx_phy_address pAddr, Bit32u mask);
 
+// Physical pages are tracked in 4G chunks covering the whole physical address
+// space. Chunks without any code share single zero filled mapping table, the
+// private table for a chunk is allocated when the first trace is created in it.
+#define BX_WRITE_STAMP_PAGES_IN_4G (1024*1024)
+#if BX_PHY_ADDRESS_LONG
+  #define BX_WRITE_STAMP_CHUNKS (1 << (BX_PHY_ADDRESS_WIDTH - 32))
+#else
+  #define BX_WRITE_STAMP_CHUNKS 1
+#endif
+
 class bxPageWriteStampTable
 {
-  const Bit32u PHY_MEM_PAGES_IN_4G_SPACE;
-  Bit32u *fineGranularityMapping;
+  Bit32u *fineGranularityMapping[BX_WRITE_STAMP_CHUNKS];
+  Bit32u *zeroMapping;
 
 public:
-  bxPageWriteStampTable(): PHY_MEM_PAGES_IN_4G_SPACE(1024*1024) {
-    fineGranularityMapping = new Bit32u[PHY_MEM_PAGES_IN_4G_SPACE];
-    resetWriteStamps();
+  bxPageWriteStampTable() {
+    zeroMapping = new Bit32u[BX_WRITE_STAMP_PAGES_IN_4G];
+    memset(zeroMapping, 0, sizeof(Bit32u) * BX_WRITE_STAMP_PAGES_IN_4G);
+    for (unsigned n=0; n<BX_WRITE_STAMP_CHUNKS; n++)
+      fineGranularityMapping[n] = zeroMapping;
+  }
+ ~bxPageWriteStampTable() {
+    for (unsigned n=0; n<BX_WRITE_STAMP_CHUNKS; n++) {
+      if (fineGranularityMapping[n] != zeroMapping)
+        delete [] fineGranularityMapping[n];
+    }
+    delete [] zeroMapping;
+  }
+
+  BX_CPP_INLINE static unsigned chunk(bx_phy_address pAddr) {
+#if BX_PHY_ADDRESS_LONG
+    return unsigned(pAddr >> 32) & (BX_WRITE_STAMP_CHUNKS-1);
+#else
+    return 0;
+#endif
   }
- ~bxPageWriteStampTable() { delete [] fineGranularityMapping; }
 
   BX_CPP_INLINE static Bit32u hash(bx_phy_address pAddr) {
-    // can share writeStamps between multiple pages if >32 bit phy address
     return ((Bit32u) pAddr) >> 12;
   }
 
   BX_CPP_INLINE Bit32u getFineGranularityMapping(bx_phy_address pAddr) const
   {
-    return fineGranularityMapping[hash(pAddr)];
+    return fineGranularityMapping[chunk(pAddr)][hash(pAddr)];
+  }
+
+  BX_CPP_INLINE Bit32u *getChunkForUpdate(bx_phy_address pAddr)
+  {
+    unsigned n = chunk(pAddr);
+    if (fineGranularityMapping[n] == zeroMapping) {
+      Bit32u *mapping = new Bit32u[BX_WRITE_STAMP_PAGES_IN_4G];
+      memset(mapping, 0, sizeof(Bit32u) * BX_WRITE_STAMP_PAGES_IN_4G);
+#if BX_SUPPORT_SMP
+      // processors running in other host threads might install the chunk first
+      if (! bx_atomic_cmpxchg_ptr((void **) &fineGranularityMapping[n], zeroMapping, mapping))
+        delete [] mapping;
+#else
+      fineGranularityMapping[n] = mapping;
+#endif
+    }
+    return fineGranularityMapping[n];
   }
 
   BX_CPP_INLINE void markICache(bx_phy_address pAddr, unsigned len)
@@ -53,38 +95,40 @@ public:
     Bit32u mask  = 1 << (PAGE_OFFSET((Bit32u) pAddr) >> 7);
            mask |= 1 << (PAGE_OFFSET((Bit32u) pAddr + len - 1) >> 7);
 
-    fineGranularityMapping[hash(pAddr)] |= mask;
+    getChunkForUpdate(pAddr)[hash(pAddr)] |= mask;
   }
 
   BX_CPP_INLINE void markICacheMask(bx_phy_address pAddr, Bit32u mask)
   {
-    fineGranularityMapping[hash(pAddr)] |= mask;
+    getChunkForUpdate(pAddr)[hash(pAddr)] |= mask;
   }
 
   // whole page is being altered
   BX_CPP_INLINE void decWriteStamp(bx_phy_address pAddr)
   {
+    Bit32u *mapping = fineGranularityMapping[chunk(pAddr)];
     Bit32u index = hash(pAddr);
 
-    if (fineGranularityMapping[index]) {
+    if (mapping[index]) {
       handleSMC(pAddr, 0xffffffff); // one of the CPUs might be running trace from this page
-      fineGranularityMapping[index] = 0;
+      mapping[index] = 0;
     }
   }
 
   // assumption: write does not split 4K page
   BX_CPP_INLINE void decWriteStamp(bx_phy_address pAddr, unsigned len)
   {
+    Bit32u *mapping = fineGranularityMapping[chunk(pAddr)];
     Bit32u index = hash(pAddr);
 
-    if (fineGranularityMapping[index]) {
+    if (mapping[index]) {
        Bit32u mask  = 1 << (PAGE_OFFSET((Bit32u) pAddr) >> 7);
               mask |= 1 << (PAGE_OFFSET((Bit32u) pAddr + len - 1) >> 7);
 
-       if (fineGranularityMapping[index] & mask) {
+       if (mapping[index] & mask) {
           // one of the CPUs might be running trace from this page
           handleSMC(pAddr, mask);
-          fineGranularityMapping[index] &= ~mask;
+          mapping[index] &= ~mask;
        }
     }
   }
@@ -94,15 +138,20 @@ public:
 
 BX_CPP_INLINE void bxPageWriteStampTable::resetWriteStamps(void)
 {
-  for (Bit32u i=0; i<PHY_MEM_PAGES_IN_4G_SPACE; i++) {
-    fineGranularityMapping[i] = 0;
+  for (unsigned n=0; n<BX_WRITE_STAMP_CHUNKS; n++) {
+    if (fineGranularityMapping[n] != zeroMapping)
+      memset(fineGranularityMapping[n], 0, sizeof(Bit32u) * BX_WRITE_STAMP_PAGES_IN_4G);
   }
 }
 
 extern bxPageWriteStampTable pageWriteStampTable;
 
-#define BxICacheEntries (64  * 1024)  // Must be a power of 2.
-#define BxICacheMemPool (576 * 1024)
+// The trace cache is set associative with runtime configurable size and
+// associativity. Every set is indexed by the low bits of the physical address,
+// so all traces starting in the same 4K page live in consecutive sets.
+#define BX_ICACHE_MIN_SETS        (4 * 1024)
+#define BX_ICACHE_POOL_PER_ENTRY   9 /* 576K instructions for 64K entries */
+#define BX_ICACHE_POOL_REGIONS     8 /* must be power of two */
 
 struct bxICacheEntry_c
 {
@@ -111,8 +160,14 @@ struct bxICacheEntry_c
 
   Bit32u tlen;          // Trace length in instructions
   bxInstruction_c *i;
+
+  Bit32u pageNext;      // Next entry in the page index list
+  Bit32u pagePrev;      // Previous entry or page index bucket
 };
 
+#define BX_ICACHE_NO_LINK     0xffffffff
+#define BX_ICACHE_BUCKET_LINK 0x80000000
+
 #define BX_MAX_TRACE_LENGTH 32
 
 static const bx_phy_address BX_ICACHE_INVALID_PHY_ADDRESS = bx_phy_address(-1);
@@ -121,12 +176,25 @@ void flushSMC(bxICacheEntry_c *e);
 
 class BOCHSAPI bxICache_c {
 public:
-  bxICacheEntry_c entry[BxICacheEntries];
-  bxInstruction_c mpool[BxICacheMemPool];
-  unsigned mpindex;
+  bxICacheEntry_c *entry;
+  bxInstruction_c *mpool;
+  unsigned mpindex;     // next free instruction in the memory pool
+  unsigned mpend;       // end of the free area in the memory pool
+
+  unsigned sets, ways, setMask;
+  unsigned mpoolSize, mpoolRegionSize;
+
+  // reverse index: lists of the entries holding traces from the same
+  // physical page, used to find the traces affected by SMC
+  Bit32u *pageIndex;
 
   Bit32u traceLinkTimeStamp;
 
+  // flush rate counters
+  Bit64u flushes;       // whole trace cache flushes
+  Bit64u reclaims;      // memory pool regions reclaimed
+  Bit64u evictions;     // valid traces replaced because of set conflict
+
 #define BX_ICACHE_PAGE_SPLIT_ENTRIES 8 /* must be power of two */
   struct pageSplitEntryIndex {
     bx_phy_address ppf; // Physical address of 2nd page of the trace
@@ -134,34 +202,86 @@ public:
   } pageSplitIndex[BX_ICACHE_PAGE_SPLIT_ENTRIES];
   int nextPageSplitIndex;
 
+#if BX_SUPPORT_JIT
+  // traces modified by SMC after being compiled by the JIT are not compiled
+  // again, indexed by hash of the trace physical address
+#define BX_JIT_SMC_HASH_SIZE 4096 /* must be power of two */
+  Bit8u jitSmcTraces[BX_JIT_SMC_HASH_SIZE];
+
+  BX_CPP_INLINE unsigned jit_smc_hash(bx_phy_address pAddr) const
+  {
+    return (unsigned)(pAddr ^ (pAddr >> 12)) & (BX_JIT_SMC_HASH_SIZE-1);
+  }
+#endif
+
 public:
-  bxICache_c() { flushICacheEntries(); }
+  bxICache_c(): entry(NULL), mpool(NULL), sets(0), ways(0), setMask(0),
+      mpoolSize(0), mpoolRegionSize(0), pageIndex(NULL),
+      flushes(0), reclaims(0), evictions(0) { flushICacheEntries(); }
+ ~bxICache_c() { delete [] entry; delete [] mpool; delete [] pageIndex; }
 
-  BX_CPP_INLINE static unsigned hash(bx_phy_address pAddr, unsigned fetchModeMask)
+  void init(unsigned numEntries, unsigned numWays);
+
+  BX_CPP_INLINE unsigned hash(bx_phy_address pAddr, unsigned fetchModeMask) const
   {
-//  return ((pAddr + (pAddr << 2) + (pAddr>>6)) & (BxICacheEntries-1)) ^ fetchModeMask;
-    return ((pAddr) & (BxICacheEntries-1)) ^ fetchModeMask;
+    return ((pAddr) & setMask) ^ fetchModeMask;
   }
 
   BX_CPP_INLINE void alloc_trace(bxICacheEntry_c *e)
   {
     // took +1 garbend for instruction chaining speedup (end-of-trace opcode)
-    if ((mpindex + BX_MAX_TRACE_LENGTH + 1) > BxICacheMemPool) {
-      flushICacheEntries();
+    if ((mpindex + BX_MAX_TRACE_LENGTH + 1) > mpend) {
+      reclaimPoolRegion();
     }
     e->i = &mpool[mpindex];
     e->tlen = 0;
   }
 
-  BX_CPP_INLINE void commit_trace(unsigned len) { mpindex += len; }
+  BX_CPP_INLINE unsigned page_hash(bx_phy_address pAddr) const
+  {
+    return (unsigned)(pAddr >> 12) & setMask;
+  }
+
+  BX_CPP_INLINE void link_page_entry(bxICacheEntry_c *e)
+  {
+    unsigned bucket = page_hash(e->pAddr);
+    Bit32u index = Bit32u(e - entry);
+
+    e->pageNext = pageIndex[bucket];
+    e->pagePrev = BX_ICACHE_BUCKET_LINK | bucket;
+    if (e->pageNext != BX_ICACHE_NO_LINK)
+      entry[e->pageNext].pagePrev = index;
+    pageIndex[bucket] = index;
+  }
+
+  BX_CPP_INLINE void unlink_page_entry(bxICacheEntry_c *e)
+  {
+    if (e->pagePrev == BX_ICACHE_NO_LINK) return;
+
+    if (e->pagePrev & BX_ICACHE_BUCKET_LINK)
+      pageIndex[e->pagePrev & ~BX_ICACHE_BUCKET_LINK] = e->pageNext;
+    else
+      entry[e->pagePrev].pageNext = e->pageNext;
+    if (e->pageNext != BX_ICACHE_NO_LINK)
+      entry[e->pageNext].pagePrev = e->pagePrev;
+
+    e->pageNext = e->pagePrev = BX_ICACHE_NO_LINK;
+  }
+
+  BX_CPP_INLINE void commit_trace(bxICacheEntry_c *e)
+  {
+    mpindex += e->tlen;
+    link_page_entry(e);
+  }
 
   BX_CPP_INLINE void commit_page_split_trace(bx_phy_address paddr, bxICacheEntry_c *e)
   {
     mpindex += e->tlen;
+    link_page_entry(e);
 
     // register page split entry
     if (pageSplitIndex[nextPageSplitIndex].ppf != BX_ICACHE_INVALID_PHY_ADDRESS)
-      pageSplitIndex[nextPageSplitIndex].e->pAddr = BX_ICACHE_INVALID_PHY_ADDRESS;
+      flushSMC(pageSplitIndex[nextPageSplitIndex].e);
 
     pageSplitIndex[nextPageSplitIndex].ppf = paddr;
     pageSplitIndex[nextPageSplitIndex].e = e;
@@ -169,22 +289,68 @@ public:
     nextPageSplitIndex = (nextPageSplitIndex+1) & (BX_ICACHE_PAGE_SPLIT_ENTRIES-1);
   }
 
-  BX_CPP_INLINE void handleSMC(bx_phy_address pAddr, Bit32u mask);
+  BX_CPP_INLINE void handleSMC(bx_phy_address pAddr, Bit32u mask, bool codeModified = true);
 
   BX_CPP_INLINE void flushICacheEntries(void);
 
+  void reclaimPoolRegion(void);
+
+  BX_CPP_INLINE bxICacheEntry_c* get_set(bx_phy_address pAddr, unsigned fetchModeMask)
+  {
+    return &(entry[hash(pAddr, fetchModeMask) * ways]);
+  }
+
+  // fetch mode of the trace held by the entry, recovered from its set index
+  BX_CPP_INLINE unsigned fetch_mode(const bxICacheEntry_c *e) const
+  {
+    return (unsigned(e - entry) / ways) ^ ((unsigned) e->pAddr & setMask);
+  }
+
+  // distance of the trace from the oldest allocated trace in the memory pool
+  BX_CPP_INLINE unsigned trace_age(const bxICacheEntry_c *e) const
+  {
+    unsigned index = unsigned(e->i - mpool);
+    return (index >= mpend) ? (index - mpend) : (index + mpoolSize - mpend);
+  }
+
+  // select entry for a new trace: free way or the way holding the oldest trace
   BX_CPP_INLINE bxICacheEntry_c* get_entry(bx_phy_address pAddr, unsigned fetchModeMask)
   {
-    return &(entry[hash(pAddr, fetchModeMask)]);
+    bxICacheEntry_c* e = get_set(pAddr, fetchModeMask);
+    bxICacheEntry_c* victim = NULL;
+    unsigned victimAge = 0xffffffff;
+
+    for (unsigned way=0; way < ways; way++, e++) {
+      if (e->pAddr == BX_ICACHE_INVALID_PHY_ADDRESS) {
+        victim = e;
+        break;
+      }
+      unsigned age = trace_age(e);
+      if (age < victimAge) {
+        victimAge = age;
+        victim = e;
+      }
+    }
+
+    if (victim->pAddr != BX_ICACHE_INVALID_PHY_ADDRESS && victim->pagePrev != BX_ICACHE_NO_LINK) {
+      // the evicted trace might be linked from other traces
+      flushSMC(victim);
+      evictions++;
+    }
+
+    unlink_page_entry(victim);
+    return victim;
   }
 
   BX_CPP_INLINE bxICacheEntry_c* find_entry(bx_phy_address pAddr, unsigned fetchModeMask)
   {
-    bxICacheEntry_c* e = get_entry(pAddr, fetchModeMask);
-    if (e->pAddr != pAddr)
-       return NULL;
+    bxICacheEntry_c* e = get_set(pAddr, fetchModeMask);
+    for (unsigned way=0; way < ways; way++, e++) {
+      if (e->pAddr == pAddr)
+        return e;
+    }
 
-    return e;
+    return NULL;
   }
 
   BX_CPP_INLINE bool breakLinks()
@@ -203,9 +369,15 @@ BX_CPP_INLINE void bxICache_c::flushICacheEntries(void)
   bxICacheEntry_c* e = entry;
   unsigned i;
 
-  for (i=0; i<BxICacheEntries; i++, e++) {
+  for (i=0; i < sets*ways; i++, e++) {
     e->pAddr = BX_ICACHE_INVALID_PHY_ADDRESS;
     e->traceMask = 0;
+    e->pageNext = e->pagePrev = BX_ICACHE_NO_LINK;
+  }
+
+  if (pageIndex) {
+    for (i=0; i < sets; i++)
+      pageIndex[i] = BX_ICACHE_NO_LINK;
   }
 
   nextPageSplitIndex = 0;
@@ -213,54 +385,55 @@ BX_CPP_INLINE void bxICache_c::flushICacheEntries(void)
     pageSplitIndex[i].ppf = BX_ICACHE_INVALID_PHY_ADDRESS;
 
   mpindex = 0;
+  mpend = mpoolSize;
 
   traceLinkTimeStamp = 0;
+
+  flushes++;
 }
 
-BX_CPP_INLINE void bxICache_c::handleSMC(bx_phy_address pAddr, Bit32u mask)
+BX_CPP_INLINE void bxICache_c::handleSMC(bx_phy_address pAddr, Bit32u mask, bool codeModified)
 {
-  Bit32u pAddrIndex = bxPageWriteStampTable::hash(pAddr);
-
-  // break all links bewteen traces
-  if (breakLinks()) return;
-
   // Need to invalidate all traces in the trace cache that might include an
   // instruction that was modified.  But this is not enough, it is possible
   // that some another trace is linked into  invalidated trace and it won't
   // be invalidated. In order to solve this issue  replace all instructions
-  // from the invalidated trace with dummy EndOfTrace opcodes.
+  // from the invalidated trace with dummy EndOfTrace opcodes (see flushSMC).
+  // The dummy opcodes are not generated when debugger is active, break all
+  // links bewteen traces instead.
+  if (bx_dbg.debugger_active) {
+    if (breakLinks()) return;
+  }
 
-  // Another corner case that has to be handled - pageWriteStampTable wrap.
-  // Multiple physical addresses could be mapped into single pageWriteStampTable
-  // entry and all of them have to be invalidated here now.
+  bx_phy_address ppf = PPFOf(pAddr);
 
   if (mask & 0x1) {
     // the store touched 1st cache line in the page, check for
     // page split traces to invalidate.
     for (unsigned i=0;i<BX_ICACHE_PAGE_SPLIT_ENTRIES;i++) {
-      if (pageSplitIndex[i].ppf != BX_ICACHE_INVALID_PHY_ADDRESS) {
-        if (pAddrIndex == bxPageWriteStampTable::hash(pageSplitIndex[i].ppf)) {
-          pageSplitIndex[i].ppf = BX_ICACHE_INVALID_PHY_ADDRESS;
-          flushSMC(pageSplitIndex[i].e);
-        }
+      if (pageSplitIndex[i].ppf == ppf) {
+        pageSplitIndex[i].ppf = BX_ICACHE_INVALID_PHY_ADDRESS;
+        flushSMC(pageSplitIndex[i].e);
       }
     }
   }
 
-  bxICacheEntry_c *e = get_entry(LPFOf(pAddr), 0);
-
-  // go over 32 "cache lines" of 128 byte each
-  for (unsigned n=0; n < 32; n++) {
-    Bit32u line_mask = (1 << n);
-    if (line_mask > mask) break;
-    for (unsigned index=0; index < 128; index++, e++) {
-      if (pAddrIndex == bxPageWriteStampTable::hash(e->pAddr) && (e->traceMask & mask) != 0) {
-        flushSMC(e);
-      }
+  // walk over all traces from the modified page
+  Bit32u index = pageIndex[page_hash(pAddr)];
+  while (index != BX_ICACHE_NO_LINK) {
+    bxICacheEntry_c *e = &entry[index];
+    index = e->pageNext;
+    if (e->pAddr != BX_ICACHE_INVALID_PHY_ADDRESS && PPFOf(e->pAddr) == ppf && (e->traceMask & mask) != 0) {
+#if BX_SUPPORT_JIT
+      if (codeModified && e->i->isJitCompiled())
+        jitSmcTraces[jit_smc_hash(e->pAddr)] = 1;
+#endif
+      flushSMC(e);
     }
   }
 }
 
 extern void flushICaches(void);
+extern void saveTraceFile(void);
 
 #endif
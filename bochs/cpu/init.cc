@@ -28,6 +28,8 @@
 #include "gui/siminterface.h"
 #include "param_names.h"
 #include "cpustats.h"
+#include "tracefile.h"
+#include "profile.h"
 
 #if BX_SUPPORT_APIC
 #include "apic.h"
@@ -74,7 +76,18 @@ BX_CPU_C::BX_CPU_C(unsigned id): bx_cpuid(id)
   svm_extensions_bitmask = 0;
 #endif
 
-  stats = NULL;
+#if BX_SUPPORT_JIT
+  jit_code_buffer = NULL;
+#endif
+
+  profile = NULL;
+
+#if BX_SUPPORT_SMP
+  smc_pending_count = 0;
+  sipi_pending = 0;
+  rmw_locked = 0;
+  spin_wait_hint = 0;
+#endif
 
   srand(time(NULL)); // initialize random generator for RDRAND/RDSEED
 }
@@ -207,6 +220,39 @@ void BX_CPU_C::initialize(void)
 
   init_FetchDecodeTables(); // must be called after init_isa_features_bitmask()
 
+  // trace cache size and associativity are rounded down to power of two
+  unsigned icache_size = 1, icache_ways = 1;
+  while (icache_size*2 <= (unsigned) SIM->get_param_num(BXPN_ICACHE_SIZE)->get())
+    icache_size *= 2;
+  while (icache_ways*2 <= (unsigned) SIM->get_param_num(BXPN_ICACHE_WAYS)->get())
+    icache_ways *= 2;
+  BX_CPU_THIS_PTR iCache.init(icache_size * 1024, icache_ways);
+  BX_INFO(("trace cache: %uK entries, %u-way set associative", icache_size, icache_ways));
+
+  TLB_resetContexts();
+
+#if BX_SUPPORT_SUPERBLOCKS
+  BX_CPU_THIS_PTR superblocks = SIM->get_param_bool(BXPN_SUPERBLOCKS)->get();
+  memset(BX_CPU_THIS_PTR superblock_exits, 0, sizeof(BX_CPU_THIS_PTR superblock_exits));
+  if (BX_CPU_THIS_PTR superblocks)
+    BX_INFO(("superblock traces enabled"));
+#endif
+
+#if BX_SUPPORT_JIT
+  jitInit();
+#endif
+
+  // decoded traces are shared by all processors
+  if (BX_CPU_ID == 0) {
+    bx_param_string_c *icache_file = SIM->get_param_string(BXPN_ICACHE_FILE);
+    if (! icache_file->isempty())
+      traceFile.load(icache_file->getptr(), this);
+  }
+
+  if (BX_CPU_ID == 0)
+    initProfile();
+  profile_countdown = SIM->get_param_num(BXPN_PROFILE_PERIOD)->get();
+
 #if BX_CPU_LEVEL >= 6
   xsave_xrestor_init();
 #endif
@@ -252,39 +298,69 @@ void BX_CPU_C::initialize(void)
 // statistics
 void BX_CPU_C::init_statistics(void)
 {
-#if InstrumentCPU
-  stats = new bx_cpu_statistics;
+#if BX_ENABLE_STATISTICS
+  static const char *exception_name[BX_CPU_HANDLED_EXCEPTIONS] = {
+    "DE", "DB", "NMI", "BP", "OF", "BR", "UD", "NM",
+    "DF", "vector9", "TS", "NP", "SS", "GP", "PF", "vector15",
+    "MF", "AC", "MC", "XM", "VE", "CP", "vector22", "vector23",
+    "vector24", "vector25", "vector26", "vector27", "vector28", "vector29", "SX", "vector31"
+  };
 
   bx_list_c *cpu = new bx_list_c(SIM->get_statistics_root(), get_name(), get_name());
 
-#if InstrumentICACHE
-  new bx_shadow_num_c(cpu, "iCacheLookups", &stats->iCacheLookups);
-  new bx_shadow_num_c(cpu, "iCachePrefetch", &stats->iCachePrefetch);
-  new bx_shadow_num_c(cpu, "iCacheMisses", &stats->iCacheMisses);
+  new bx_shadow_num_c(cpu, "iCacheLookups", &stats.iCacheLookups);
+  new bx_shadow_num_c(cpu, "iCachePrefetch", &stats.iCachePrefetch);
+  new bx_shadow_num_c(cpu, "iCacheMisses", &stats.iCacheMisses);
+  new bx_shadow_num_c(cpu, "iCacheFlushes", &iCache.flushes);
+  new bx_shadow_num_c(cpu, "iCacheReclaims", &iCache.reclaims);
+  new bx_shadow_num_c(cpu, "iCacheEvictions", &iCache.evictions);
+#if BX_SUPPORT_SUPERBLOCKS
+  new bx_shadow_num_c(cpu, "iCacheSuperblockBranches", &stats.iCacheSuperblockBranches);
+  new bx_shadow_num_c(cpu, "iCacheSideExitRebuilds", &stats.iCacheSideExitRebuilds);
 #endif
-
-#if InstrumentTLB
-  new bx_shadow_num_c(cpu, "tlbLookups", &stats->tlbLookups);
-  new bx_shadow_num_c(cpu, "tlbExecuteLookups", &stats->tlbExecuteLookups);
-  new bx_shadow_num_c(cpu, "tlbWriteLookups", &stats->tlbWriteLookups);
-  new bx_shadow_num_c(cpu, "tlbMisses", &stats->tlbMisses);
-  new bx_shadow_num_c(cpu, "tlbExecuteMisses", &stats->tlbExecuteMisses);
-  new bx_shadow_num_c(cpu, "tlbWriteMisses", &stats->tlbWriteMisses);
+#if BX_SUPPORT_JIT
+  new bx_shadow_num_c(cpu, "iCacheJitTraces", &stats.iCacheJitTraces);
+  new bx_shadow_num_c(cpu, "iCacheJitResets", &stats.iCacheJitResets);
 #endif
+  new bx_shadow_num_c(cpu, "iCacheFileTraces", &stats.iCacheFileTraces);
 
-#if InstrumentTLBFlush
-  new bx_shadow_num_c(cpu, "tlbGlobalFlushes", &stats->tlbGlobalFlushes);
-  new bx_shadow_num_c(cpu, "tlbNonGlobalFlushes", &stats->tlbNonGlobalFlushes);
+#if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS && BX_ENABLE_TRACE_LINKING
+  new bx_shadow_num_c(cpu, "traceLinks", &stats.traceLinks);
+  new bx_shadow_num_c(cpu, "traceLinkMisses", &stats.traceLinkMisses);
+  new bx_shadow_num_c(cpu, "traceLinkBreaks", &stats.traceLinkBreaks);
 #endif
 
-#if InstrumentStackPrefetch
-  new bx_shadow_num_c(cpu, "stackPrefetch", &stats->stackPrefetch);
+  new bx_shadow_num_c(cpu, "tlbLookups", &stats.tlbLookups);
+  new bx_shadow_num_c(cpu, "tlbExecuteLookups", &stats.tlbExecuteLookups);
+  new bx_shadow_num_c(cpu, "tlbWriteLookups", &stats.tlbWriteLookups);
+  new bx_shadow_num_c(cpu, "tlbMisses", &stats.tlbMisses);
+  new bx_shadow_num_c(cpu, "tlbExecuteMisses", &stats.tlbExecuteMisses);
+  new bx_shadow_num_c(cpu, "tlbWriteMisses", &stats.tlbWriteMisses);
+  new bx_shadow_num_c(cpu, "stlbHits", &stats.stlbHits);
+  new bx_shadow_num_c(cpu, "stlbMisses", &stats.stlbMisses);
+  new bx_shadow_num_c(cpu, "tlbWalkCacheHits", &stats.tlbWalkCacheHits);
+  new bx_shadow_num_c(cpu, "pageWalks", &stats.pageWalks);
+#if (BX_SUPPORT_VMX >= 2) || BX_SUPPORT_SVM
+  new bx_shadow_num_c(cpu, "tlbNestedWalkCacheHits", &stats.tlbNestedWalkCacheHits);
+  new bx_shadow_num_c(cpu, "nestedPageWalks", &stats.nestedPageWalks);
 #endif
 
-#if InstrumentSMC
-  new bx_shadow_num_c(cpu, "smc", &stats->smc);
-#endif
+  new bx_shadow_num_c(cpu, "tlbGlobalFlushes", &stats.tlbGlobalFlushes);
+  new bx_shadow_num_c(cpu, "tlbNonGlobalFlushes", &stats.tlbNonGlobalFlushes);
+  new bx_shadow_num_c(cpu, "tlbContextSwitches", &stats.tlbContextSwitches);
+  new bx_shadow_num_c(cpu, "tlbContextFlushes", &stats.tlbContextFlushes);
+  new bx_shadow_num_c(cpu, "tlbContextReclaims", &stats.tlbContextReclaims);
 
+  new bx_shadow_num_c(cpu, "stackPrefetch", &stats.stackPrefetch);
+
+  new bx_shadow_num_c(cpu, "smc", &stats.smc);
+  new bx_shadow_num_c(cpu, "rmwRestarts", &stats.rmwRestarts);
+
+  new bx_shadow_num_c(cpu, "asyncEvents", &stats.asyncEvents);
+
+  bx_list_c *exceptions = new bx_list_c(cpu, "exceptions", "exceptions by vector");
+  for (unsigned n=0; n < BX_CPU_HANDLED_EXCEPTIONS; n++)
+    new bx_shadow_num_c(exceptions, exception_name[n], &stats.exceptions[n]);
 #endif
 }
 
@@ -816,6 +892,9 @@ void BX_CPU_C::after_restore_state(void)
   BX_CPU_THIS_PTR linaddr_width = BX_CPU_THIS_PTR cr4.get_LA57() ? 57 : 48;
 #endif
 
+  // TLB entries restored with the CPU state are tagged with unknown contexts
+  TLB_resetContexts();
+
   handleCpuContextChange();
 
   assert_checks();
@@ -841,10 +920,12 @@ BX_CPU_C::~BX_CPU_C()
   delete vmcb;
 #endif
 
-#if InstrumentCPU
-  delete stats;
+#if BX_SUPPORT_JIT
+  jitFree();
 #endif
 
+  delete profile;
+
 #if BX_CPU_LEVEL >= 5
   destroy_MSRs();
 #endif
@@ -0,0 +1,552 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#define NEED_CPU_REG_SHORTCUTS 1
+#include "bochs.h"
+#include "cpu.h"
+#define LOG_THIS BX_CPU_THIS_PTR
+
+#include "gui/siminterface.h"
+#include "param_names.h"
+#include "cpustats.h"
+
+#if BX_SUPPORT_JIT
+
+#include "jit.h"
+
+#include <sys/mman.h>
+
+// The JIT compiles the leading part of a hot trace into host code. Integer
+// ALU and register move instructions are translated inline and update the
+// lazy flags exactly like their handlers do. Memory accesses and a few other
+// simple instructions call their regular handlers, so all accesses go through
+// the TLB fast paths in access.cc. The compiled part ends at the first
+// instruction which is neither, including all branches, and the rest of the
+// trace is executed by the handlers as usual.
+//
+// Every trace built with the JIT enabled starts with a header instruction
+// counting the trace executions. When the trace becomes hot the header is
+// changed to enter the compiled code. SMC replaces the header together with
+// the whole trace, the trace is rebuilt and interpreted from now on.
+
+enum {
+  BX_JIT_MOV_RR,
+  BX_JIT_MOV_RI,
+  BX_JIT_MOV_RI64,
+  BX_JIT_ALU_RR,
+  BX_JIT_ALU_RI,
+  BX_JIT_INC,
+  BX_JIT_DEC,
+  BX_JIT_NEG,
+  BX_JIT_NOT,
+  BX_JIT_ZERO,
+  BX_JIT_CALL
+};
+
+struct bxJitInlineOp {
+  BxExecutePtr_tR handler;
+  Bit8u kind;
+  Bit8u alu;
+  bool is64;
+};
+
+#define BX_JIT_ALU_OPS(op, alu) \
+  { &BX_CPU_C::op##_GdEdR, BX_JIT_ALU_RR, alu, false }, \
+  { &BX_CPU_C::op##_EdIdR, BX_JIT_ALU_RI, alu, false }, \
+  { &BX_CPU_C::op##_GqEqR, BX_JIT_ALU_RR, alu, true  }, \
+  { &BX_CPU_C::op##_EqIdR, BX_JIT_ALU_RI, alu, true  },
+
+static const bxJitInlineOp jitInlineOps[] = {
+  { &BX_CPU_C::MOV_GdEdR,      BX_JIT_MOV_RR,   0, false },
+  { &BX_CPU_C::MOV_EdIdR,      BX_JIT_MOV_RI,   0, false },
+  { &BX_CPU_C::MOV_GqEqR,      BX_JIT_MOV_RR,   0, true  },
+  { &BX_CPU_C::MOV_EqIdR,      BX_JIT_MOV_RI,   0, true  },
+  { &BX_CPU_C::MOV_RRXIq,      BX_JIT_MOV_RI64, 0, true  },
+  { &BX_CPU_C::ZERO_IDIOM_GdR, BX_JIT_ZERO,     0, false },
+  BX_JIT_ALU_OPS(ADD, BX_JIT_ALU_ADD)
+  BX_JIT_ALU_OPS(OR,  BX_JIT_ALU_OR)
+  BX_JIT_ALU_OPS(AND, BX_JIT_ALU_AND)
+  BX_JIT_ALU_OPS(SUB, BX_JIT_ALU_SUB)
+  BX_JIT_ALU_OPS(XOR, BX_JIT_ALU_XOR)
+  BX_JIT_ALU_OPS(CMP, BX_JIT_ALU_CMP)
+  { &BX_CPU_C::TEST_EdGdR,     BX_JIT_ALU_RR, BX_JIT_ALU_TEST, false },
+  { &BX_CPU_C::TEST_EdIdR,     BX_JIT_ALU_RI, BX_JIT_ALU_TEST, false },
+  { &BX_CPU_C::TEST_EqGqR,     BX_JIT_ALU_RR, BX_JIT_ALU_TEST, true  },
+  { &BX_CPU_C::TEST_EqIdR,     BX_JIT_ALU_RI, BX_JIT_ALU_TEST, true  },
+  { &BX_CPU_C::INC_EdR,        BX_JIT_INC,    0, false },
+  { &BX_CPU_C::DEC_EdR,        BX_JIT_DEC,    0, false },
+  { &BX_CPU_C::NEG_EdR,        BX_JIT_NEG,    0, false },
+  { &BX_CPU_C::NOT_EdR,        BX_JIT_NOT,    0, false },
+  { &BX_CPU_C::INC_EqR,        BX_JIT_INC,    0, true  },
+  { &BX_CPU_C::DEC_EqR,        BX_JIT_DEC,    0, true  },
+  { &BX_CPU_C::NEG_EqR,        BX_JIT_NEG,    0, true  },
+  { &BX_CPU_C::NOT_EqR,        BX_JIT_NOT,    0, true  }
+};
+
+// Handlers called directly from the compiled code. Each of them finishes
+// with single BX_NEXT_INSTR and never changes RIP by itself.
+#define BX_JIT_HANDLER_ALU_M(op) \
+  &BX_CPU_C::op##_GdEdM, &BX_CPU_C::op##_EdGdM, &BX_CPU_C::op##_EdIdM, \
+  &BX_CPU_C::op##_GqEqM, &BX_CPU_C::op##_EqGqM, &BX_CPU_C::op##_EqIdM,
+
+#define BX_JIT_HANDLER_CMOV(cc) \
+  &BX_CPU_C::CMOV##cc##_GdEdR, &BX_CPU_C::CMOV##cc##_GqEqR,
+
+static const BxExecutePtr_tR jitCalledHandlers[] = {
+  BX_JIT_HANDLER_ALU_M(ADD)
+  BX_JIT_HANDLER_ALU_M(OR)
+  BX_JIT_HANDLER_ALU_M(ADC)
+  BX_JIT_HANDLER_ALU_M(SBB)
+  BX_JIT_HANDLER_ALU_M(AND)
+  BX_JIT_HANDLER_ALU_M(SUB)
+  BX_JIT_HANDLER_ALU_M(XOR)
+  BX_JIT_HANDLER_ALU_M(CMP)
+  &BX_CPU_C::ADC_GdEdR, &BX_CPU_C::ADC_EdIdR, &BX_CPU_C::ADC_GqEqR, &BX_CPU_C::ADC_EqIdR,
+  &BX_CPU_C::SBB_GdEdR, &BX_CPU_C::SBB_EdIdR, &BX_CPU_C::SBB_GqEqR, &BX_CPU_C::SBB_EqIdR,
+  &BX_CPU_C::TEST_EdGdM, &BX_CPU_C::TEST_EdIdM, &BX_CPU_C::TEST_EqGqM, &BX_CPU_C::TEST_EqIdM,
+  &BX_CPU_C::INC_EdM, &BX_CPU_C::DEC_EdM, &BX_CPU_C::NOT_EdM, &BX_CPU_C::NEG_EdM,
+  &BX_CPU_C::INC_EqM, &BX_CPU_C::DEC_EqM, &BX_CPU_C::NOT_EqM, &BX_CPU_C::NEG_EqM,
+  &BX_CPU_C::MOV32_GdEdM, &BX_CPU_C::MOV32S_GdEdM, &BX_CPU_C::MOV32_EdGdM, &BX_CPU_C::MOV32S_EdGdM,
+  &BX_CPU_C::MOV_EdIdM, &BX_CPU_C::LEA_GdM,
+  &BX_CPU_C::MOV64_GdEdM, &BX_CPU_C::MOV64_EdGdM, &BX_CPU_C::MOV_EqGqM, &BX_CPU_C::MOV64S_EqGqM,
+  &BX_CPU_C::MOV_GqEqM, &BX_CPU_C::MOV64S_GqEqM, &BX_CPU_C::MOV_EqIdM, &BX_CPU_C::LEA_GqM,
+  &BX_CPU_C::MOVZX_GdEbM, &BX_CPU_C::MOVZX_GdEbR, &BX_CPU_C::MOVZX_GdEwM, &BX_CPU_C::MOVZX_GdEwR,
+  &BX_CPU_C::MOVSX_GdEbM, &BX_CPU_C::MOVSX_GdEbR, &BX_CPU_C::MOVSX_GdEwM, &BX_CPU_C::MOVSX_GdEwR,
+  &BX_CPU_C::MOVZX_GqEbM, &BX_CPU_C::MOVZX_GqEbR, &BX_CPU_C::MOVZX_GqEwM, &BX_CPU_C::MOVZX_GqEwR,
+  &BX_CPU_C::MOVSX_GqEbM, &BX_CPU_C::MOVSX_GqEbR, &BX_CPU_C::MOVSX_GqEwM, &BX_CPU_C::MOVSX_GqEwR,
+  &BX_CPU_C::MOVSX_GqEdM, &BX_CPU_C::MOVSX_GqEdR,
+  &BX_CPU_C::PUSH_EdR, &BX_CPU_C::POP_EdR, &BX_CPU_C::PUSH_Id,
+  &BX_CPU_C::PUSH_EqR, &BX_CPU_C::POP_EqR, &BX_CPU_C::PUSH64_Id,
+  &BX_CPU_C::SHL_EdR, &BX_CPU_C::SHR_EdR, &BX_CPU_C::SAR_EdR,
+  &BX_CPU_C::SHL_EqR, &BX_CPU_C::SHR_EqR, &BX_CPU_C::SAR_EqR,
+  &BX_CPU_C::IMUL_GdEdR, &BX_CPU_C::IMUL_GdEdIdR, &BX_CPU_C::IMUL_GqEqR, &BX_CPU_C::IMUL_GqEqIdR,
+#if BX_CPU_LEVEL >= 6
+  BX_JIT_HANDLER_CMOV(O)  BX_JIT_HANDLER_CMOV(NO)
+  BX_JIT_HANDLER_CMOV(B)  BX_JIT_HANDLER_CMOV(NB)
+  BX_JIT_HANDLER_CMOV(Z)  BX_JIT_HANDLER_CMOV(NZ)
+  BX_JIT_HANDLER_CMOV(BE) BX_JIT_HANDLER_CMOV(NBE)
+  BX_JIT_HANDLER_CMOV(S)  BX_JIT_HANDLER_CMOV(NS)
+  BX_JIT_HANDLER_CMOV(P)  BX_JIT_HANDLER_CMOV(NP)
+  BX_JIT_HANDLER_CMOV(L)  BX_JIT_HANDLER_CMOV(NL)
+  BX_JIT_HANDLER_CMOV(LE) BX_JIT_HANDLER_CMOV(NLE)
+#endif
+};
+
+// host address of the handler or NULL if it cannot be called directly
+static const void *jitHandlerAddress(BxExecutePtr_tR handler)
+{
+#if BX_USE_CPU_SMF
+  return (const void *) handler;
+#else
+  // Itanium C++ ABI member function pointer: function address and 'this'
+  // adjustment, odd address stands for virtual function
+  struct {
+    Bit64u ptr;
+    Bit64s adj;
+  } mfp;
+
+  if (sizeof(handler) != sizeof(mfp)) return NULL;
+  memcpy(&mfp, &handler, sizeof(mfp));
+  if (mfp.adj != 0 || (mfp.ptr & 1) != 0) return NULL;
+  return (const void *) mfp.ptr;
+#endif
+}
+
+struct bxJitOp {
+  const bxInstruction_c *i;
+  const bxJitInlineOp *op; // NULL for called handler
+  const void *handler;
+  bool needFlags;
+};
+
+static bool jitDecode(const bxInstruction_c *i, bxJitOp *jop)
+{
+  unsigned n;
+
+  jop->i = i;
+  jop->op = NULL;
+  jop->handler = NULL;
+  jop->needFlags = true;
+
+  for (n=0; n < sizeof(jitInlineOps)/sizeof(jitInlineOps[0]); n++) {
+    if (i->execute1 == jitInlineOps[n].handler) {
+      jop->op = &jitInlineOps[n];
+      return true;
+    }
+  }
+
+  for (n=0; n < sizeof(jitCalledHandlers)/sizeof(jitCalledHandlers[0]); n++) {
+    if (i->execute1 == jitCalledHandlers[n]) {
+      jop->handler = jitHandlerAddress(i->execute1);
+      return jop->handler != NULL;
+    }
+  }
+
+  return false;
+}
+
+// offsets of the processor fields accessed by the compiled code
+struct bxJitOffsets {
+  Bit32u gen_reg;
+  Bit32u rip;
+  Bit32u prev_rip;
+  Bit32u icount;
+  Bit32u async_event;
+  Bit32u lf_result;
+  Bit32u lf_auxbits;
+};
+
+// Compiles lazy flags update after the operation. The operands are in
+// RDX (op1) and RCX (op2), result in RAX. Implements SET_FLAGS_OSZAPC_*
+// and SET_FLAGS_OSZAP_* (preserving CF) macros from lazy_flags.h.
+static void jitEmitFlags(bxJitEmitter &e, const bxJitOffsets &off, unsigned alu, bool is64, bool keepCF)
+{
+  if (is64) {
+    e.store(BX_JIT_RAX, off.lf_result, true);
+  }
+  else {
+    e.movsxd(BX_JIT_RDI, BX_JIT_RAX);
+    e.store(BX_JIT_RDI, off.lf_result, true);
+  }
+
+  if (alu != BX_JIT_ALU_ADD && alu != BX_JIT_ALU_SUB && alu != BX_JIT_ALU_CMP) {
+    // logical operation, no carries
+    e.mov_mem_imm(off.lf_auxbits, 0, true);
+    return;
+  }
+
+  // carries vector into RSI
+  if (alu == BX_JIT_ALU_ADD) {
+    // (op1 & op2) | ((op1 | op2) & ~result)
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RSI, BX_JIT_RDX, is64);
+    e.alu(BX_JIT_ALU_AND, BX_JIT_RSI, BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RDI, BX_JIT_RDX, is64);
+    e.alu(BX_JIT_ALU_OR,  BX_JIT_RDI, BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RCX, BX_JIT_RAX, is64);
+    e.not_reg(BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_AND, BX_JIT_RDI, BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_OR,  BX_JIT_RSI, BX_JIT_RDI, is64);
+  }
+  else {
+    // (~op1 & op2) | ((~op1 ^ op2) & result)
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RSI, BX_JIT_RDX, is64);
+    e.not_reg(BX_JIT_RSI, is64);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RDI, BX_JIT_RSI, is64);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RDI, BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_AND, BX_JIT_RSI, BX_JIT_RCX, is64);
+    e.alu(BX_JIT_ALU_AND, BX_JIT_RDI, BX_JIT_RAX, is64);
+    e.alu(BX_JIT_ALU_OR,  BX_JIT_RSI, BX_JIT_RDI, is64);
+  }
+
+  if (is64) {
+    // (carries & LF_MASK_AF) | ((carries >> 62) << LF_BIT_PO)
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RDI, BX_JIT_RSI, true);
+    e.shr(BX_JIT_RDI, 62, true);
+    e.shl(BX_JIT_RDI, LF_BIT_PO, false);
+    e.alu_imm(4 /* and */, BX_JIT_RSI, LF_MASK_AF, false);
+    e.alu(BX_JIT_ALU_OR, BX_JIT_RSI, BX_JIT_RDI, false);
+  }
+  else {
+    e.alu_imm(4 /* and */, BX_JIT_RSI, ~(LF_MASK_PDB | LF_MASK_SD), false);
+  }
+
+  if (keepCF) {
+    // delta_c = (auxbits ^ temp) & LF_MASK_CF; delta_c ^= (delta_c >> 1)
+    e.load(BX_JIT_RDI, off.lf_auxbits, false);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RDI, BX_JIT_RSI, false);
+    e.alu_imm(4 /* and */, BX_JIT_RDI, LF_MASK_CF, false);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RCX, BX_JIT_RDI, false);
+    e.shr(BX_JIT_RCX, 1, false);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RDI, BX_JIT_RCX, false);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RSI, BX_JIT_RDI, false);
+  }
+
+  e.store(BX_JIT_RSI, off.lf_auxbits, true);
+}
+
+static void jitEmitInline(bxJitEmitter &e, const bxJitOffsets &off, const bxJitOp &jop)
+{
+  const bxInstruction_c *i = jop.i;
+  bool is64 = jop.op->is64;
+  unsigned alu = jop.op->alu;
+  Bit32u dst = off.gen_reg + i->dst() * sizeof(bx_gen_reg_t);
+  Bit32u src = off.gen_reg + i->src() * sizeof(bx_gen_reg_t);
+
+  // 32-bit operations zero extend the result into 64-bit host register,
+  // so results are always stored as 64-bit like BX_WRITE_32BIT_REGZ does
+  switch(jop.op->kind) {
+  case BX_JIT_MOV_RR:
+    e.load(BX_JIT_RAX, src, is64);
+    e.store(BX_JIT_RAX, dst, true);
+    break;
+
+  case BX_JIT_MOV_RI:
+    if (is64)
+      e.mov_simm32(BX_JIT_RAX, i->Id());
+    else
+      e.mov_imm32(BX_JIT_RAX, i->Id());
+    e.store(BX_JIT_RAX, dst, true);
+    break;
+
+  case BX_JIT_MOV_RI64:
+    e.mov_imm64(BX_JIT_RAX, i->Iq());
+    e.store(BX_JIT_RAX, dst, true);
+    break;
+
+  case BX_JIT_ZERO:
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RAX, BX_JIT_RAX, false);
+    e.store(BX_JIT_RAX, dst, true);
+    if (jop.needFlags) {
+      e.mov_mem_imm(off.lf_result, 0, true);
+      e.mov_mem_imm(off.lf_auxbits, 0, true);
+    }
+    break;
+
+  case BX_JIT_ALU_RR:
+  case BX_JIT_ALU_RI:
+    e.load(BX_JIT_RDX, dst, is64);
+    if (jop.op->kind == BX_JIT_ALU_RR)
+      e.load(BX_JIT_RCX, src, is64);
+    else if (is64)
+      e.mov_simm32(BX_JIT_RCX, i->Id());
+    else
+      e.mov_imm32(BX_JIT_RCX, i->Id());
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RAX, BX_JIT_RDX, is64);
+    // TEST and CMP compute the result for the flags only
+    if (alu == BX_JIT_ALU_TEST)
+      e.alu(BX_JIT_ALU_AND, BX_JIT_RAX, BX_JIT_RCX, is64);
+    else if (alu == BX_JIT_ALU_CMP)
+      e.alu(BX_JIT_ALU_SUB, BX_JIT_RAX, BX_JIT_RCX, is64);
+    else {
+      e.alu(alu, BX_JIT_RAX, BX_JIT_RCX, is64);
+      e.store(BX_JIT_RAX, dst, true);
+    }
+    if (jop.needFlags)
+      jitEmitFlags(e, off, alu, is64, false);
+    break;
+
+  case BX_JIT_INC:
+  case BX_JIT_DEC:
+    e.load(BX_JIT_RDX, dst, is64);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RAX, BX_JIT_RDX, is64);
+    e.alu_imm((jop.op->kind == BX_JIT_INC) ? 0 /* add */ : 5 /* sub */, BX_JIT_RAX, 1, is64);
+    e.store(BX_JIT_RAX, dst, true);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RCX, BX_JIT_RCX, false);
+    jitEmitFlags(e, off, (jop.op->kind == BX_JIT_INC) ? BX_JIT_ALU_ADD : BX_JIT_ALU_SUB, is64, true);
+    break;
+
+  case BX_JIT_NEG:
+    e.load(BX_JIT_RCX, dst, is64);
+    e.alu(BX_JIT_ALU_XOR, BX_JIT_RDX, BX_JIT_RDX, false);
+    e.alu(BX_JIT_ALU_MOV, BX_JIT_RAX, BX_JIT_RDX, is64);
+    e.alu(BX_JIT_ALU_SUB, BX_JIT_RAX, BX_JIT_RCX, is64);
+    e.store(BX_JIT_RAX, dst, true);
+    if (jop.needFlags)
+      jitEmitFlags(e, off, BX_JIT_ALU_SUB, is64, false);
+    break;
+
+  case BX_JIT_NOT:
+    e.load(BX_JIT_RAX, dst, is64);
+    e.not_reg(BX_JIT_RAX, is64);
+    e.store(BX_JIT_RAX, dst, true);
+    break;
+  }
+}
+
+void BX_CPU_C::jitInit(void)
+{
+  BX_CPU_THIS_PTR jit = SIM->get_param_bool(BXPN_JIT)->get();
+  if (! BX_CPU_THIS_PTR jit) return;
+
+  if (BX_CPU_THIS_PTR jit_code_buffer == NULL) {
+    void *buffer = mmap(NULL, BX_JIT_CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+      BX_ERROR(("JIT: failed to allocate executable host memory, JIT disabled"));
+      BX_CPU_THIS_PTR jit = 0;
+      return;
+    }
+    BX_CPU_THIS_PTR jit_code_buffer = (Bit8u *) buffer;
+  }
+
+  BX_CPU_THIS_PTR jit_code_ptr = BX_CPU_THIS_PTR jit_code_buffer;
+  BX_INFO(("JIT enabled, %dM host code buffer", BX_JIT_CODE_BUFFER_SIZE >> 20));
+}
+
+void BX_CPU_C::jitFree(void)
+{
+  if (BX_CPU_THIS_PTR jit_code_buffer) {
+    munmap(BX_CPU_THIS_PTR jit_code_buffer, BX_JIT_CODE_BUFFER_SIZE);
+    BX_CPU_THIS_PTR jit_code_buffer = NULL;
+  }
+}
+
+// The host code buffer is full, revert all compiled traces to counting
+// headers so they are compiled again when found hot.
+void BX_CPU_C::jitReset(void)
+{
+  extern void genJitHeader(bxInstruction_c *i);
+
+  bxICache_c *ic = &BX_CPU_THIS_PTR iCache;
+  bxICacheEntry_c *e = ic->entry;
+
+  for (unsigned n=0; n < ic->sets * ic->ways; n++, e++) {
+    if (e->pAddr != BX_ICACHE_INVALID_PHY_ADDRESS && e->i->isJitCompiled())
+      genJitHeader(e->i);
+  }
+
+  BX_CPU_THIS_PTR jit_code_ptr = BX_CPU_THIS_PTR jit_code_buffer;
+  INC_CPU_STAT(iCacheJitResets);
+}
+
+void BX_CPU_C::jitCompile(bxInstruction_c *header)
+{
+  if (BX_CPU_THIS_PTR jit_code_ptr + BX_JIT_MAX_TRACE_CODE > BX_CPU_THIS_PTR jit_code_buffer + BX_JIT_CODE_BUFFER_SIZE)
+    jitReset();
+
+  bxJitOp ops[BX_MAX_TRACE_LENGTH];
+  unsigned n, count = 0, inlined = 0;
+
+  // the trace always ends with zero length end-of-trace opcode
+  for (bxInstruction_c *i = header + 1; count < BX_MAX_TRACE_LENGTH; i++) {
+    if (i->ilen() == 0 || ! jitDecode(i, &ops[count])) break;
+    if (ops[count].op) inlined++;
+    count++;
+  }
+
+  // not worth compiling
+  if (count < 2 || inlined == 0) return;
+
+  // Flags of an inlined instruction are dead when overwritten by the
+  // following inlined instruction. Called handlers and the code after the
+  // compiled part might read the flags, INC and DEC preserve CF.
+  bool flagsLive = true;
+  for (n=count; n-- > 0;) {
+    const bxJitInlineOp *op = ops[n].op;
+    if (op == NULL || op->kind == BX_JIT_INC || op->kind == BX_JIT_DEC) {
+      flagsLive = true;
+    }
+    else if (op->kind == BX_JIT_ALU_RR || op->kind == BX_JIT_ALU_RI ||
+             op->kind == BX_JIT_NEG || op->kind == BX_JIT_ZERO) {
+      ops[n].needFlags = flagsLive;
+      flagsLive = false;
+    }
+  }
+
+  Bit8u *cpu = (Bit8u *) BX_CPU_THIS;
+  bxJitOffsets off;
+  off.gen_reg     = Bit32u((Bit8u *) &BX_CPU_THIS_PTR gen_reg[0] - cpu);
+  off.rip         = Bit32u((Bit8u *) &RIP - cpu);
+  off.prev_rip    = Bit32u((Bit8u *) &BX_CPU_THIS_PTR prev_rip - cpu);
+  off.icount      = Bit32u((Bit8u *) &BX_CPU_THIS_PTR icount - cpu);
+  off.async_event = Bit32u((Bit8u *) &BX_CPU_THIS_PTR async_event - cpu);
+  off.lf_result   = Bit32u((Bit8u *) &BX_CPU_THIS_PTR oszapc.result - cpu);
+  off.lf_auxbits  = Bit32u((Bit8u *) &BX_CPU_THIS_PTR oszapc.auxbits - cpu);
+
+  bxJitEmitter e(BX_CPU_THIS_PTR jit_code_ptr);
+  e.prologue();
+
+  // RIP and icount updates of the inlined instructions are batched until
+  // the next called handler or the end of the compiled code
+  unsigned pendingLen = 0, pendingCount = 0;
+
+  for (n=0; n <= count; n++) {
+    if (n == count || ops[n].op == NULL) {
+      if (pendingCount) {
+        e.alu_mem_imm(0 /* add */, off.rip, pendingLen, true);
+        e.load(BX_JIT_RAX, off.rip, true);
+        e.store(BX_JIT_RAX, off.prev_rip, true);
+        e.alu_mem_imm(0 /* add */, off.icount, pendingCount, true);
+        pendingLen = pendingCount = 0;
+      }
+      if (n == count) break;
+
+      // the handler sees the JIT call event and returns here instead of
+      // executing the next instruction, processors running in other host
+      // threads signal events concurrently so async_event is only changed
+      // with locked instructions
+      Bit32u disp = n * sizeof(bxInstruction_c);
+      e.lock_alu_mem_imm(1 /* or */, off.async_event, BX_ASYNC_EVENT_JIT_CALL, false);
+      e.alu_mem_imm(0 /* add */, off.rip, ops[n].i->ilen(), true);
+#if BX_USE_CPU_SMF
+      e.lea_instr(BX_JIT_RDI, disp);
+#else
+      e.alu(BX_JIT_ALU_MOV, BX_JIT_RDI, BX_JIT_RBX, true);
+      e.lea_instr(BX_JIT_RSI, disp);
+#endif
+      e.call(ops[n].handler);
+
+      // any other event stops the trace
+      e.alu_mem_imm(7 /* cmp */, off.async_event, BX_ASYNC_EVENT_JIT_CALL, false);
+      Bit8u *skip = e.je_forward();
+      e.lock_alu_mem_imm(4 /* and */, off.async_event, ~BX_ASYNC_EVENT_JIT_CALL, false);
+      e.alu(BX_JIT_ALU_XOR, BX_JIT_RAX, BX_JIT_RAX, false);
+      e.epilogue();
+      e.patch_forward(skip);
+      e.lock_alu_mem_imm(4 /* and */, off.async_event, ~BX_ASYNC_EVENT_JIT_CALL, false);
+    }
+    else {
+      jitEmitInline(e, off, ops[n]);
+      pendingLen += ops[n].i->ilen();
+      pendingCount++;
+    }
+  }
+
+  // continue with the first instruction which was not compiled
+  e.lea_instr(BX_JIT_RAX, count * sizeof(bxInstruction_c));
+  e.epilogue();
+
+  BX_ASSERT(e.pos() <= BX_CPU_THIS_PTR jit_code_ptr + BX_JIT_MAX_TRACE_CODE);
+
+  header->setJitCode(BX_CPU_THIS_PTR jit_code_ptr);
+  header->execute1 = &BX_CPU_C::BxJitBlock;
+
+  // keep the entry points aligned
+  BX_CPU_THIS_PTR jit_code_ptr = (Bit8u *)(((Bit64u) e.pos() + 15) & ~BX_CONST64(15));
+
+  INC_CPU_STAT(iCacheJitTraces);
+}
+
+void BX_CPP_AttrRegparmN(1) BX_CPU_C::BxJitProfile(bxInstruction_c *i)
+{
+  if (i->jitExecCount() == BX_JIT_HOT_THRESHOLD)
+    jitCompile(i);
+
+  ++i;
+  BX_EXECUTE_INSTRUCTION(i);
+}
+
+void BX_CPP_AttrRegparmN(1) BX_CPU_C::BxJitBlock(bxInstruction_c *i)
+{
+  if (! BX_CPU_THIS_PTR async_event) {
+    bxJitCode_t code = (bxJitCode_t) i->jitCode();
+    i = code(BX_CPU_THIS, i+1);
+    if (i == NULL) return; // back to the cpu loop
+  }
+  else {
+    ++i;
+  }
+
+  BX_EXECUTE_INSTRUCTION(i);
+}
+
+#endif // BX_SUPPORT_JIT
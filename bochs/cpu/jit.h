@@ -0,0 +1,175 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_JIT_H
+#define BX_JIT_H
+
+#if BX_SUPPORT_JIT
+
+// trace executions before the trace is compiled
+#define BX_JIT_HOT_THRESHOLD 64
+
+// host code buffer size per processor
+#define BX_JIT_CODE_BUFFER_SIZE (8 * 1024 * 1024)
+
+// upper limit of the host code generated for single trace
+#define BX_JIT_MAX_TRACE_CODE (BX_MAX_TRACE_LENGTH * 192 + 256)
+
+// Compiled trace entry point, called with the processor and the first
+// compiled instruction. Returns the next instruction to execute or NULL
+// if the trace should return to the cpu loop.
+typedef bxInstruction_c* (*bxJitCode_t)(BX_CPU_C *cpu, bxInstruction_c *i);
+
+// host registers
+enum {
+  BX_JIT_RAX = 0,
+  BX_JIT_RCX = 1,
+  BX_JIT_RDX = 2,
+  BX_JIT_RBX = 3, // holds pointer to the processor
+  BX_JIT_RSI = 6,
+  BX_JIT_RDI = 7
+};
+
+// primary opcodes of the ALU instructions in 'r/m, reg' form
+enum {
+  BX_JIT_ALU_ADD  = 0x01,
+  BX_JIT_ALU_OR   = 0x09,
+  BX_JIT_ALU_AND  = 0x21,
+  BX_JIT_ALU_SUB  = 0x29,
+  BX_JIT_ALU_XOR  = 0x31,
+  BX_JIT_ALU_CMP  = 0x39,
+  BX_JIT_ALU_TEST = 0x85,
+  BX_JIT_ALU_MOV  = 0x89
+};
+
+// Minimal x86-64 machine code emitter. Processor fields are addressed
+// relative to RBX, instructions of the trace relative to R12.
+class bxJitEmitter {
+  Bit8u *ptr;
+
+  BX_CPP_INLINE void rexw(bool is64) { if (is64) byte(0x48); }
+
+  // modrm for [rbx + disp32] memory operand
+  BX_CPP_INLINE void cpu_operand(unsigned reg, Bit32u disp) {
+    byte(0x80 | (reg << 3) | BX_JIT_RBX);
+    dword(disp);
+  }
+
+public:
+  bxJitEmitter(Bit8u *code): ptr(code) {}
+
+  BX_CPP_INLINE Bit8u *pos() const { return ptr; }
+
+  BX_CPP_INLINE void byte(Bit8u val) { *ptr++ = val; }
+  BX_CPP_INLINE void dword(Bit32u val) { memcpy(ptr, &val, 4); ptr += 4; }
+  BX_CPP_INLINE void qword(Bit64u val) { memcpy(ptr, &val, 8); ptr += 8; }
+
+  // mov reg, [rbx + disp]
+  BX_CPP_INLINE void load(unsigned reg, Bit32u disp, bool is64) {
+    rexw(is64); byte(0x8B); cpu_operand(reg, disp);
+  }
+  // mov [rbx + disp], reg
+  BX_CPP_INLINE void store(unsigned reg, Bit32u disp, bool is64) {
+    rexw(is64); byte(0x89); cpu_operand(reg, disp);
+  }
+  // <op> dword/qword [rbx + disp], imm32
+  BX_CPP_INLINE void alu_mem_imm(unsigned ext, Bit32u disp, Bit32u imm, bool is64) {
+    rexw(is64); byte(0x81); cpu_operand(ext, disp); dword(imm);
+  }
+  // lock <op> dword/qword [rbx + disp], imm32
+  BX_CPP_INLINE void lock_alu_mem_imm(unsigned ext, Bit32u disp, Bit32u imm, bool is64) {
+    byte(0xF0); alu_mem_imm(ext, disp, imm, is64);
+  }
+  // mov dword/qword [rbx + disp], imm32
+  BX_CPP_INLINE void mov_mem_imm(Bit32u disp, Bit32u imm, bool is64) {
+    rexw(is64); byte(0xC7); cpu_operand(0, disp); dword(imm);
+  }
+
+  // <op> dst, src
+  BX_CPP_INLINE void alu(unsigned opcode, unsigned dst, unsigned src, bool is64) {
+    rexw(is64); byte(opcode); byte(0xC0 | (src << 3) | dst);
+  }
+  // <op> reg, imm32 (group 1 extension in ext)
+  BX_CPP_INLINE void alu_imm(unsigned ext, unsigned reg, Bit32u imm, bool is64) {
+    rexw(is64); byte(0x81); byte(0xC0 | (ext << 3) | reg); dword(imm);
+  }
+  BX_CPP_INLINE void not_reg(unsigned reg, bool is64) {
+    rexw(is64); byte(0xF7); byte(0xD0 | reg);
+  }
+  BX_CPP_INLINE void shr(unsigned reg, unsigned count, bool is64) {
+    rexw(is64); byte(0xC1); byte(0xE8 | reg); byte(count);
+  }
+  BX_CPP_INLINE void shl(unsigned reg, unsigned count, bool is64) {
+    rexw(is64); byte(0xC1); byte(0xE0 | reg); byte(count);
+  }
+  // mov reg32, imm32 (zero extended)
+  BX_CPP_INLINE void mov_imm32(unsigned reg, Bit32u imm) {
+    byte(0xB8 | reg); dword(imm);
+  }
+  // mov reg64, simm32 (sign extended)
+  BX_CPP_INLINE void mov_simm32(unsigned reg, Bit32u imm) {
+    byte(0x48); byte(0xC7); byte(0xC0 | reg); dword(imm);
+  }
+  BX_CPP_INLINE void mov_imm64(unsigned reg, Bit64u imm) {
+    byte(0x48); byte(0xB8 | reg); qword(imm);
+  }
+  // movsxd dst, src32
+  BX_CPP_INLINE void movsxd(unsigned dst, unsigned src) {
+    byte(0x48); byte(0x63); byte(0xC0 | (dst << 3) | src);
+  }
+  // lea reg, [r12 + disp]
+  BX_CPP_INLINE void lea_instr(unsigned reg, Bit32u disp) {
+    byte(0x49); byte(0x8D); byte(0x84 | (reg << 3)); byte(0x24); dword(disp);
+  }
+
+  BX_CPP_INLINE void call(const void *func) {
+    mov_imm64(BX_JIT_RAX, (Bit64u) func);
+    byte(0xFF); byte(0xD0); // call rax
+  }
+
+  BX_CPP_INLINE void prologue(void) {
+    byte(0x53);                                   // push rbx
+    byte(0x41); byte(0x54);                       // push r12
+    byte(0x48); byte(0x83); byte(0xEC); byte(8);  // sub rsp, 8
+    byte(0x48); byte(0x89); byte(0xFB);           // mov rbx, rdi
+    byte(0x49); byte(0x89); byte(0xF4);           // mov r12, rsi
+  }
+  BX_CPP_INLINE void epilogue(void) {
+    byte(0x48); byte(0x83); byte(0xC4); byte(8);  // add rsp, 8
+    byte(0x41); byte(0x5C);                       // pop r12
+    byte(0x5B);                                   // pop rbx
+    byte(0xC3);                                   // ret
+  }
+
+  // je rel8 with the target patched later
+  BX_CPP_INLINE Bit8u *je_forward(void) {
+    byte(0x74); byte(0);
+    return ptr;
+  }
+  BX_CPP_INLINE void patch_forward(Bit8u *from) {
+    from[-1] = (Bit8u)(ptr - from);
+  }
+};
+
+#endif // BX_SUPPORT_JIT
+
+#endif
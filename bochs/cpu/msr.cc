@@ -36,6 +36,8 @@
 #include "apic.h"
 #endif
 
+#include "pc_system.h"
+
 #include "decoder/ia_opcodes.h"
 
 #if BX_SUPPORT_CET
@@ -223,8 +225,12 @@ bool BX_CPP_AttrRegparmN(2) BX_CPU_C::rdmsr(Bit32u index, Bit64u *msr)
 #if BX_CPU_LEVEL >= 6
   if (is_cpu_extension_supported(BX_ISA_X2APIC)) {
     if (is_x2apic_msr_range(index)) {
-      if (x2apic_mode())
-        return BX_CPU_THIS_PTR lapic->read_x2apic(index, msr);
+      if (x2apic_mode()) {
+        BX_LOCK_DEVICES();
+        bool ok = BX_CPU_THIS_PTR lapic->read_x2apic(index, msr);
+        BX_UNLOCK_DEVICES();
+        return ok;
+      }
       else
         return false;
     }
@@ -785,8 +791,12 @@ bool BX_CPP_AttrRegparmN(2) BX_CPU_C::wrmsr(Bit32u index, Bit64u val_64)
 #if BX_CPU_LEVEL >= 6
   if (is_cpu_extension_supported(BX_ISA_X2APIC)) {
     if (is_x2apic_msr_range(index)) {
-      if (x2apic_mode())
-        return BX_CPU_THIS_PTR lapic->write_x2apic(index, val32_hi, val32_lo);
+      if (x2apic_mode()) {
+        BX_LOCK_DEVICES();
+        bool ok = BX_CPU_THIS_PTR lapic->write_x2apic(index, val32_hi, val32_lo);
+        BX_UNLOCK_DEVICES();
+        return ok;
+      }
       else
         return false;
     }
@@ -392,15 +392,156 @@ const Bit32u TLB_NoHostPtr = 0x800; /* set this bit when direct access is NOT al
 
 // ==============================================================
 
-void BX_CPU_C::TLB_flush(void)
+// TLB contexts
+//
+// Every TLB entry is tagged with the context it was created in (see tlb.h).
+// The context is identified by the PCID of CR3 when CR4.PCIDE is set and by
+// the VPID/ASID of the VMX/SVM guest. Writing CR3 with CR4.PCIDE=1 selects
+// the context of the new PCID instead of flushing the TLB.
+//
+// Flushing the TLB doesn't touch the entries. The flushed contexts become
+// stale and their entries are never hit again because the lookups use the
+// tag of a newly allocated context. Stale context tags are reclaimed all at
+// once, invalidating their entries, when no free tag is left. Global entries
+// survive flushes of non-global translations: a global entry found with an
+// old tag is moved to the current context on TLB miss unless the global
+// translations were flushed since the old context was created. The second
+// level TLB identifies the contexts by serial numbers which are never reused
+// and is left alone when the context tags are reclaimed.
+
+Bit64u BX_CPU_C::TLB_contextKey(Bit32u pcid)
 {
-  INC_TLBFLUSH_STAT(tlbGlobalFlushes);
+  Bit64u key = pcid;
 
-  invalidate_prefetch_q();
-  invalidate_stack_cache();
+#if BX_SUPPORT_VMX >= 2
+  if (BX_CPU_THIS_PTR in_vmx_guest && BX_CPU_THIS_PTR vmcs.vmexec_ctrls2.VPID_ENABLE())
+    key |= Bit64u(BX_CPU_THIS_PTR vmcs.vpid) << 12;
+#endif
+
+#if BX_SUPPORT_SVM
+  if (BX_CPU_THIS_PTR in_svm_guest)
+    key |= Bit64u(BX_CPU_THIS_PTR vmcb->ctrls.guest_asid) << 12;
+#endif
+
+  return key;
+}
+
+Bit32u BX_CPU_C::TLB_currentPCID(void)
+{
+#if BX_SUPPORT_X86_64
+  if (BX_CPU_THIS_PTR cr4.get_PCIDE())
+    return Bit32u(BX_CPU_THIS_PTR cr3) & 0xfff;
+#endif
 
+  return 0;
+}
+
+// invalidate all TLB entries and forget all contexts
+void BX_CPU_C::TLB_resetContexts(void)
+{
   BX_CPU_THIS_PTR DTLB.flush();
   BX_CPU_THIS_PTR ITLB.flush();
+  BX_CPU_THIS_PTR STLB.flush();
+#if BX_SUPPORT_X86_64
+  BX_CPU_THIS_PTR PSC.flush();
+#endif
+#if (BX_SUPPORT_VMX >= 2) || BX_SUPPORT_SVM
+  BX_CPU_THIS_PTR nestedWalkCache.flush();
+#endif
+
+  for (unsigned n=0; n < BX_TLB_CONTEXTS; n++) {
+    BX_CPU_THIS_PTR tlb_context[n].key = BX_TLB_NO_CONTEXT;
+    BX_CPU_THIS_PTR tlb_context[n].live = false;
+  }
+
+  BX_CPU_THIS_PTR tlb_global_epoch = 0;
+  BX_CPU_THIS_PTR tlb_context_next = 0;
+  BX_CPU_THIS_PTR tlb_context_serial = 0;
+  TLB_selectContext(TLB_allocContext(0));
+}
+
+// VMX/SVM guest mode was entered or left after the TLB was flushed, the
+// translations created since then belong to the new mode
+void BX_CPU_C::TLB_updateContextKey(void)
+{
+  unsigned n = unsigned(BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift);
+  BX_CPU_THIS_PTR tlb_context[n].key = TLB_contextKey(TLB_currentPCID());
+}
+
+unsigned BX_CPU_C::TLB_findContext(Bit64u key)
+{
+  for (unsigned n=0; n < BX_TLB_CONTEXTS; n++) {
+    if (BX_CPU_THIS_PTR tlb_context[n].live && BX_CPU_THIS_PTR tlb_context[n].key == key) return n;
+  }
+
+  return BX_TLB_CONTEXTS;
+}
+
+unsigned BX_CPU_C::TLB_allocContext(Bit64u key)
+{
+  unsigned n;
+
+  for (n=0; n < BX_TLB_CONTEXTS; n++) {
+    if (BX_CPU_THIS_PTR tlb_context[n].key == BX_TLB_NO_CONTEXT) break;
+  }
+
+  if (n == BX_TLB_CONTEXTS) {
+    INC_CPU_STAT(tlbContextReclaims);
+
+    // reclaim the tags of all stale contexts
+    Bit32u stale = 0;
+    for (n=0; n < BX_TLB_CONTEXTS; n++) {
+      if (! BX_CPU_THIS_PTR tlb_context[n].live) {
+        BX_CPU_THIS_PTR tlb_context[n].key = BX_TLB_NO_CONTEXT;
+        stale |= (1 << n);
+      }
+    }
+
+    if (! stale) {
+      // all tags are used by live contexts, drop one of them
+      stale = 1 << BX_CPU_THIS_PTR tlb_context_next;
+      BX_CPU_THIS_PTR tlb_context_next = (BX_CPU_THIS_PTR tlb_context_next + 1) % BX_TLB_CONTEXTS;
+    }
+
+    BX_CPU_THIS_PTR DTLB.flushContexts(stale);
+    BX_CPU_THIS_PTR ITLB.flushContexts(stale);
+#if BX_SUPPORT_X86_64
+    BX_CPU_THIS_PTR PSC.flushContexts(stale);
+#endif
+#if (BX_SUPPORT_VMX >= 2) || BX_SUPPORT_SVM
+    BX_CPU_THIS_PTR nestedWalkCache.flushContexts(stale);
+#endif
+
+    for (n=0; n < BX_TLB_CONTEXTS; n++) {
+      if (stale & (1 << n)) break;
+    }
+  }
+
+  BX_CPU_THIS_PTR tlb_context[n].key = key;
+  BX_CPU_THIS_PTR tlb_context[n].serial = ++BX_CPU_THIS_PTR tlb_context_serial;
+  BX_CPU_THIS_PTR tlb_context[n].epoch = BX_CPU_THIS_PTR tlb_global_epoch;
+  BX_CPU_THIS_PTR tlb_context[n].live = true;
+  return n;
+}
+
+void BX_CPU_C::TLB_selectContext(unsigned n)
+{
+  BX_CPU_THIS_PTR tlb_context_tag = n << TLB_ContextShift;
+}
+
+// make all live contexts stale and continue in a new context
+void BX_CPU_C::TLB_flushContexts(bool global)
+{
+  invalidate_prefetch_q();
+  invalidate_stack_cache();
+
+  if (global)
+    BX_CPU_THIS_PTR tlb_global_epoch++;
+
+  for (unsigned n=0; n < BX_TLB_CONTEXTS; n++)
+    BX_CPU_THIS_PTR tlb_context[n].live = false;
+
+  TLB_selectContext(TLB_allocContext(TLB_contextKey(TLB_currentPCID())));
 
 #if BX_SUPPORT_MONITOR_MWAIT
   // invalidating of the TLB might change translation for monitored page
@@ -412,19 +553,53 @@ void BX_CPU_C::TLB_flush(void)
   BX_CPU_THIS_PTR iCache.breakLinks();
 }
 
+// global entry of another context can be used by the current context
+bool BX_CPU_C::TLB_isValidGlobal(const bx_TLB_entry *tlbEntry)
+{
+  unsigned n = unsigned((tlbEntry->lpf & TLB_ContextMask) >> TLB_ContextShift);
+  unsigned current = unsigned(BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift);
+
+  // global translations are shared between PCIDs but not between VPIDs/ASIDs
+  return BX_CPU_THIS_PTR tlb_context[n].epoch == BX_CPU_THIS_PTR tlb_global_epoch &&
+        (BX_CPU_THIS_PTR tlb_context[n].key >> 12) == (BX_CPU_THIS_PTR tlb_context[current].key >> 12);
+}
+
+void BX_CPU_C::TLB_flush(void)
+{
+  INC_CPU_STAT(tlbGlobalFlushes);
+
+  TLB_flushContexts(true);
+}
+
 #if BX_CPU_LEVEL >= 6
 void BX_CPU_C::TLB_flushNonGlobal(void)
 {
-  INC_TLBFLUSH_STAT(tlbNonGlobalFlushes);
+  INC_CPU_STAT(tlbNonGlobalFlushes);
+
+  TLB_flushContexts(false);
+}
+
+void BX_CPU_C::TLB_switchContext(bool noflush)
+{
+  INC_CPU_STAT(tlbContextSwitches);
 
   invalidate_prefetch_q();
   invalidate_stack_cache();
 
-  BX_CPU_THIS_PTR DTLB.flushNonGlobal();
-  BX_CPU_THIS_PTR ITLB.flushNonGlobal();
+  Bit64u key = TLB_contextKey(TLB_currentPCID());
+  unsigned n = TLB_findContext(key);
+  if (n == BX_TLB_CONTEXTS || ! noflush) {
+    if (n != BX_TLB_CONTEXTS) {
+      INC_CPU_STAT(tlbContextFlushes);
+      BX_CPU_THIS_PTR tlb_context[n].live = false;
+    }
+    n = TLB_allocContext(key);
+  }
+
+  TLB_selectContext(n);
 
 #if BX_SUPPORT_MONITOR_MWAIT
-  // invalidating of the TLB might change translation for monitored page
+  // switching the context might change translation for monitored page
   // and cause subsequent MWAIT instruction to wait forever
   BX_CPU_THIS_PTR wakeup_monitor();
 #endif
@@ -432,6 +607,44 @@ void BX_CPU_C::TLB_flushNonGlobal(void)
   // break all links bewteen traces
   BX_CPU_THIS_PTR iCache.breakLinks();
 }
+
+// invalidate non-global translations of a single PCID
+void BX_CPU_C::TLB_flushPCID(Bit32u pcid)
+{
+  unsigned n = TLB_findContext(TLB_contextKey(pcid));
+  if (n == BX_TLB_CONTEXTS) return; // nothing cached for the PCID
+
+  INC_CPU_STAT(tlbContextFlushes);
+
+  BX_CPU_THIS_PTR tlb_context[n].live = false;
+
+  if (n == unsigned(BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift)) {
+    invalidate_prefetch_q();
+    invalidate_stack_cache();
+
+    TLB_selectContext(TLB_allocContext(TLB_contextKey(pcid)));
+
+#if BX_SUPPORT_MONITOR_MWAIT
+    BX_CPU_THIS_PTR wakeup_monitor();
+#endif
+
+    // break all links bewteen traces
+    BX_CPU_THIS_PTR iCache.breakLinks();
+  }
+}
+
+// invalidate translations of the linear address tagged with the PCID
+void BX_CPU_C::TLB_invlpgPCID(bx_address laddr, Bit32u pcid)
+{
+  TLB_invlpg(laddr);
+
+#if BX_SUPPORT_X86_64
+  // TLB_invlpg() drops the paging-structure caches of the current PCID only
+  unsigned n = TLB_findContext(TLB_contextKey(pcid));
+  if (n != BX_TLB_CONTEXTS)
+    BX_CPU_THIS_PTR PSC.flushContexts(1 << n);
+#endif
+}
 #endif
 
 void BX_CPU_C::TLB_invlpg(bx_address laddr)
@@ -442,6 +655,12 @@ void BX_CPU_C::TLB_invlpg(bx_address laddr)
   BX_DEBUG(("TLB_invlpg(0x" FMT_ADDRX "): invalidate TLB entry", laddr));
   BX_CPU_THIS_PTR DTLB.invlpg(laddr);
   BX_CPU_THIS_PTR ITLB.invlpg(laddr);
+  BX_CPU_THIS_PTR STLB.invlpg(laddr);
+#if BX_SUPPORT_X86_64
+  // INVLPG invalidates all paging-structure caches of the current PCID
+  // regardless of the linear address they correspond to
+  BX_CPU_THIS_PTR PSC.flushContexts(1 << (BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift));
+#endif
 
 #if BX_SUPPORT_MONITOR_MWAIT
   // invalidating of the TLB entry might change translation for monitored
@@ -504,6 +723,12 @@ void BX_CPU_C::page_fault(unsigned fault, bx_address laddr, unsigned user, unsig
 {
   unsigned isWrite = rw & 1;
 
+  // page fault invalidates the TLB and paging-structure cache entries for the address
+  BX_CPU_THIS_PTR STLB.invlpg(laddr);
+#if BX_SUPPORT_X86_64
+  BX_CPU_THIS_PTR PSC.invlpg(laddr);
+#endif
+
   Bit32u error_code = fault | (user << 2) | (isWrite << 1);
 #if BX_CPU_LEVEL >= 6
   if (rw == BX_EXECUTE) {
@@ -832,6 +1057,8 @@ bx_phy_address BX_CPU_C::translate_linear_long_mode(bx_address laddr, Bit32u &lp
   bx_phy_address entry_addr[5];
   Bit64u entry[5];
   BxMemtype entry_memtype[5] = { BX_MEMTYPE_INVALID, BX_MEMTYPE_INVALID, BX_MEMTYPE_INVALID, BX_MEMTYPE_INVALID, BX_MEMTYPE_INVALID };
+  Bit32u entry_access[5];
+  bool entry_nx[5];
 
   Bit64u reserved = PAGING_PAE_RESERVED_BITS;
   if (! BX_CPU_THIS_PTR efer.get_NXE())
@@ -845,6 +1072,24 @@ bx_phy_address BX_CPU_C::translate_linear_long_mode(bx_address laddr, Bit32u &lp
 
   int start_leaf = BX_CPU_THIS_PTR cr4.get_LA57() ? BX_LEVEL_PML5 : BX_LEVEL_PML4, leaf = start_leaf;
 
+  // continue the walk below the deepest paging-structure cache hit, an entry
+  // with XD bit set can't be used if the bit became reserved
+  for (int level = BX_LEVEL_PDE; level <= start_leaf; level++) {
+    bx_PSC_entry *psc = BX_CPU_THIS_PTR PSC.lookup(laddr, level, BX_CPU_THIS_PTR tlb_context_tag);
+    if (psc && (! psc->nx || BX_CPU_THIS_PTR efer.get_NXE())) {
+      INC_CPU_STAT(tlbWalkCacheHits);
+      curr_entry = psc->entry;
+      combined_access = psc->combined_access;
+      nx_page = psc->nx;
+      ppf = curr_entry & BX_CONST64(0x000ffffffffff000);
+      offset_mask = (BX_CONST64(1) << (12 + 9*level)) - 1;
+      leaf = level - 1;
+      break;
+    }
+  }
+
+  int walk_leaf = leaf; // the first level read from memory
+
   for (;; --leaf) {
     entry_addr[leaf] = ppf + ((laddr >> (9 + 9*leaf)) & 0xff8);
 #if BX_SUPPORT_VMX >= 2
@@ -888,6 +1133,8 @@ bx_phy_address BX_CPU_C::translate_linear_long_mode(bx_address laddr, Bit32u &lp
     }
 
     combined_access &= curr_entry; // U/S and R/W
+    entry_access[leaf] = combined_access;
+    entry_nx[leaf] = nx_page;
   }
 
 #if BX_SUPPORT_PKEYS
@@ -907,7 +1154,11 @@ bx_phy_address BX_CPU_C::translate_linear_long_mode(bx_address laddr, Bit32u &lp
   bool isWrite = (rw & 1); // write or r-m-w
 
   // Update A/D bits if needed
-  update_access_dirty_PAE(entry_addr, entry, entry_memtype, start_leaf, leaf, isWrite);
+  update_access_dirty_PAE(entry_addr, entry, entry_memtype, walk_leaf, leaf, isWrite);
+
+  // cache the non-leaf entries read by the walk, their Accessed bits are set now
+  for (int level = walk_leaf; level > leaf; level--)
+    BX_CPU_THIS_PTR PSC.update(laddr, level, BX_CPU_THIS_PTR tlb_context_tag, entry[level], entry_access[level], entry_nx[level]);
 
   return (ppf | combined_access);
 }
@@ -1268,16 +1519,51 @@ bx_phy_address BX_CPU_C::translate_linear(bx_TLB_entry *tlbEntry, bx_address lad
   unsigned isWrite = rw & 1; // write or r-m-w
   unsigned isExecute = (rw == BX_EXECUTE);
   unsigned isShadowStack = (rw & 4); // 4 if shadowstack and 0 otherwise
-  bx_address lpf = LPFOf(laddr);
+  bx_address lpf = BX_TLB_LPFOf(laddr);
 
-  INC_TLB_STAT(tlbLookups);
+  INC_CPU_STAT(tlbLookups);
   if (isExecute)
-    INC_TLB_STAT(tlbExecuteLookups);
+    INC_CPU_STAT(tlbExecuteLookups);
   if (isWrite)
-    INC_TLB_STAT(tlbWriteLookups);
+    INC_CPU_STAT(tlbWriteLookups);
 
   // already looked up TLB for code access
-  if (! isExecute && TLB_LPFOf(tlbEntry->lpf) == lpf)
+  bool lookup = ! isExecute;
+
+#if BX_CPU_LEVEL >= 6
+  // global entry left with the tag of another context by TLB flush
+  if (LPFOf(tlbEntry->lpf) == LPFOf(laddr) && (tlbEntry->accessBits & TLB_GlobalPage) != 0) {
+    if (TLB_isValidGlobal(tlbEntry)) {
+      tlbEntry->lpf = (tlbEntry->lpf & ~bx_address(TLB_ContextMask)) | BX_CPU_THIS_PTR tlb_context_tag;
+      lookup = true;
+    }
+  }
+#endif
+
+  bool hit = lookup && TLB_LPFOf(tlbEntry->lpf) == lpf;
+
+  if (! hit) {
+    // the translation might be evicted from the first level TLB by a conflicting page
+    const bx_STLB_entry *stlbEntry = BX_CPU_THIS_PTR STLB.lookup(laddr, isExecute);
+    if (stlbEntry) {
+      const unsigned current = unsigned(BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift);
+      if (stlbEntry->context == BX_CPU_THIS_PTR tlb_context[current].serial
+#if BX_CPU_LEVEL >= 6
+         || ((stlbEntry->tlbEntry.accessBits & TLB_GlobalPage) != 0 && stlbEntry->epoch == BX_CPU_THIS_PTR tlb_global_epoch &&
+              stlbEntry->vpid == Bit32u(BX_CPU_THIS_PTR tlb_context[current].key >> 12))
+#endif
+      ) {
+        INC_CPU_STAT(stlbHits);
+        *tlbEntry = stlbEntry->tlbEntry;
+        tlbEntry->lpf = (tlbEntry->lpf & ~bx_address(TLB_ContextMask)) | BX_CPU_THIS_PTR tlb_context_tag;
+        hit = true;
+      }
+    }
+    if (! hit)
+      INC_CPU_STAT(stlbMisses);
+  }
+
+  if (hit)
   {
     paddress = tlbEntry->ppf | poffset;
 
@@ -1305,11 +1591,11 @@ bx_phy_address BX_CPU_C::translate_linear(bx_TLB_entry *tlbEntry, bx_address lad
     tlbEntry->invalidate();
   }
 
-  INC_TLB_STAT(tlbMisses);
+  INC_CPU_STAT(tlbMisses);
   if (isExecute)
-    INC_TLB_STAT(tlbExecuteMisses);
+    INC_CPU_STAT(tlbExecuteMisses);
   if (isWrite)
-    INC_TLB_STAT(tlbWriteMisses);
+    INC_CPU_STAT(tlbWriteMisses);
 
   Bit32u lpf_mask = 0xfff; // 4K pages
   Bit32u combined_access = BX_COMBINED_ACCESS_WRITE | BX_COMBINED_ACCESS_USER;
@@ -1320,6 +1606,7 @@ bx_phy_address BX_CPU_C::translate_linear(bx_TLB_entry *tlbEntry, bx_address lad
   if(BX_CPU_THIS_PTR cr0.get_PG())
   {
     BX_DEBUG(("page walk for%s address 0x" FMT_LIN_ADDRX, isShadowStack ? " shadow stack" : "", laddr));
+    INC_CPU_STAT(pageWalks);
 
 #if BX_CPU_LEVEL >= 6
 #if BX_SUPPORT_X86_64
@@ -1492,6 +1779,11 @@ bx_phy_address BX_CPU_C::translate_linear(bx_TLB_entry *tlbEntry, bx_address lad
   // will be returned, and it's OK to OR zero in anyways.
   tlbEntry->hostPageAddr = BX_CPU_THIS_PTR getHostMemAddr(ppf, rw);
   if (tlbEntry->hostPageAddr) {
+    // stores hitting in the TLB are not seen by the memory object, do not
+    // grant write access on read so the first store refills the entry
+    // through the write path and marks the page dirty there
+    if (! (rw & 1))
+      tlbEntry->accessBits &= ~(TLB_SysWriteOK | TLB_UserWriteOK | TLB_SysWriteShadowStackOK | TLB_UserWriteShadowStackOK);
     // All access allowed also via direct pointer
 #if BX_X86_DEBUGGER
     if (! hwbreakpoint_check(laddr, BX_HWDebugMemW, BX_HWDebugMemRW))
@@ -1503,6 +1795,12 @@ bx_phy_address BX_CPU_C::translate_linear(bx_TLB_entry *tlbEntry, bx_address lad
   tlbEntry->memtype = resolve_memtype(memtype_by_mtrr(tlbEntry->ppf), extract_memtype(combined_access) /* effective page tables memory type */);
 #endif
 
+  if (lpf_mask == 0xfff) {
+    const unsigned current = unsigned(BX_CPU_THIS_PTR tlb_context_tag >> TLB_ContextShift);
+    BX_CPU_THIS_PTR STLB.insert(tlbEntry, isExecute, BX_CPU_THIS_PTR tlb_context[current].serial,
+        Bit32u(BX_CPU_THIS_PTR tlb_context[current].key >> 12), BX_CPU_THIS_PTR tlb_global_epoch);
+  }
+
   return paddress;
 }
 
@@ -1846,14 +2144,29 @@ bx_phy_address BX_CPU_C::nested_walk(bx_phy_address guest_paddr, unsigned rw, bo
 {
   SVM_HOST_STATE *host_state = &BX_CPU_THIS_PTR vmcb->host_state;
 
+  bx_phy_address paddr;
+
+  if (is_page_walk) {
+    if (BX_CPU_THIS_PTR nestedWalkCache.lookup(guest_paddr, BX_CPU_THIS_PTR tlb_context_tag, &paddr)) {
+      INC_CPU_STAT(tlbNestedWalkCacheHits);
+      return paddr;
+    }
+  }
+
   BX_DEBUG(("Nested walk for guest paddr 0x" FMT_PHY_ADDRX, guest_paddr));
+  INC_CPU_STAT(nestedPageWalks);
 
   if (host_state->efer.get_LMA())
-    return nested_walk_long_mode(guest_paddr, rw, is_page_walk);
+    paddr = nested_walk_long_mode(guest_paddr, rw, is_page_walk);
   else if (host_state->cr4.get_PAE())
-    return nested_walk_PAE(guest_paddr, rw, is_page_walk);
+    paddr = nested_walk_PAE(guest_paddr, rw, is_page_walk);
   else
-    return nested_walk_legacy(guest_paddr, rw, is_page_walk);
+    paddr = nested_walk_legacy(guest_paddr, rw, is_page_walk);
+
+  if (is_page_walk)
+    BX_CPU_THIS_PTR nestedWalkCache.update(guest_paddr, BX_CPU_THIS_PTR tlb_context_tag, paddr);
+
+  return paddr;
 }
 
 #endif
@@ -1958,6 +2271,18 @@ bx_phy_address BX_CPU_C::translate_guest_physical(bx_phy_address guest_paddr, bx
   if (rw & 1) access_mask |= BX_EPT_WRITE; // write or r-m-w
   if ((rw & 3) == BX_READ) access_mask |= BX_EPT_READ;  // handle correctly shadow stack reads
 
+  // guest page walk through the guest physical page translated before
+  bool walk_cache = is_page_walk && guest_laddr_valid;
+  if (walk_cache) {
+    bx_phy_address paddr;
+    if (BX_CPU_THIS_PTR nestedWalkCache.lookup(guest_paddr, BX_CPU_THIS_PTR tlb_context_tag, &paddr)) {
+      INC_CPU_STAT(tlbNestedWalkCacheHits);
+      return paddr;
+    }
+  }
+
+  INC_CPU_STAT(nestedPageWalks);
+
   Bit32u vmexit_reason = 0;
 
   for (leaf = BX_LEVEL_PML4;; --leaf) {
@@ -2126,6 +2451,10 @@ bx_phy_address BX_CPU_C::translate_guest_physical(bx_phy_address guest_paddr, bx
   }
 
   Bit32u page_offset = PAGE_OFFSET(guest_paddr);
+
+  if (walk_cache)
+    BX_CPU_THIS_PTR nestedWalkCache.update(guest_paddr, BX_CPU_THIS_PTR tlb_context_tag, ppf | page_offset);
+
   return ppf | page_offset;
 }
 
@@ -2517,7 +2846,9 @@ void BX_CPU_C::access_read_physical(bx_phy_address paddr, unsigned len, void *da
 
 #if BX_SUPPORT_APIC
   if (BX_CPU_THIS_PTR lapic->is_selected(paddr)) {
+    BX_LOCK_DEVICES();
     BX_CPU_THIS_PTR lapic->read(paddr, data, len);
+    BX_UNLOCK_DEVICES();
     return;
   }
 #endif
@@ -2568,7 +2899,9 @@ void BX_CPU_C::access_write_physical(bx_phy_address paddr, unsigned len, void *d
 
 #if BX_SUPPORT_APIC
   if (BX_CPU_THIS_PTR lapic->is_selected(paddr)) {
+    BX_LOCK_DEVICES();
     BX_CPU_THIS_PTR lapic->write(paddr, data, len);
+    BX_UNLOCK_DEVICES();
     return;
   }
 #endif
@@ -2600,7 +2933,59 @@ void BX_CPU_C::write_physical_qword(bx_phy_address paddr, Bit64u val_64, BxMemty
   BX_NOTIFY_PHY_MEMORY_ACCESS(paddr, 8, memtype, BX_WRITE, reason, (Bit8u*)(&val_64));
 }
 
+// Dirty page log was cleared for the physical memory range [start, end),
+// writes to it through host pointers must go through the memory object
+// again to mark the pages.
+void BX_CPU_C::TLB_flushWritable(bx_phy_address start, bx_phy_address end)
+{
+  for (unsigned tlb_entry_num=0; tlb_entry_num < BX_DTLB_SIZE; tlb_entry_num++) {
+    bx_TLB_entry *tlbEntry = &BX_CPU_THIS_PTR DTLB.entry[tlb_entry_num];
+    if (tlbEntry->valid() && tlbEntry->ppf >= start && tlbEntry->ppf < end) {
+      if (tlbEntry->accessBits & (TLB_SysWriteOK | TLB_UserWriteOK | TLB_SysWriteShadowStackOK | TLB_UserWriteShadowStackOK))
+        tlbEntry->invalidate();
+    }
+  }
+
+  for (unsigned set=0; set < BX_STLB_SETS; set++) {
+    for (unsigned n=0; n < BX_STLB_WAYS; n++) {
+      bx_TLB_entry *tlbEntry = &BX_CPU_THIS_PTR STLB.entry[set][n].tlbEntry;
+      if (tlbEntry->valid() && ! BX_CPU_THIS_PTR STLB.entry[set][n].code && tlbEntry->ppf >= start && tlbEntry->ppf < end) {
+        if (tlbEntry->accessBits & (TLB_SysWriteOK | TLB_UserWriteOK | TLB_SysWriteShadowStackOK | TLB_UserWriteShadowStackOK))
+          tlbEntry->invalidate();
+      }
+    }
+  }
+
+  // VMCS and VMCB are always written through the host pointer
+#if BX_SUPPORT_VMX
+  if (BX_CPU_THIS_PTR vmcshostptr) {
+    bx_phy_address vmcs_addr = A20ADDR(BX_CPU_THIS_PTR vmcsptr);
+    if (vmcs_addr >= start && vmcs_addr < end)
+      BX_MEM(0)->mark_dirty_page(vmcs_addr);
+  }
+#endif
+#if BX_SUPPORT_SVM
+  if (BX_CPU_THIS_PTR vmcbhostptr) {
+    bx_phy_address vmcb_addr = A20ADDR(BX_CPU_THIS_PTR vmcbptr);
+    if (vmcb_addr >= start && vmcb_addr < end)
+      BX_MEM(0)->mark_dirty_page(vmcb_addr);
+  }
+#endif
+}
+
 #if BX_LARGE_RAMFILE
+// the translation can still be hit, by its own context or as a global
+// translation by another context, entries left behind by a TLB flush can't
+bool BX_CPU_C::TLB_isLiveEntry(const bx_TLB_entry *tlbEntry)
+{
+  unsigned n = unsigned((tlbEntry->lpf & TLB_ContextMask) >> TLB_ContextShift);
+
+  if (BX_CPU_THIS_PTR tlb_context[n].live) return true;
+
+  return (tlbEntry->accessBits & TLB_GlobalPage) != 0 &&
+          BX_CPU_THIS_PTR tlb_context[n].epoch == BX_CPU_THIS_PTR tlb_global_epoch;
+}
+
 bool BX_CPU_C::check_addr_in_tlb_buffers(const Bit8u *addr, const Bit8u *end)
 {
 #if BX_SUPPORT_VMX
@@ -2621,7 +3006,7 @@ bool BX_CPU_C::check_addr_in_tlb_buffers(const Bit8u *addr, const Bit8u *end)
     bx_TLB_entry *tlbEntry = &BX_CPU_THIS_PTR DTLB.entry[tlb_entry_num];
     if (tlbEntry->valid()) {
       if ((tlbEntry->hostPageAddr >= (const bx_hostpageaddr_t)addr) &&
-          (tlbEntry->hostPageAddr  < (const bx_hostpageaddr_t)end))
+          (tlbEntry->hostPageAddr  < (const bx_hostpageaddr_t)end) && TLB_isLiveEntry(tlbEntry))
         return true;
     }
   }
@@ -2630,11 +3015,36 @@ bool BX_CPU_C::check_addr_in_tlb_buffers(const Bit8u *addr, const Bit8u *end)
     bx_TLB_entry *tlbEntry = &BX_CPU_THIS_PTR ITLB.entry[tlb_entry_num];
     if (tlbEntry->valid()) {
       if ((tlbEntry->hostPageAddr >= (const bx_hostpageaddr_t)addr) &&
-          (tlbEntry->hostPageAddr  < (const bx_hostpageaddr_t)end))
+          (tlbEntry->hostPageAddr  < (const bx_hostpageaddr_t)end) && TLB_isLiveEntry(tlbEntry))
         return true;
     }
   }
 
+  // the second level TLB is tagged with the serial numbers of the contexts
+  Bit64u live_serial[BX_TLB_CONTEXTS];
+  unsigned num_live = 0;
+  for (unsigned n=0; n < BX_TLB_CONTEXTS; n++) {
+    if (BX_CPU_THIS_PTR tlb_context[n].live)
+      live_serial[num_live++] = BX_CPU_THIS_PTR tlb_context[n].serial;
+  }
+
+  for (unsigned set=0; set < BX_STLB_SETS; set++) {
+    for (unsigned n=0; n < BX_STLB_WAYS; n++) {
+      const bx_STLB_entry *stlbEntry = &BX_CPU_THIS_PTR STLB.entry[set][n];
+      if (stlbEntry->tlbEntry.valid()) {
+        if ((stlbEntry->tlbEntry.hostPageAddr >= (const bx_hostpageaddr_t)addr) &&
+            (stlbEntry->tlbEntry.hostPageAddr  < (const bx_hostpageaddr_t)end))
+        {
+          if ((stlbEntry->tlbEntry.accessBits & TLB_GlobalPage) != 0 && stlbEntry->epoch == BX_CPU_THIS_PTR tlb_global_epoch)
+            return true;
+          for (unsigned k=0; k < num_live; k++) {
+            if (stlbEntry->context == live_serial[k]) return true;
+          }
+        }
+      }
+    }
+  }
+
   return false;
 }
 #endif
@@ -86,6 +86,10 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::PAUSE(bxInstruction_c *i)
   }
 #endif
 
+#if BX_SUPPORT_SMP
+  BX_CPU_THIS_PTR spin_wait_hint = 1;
+#endif
+
   BX_NEXT_INSTR(i);
 }
 
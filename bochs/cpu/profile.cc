@@ -0,0 +1,582 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#define NEED_CPU_REG_SHORTCUTS 1
+#include "bochs.h"
+#include "cpu.h"
+#include "gui/siminterface.h"
+#include "param_names.h"
+#include "memory/memory-bochs.h"
+#include "profile.h"
+
+#include "bx_debug/debug.h"
+
+#include <stdarg.h>
+
+#define LOG_THIS genlog->
+
+// number of lines of each section written to the report file
+#define BX_PROFILE_REPORT_LINES 100
+
+static bx_param_bool_c *profileEnabled = NULL;
+static Bit32u profilePeriod = 0;
+// call stacks are unwound only when they are written to the script file
+static bool profileStacks = false;
+
+static Bit64u hash_address(Bit64u h, bx_address addr)
+{
+  h = (h ^ (Bit64u) addr) * BX_CONST64(0x9E3779B97F4A7C15);
+  return h ^ (h >> 29);
+}
+
+bxProfile_c::bxProfile_c()
+{
+  traces = NULL;
+  stacks = NULL;
+  framePool = NULL;
+  traceHashSize = stackHashSize = 0;
+  framePoolCapacity = 0;
+  reset();
+}
+
+bxProfile_c::~bxProfile_c()
+{
+  delete [] traces;
+  delete [] stacks;
+  delete [] framePool;
+}
+
+void bxProfile_c::reset(void)
+{
+  if (traces) memset(traces, 0, traceHashSize * sizeof(bxProfileTrace));
+  if (stacks) memset(stacks, 0, stackHashSize * sizeof(bxProfileStack));
+  traceCount = stackCount = 0;
+  framePoolSize = 0;
+  samples = instructions = 0;
+}
+
+void bxProfile_c::growTraces(void)
+{
+  bxProfileTrace *old = traces;
+  Bit32u oldSize = traceHashSize;
+
+  traceHashSize = oldSize ? (oldSize * 2) : 1024;
+  traces = new bxProfileTrace[traceHashSize];
+  memset(traces, 0, traceHashSize * sizeof(bxProfileTrace));
+
+  for (Bit32u n=0; n < oldSize; n++) {
+    if (! old[n].samples) continue;
+    Bit32u slot = (Bit32u) hash_address(hash_address(0, old[n].laddr), old[n].context);
+    for (;; slot++) {
+      slot &= traceHashSize - 1;
+      if (! traces[slot].samples) break;
+    }
+    traces[slot] = old[n];
+  }
+
+  delete [] old;
+}
+
+void bxProfile_c::growStacks(void)
+{
+  bxProfileStack *old = stacks;
+  Bit32u oldSize = stackHashSize;
+
+  stackHashSize = oldSize ? (oldSize * 2) : 1024;
+  stacks = new bxProfileStack[stackHashSize];
+  memset(stacks, 0, stackHashSize * sizeof(bxProfileStack));
+
+  for (Bit32u n=0; n < oldSize; n++) {
+    if (! old[n].samples) continue;
+    Bit32u slot = (Bit32u) old[n].hash;
+    for (;; slot++) {
+      slot &= stackHashSize - 1;
+      if (! stacks[slot].samples) break;
+    }
+    stacks[slot] = old[n];
+  }
+
+  delete [] old;
+}
+
+void bxProfile_c::addSample(bx_address laddr, bx_address context, unsigned tlen, const bx_address *stack, unsigned depth)
+{
+  samples++;
+  instructions += tlen;
+
+  if (2 * (traceCount + 1) > traceHashSize)
+    growTraces();
+
+  Bit32u slot = (Bit32u) hash_address(hash_address(0, laddr), context);
+  for (;; slot++) {
+    slot &= traceHashSize - 1;
+    bxProfileTrace *trace = &traces[slot];
+    if (! trace->samples) {
+      trace->laddr = laddr;
+      trace->context = context;
+      trace->tlen = tlen;
+      traceCount++;
+    }
+    else if (trace->laddr != laddr || trace->context != context) {
+      continue;
+    }
+    trace->samples++;
+    // the trace could be rebuilt with another length after SMC
+    if (tlen > trace->tlen) trace->tlen = tlen;
+    break;
+  }
+
+  if (! depth) return;
+
+  if (2 * (stackCount + 1) > stackHashSize)
+    growStacks();
+
+  Bit64u hash = hash_address(depth, context);
+  for (unsigned n=0; n < depth; n++)
+    hash = hash_address(hash, stack[n]);
+
+  slot = (Bit32u) hash;
+  for (;; slot++) {
+    slot &= stackHashSize - 1;
+    bxProfileStack *s = &stacks[slot];
+    if (! s->samples) {
+      if (framePoolSize + depth > framePoolCapacity) {
+        Bit32u capacity = framePoolCapacity ? (framePoolCapacity * 2) : 4096;
+        bx_address *pool = new bx_address[capacity];
+        if (framePoolSize)
+          memcpy(pool, framePool, framePoolSize * sizeof(bx_address));
+        delete [] framePool;
+        framePool = pool;
+        framePoolCapacity = capacity;
+      }
+      memcpy(framePool + framePoolSize, stack, depth * sizeof(bx_address));
+      s->hash = hash;
+      s->context = context;
+      s->frames = framePoolSize;
+      s->depth = depth;
+      framePoolSize += depth;
+      stackCount++;
+    }
+    else if (s->hash != hash || s->context != context || s->depth != depth ||
+             memcmp(framePool + s->frames, stack, depth * sizeof(bx_address))) {
+      continue;
+    }
+    s->samples++;
+    break;
+  }
+}
+
+void initProfile(void)
+{
+  profileEnabled = SIM->get_param_bool(BXPN_PROFILE_ENABLED);
+  profilePeriod = SIM->get_param_num(BXPN_PROFILE_PERIOD)->get();
+  profileStacks = ! SIM->get_param_string(BXPN_PROFILE_SCRIPT)->isempty();
+}
+
+// read guest stack memory, never generates exceptions
+bool BX_CPU_C::profileReadStack(bx_address laddr, unsigned len, Bit8u *data)
+{
+  bx_phy_address paddr;
+
+  if (PAGE_OFFSET(laddr) + len > 0x1000)
+    return false;
+
+  if (! dbg_xlate_linear2phy(laddr, &paddr))
+    return false;
+
+  return BX_MEM(0)->dbg_fetch_mem(BX_CPU_THIS, paddr, len, data);
+}
+
+// Walk the frame pointer chain: every frame starts with the saved frame
+// pointer of the caller followed by the return address. The walk stops at
+// the first frame which is not above the previous one.
+unsigned BX_CPU_C::profileUnwind(bx_address *stack, unsigned max_depth)
+{
+  bx_address base = BX_CPU_THIS_PTR sregs[BX_SEG_REG_SS].cache.u.segment.base;
+  bx_address fp;
+  unsigned size, depth = 0;
+
+#if BX_SUPPORT_X86_64
+  if (long64_mode()) {
+    base = 0;
+    fp = RBP;
+    size = 8;
+  }
+  else
+#endif
+  if (BX_CPU_THIS_PTR sregs[BX_SEG_REG_SS].cache.u.segment.d_b) {
+    fp = EBP;
+    size = 4;
+  }
+  else {
+    return 0; // 16-bit code is not unwound
+  }
+
+  while (depth < max_depth) {
+    Bit8u frame[16];
+    bx_address laddr = base + fp;
+    if (size == 4) laddr &= 0xffffffff;
+    if (! profileReadStack(laddr, 2 * size, frame))
+      break;
+
+    bx_address next_fp, ret;
+#if BX_SUPPORT_X86_64
+    if (size == 8) {
+      next_fp = ReadHostQWordFromLittleEndian((Bit64u*) frame);
+      ret = ReadHostQWordFromLittleEndian((Bit64u*) (frame + 8));
+    }
+    else
+#endif
+    {
+      next_fp = ReadHostDWordFromLittleEndian((Bit32u*) frame);
+      ret = ReadHostDWordFromLittleEndian((Bit32u*) (frame + 4));
+    }
+
+    if (! ret) break;
+    if (size == 4)
+      ret = (BX_CPU_THIS_PTR sregs[BX_SEG_REG_CS].cache.u.segment.base + ret) & 0xffffffff;
+    stack[depth++] = ret;
+
+    if (next_fp <= fp) break;
+    fp = next_fp;
+  }
+
+  return depth;
+}
+
+// Called when the sample countdown of the processor expires. The trace about
+// to be executed is sampled. The trace entry is not known when the trace is
+// reached through a trace link, it is looked up in the trace cache then.
+void BX_CPU_C::profileSample(bxICacheEntry_c *entry)
+{
+  BX_CPU_THIS_PTR profile_countdown = profilePeriod;
+
+  if (! profileEnabled || ! profileEnabled->get())
+    return;
+
+  if (! BX_CPU_THIS_PTR profile)
+    BX_CPU_THIS_PTR profile = new bxProfile_c;
+
+  unsigned tlen = 1;
+  if (! entry) {
+    bx_address eipBiased = RIP + BX_CPU_THIS_PTR eipPageBias;
+    if (eipBiased < BX_CPU_THIS_PTR eipPageWindowSize)
+      entry = BX_CPU_THIS_PTR iCache.find_entry(BX_CPU_THIS_PTR pAddrFetchPage + eipBiased, BX_CPU_THIS_PTR fetchModeMask);
+  }
+  // the debugger executes a single instruction after every trace lookup
+  if (entry && ! bx_dbg.debugger_active)
+    tlen = entry->tlen;
+
+  bx_address laddr = get_laddr(BX_SEG_REG_CS, RIP);
+  bx_address context = (bx_address)(BX_CPU_THIS_PTR cr3 >> 12);
+
+  bx_address stack[BX_PROFILE_MAX_DEPTH];
+  unsigned depth = 0;
+  if (profileStacks) {
+    stack[0] = laddr;
+    depth = 1 + profileUnwind(stack + 1, BX_PROFILE_MAX_DEPTH - 1);
+  }
+
+  BX_CPU_THIS_PTR profile->addSample(laddr, context, tlen, stack, depth);
+}
+
+/* ************************************************************************ */
+/* Profile report */
+
+struct bxProfileRow {
+  const char *name;     // symbol name, NULL when no symbol is known
+  bx_address start;     // symbol start or the sampled address without symbol
+  bx_address context;
+  bx_address callee;    // callee symbol start of the call site rows
+  Bit32u tlen;
+  Bit64u samples;
+  Bit64u instructions;
+};
+
+static const char *profile_symbol(bx_address context, bx_address laddr, bx_address *start)
+{
+#if BX_DEBUGGER
+  const char *name = bx_dbg_symbol_lookup(context, laddr, start);
+  if (name) return name;
+#endif
+  *start = laddr;
+  return NULL;
+}
+
+static int row_key_compare(const void *a, const void *b)
+{
+  const bxProfileRow *r1 = (const bxProfileRow *) a, *r2 = (const bxProfileRow *) b;
+  if (r1->start != r2->start) return (r1->start < r2->start) ? -1 : 1;
+  if (r1->callee != r2->callee) return (r1->callee < r2->callee) ? -1 : 1;
+  if (r1->name != r2->name) return (r1->name < r2->name) ? -1 : 1;
+  if (r1->context != r2->context) return (r1->context < r2->context) ? -1 : 1;
+  return 0;
+}
+
+static int row_samples_compare(const void *a, const void *b)
+{
+  const bxProfileRow *r1 = (const bxProfileRow *) a, *r2 = (const bxProfileRow *) b;
+  if (r1->instructions != r2->instructions) return (r1->instructions > r2->instructions) ? -1 : 1;
+  if (r1->samples != r2->samples) return (r1->samples > r2->samples) ? -1 : 1;
+  return row_key_compare(a, b);
+}
+
+// Sort the rows by key and sum the rows with the same key, then sort them
+// by weight. Returns the number of the remaining rows.
+static unsigned merge_rows(bxProfileRow *rows, unsigned count)
+{
+  if (! count) return 0;
+
+  qsort(rows, count, sizeof(bxProfileRow), row_key_compare);
+
+  unsigned n = 0;
+  for (unsigned i=1; i < count; i++) {
+    if (! row_key_compare(&rows[n], &rows[i])) {
+      rows[n].samples += rows[i].samples;
+      rows[n].instructions += rows[i].instructions;
+      if (rows[i].tlen > rows[n].tlen) rows[n].tlen = rows[i].tlen;
+    }
+    else {
+      rows[++n] = rows[i];
+    }
+  }
+  count = n + 1;
+
+  qsort(rows, count, sizeof(bxProfileRow), row_samples_compare);
+  return count;
+}
+
+// the report goes to the debugger console when no file is given
+static void profile_printf(FILE *fp, const char *fmt, ...)
+{
+  char buf[512];
+  va_list ap;
+
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+#if BX_DEBUGGER
+  if (! fp) {
+    dbg_printf("%s", buf);
+    return;
+  }
+#endif
+  if (fp) fputs(buf, fp);
+}
+
+static const char *profile_location(char *buf, unsigned len, const char *name, bx_address start, bx_address laddr)
+{
+  if (name)
+    snprintf(buf, len, "%s+0x%x", name, (unsigned)(laddr - start));
+  else
+    snprintf(buf, len, "[unknown]");
+  return buf;
+}
+
+static void write_report(FILE *fp, unsigned maxLines)
+{
+  Bit64u samples = 0, instructions = 0;
+  unsigned traceCount = 0, callCount = 0;
+  Bit32u size;
+
+  for (unsigned cpu=0; cpu<BX_SMP_PROCESSORS; cpu++) {
+    bxProfile_c *profile = BX_CPU(cpu) ? BX_CPU(cpu)->profile : NULL;
+    if (! profile) continue;
+    samples += profile->totalSamples();
+    instructions += profile->totalInstructions();
+    const bxProfileTrace *traces = profile->getTraces(&size);
+    for (Bit32u n=0; n < size; n++)
+      if (traces[n].samples) traceCount++;
+    const bxProfileStack *stacks = profile->getStacks(&size);
+    for (Bit32u n=0; n < size; n++)
+      if (stacks[n].samples && stacks[n].depth > 1) callCount++;
+  }
+
+  profile_printf(fp, "Bochs profile: %u processors, %llu samples, one of %u trace entries sampled\n",
+      (unsigned) BX_SMP_PROCESSORS, (unsigned long long) samples, (unsigned) profilePeriod);
+  if (! samples) return;
+
+  bxProfileRow *rows = new bxProfileRow[traceCount + callCount];
+  char loc[128];
+
+  // hottest traces
+  unsigned count = 0;
+  for (unsigned cpu=0; cpu<BX_SMP_PROCESSORS; cpu++) {
+    bxProfile_c *profile = BX_CPU(cpu) ? BX_CPU(cpu)->profile : NULL;
+    if (! profile) continue;
+    const bxProfileTrace *traces = profile->getTraces(&size);
+    for (Bit32u n=0; n < size; n++) {
+      if (! traces[n].samples) continue;
+      bxProfileRow *row = &rows[count++];
+      row->name = NULL;
+      row->start = traces[n].laddr;
+      row->context = traces[n].context;
+      row->callee = 0;
+      row->tlen = traces[n].tlen;
+      row->samples = traces[n].samples;
+      row->instructions = (Bit64u) traces[n].samples * traces[n].tlen;
+    }
+  }
+  unsigned traceRows = merge_rows(rows, count);
+
+  // flat profile by symbol, the merged trace rows are aggregated once more
+  bxProfileRow *symbols = new bxProfileRow[traceRows];
+  for (unsigned n=0; n < traceRows; n++) {
+    symbols[n] = rows[n];
+    symbols[n].name = profile_symbol(rows[n].context, rows[n].start, &symbols[n].start);
+    // symbols are shared by all contexts when found in the global context
+    if (symbols[n].name) symbols[n].context = 0;
+  }
+  unsigned symbolRows = merge_rows(symbols, traceRows);
+
+  profile_printf(fp, "\nFlat profile (instructions estimated from sampled trace lengths):\n\n");
+  profile_printf(fp, "  samples  instructions       %%  symbol\n");
+  for (unsigned n=0; n < symbolRows && n < maxLines; n++) {
+    // without symbol every trace is its own row
+    if (! symbols[n].name)
+      snprintf(loc, sizeof(loc), "[unknown] " FMT_ADDRX, symbols[n].start);
+    profile_printf(fp, "%9llu  %12llu  %5.2f%%  %s\n",
+        (unsigned long long) symbols[n].samples, (unsigned long long) symbols[n].instructions,
+        100.0 * symbols[n].instructions / instructions,
+        symbols[n].name ? symbols[n].name : loc);
+  }
+
+  profile_printf(fp, "\nHottest traces:\n\n");
+  profile_printf(fp, "  samples  instructions  length  address           location\n");
+  for (unsigned n=0; n < traceRows && n < maxLines; n++) {
+    bx_address start;
+    const char *name = profile_symbol(rows[n].context, rows[n].start, &start);
+    profile_printf(fp, "%9llu  %12llu  %6u  " FMT_ADDRX "  %s\n",
+        (unsigned long long) rows[n].samples, (unsigned long long) rows[n].instructions,
+        rows[n].tlen, rows[n].start,
+        profile_location(loc, sizeof(loc), name, start, rows[n].start));
+  }
+
+  // call sites: return address in the caller and the callee symbol
+  count = 0;
+  for (unsigned cpu=0; cpu<BX_SMP_PROCESSORS; cpu++) {
+    bxProfile_c *profile = BX_CPU(cpu) ? BX_CPU(cpu)->profile : NULL;
+    if (! profile) continue;
+    const bxProfileStack *stacks = profile->getStacks(&size);
+    const bx_address *frames = profile->getFrames();
+    for (Bit32u n=0; n < size; n++) {
+      if (! stacks[n].samples || stacks[n].depth < 2) continue;
+      bxProfileRow *row = &rows[count++];
+      row->start = frames[stacks[n].frames + 1];
+      row->context = stacks[n].context;
+      row->name = profile_symbol(stacks[n].context, frames[stacks[n].frames], &row->callee);
+      row->tlen = 0;
+      row->samples = row->instructions = stacks[n].samples;
+    }
+  }
+  unsigned callRows = merge_rows(rows, count);
+
+  if (callRows) {
+    profile_printf(fp, "\nCall sites (from frame pointer chains):\n\n");
+    profile_printf(fp, "  samples  return address    caller -> callee\n");
+    for (unsigned n=0; n < callRows && n < maxLines; n++) {
+      bx_address start;
+      const char *name = profile_symbol(rows[n].context, rows[n].start, &start);
+      char callee[128];
+      if (rows[n].name)
+        snprintf(callee, sizeof(callee), "%s", rows[n].name);
+      else
+        snprintf(callee, sizeof(callee), "[unknown] " FMT_ADDRX, rows[n].callee);
+      profile_printf(fp, "%9llu  " FMT_ADDRX "  %s -> %s\n",
+          (unsigned long long) rows[n].samples, rows[n].start,
+          profile_location(loc, sizeof(loc), name, start, rows[n].start), callee);
+    }
+  }
+
+  delete [] symbols;
+  delete [] rows;
+}
+
+// Sampled call stacks in the format of 'perf script', every distinct stack
+// is written once with the number of trace entries it represents as period.
+static void write_script(FILE *fp)
+{
+  Bit32u size;
+  char loc[128];
+
+  for (unsigned cpu=0; cpu<BX_SMP_PROCESSORS; cpu++) {
+    bxProfile_c *profile = BX_CPU(cpu) ? BX_CPU(cpu)->profile : NULL;
+    if (! profile) continue;
+    const bxProfileStack *stacks = profile->getStacks(&size);
+    const bx_address *frames = profile->getFrames();
+    for (Bit32u n=0; n < size; n++) {
+      if (! stacks[n].samples) continue;
+      fprintf(fp, "bochs %u [%03u] 0.000000: %llu traces:\n", cpu, cpu,
+          (unsigned long long) stacks[n].samples * profilePeriod);
+      for (unsigned d=0; d < stacks[n].depth; d++) {
+        bx_address laddr = frames[stacks[n].frames + d], start;
+        const char *name = profile_symbol(stacks[n].context, laddr, &start);
+        fprintf(fp, "\t%16llx %s (guest)\n", (unsigned long long) laddr,
+            profile_location(loc, sizeof(loc), name, start, laddr));
+      }
+      fprintf(fp, "\n");
+    }
+  }
+}
+
+void writeProfile(void)
+{
+  bool sampled = false;
+  for (unsigned cpu=0; cpu<BX_SMP_PROCESSORS; cpu++) {
+    if (BX_CPU(cpu) && BX_CPU(cpu)->profile) sampled = true;
+  }
+  if (! sampled) return;
+
+  bx_param_string_c *file = SIM->get_param_string(BXPN_PROFILE_FILE);
+  if (! file->isempty()) {
+    FILE *fp = fopen(file->getptr(), "w");
+    if (fp) {
+      write_report(fp, BX_PROFILE_REPORT_LINES);
+      fclose(fp);
+      BX_INFO(("profile report written to '%s'", file->getptr()));
+    }
+    else {
+      BX_ERROR(("failed to write profile report '%s'", file->getptr()));
+    }
+  }
+
+  file = SIM->get_param_string(BXPN_PROFILE_SCRIPT);
+  if (! file->isempty()) {
+    FILE *fp = fopen(file->getptr(), "w");
+    if (fp) {
+      write_script(fp);
+      fclose(fp);
+      BX_INFO(("profile call stacks written to '%s'", file->getptr()));
+    }
+    else {
+      BX_ERROR(("failed to write profile call stacks '%s'", file->getptr()));
+    }
+  }
+}
+
+#if BX_DEBUGGER
+void printProfile(unsigned lines)
+{
+  write_report(NULL, lines);
+}
+#endif
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_PROFILE_H
+#define BX_PROFILE_H
+
+// Sampling profiler of the executed guest code. Every processor counts the
+// traces it enters, one of every 'period' trace entries is sampled: the
+// linear address of the trace, its length and optionally the guest call
+// stack found by following the frame pointer chain are recorded in the
+// tables of the processor. The report aggregates the samples by guest
+// symbol when debug symbols are loaded.
+
+#define BX_PROFILE_MAX_DEPTH      32
+
+// sampled trace, keyed by linear address and symbol context
+struct bxProfileTrace {
+  bx_address laddr;
+  bx_address context;
+  Bit32u tlen;
+  Bit32u samples;
+};
+
+// sampled call stack, the frames are stored in the frame pool: the first
+// one is the sampled trace followed by the return addresses of the callers
+struct bxProfileStack {
+  Bit64u hash;
+  bx_address context;
+  Bit32u frames;        // index of the first frame in the frame pool
+  Bit32u depth;
+  Bit32u samples;
+};
+
+class bxProfile_c {
+public:
+  bxProfile_c();
+ ~bxProfile_c();
+
+  void reset(void);
+  void addSample(bx_address laddr, bx_address context, unsigned tlen, const bx_address *stack, unsigned depth);
+
+  Bit64u totalSamples(void) const { return samples; }
+  Bit64u totalInstructions(void) const { return instructions; }
+
+  // tables are open addressing hashes, unused entries have zero samples
+  const bxProfileTrace *getTraces(Bit32u *size) const { *size = traceHashSize; return traces; }
+  const bxProfileStack *getStacks(Bit32u *size) const { *size = stackHashSize; return stacks; }
+  const bx_address *getFrames(void) const { return framePool; }
+
+private:
+  bxProfileTrace *traces;
+  Bit32u traceHashSize, traceCount;
+  bxProfileStack *stacks;
+  Bit32u stackHashSize, stackCount;
+  bx_address *framePool;
+  Bit32u framePoolSize, framePoolCapacity;
+
+  Bit64u samples;
+  Bit64u instructions;
+
+  void growTraces(void);
+  void growStacks(void);
+};
+
+extern void initProfile(void);
+extern void writeProfile(void);
+#if BX_DEBUGGER
+extern void printProfile(unsigned lines);
+#endif
+
+#endif
@@ -33,7 +33,7 @@ void BX_CPP_AttrRegparmN(2) BX_CPU_C::stackPrefetch(bx_address offset, unsigned
   bx_address laddr;
   unsigned pageOffset;
 
-  INC_STACK_PREFETCH_STAT(stackPrefetch);
+  INC_CPU_STAT(stackPrefetch);
 
   BX_CPU_THIS_PTR espHostPtr = 0; // initialize with NULL pointer
   BX_CPU_THIS_PTR espPageWindowSize = 0;
@@ -107,7 +107,7 @@ void BX_CPP_AttrRegparmN(2) BX_CPU_C::stackPrefetch(bx_address offset, unsigned
     }
   }
 
-  Bit64u lpf = LPFOf(laddr);
+  Bit64u lpf = BX_TLB_LPFOf(laddr);
   bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
   if (tlbEntry->lpf == lpf) {
     // See if the TLB entry privilege level allows us write access from this CPL
@@ -369,6 +369,7 @@ bool BX_CPU_C::SvmEnterLoadCheckControls(SVM_CONTROLS *ctrls)
     BX_ERROR(("VMRUN: attempt to run guest with host ASID !"));
     return 0;
   }
+  ctrls->guest_asid = guest_asid;
 
   ctrls->v_tpr = vmcb_read8(SVM_CONTROL_VTPR);
   ctrls->v_intr_masking = vmcb_read8(SVM_CONTROL_VINTR_MASKING) & 0x1;
@@ -1057,6 +1058,7 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::VMRUN(bxInstruction_c *i)
     Svm_Vmexit(SVM_VMEXIT_INVALID);
 
   BX_CPU_THIS_PTR in_svm_guest = true;
+  TLB_updateContextKey();
   BX_CPU_THIS_PTR svm_gif = true;
   BX_CPU_THIS_PTR async_event = 1;
 
@@ -1294,6 +1296,7 @@ void BX_CPU_C::register_svm_state(bx_param_c *parent)
   BXRS_HEX_PARAM_FIELD(vmcb_ctrls, v_intr_vector, BX_CPU_THIS_PTR vmcb->ctrls.v_intr_vector);
   BXRS_PARAM_BOOL(vmcb_ctrls, nested_paging, BX_CPU_THIS_PTR vmcb->ctrls.nested_paging);
   BXRS_HEX_PARAM_FIELD(vmcb_ctrls, ncr3, BX_CPU_THIS_PTR vmcb->ctrls.ncr3);
+  BXRS_HEX_PARAM_FIELD(vmcb_ctrls, guest_asid, BX_CPU_THIS_PTR vmcb->ctrls.guest_asid);
 
   //
   // VMCB Host State
@@ -310,6 +310,8 @@ struct SVM_CONTROLS
   bool nested_paging;
   Bit64u ncr3;
 
+  Bit32u guest_asid;
+
   Bit16u pause_filter_count;
 //Bit16u pause_filter_threshold;
 };
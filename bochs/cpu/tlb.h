@@ -49,6 +49,23 @@ BX_CPP_INLINE bx_address AlignedAccessLPFOf(bx_address laddr, unsigned alignment
   return laddr & (LPF_MASK | alignment_mask);
 }
 
+// TLB entries are tagged with the translation context (PCID and VPID/ASID of
+// the guest) they were created in. The tag is kept in bits [10:6] of the entry
+// lpf, below the TLB_NoHostPtr bit and above the alignment check bits, so the
+// TLB lookups compare the linear page frame combined with the tag of current
+// context against the entry lpf and the context costs nothing on TLB hit.
+// The tag doubles as flush generation: a flushed context continues with a new
+// tag and the entries left with the old one are never hit again.
+const unsigned BX_TLB_CONTEXTS = 32;
+const Bit32u TLB_ContextShift = 6;
+const Bit32u TLB_ContextMask = (BX_TLB_CONTEXTS - 1) << TLB_ContextShift;
+const Bit64u BX_TLB_NO_CONTEXT = BX_CONST64(0xffffffffffffffff);
+
+#define BX_TLB_LPFOf(laddr) \
+  (LPFOf(laddr) | BX_CPU_THIS_PTR tlb_context_tag)
+#define BX_TLB_AlignedAccessLPFOf(laddr, alignment_mask) \
+  (AlignedAccessLPFOf((laddr), (alignment_mask)) | BX_CPU_THIS_PTR tlb_context_tag)
+
 // BX_TLB_INDEX_OF(lpf): This macro is passed the linear page frame
 //   (top bits of the linear address).  It must map these bits to
 //   one of the TLB cache slots, given the size of BX_TLB_SIZE.
@@ -206,24 +223,25 @@ public:
 #endif
   }
 
-#if BX_CPU_LEVEL >= 6
-  BX_CPP_INLINE void flushNonGlobal(void)
+  // invalidate all entries tagged with one of the TLB contexts in the mask
+  BX_CPP_INLINE void flushContexts(Bit32u contextMask)
   {
     Bit32u lpf_mask = 0;
 
     for (unsigned n=0; n<size; n++) {
       bx_TLB_entry *tlbEntry = &entry[n];
       if (tlbEntry->valid()) {
-        if (!(tlbEntry->accessBits & TLB_GlobalPage))
+        if (contextMask & (1 << ((tlbEntry->lpf & TLB_ContextMask) >> TLB_ContextShift)))
           tlbEntry->invalidate();
         else
           lpf_mask |= tlbEntry->lpf_mask;
       }
     }
 
+#if BX_CPU_LEVEL >= 5
     split_large = (lpf_mask > 0xfff);
-  }
 #endif
+  }
 
   BX_CPP_INLINE void invlpg(bx_address laddr)
   {
@@ -257,4 +275,231 @@ public:
   }
 };
 
+// Second level TLB: set associative TLB shared by data and instruction
+// translations. Every 4K translation put into the DTLB or ITLB is also put
+// here, so a translation lost in the direct mapped first level TLB because
+// of a conflicting page is found again without page walk. The set index
+// mixes in the linear address bits above the first level TLB index so the
+// pages conflicting in the first level TLB are spread over different sets.
+// Translations of large pages are not kept as INVLPG would have to search
+// the whole TLB for them.
+//
+// The entries are not tagged with the 5-bit TLB context tag but with the
+// serial number of the TLB context, which is never reused, so reclaiming
+// the context tags doesn't have to search the second level TLB.
+
+struct bx_STLB_entry
+{
+  bx_TLB_entry tlbEntry;
+  Bit64u context;       // serial number of the TLB context of the translation
+  Bit32u vpid;          // VPID/ASID of the context, global translations are not shared between them
+  Bit32u epoch;         // global TLB flush epoch the translation was created in
+  bool code;            // ITLB entry, accessBits have the ITLB format
+};
+
+template <unsigned sets, unsigned ways>
+struct SecondLevelTLB {
+  bx_STLB_entry entry[sets][ways];
+
+public:
+  SecondLevelTLB() { flush(); }
+
+  BX_CPP_INLINE static unsigned get_set_of(bx_address laddr)
+  {
+    return unsigned((laddr >> 12) ^ (laddr >> 22)) & (sets-1);
+  }
+
+  // find the translation of the linear page created in any TLB context
+  BX_CPP_INLINE bx_STLB_entry *lookup(bx_address laddr, bool isCode)
+  {
+    bx_STLB_entry *e = entry[get_set_of(laddr)];
+    for (unsigned n=0; n < ways; n++, e++) {
+      if (e->tlbEntry.valid() && LPFOf(e->tlbEntry.lpf) == LPFOf(laddr) && e->code == isCode)
+        return e;
+    }
+    return NULL;
+  }
+
+  // replace the older translation of the page or the oldest entry of the set
+  BX_CPP_INLINE void insert(const bx_TLB_entry *tlbEntry, bool isCode, Bit64u context, Bit32u vpid, Bit32u epoch)
+  {
+    bx_STLB_entry *e = entry[get_set_of(tlbEntry->lpf)];
+    unsigned n;
+    for (n=0; n < ways-1; n++) {
+      if (LPFOf(e[n].tlbEntry.lpf) == LPFOf(tlbEntry->lpf) && e[n].code == isCode) break;
+    }
+    for (; n > 0; n--)
+      e[n] = e[n-1];
+
+    e->tlbEntry = *tlbEntry;
+    e->context = context;
+    e->vpid = vpid;
+    e->epoch = epoch;
+    e->code = isCode;
+  }
+
+  BX_CPP_INLINE void flush(void)
+  {
+    for (unsigned set=0; set < sets; set++)
+      for (unsigned n=0; n < ways; n++)
+        entry[set][n].tlbEntry.invalidate();
+  }
+
+  BX_CPP_INLINE void invlpg(bx_address laddr)
+  {
+    bx_STLB_entry *e = entry[get_set_of(laddr)];
+    for (unsigned n=0; n < ways; n++, e++) {
+      if (LPFOf(e->tlbEntry.lpf) == LPFOf(laddr))
+        e->tlbEntry.invalidate();
+    }
+  }
+};
+
+#if BX_SUPPORT_X86_64
+
+// Paging-structure cache: non-leaf entries read by recent long mode page
+// walks, one direct mapped table for each of the PDE, PDPTE, PML4E and PML5E
+// levels. An entry is found by the linear address bits translated by its level
+// and the levels above and is tagged with the TLB context of the walk, so the
+// TLB flushes and context switches make it stale together with the TLB entries.
+
+#define BX_PSC_SIZE 64
+#define BX_PSC_LEVELS 4
+
+struct bx_PSC_entry
+{
+  bx_address key;         // linear address bits translated down to the level | context tag
+  Bit64u entry;           // the cached paging-structure entry with Accessed bit set
+  Bit32u combined_access; // U/S and R/W of the entry and the upper level entries
+  Bit32u nx;              // XD bit set in the entry or one of the upper level entries
+
+  BX_CPP_INLINE void invalidate() { key = BX_INVALID_TLB_ENTRY; }
+};
+
+struct PagingStructureCache {
+  bx_PSC_entry entry[BX_PSC_LEVELS][BX_PSC_SIZE];
+
+public:
+  PagingStructureCache() { flush(); }
+
+  // level is 1 (PDE) to 4 (PML5E), the entry maps 2^(12+9*level) bytes
+  BX_CPP_INLINE static bx_address key_of(bx_address laddr, unsigned level, bx_address tag)
+  {
+    return (laddr & ~((bx_address(1) << (12 + 9*level)) - 1)) | tag;
+  }
+
+  BX_CPP_INLINE bx_PSC_entry *get_entry_of(bx_address laddr, unsigned level)
+  {
+    return &entry[level-1][(laddr >> (12 + 9*level)) & (BX_PSC_SIZE-1)];
+  }
+
+  BX_CPP_INLINE bx_PSC_entry *lookup(bx_address laddr, unsigned level, bx_address tag)
+  {
+    bx_PSC_entry *e = get_entry_of(laddr, level);
+    return (e->key == key_of(laddr, level, tag)) ? e : NULL;
+  }
+
+  BX_CPP_INLINE void update(bx_address laddr, unsigned level, bx_address tag, Bit64u entry, Bit32u combined_access, bool nx)
+  {
+    bx_PSC_entry *e = get_entry_of(laddr, level);
+    e->key = key_of(laddr, level, tag);
+    e->entry = entry;
+    e->combined_access = combined_access;
+    e->nx = nx;
+  }
+
+  BX_CPP_INLINE void flush(void)
+  {
+    for (unsigned level=0; level < BX_PSC_LEVELS; level++)
+      for (unsigned n=0; n < BX_PSC_SIZE; n++)
+        entry[level][n].invalidate();
+  }
+
+  // invalidate all entries tagged with one of the TLB contexts in the mask
+  BX_CPP_INLINE void flushContexts(Bit32u contextMask)
+  {
+    for (unsigned level=0; level < BX_PSC_LEVELS; level++) {
+      for (unsigned n=0; n < BX_PSC_SIZE; n++) {
+        bx_PSC_entry *e = &entry[level][n];
+        if (e->key != BX_INVALID_TLB_ENTRY && (contextMask & (1 << ((e->key & TLB_ContextMask) >> TLB_ContextShift))))
+          e->invalidate();
+      }
+    }
+  }
+
+  // invalidate the entries which could be used to translate the linear address
+  BX_CPP_INLINE void invlpg(bx_address laddr)
+  {
+    for (unsigned level=1; level <= BX_PSC_LEVELS; level++) {
+      bx_PSC_entry *e = get_entry_of(laddr, level);
+      if ((e->key & ~bx_address(TLB_ContextMask)) == key_of(laddr, level, 0))
+        e->invalidate();
+    }
+  }
+};
+
+#endif
+
+#if (BX_SUPPORT_VMX >= 2) || BX_SUPPORT_SVM
+
+// Nested walk cache: EPT/NPT translations of the guest physical pages holding
+// guest paging structures, used by the guest page walks instead of walking the
+// EPT/NPT tables for every guest paging-structure entry read. Entries are only
+// created after successful nested walk which already set the Accessed/Dirty
+// bits in the EPT/NPT entries and are tagged with the TLB context like the
+// paging-structure cache.
+
+#define BX_NESTED_WALK_CACHE_SIZE 64
+
+struct bx_nested_walk_entry
+{
+  bx_phy_address key;     // guest physical page frame | context tag
+  bx_phy_address ppf;     // host physical page frame
+};
+
+struct NestedWalkCache {
+  bx_nested_walk_entry entry[BX_NESTED_WALK_CACHE_SIZE];
+
+public:
+  NestedWalkCache() { flush(); }
+
+  BX_CPP_INLINE bx_nested_walk_entry *get_entry_of(bx_phy_address guest_paddr)
+  {
+    return &entry[(guest_paddr >> 12) & (BX_NESTED_WALK_CACHE_SIZE-1)];
+  }
+
+  BX_CPP_INLINE bool lookup(bx_phy_address guest_paddr, bx_address tag, bx_phy_address *paddr)
+  {
+    bx_nested_walk_entry *e = get_entry_of(guest_paddr);
+    if (e->key != (PPFOf(guest_paddr) | tag)) return false;
+    *paddr = e->ppf | PAGE_OFFSET(guest_paddr);
+    return true;
+  }
+
+  BX_CPP_INLINE void update(bx_phy_address guest_paddr, bx_address tag, bx_phy_address paddr)
+  {
+    bx_nested_walk_entry *e = get_entry_of(guest_paddr);
+    e->key = PPFOf(guest_paddr) | tag;
+    e->ppf = PPFOf(paddr);
+  }
+
+  BX_CPP_INLINE void flush(void)
+  {
+    for (unsigned n=0; n < BX_NESTED_WALK_CACHE_SIZE; n++)
+      entry[n].key = (bx_phy_address) BX_INVALID_TLB_ENTRY;
+  }
+
+  // invalidate all entries tagged with one of the TLB contexts in the mask
+  BX_CPP_INLINE void flushContexts(Bit32u contextMask)
+  {
+    for (unsigned n=0; n < BX_NESTED_WALK_CACHE_SIZE; n++) {
+      bx_nested_walk_entry *e = &entry[n];
+      if (e->key != (bx_phy_address) BX_INVALID_TLB_ENTRY && (contextMask & (1 << ((e->key & TLB_ContextMask) >> TLB_ContextShift))))
+        e->key = (bx_phy_address) BX_INVALID_TLB_ENTRY;
+    }
+  }
+};
+
+#endif
+
 #endif
@@ -0,0 +1,586 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#define NEED_CPU_REG_SHORTCUTS 1
+#include "bochs.h"
+#include "cpu.h"
+#include "cpustats.h"
+#include "memory/memory-bochs.h"
+#include "pc_system.h"
+#include "tracefile.h"
+
+#include "decoder/fetchdecode.h"
+
+// table of all Bochs opcodes
+extern struct bxIAOpcodeTable BxOpcodesTable[];
+
+#define LOG_THIS genlog->
+
+// upper limit of the instructions accepted from the file
+#define BX_TRACE_FILE_MAX_INSTRUCTIONS (16 * 1024 * 1024)
+
+bxTraceFile_c traceFile;
+
+#if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
+extern void genDummyICacheEntry(bxInstruction_c *i);
+#endif
+
+void saveTraceFile(void)
+{
+  traceFile.save();
+}
+
+Bit64u bxTraceFile_c::hash_bytes(Bit64u h, const void *data, unsigned len)
+{
+  const Bit8u *p = (const Bit8u *) data;
+
+  for (; len >= 8; len -= 8, p += 8) {
+    Bit64u word;
+    memcpy(&word, p, 8);
+    h = (h ^ word) * BX_CONST64(0x9E3779B97F4A7C15);
+    h ^= h >> 29;
+  }
+  for (; len > 0; len--, p++) {
+    h = (h ^ *p) * BX_CONST64(0x9E3779B97F4A7C15);
+    h ^= h >> 29;
+  }
+
+  return h;
+}
+
+Bit64u bxTraceFile_c::page_hash(const Bit8u *page, Bit32u codeMask)
+{
+  Bit64u h = codeMask;
+
+  for (unsigned line=0; line < 32; line++) {
+    if (codeMask & (1 << line))
+      h = hash_bytes(h ^ line, page + line * 128, 128);
+  }
+
+  return h;
+}
+
+// Decoded instructions are stored as is, so the file can be used only with
+// the same instruction layout and opcode numbering. Both are derived from
+// the decoder data, a rebuild of the same sources produces the same id.
+Bit64u bxTraceFile_c::build_id(void)
+{
+  Bit32u layout[2] = { (Bit32u) sizeof(bxInstruction_c), BX_IA_LAST };
+  Bit64u h = hash_bytes(0, layout, sizeof(layout));
+
+  for (unsigned n=0; n < BX_IA_LAST; n++) {
+    const char *name = get_bx_opcode_name(n);
+    h = hash_bytes(h, name, strlen(name));
+    h = hash_bytes(h, BxOpcodesTable[n].src, sizeof(BxOpcodesTable[n].src));
+    h = hash_bytes(h, &BxOpcodesTable[n].opflags, sizeof(BxOpcodesTable[n].opflags));
+  }
+
+  return h;
+}
+
+// Decoder tables depend on the ISA extensions supported by the CPU model
+Bit64u bxTraceFile_c::cpu_id(BX_CPU_C *cpu)
+{
+  return hash_bytes(BX_CPU_LEVEL, cpu->ia_extensions_bitmask, sizeof(cpu->ia_extensions_bitmask));
+}
+
+void bxTraceFile_c::free_tables(void)
+{
+  delete [] pages;
+  delete [] traces;
+  delete [] instructions;
+  delete [] pageHash;
+  delete [] traceHash;
+
+  pages = NULL;
+  traces = NULL;
+  instructions = NULL;
+  pageHash = traceHash = NULL;
+  numPages = numTraces = numInstructions = 0;
+  pageHashMask = traceHashMask = 0;
+}
+
+static unsigned hash_table_size(unsigned entries)
+{
+  unsigned size = 16;
+  while (size < entries * 2) size *= 2;
+  return size;
+}
+
+// Check the records read from the file and index them. Returns false when
+// the file is corrupted.
+bool bxTraceFile_c::build_tables(void)
+{
+  unsigned n, k, size;
+
+  size = hash_table_size(numPages);
+  pageHash = new Bit32u[size];
+  memset(pageHash, 0, sizeof(Bit32u) * size);
+  pageHashMask = size - 1;
+
+  for (n=0; n < numPages; n++) {
+    bxTraceFilePage *page = &pages[n];
+    if (PAGE_OFFSET(page->ppf) != 0 || find_page(page->ppf) != NULL)
+      return false;
+    page->state = BX_TRACE_FILE_PAGE_UNKNOWN;
+
+    k = hash(page->ppf, 0) & pageHashMask;
+    while (pageHash[k] != 0) k = (k + 1) & pageHashMask;
+    pageHash[k] = n + 1;
+  }
+
+  size = hash_table_size(numTraces);
+  traceHash = new Bit32u[size];
+  memset(traceHash, 0, sizeof(Bit32u) * size);
+  traceHashMask = size - 1;
+
+  for (n=0; n < numTraces; n++) {
+    bxTraceFileTrace *t = &traces[n];
+    if (t->page >= numPages || PPFOf(t->pAddr) != pages[t->page].ppf)
+      return false;
+    if (t->tlen == 0 || t->tlen > BX_MAX_TRACE_LENGTH || t->instr > numInstructions - t->tlen)
+      return false;
+
+    // the instructions must follow each other inside the lines of the page
+    // covered by the page hash
+    Bit32u pageOffset = PAGE_OFFSET((Bit32u) t->pAddr), traceMask = 0;
+    const bxInstruction_c *i = &instructions[t->instr];
+    for (k=0; k < t->tlen; k++, i++) {
+      unsigned iLen = i->ilen();
+      if (iLen == 0 || iLen > 15 || pageOffset + iLen > 4096 || i->getIaOpcode() >= BX_IA_LAST)
+        return false;
+      traceMask |= 1 <<  (pageOffset >> 7);
+      traceMask |= 1 << ((pageOffset + iLen - 1) >> 7);
+      pageOffset += iLen;
+    }
+    if ((traceMask & ~pages[t->page].codeMask) != 0)
+      return false;
+
+    k = hash(t->pAddr, t->fetchModeMask) & traceHashMask;
+    while (traceHash[k] != 0) k = (k + 1) & traceHashMask;
+    traceHash[k] = n + 1;
+  }
+
+  return true;
+}
+
+bxTraceFilePage *bxTraceFile_c::find_page(bx_phy_address ppf) const
+{
+  unsigned k = hash(ppf, 0) & pageHashMask;
+
+  for (;;) {
+    Bit32u index = pageHash[k];
+    if (index == 0) return NULL;
+    if (pages[index-1].ppf == ppf) return &pages[index-1];
+    k = (k + 1) & pageHashMask;
+  }
+}
+
+void bxTraceFile_c::load(const char *filename, BX_CPU_C *cpu)
+{
+  free_tables();
+  delete [] path;
+  path = new char[strlen(filename) + 1];
+  strcpy(path, filename);
+
+  FILE *fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    BX_INFO(("trace cache file '%s' not found, it will be created on exit", filename));
+    return;
+  }
+
+  bxTraceFileHeader header;
+  const char *error = NULL;
+
+  if (fread(&header, sizeof(header), 1, fp) != 1 ||
+      header.magic != BX_TRACE_FILE_MAGIC || header.version != BX_TRACE_FILE_VERSION)
+    error = "unknown file format";
+  else if (header.instrSize != sizeof(bxInstruction_c) || header.buildId != build_id())
+    error = "created by another Bochs binary";
+  else if (header.cpuId != cpu_id(cpu))
+    error = "created for another CPU model";
+  else if (header.numPages > header.numTraces || header.numTraces > header.numInstructions ||
+           header.numInstructions > BX_TRACE_FILE_MAX_INSTRUCTIONS)
+    error = "file is corrupted";
+  else {
+    numPages = header.numPages;
+    numTraces = header.numTraces;
+    numInstructions = header.numInstructions;
+    pages = new bxTraceFilePage[numPages];
+    traces = new bxTraceFileTrace[numTraces];
+    instructions = new bxInstruction_c[numInstructions];
+
+    if (fread(pages, sizeof(bxTraceFilePage), numPages, fp) != numPages ||
+        fread(traces, sizeof(bxTraceFileTrace), numTraces, fp) != numTraces ||
+        fread(instructions, sizeof(bxInstruction_c), numInstructions, fp) != numInstructions)
+      error = "file is truncated";
+    else {
+      Bit64u checksum = hash_bytes(0, pages, sizeof(bxTraceFilePage) * numPages);
+      checksum = hash_bytes(checksum, traces, sizeof(bxTraceFileTrace) * numTraces);
+      checksum = hash_bytes(checksum, instructions, sizeof(bxInstruction_c) * numInstructions);
+      if (checksum != header.checksum || ! build_tables())
+        error = "file is corrupted";
+    }
+  }
+
+  fclose(fp);
+
+  if (error) {
+    BX_ERROR(("trace cache file '%s' ignored: %s", filename, error));
+    free_tables();
+    return;
+  }
+
+  BX_INFO(("loaded %u decoded traces from %u pages from trace cache file '%s'", numTraces, numPages, filename));
+}
+
+const bxTraceFileTrace *bxTraceFile_c::lookup(bx_phy_address pAddr, Bit32u fetchModeMask, const Bit8u *page)
+{
+  if (numTraces == 0) return NULL;
+
+  const bxTraceFileTrace *t;
+  unsigned k = hash(pAddr, fetchModeMask) & traceHashMask;
+  for (;;) {
+    Bit32u index = traceHash[k];
+    if (index == 0) return NULL;
+    t = &traces[index-1];
+    if (t->pAddr == pAddr && t->fetchModeMask == fetchModeMask) break;
+    k = (k + 1) & traceHashMask;
+  }
+
+  // the page state is shared by all processors, which may run in separate
+  // host threads
+  bxTraceFilePage *p = &pages[t->page];
+  BX_LOCK_DEVICES();
+  if (p->state == BX_TRACE_FILE_PAGE_UNKNOWN) {
+    if (page_hash(page, p->codeMask) == p->hash) {
+      p->state = BX_TRACE_FILE_PAGE_VALID;
+      // any store to the verified lines invalidates the page, see handleSMC
+      pageWriteStampTable.markICacheMask(p->ppf, p->codeMask);
+    }
+    else {
+      p->state = BX_TRACE_FILE_PAGE_STALE;
+    }
+  }
+  bool valid = (p->state == BX_TRACE_FILE_PAGE_VALID);
+  BX_UNLOCK_DEVICES();
+
+  return valid ? t : NULL;
+}
+
+void bxTraceFile_c::handleSMCPage(bx_phy_address pAddr, Bit32u mask)
+{
+  bxTraceFilePage *page = find_page(PPFOf(pAddr));
+  if (page == NULL) return;
+
+  BX_LOCK_DEVICES();
+  if (page->state == BX_TRACE_FILE_PAGE_VALID && (page->codeMask & mask) != 0)
+    page->state = BX_TRACE_FILE_PAGE_UNKNOWN;
+  BX_UNLOCK_DEVICES();
+}
+
+void bxTraceFile_c::resetPages(void)
+{
+  BX_LOCK_DEVICES();
+  for (unsigned n=0; n < numPages; n++) {
+    if (pages[n].state == BX_TRACE_FILE_PAGE_VALID)
+      pages[n].state = BX_TRACE_FILE_PAGE_UNKNOWN;
+  }
+  BX_UNLOCK_DEVICES();
+}
+
+struct bxTraceFileCandidate {
+  bx_phy_address pAddr;
+  Bit32u fetchModeMask;
+  Bit32u tlen;
+  const bxInstruction_c *i;
+};
+
+static int compare_candidates(const void *a, const void *b)
+{
+  const bxTraceFileCandidate *t1 = (const bxTraceFileCandidate *) a;
+  const bxTraceFileCandidate *t2 = (const bxTraceFileCandidate *) b;
+
+  if (t1->pAddr != t2->pAddr)
+    return (t1->pAddr < t2->pAddr) ? -1 : 1;
+  if (t1->fetchModeMask != t2->fetchModeMask)
+    return (t1->fetchModeMask < t2->fetchModeMask) ? -1 : 1;
+  return 0;
+}
+
+static Bit32u candidate_lines(const bxTraceFileCandidate *t)
+{
+  Bit32u pageOffset = PAGE_OFFSET((Bit32u) t->pAddr), traceMask = 0;
+
+  for (unsigned n=0; n < t->tlen; n++) {
+    unsigned iLen = t->i[n].ilen();
+    traceMask |= 1 <<  (pageOffset >> 7);
+    traceMask |= 1 << ((pageOffset + iLen - 1) >> 7);
+    pageOffset += iLen;
+  }
+
+  return traceMask;
+}
+
+// Write the traces found in the trace caches of all processors together with
+// the saved traces still matching the guest memory
+void bxTraceFile_c::save(void)
+{
+  if (! path) return;
+
+  unsigned count = 0, totalInstructions = 0, n, cpu;
+
+  unsigned maxTraces = numTraces;
+  for (cpu=0; cpu < BX_SMP_PROCESSORS; cpu++)
+    maxTraces += BX_CPU(cpu)->iCache.sets * BX_CPU(cpu)->iCache.ways;
+
+  bxTraceFileCandidate *list = new bxTraceFileCandidate[maxTraces];
+
+  for (n=0; n < numPages; n++) {
+    const Bit8u *host = BX_MEM(0)->getHostMemAddr(BX_CPU(0), pages[n].ppf, BX_EXECUTE);
+    pages[n].state = (host && page_hash(host, pages[n].codeMask) == pages[n].hash) ?
+        BX_TRACE_FILE_PAGE_VALID : BX_TRACE_FILE_PAGE_STALE;
+  }
+
+  for (n=0; n < numTraces; n++) {
+    if (pages[traces[n].page].state == BX_TRACE_FILE_PAGE_VALID) {
+      list[count].pAddr = traces[n].pAddr;
+      list[count].fetchModeMask = traces[n].fetchModeMask;
+      list[count].tlen = traces[n].tlen;
+      list[count].i = &instructions[traces[n].instr];
+      count++;
+    }
+  }
+
+  for (cpu=0; cpu < BX_SMP_PROCESSORS; cpu++) {
+    bxICache_c *iCache = &BX_CPU(cpu)->iCache;
+    for (n=0; n < iCache->sets * iCache->ways; n++) {
+      const bxICacheEntry_c *e = &iCache->entry[n];
+      if (e->pAddr == BX_ICACHE_INVALID_PHY_ADDRESS) continue;
+
+      Bit32u fetchModeMask = iCache->fetch_mode(e);
+      const bxInstruction_c *i = e->i;
+      unsigned tlen = e->tlen;
+      // skip the inserted trace header
+      if (tlen > 0 && i->ilen() == 0) {
+        i++;
+        tlen--;
+      }
+      tlen = BX_CPU(cpu)->savedTraceLength(i, tlen, e->pAddr, fetchModeMask);
+      if (tlen > 0) {
+        list[count].pAddr = e->pAddr;
+        list[count].fetchModeMask = fetchModeMask;
+        list[count].tlen = tlen;
+        list[count].i = i;
+        count++;
+      }
+    }
+  }
+
+  qsort(list, count, sizeof(bxTraceFileCandidate), compare_candidates);
+
+  // drop the duplicates, the same trace might be found in the file and in
+  // the trace caches of several processors
+  for (n=1; n < count; n++) {
+    if (compare_candidates(&list[n-1], &list[n]) == 0) {
+      // keep the longest one
+      if (list[n-1].tlen > list[n].tlen) {
+        list[n].tlen = list[n-1].tlen;
+        list[n].i = list[n-1].i;
+      }
+      list[n-1].tlen = 0;
+    }
+  }
+
+  for (n=0; n < count; n++)
+    totalInstructions += list[n].tlen;
+
+  bxTraceFilePage *newPages = new bxTraceFilePage[count];
+  bxTraceFileTrace *newTraces = new bxTraceFileTrace[count];
+  bxInstruction_c *newInstructions = new bxInstruction_c[totalInstructions];
+  unsigned nPages = 0, nTraces = 0, nInstructions = 0;
+
+  memset(newPages, 0, sizeof(bxTraceFilePage) * count);
+  memset(newTraces, 0, sizeof(bxTraceFileTrace) * count);
+
+  for (n=0; n < count;) {
+    bx_phy_address ppf = PPFOf(list[n].pAddr);
+    unsigned first = n;
+    Bit32u codeMask = 0;
+
+    for (; n < count && PPFOf(list[n].pAddr) == ppf; n++)
+      codeMask |= candidate_lines(&list[n]);
+    if (codeMask == 0) continue;
+
+    const Bit8u *host = BX_MEM(0)->getHostMemAddr(BX_CPU(0), ppf, BX_EXECUTE);
+    if (host == NULL) continue;
+
+    bxTraceFilePage *page = &newPages[nPages];
+    page->ppf = ppf;
+    page->codeMask = codeMask;
+    page->hash = page_hash(host, codeMask);
+    page->state = BX_TRACE_FILE_PAGE_UNKNOWN;
+
+    for (unsigned k=first; k < n; k++) {
+      if (list[k].tlen == 0) continue;
+
+      bxTraceFileTrace *t = &newTraces[nTraces++];
+      t->pAddr = list[k].pAddr;
+      t->fetchModeMask = list[k].fetchModeMask;
+      t->page = nPages;
+      t->tlen = list[k].tlen;
+      t->instr = nInstructions;
+
+      // handler pointers are host addresses, assigned again on load
+      for (unsigned j=0; j < t->tlen; j++) {
+        bxInstruction_c *i = &newInstructions[nInstructions++];
+        memcpy(i, &list[k].i[j], sizeof(bxInstruction_c));
+        i->execute1 = NULL;
+        i->handlers.execute2 = NULL;
+      }
+    }
+
+    nPages++;
+  }
+
+  delete [] list;
+
+  bxTraceFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = BX_TRACE_FILE_MAGIC;
+  header.version = BX_TRACE_FILE_VERSION;
+  header.instrSize = sizeof(bxInstruction_c);
+  header.numPages = nPages;
+  header.numTraces = nTraces;
+  header.numInstructions = nInstructions;
+  header.buildId = build_id();
+  header.cpuId = cpu_id(BX_CPU(0));
+  header.checksum = hash_bytes(0, newPages, sizeof(bxTraceFilePage) * nPages);
+  header.checksum = hash_bytes(header.checksum, newTraces, sizeof(bxTraceFileTrace) * nTraces);
+  header.checksum = hash_bytes(header.checksum, newInstructions, sizeof(bxInstruction_c) * nInstructions);
+
+  // write to temporary file first, so the other simulations started with
+  // the same file never see it incomplete
+  char *tmpname = new char[strlen(path) + 5];
+  sprintf(tmpname, "%s.tmp", path);
+
+  bool ok = false;
+  FILE *fp = fopen(tmpname, "wb");
+  if (fp != NULL) {
+    ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+         fwrite(newPages, sizeof(bxTraceFilePage), nPages, fp) == nPages &&
+         fwrite(newTraces, sizeof(bxTraceFileTrace), nTraces, fp) == nTraces &&
+         fwrite(newInstructions, sizeof(bxInstruction_c), nInstructions, fp) == nInstructions;
+    if (fclose(fp) != 0) ok = false;
+  }
+  if (ok) {
+#ifdef WIN32
+    remove(path);
+#endif
+    ok = (rename(tmpname, path) == 0);
+  }
+
+  if (ok)
+    BX_INFO(("saved %u decoded traces from %u pages to trace cache file '%s'", nTraces, nPages, path));
+  else {
+    BX_ERROR(("failed to write trace cache file '%s'", path));
+    remove(tmpname);
+  }
+
+  delete [] tmpname;
+  delete [] newPages;
+  delete [] newTraces;
+  delete [] newInstructions;
+}
+
+// Length of the leading part of the trace that can be saved to the trace
+// cache file: instructions following each other in the page, executed by the
+// handlers assigned by the decoder (inserted opcodes and superblock branches
+// are not saved).
+unsigned BX_CPU_C::savedTraceLength(const bxInstruction_c *i, unsigned tlen, bx_phy_address pAddr, Bit32u fetchModeMask)
+{
+  Bit32u pageOffset = PAGE_OFFSET((Bit32u) pAddr);
+  bxInstruction_c copy;
+  unsigned n;
+
+  for (n=0; n < tlen; n++, i++) {
+    unsigned iLen = i->ilen();
+    if (iLen == 0 || pageOffset + iLen > 4096) break;
+
+    memcpy(&copy, i, sizeof(bxInstruction_c));
+    assignHandler(&copy, fetchModeMask);
+    // handlers.execute2 shares the storage with the trace link of branches,
+    // the first handler is enough to spot inserted or replaced opcodes
+    if (copy.execute1 != i->execute1) break;
+
+    pageOffset += iLen;
+  }
+
+  return n;
+}
+
+// Build the trace from decoded instructions saved by the previous run
+bool BX_CPU_C::fetchTraceFromFile(bxICacheEntry_c *entry, bxInstruction_c *i, bx_phy_address pAddr, unsigned maxlen)
+{
+  // page window is limited by the CS segment limit, let the decoder check it
+  if (BX_CPU_THIS_PTR eipPageWindowSize != 4096) return false;
+
+  const bxTraceFileTrace *t = traceFile.lookup(pAddr, BX_CPU_THIS_PTR fetchModeMask, BX_CPU_THIS_PTR eipFetchPtr);
+  if (t == NULL || t->tlen > maxlen) return false;
+
+  memcpy(i, traceFile.get_instructions(t), sizeof(bxInstruction_c) * t->tlen);
+
+  Bit32u pageOffset = PAGE_OFFSET((Bit32u) pAddr);
+  Bit32u traceMask = 0;
+
+  for (unsigned n=0; n < t->tlen; n++, i++) {
+    assignHandler(i, BX_CPU_THIS_PTR fetchModeMask);
+
+    unsigned iLen = i->ilen();
+
+#ifdef BX_INSTR_STORE_OPCODE_BYTES
+    i->set_opcode_bytes(BX_CPU_THIS_PTR eipFetchPtr + pageOffset);
+#endif
+    BX_INSTR_OPCODE(BX_CPU_ID, i, BX_CPU_THIS_PTR eipFetchPtr + pageOffset, iLen,
+       BX_CPU_THIS_PTR sregs[BX_SEG_REG_CS].cache.u.segment.d_b, long64_mode());
+
+    traceMask |= 1 <<  (pageOffset >> 7);
+    traceMask |= 1 << ((pageOffset + iLen - 1) >> 7);
+    pageOffset += iLen;
+  }
+
+  entry->tlen += t->tlen;
+  entry->traceMask |= traceMask;
+
+  pageWriteStampTable.markICacheMask(pAddr, entry->traceMask);
+
+#if BX_SUPPORT_HANDLERS_CHAINING_SPEEDUPS
+  entry->tlen++; /* Add the inserted end of trace opcode */
+  genDummyICacheEntry(i);
+#endif
+
+  BX_CPU_THIS_PTR iCache.commit_trace(entry);
+
+  INC_CPU_STAT(iCacheFileTraces);
+
+  return true;
+}
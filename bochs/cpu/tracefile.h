@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (c) 2026 The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_TRACEFILE_H
+#define BX_TRACEFILE_H
+
+// Decoded traces are saved to the trace cache file when the simulation ends
+// and preloaded by the next run, so the code executed by every boot (BIOS,
+// boot loader, kernel) is not decoded again. A saved trace is used only after
+// the guest code it was decoded from is verified: the content of all 128-byte
+// lines of the physical page covered by saved traces is hashed when the first
+// trace from the page is needed and compared with the hash stored in the file.
+
+#define BX_TRACE_FILE_MAGIC   0x43545842 /* "BXTC" */
+#define BX_TRACE_FILE_VERSION 1
+
+enum {
+  BX_TRACE_FILE_PAGE_UNKNOWN = 0, // not verified yet or modified after verification
+  BX_TRACE_FILE_PAGE_VALID,       // page content matches the saved traces
+  BX_TRACE_FILE_PAGE_STALE        // page content changed, saved traces are never used
+};
+
+struct bxTraceFileHeader {
+  Bit32u magic;
+  Bit32u version;
+  Bit32u instrSize;     // sizeof(bxInstruction_c)
+  Bit32u numPages;
+  Bit32u numTraces;
+  Bit32u numInstructions;
+  Bit64u buildId;       // identifies Bochs binary and decoder tables
+  Bit64u cpuId;         // identifies enabled ISA extensions of the CPU model
+  Bit64u checksum;      // hash of the page, trace and instruction records
+};
+
+struct bxTraceFilePage {
+  bx_phy_address ppf;
+  Bit64u hash;          // hash of the lines marked in codeMask
+  Bit32u codeMask;      // 128-byte lines covered by the saved traces
+  Bit32u state;
+};
+
+struct bxTraceFileTrace {
+  bx_phy_address pAddr;
+  Bit32u fetchModeMask;
+  Bit32u page;          // index of the page record
+  Bit32u tlen;
+  Bit32u instr;         // index of the first instruction
+};
+
+class bxTraceFile_c {
+  bxTraceFilePage *pages;
+  bxTraceFileTrace *traces;
+  bxInstruction_c *instructions;
+  unsigned numPages, numTraces, numInstructions;
+
+  // open addressing hash tables holding index+1 of the page or trace record
+  Bit32u *pageHash, *traceHash;
+  unsigned pageHashMask, traceHashMask;
+
+  char *path;
+
+  BX_CPP_INLINE static unsigned hash(bx_phy_address pAddr, Bit32u fetchModeMask) {
+    Bit64u h = ((Bit64u) pAddr ^ ((Bit64u) fetchModeMask << 56)) * BX_CONST64(0x9E3779B97F4A7C15);
+    return (unsigned)(h >> 32);
+  }
+
+  bxTraceFilePage *find_page(bx_phy_address ppf) const;
+  void free_tables(void);
+  bool build_tables(void);
+  void handleSMCPage(bx_phy_address pAddr, Bit32u mask);
+
+public:
+  bxTraceFile_c(): pages(NULL), traces(NULL), instructions(NULL),
+      numPages(0), numTraces(0), numInstructions(0),
+      pageHash(NULL), traceHash(NULL), pageHashMask(0), traceHashMask(0),
+      path(NULL) {}
+ ~bxTraceFile_c() { free_tables(); delete [] path; }
+
+  BX_CPP_INLINE bool enabled(void) const { return path != NULL; }
+
+  static Bit64u hash_bytes(Bit64u h, const void *data, unsigned len);
+  static Bit64u page_hash(const Bit8u *page, Bit32u codeMask);
+  static Bit64u build_id(void);
+  static Bit64u cpu_id(BX_CPU_C *cpu);
+
+  void load(const char *filename, BX_CPU_C *cpu);
+  void save(void);
+
+  // find saved trace starting at pAddr, the page is verified against the
+  // guest code found at host address 'page' on the first use
+  const bxTraceFileTrace *lookup(bx_phy_address pAddr, Bit32u fetchModeMask, const Bit8u *page);
+
+  BX_CPP_INLINE const bxInstruction_c *get_instructions(const bxTraceFileTrace *t) const {
+    return &instructions[t->instr];
+  }
+
+  BX_CPP_INLINE void handleSMC(bx_phy_address pAddr, Bit32u mask)
+  {
+    if (numPages != 0) handleSMCPage(pAddr, mask);
+  }
+
+  // write stamps were reset, verify the pages again before using them
+  void resetPages(void);
+};
+
+extern bxTraceFile_c traceFile;
+
+#endif
@@ -3313,6 +3313,7 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::VMLAUNCH(bxInstruction_c *i)
 */
 
   BX_CPU_THIS_PTR in_vmx_guest = true;
+  TLB_updateContextKey();
 
   unmask_event(BX_EVENT_INIT);
 
@@ -4086,7 +4087,7 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::INVPCID(bxInstruction_c *i)
       BX_ERROR(("INVPCID: invalid PCID"));
       exception(BX_GP_EXCEPTION, 0);
     }
-    TLB_flushNonGlobal(); // Invalidate all mappings for LADDR tagged with PCID except globals
+    TLB_invlpgPCID((bx_address) invpcid_desc.xmm64u(1), pcid); // Invalidate all mappings for LADDR tagged with PCID except globals
     break;
 
   case BX_INVPCID_SINGLE_CONTEXT_NON_GLOBAL_INVALIDATION:
@@ -4094,7 +4095,7 @@ void BX_CPP_AttrRegparmN(1) BX_CPU_C::INVPCID(bxInstruction_c *i)
       BX_ERROR(("INVPCID: invalid PCID"));
       exception(BX_GP_EXCEPTION, 0);
     }
-    TLB_flushNonGlobal(); // Invalidate all mappings tagged with PCID except globals
+    TLB_flushPCID(pcid); // Invalidate all mappings tagged with PCID except globals
     break;
 
   case BX_INVPCID_ALL_CONTEXT_INVALIDATION:
@@ -1118,6 +1118,9 @@ bx_shadow_data_c::bx_shadow_data_c(bx_param_c *parent,
   this->data_ptr = ptr_to_data;
   this->data_size = data_size;
   this->is_text = is_text;
+  this->sr_devptr = NULL;
+  this->save_handler = NULL;
+  this->restore_handler = NULL;
   if (parent) {
     BX_ASSERT(parent->get_type() == BXT_LIST);
     this->parent = (bx_list_c *)parent;
@@ -1141,6 +1144,27 @@ void bx_shadow_data_c::set(Bit32u index, Bit8u value)
   }
 }
 
+void bx_shadow_data_c::set_sr_handlers(void *devptr, data_save_handler save, data_restore_handler restore)
+{
+  this->sr_devptr = devptr;
+  this->save_handler = save;
+  this->restore_handler = restore;
+}
+
+bool bx_shadow_data_c::save(const char *path)
+{
+  if (save_handler)
+    return (*save_handler)(sr_devptr, path);
+  return false;
+}
+
+bool bx_shadow_data_c::restore(const char *path)
+{
+  if (restore_handler)
+    return (*restore_handler)(sr_devptr, path);
+  return false;
+}
+
 bx_shadow_filedata_c::bx_shadow_filedata_c(bx_param_c *parent,
     const char *name, FILE **scratch_file_ptr_ptr)
   : bx_param_c(SIM->gen_param_id(), name, "")
@@ -450,10 +450,17 @@ public:
   virtual void set_initial_val(const char *buf);
 };
 
+// binary data save / restore handlers return false to use the default method
+typedef bool (*data_save_handler)(void *devptr, const char *path);
+typedef bool (*data_restore_handler)(void *devptr, const char *path);
+
 class BOCHSAPI bx_shadow_data_c : public bx_param_c {
   Bit32u data_size;
   Bit8u *data_ptr;
   bool is_text;
+  void *sr_devptr;
+  data_save_handler    save_handler;
+  data_restore_handler restore_handler;
 public:
   bx_shadow_data_c(bx_param_c *parent,
       const char *name,
@@ -465,6 +472,9 @@ public:
   bool is_text_format() const {return is_text;}
   Bit8u get(Bit32u index);
   void set(Bit32u index, Bit8u value);
+  void set_sr_handlers(void *devptr, data_save_handler save, data_restore_handler restore);
+  bool save(const char *path);
+  bool restore(const char *path);
 };
 
 typedef void (*filedata_save_handler)(void *devptr, FILE *save_fp);
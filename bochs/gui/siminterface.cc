@@ -26,6 +26,7 @@
 
 #include "param_names.h"
 #include "iodev.h"
+#include "iodev/hdimage/hdimage.h"
 #include "bx_debug/debug.h"
 #include "virt_timer.h"
 #if BX_USB_DEBUGGER
@@ -1166,6 +1167,8 @@ bool bx_real_sim_c::save_state(const char *checkpoint_path)
   int dev, ndev = SIM->get_n_log_modules();
   int type, ntype = SIM->get_max_log_level();
 
+  // the device state is only consistent without disk requests in flight
+  bx_hdimage_ctl.aio_flush();
   get_param_string(BXPN_RESTORE_PATH)->set(checkpoint_path);
   snprintf(sr_file, BX_PATHNAME_LEN, "%s/config", checkpoint_path);
   if (write_rc(sr_file, 1) < 0)
@@ -1347,10 +1350,12 @@ bool bx_real_sim_c::restore_bochs_param(bx_list_c *root, const char *sr_path, co
                     bx_shadow_data_c *dparam = (bx_shadow_data_c*)param;
                     if (!dparam->is_text_format()) {
                       snprintf(devdata, BX_PATHNAME_LEN, "%s/%s", sr_path, ptr);
-                      fp2 = fopen(devdata, "rb");
-                      if (fp2 != NULL) {
-                        fread(dparam->getptr(), 1, dparam->get_size(), fp2);
-                        fclose(fp2);
+                      if (!dparam->restore(devdata)) {
+                        fp2 = fopen(devdata, "rb");
+                        if (fp2 != NULL) {
+                          fread(dparam->getptr(), 1, dparam->get_size(), fp2);
+                          fclose(fp2);
+                        }
                       }
                     } else if (!strcmp(ptr, "[")) {
                       i = 0;
@@ -1464,10 +1469,12 @@ bool bx_real_sim_c::save_sr_param(FILE *fp, bx_param_c *node, const char *sr_pat
             snprintf(tmpstr, BX_PATHNAME_LEN+1, "%s/%s", sr_path, pname);
           else
             strcpy(tmpstr, pname);
-          fp2 = fopen(tmpstr, "wb");
-          if (fp2 != NULL) {
-            fwrite(dparam->getptr(), 1, dparam->get_size(), fp2);
-            fclose(fp2);
+          if (!dparam->save(tmpstr)) {
+            fp2 = fopen(tmpstr, "wb");
+            if (fp2 != NULL) {
+              fwrite(dparam->getptr(), 1, dparam->get_size(), fp2);
+              fclose(fp2);
+            }
           }
         } else {
           fprintf(fp, "[\n");
@@ -545,6 +545,12 @@ enum {
   BX_PCI_CHIPSET_I440BX
 };
 
+enum {
+  BX_MEM_HUGEPAGES_NONE,
+  BX_MEM_HUGEPAGES_THP,
+  BX_MEM_HUGEPAGES_HUGETLBFS
+};
+
 #define BX_CLOCK_TIME0_LOCAL     1
 #define BX_CLOCK_TIME0_UTC       2
 
@@ -470,6 +470,8 @@ void bx_devices_c::exit()
   bx_virt_timer.setup();
   bx_slowdown_timer.exit();
 
+  // finish disk image requests in flight before the drives are removed
+  bx_hdimage_ctl.aio_stop();
   // unload device plugins
   bx_unload_plugins();
   // remove runtime parameter handlers
@@ -1090,7 +1092,9 @@ bx_devices_c::inp(Bit16u addr, unsigned io_len)
 
   io_read_handler = read_port_to_handler[addr];
   if (io_read_handler->mask & io_len) {
+    BX_LOCK_DEVICES();
     ret = ((bx_read_handler_t)io_read_handler->funct)(io_read_handler->this_ptr, (Bit32u)addr, io_len);
+    BX_UNLOCK_DEVICES();
   } else {
     switch (io_len) {
       case 1: ret = 0xff; break;
@@ -1123,7 +1127,9 @@ bx_devices_c::outp(Bit16u addr, Bit32u value, unsigned io_len)
 
   io_write_handler = write_port_to_handler[addr];
   if (io_write_handler->mask & io_len) {
+    BX_LOCK_DEVICES();
     ((bx_write_handler_t)io_write_handler->funct)(io_write_handler->this_ptr, (Bit32u)addr, value, io_len);
+    BX_UNLOCK_DEVICES();
   } else if (addr != 0x0cf8) { // don't flood the logfile when probing PCI
     BX_ERROR(("write to port 0x%04x with len %d ignored", addr, io_len));
   }
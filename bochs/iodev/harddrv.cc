@@ -29,8 +29,8 @@
 #define BX_PLUGGABLE
 
 #include "iodev.h"
-#include "harddrv.h"
 #include "hdimage/hdimage.h"
+#include "harddrv.h"
 #include "hdimage/cdrom.h"
 
 #define LOG_THIS theHardDrive->
@@ -135,6 +135,7 @@ bx_hard_drive_c::bx_hard_drive_c()
       channels[channel].drives[device].cdrom.cd = NULL;
       channels[channel].drives[device].seek_timer_index = BX_NULL_TIMER_HANDLE;
       channels[channel].drives[device].statusbar_id = -1;
+      channels[channel].drives[device].aio.state = HDIMAGE_AIO_IDLE;
     }
   }
   rt_conf_id = -1;
@@ -146,6 +147,7 @@ bx_hard_drive_c::~bx_hard_drive_c()
   for (Bit8u channel=0; channel<BX_MAX_ATA_CHANNEL; channel++) {
     for (Bit8u device=0; device<2; device ++) {
       if (channels[channel].drives[device].hdimage != NULL) {
+        bx_hdimage_ctl.aio_cancel(&channels[channel].drives[device].aio);
         channels[channel].drives[device].hdimage->close();
         delete channels[channel].drives[device].hdimage;
         channels[channel].drives[device].hdimage = NULL;
@@ -306,6 +308,8 @@ void bx_hard_drive_c::init(void)
         image_mode = SIM->get_param_enum("mode", base)->get_selected();
         channels[channel].drives[device].hdimage = DEV_hdimage_init_image(image_mode,
             disk_size, SIM->get_param_string("journal", base)->getptr());
+        channels[channel].drives[device].hdimage =
+          DEV_hdimage_init_cache(channels[channel].drives[device].hdimage);
 
         if (channels[channel].drives[device].hdimage != NULL) {
           BX_INFO(("HD on ata%d-%d: '%s', '%s' mode", channel, device,
@@ -572,6 +576,9 @@ void bx_hard_drive_c::reset(unsigned type)
   for (unsigned channel=0; channel<BX_MAX_ATA_CHANNEL; channel++) {
     if (BX_HD_THIS channels[channel].irq)
       DEV_pic_lower_irq(BX_HD_THIS channels[channel].irq);
+    for (unsigned device=0; device<2; device++) {
+      bx_hdimage_ctl.aio_cancel(&BX_DRIVE(channel, device).aio);
+    }
   }
 }
 
@@ -2466,6 +2473,29 @@ void bx_hard_drive_c::write(Bit32u address, Bit32u value, unsigned io_len)
 
             case 0x02: // Enable and
             case 0x82: //  Disable write cache.
+              if (!BX_SELECTED_IS_HD(channel) ||
+                  !(BX_SELECTED_DRIVE(channel).hdimage->get_capabilities() & HDIMAGE_WRITE_CACHE)) {
+                BX_INFO(("ata%d-%d: SET FEATURES subcommand 0x%02x not supported, but returning success",
+                  channel,BX_SLAVE_SELECTED(channel),(unsigned) controller->features));
+              } else {
+                // the cache is written back before it is disabled
+                bx_hdimage_ctl.aio_wait(&BX_SELECTED_DRIVE(channel).aio);
+                if (!BX_SELECTED_DRIVE(channel).hdimage->set_write_cache(controller->features == 0x02)) {
+                  BX_ERROR(("ata%d-%d: could not %s the write cache", channel,
+                            BX_SLAVE_SELECTED(channel),
+                            (controller->features == 0x02) ? "enable" : "disable"));
+                  command_aborted(channel, value);
+                  break;
+                }
+                BX_DEBUG(("ata%d-%d: write cache %s", channel, BX_SLAVE_SELECTED(channel),
+                          (controller->features == 0x02) ? "enabled" : "disabled"));
+                BX_SELECTED_DRIVE(channel).identify_set = 0;
+              }
+              controller->status.drive_ready = 1;
+              controller->status.seek_complete = 1;
+              raise_interrupt(channel);
+              break;
+
             case 0xAA: // Enable and
             case 0x55: //  Disable look-ahead cache.
             case 0xCC: // Enable and
@@ -2619,11 +2649,28 @@ void bx_hard_drive_c::write(Bit32u address, Bit32u value, unsigned io_len)
           }
           break;
 
-        // power management & flush cache stubs
-        case 0xE0: // STANDBY NOW
-        case 0xE1: // IDLE IMMEDIATE
         case 0xE7: // FLUSH CACHE
         case 0xEA: // FLUSH CACHE EXT
+          if (BX_SELECTED_IS_HD(channel)) {
+            // write the data held by the disk image cache
+            bx_hdimage_ctl.aio_wait(&BX_SELECTED_DRIVE(channel).aio);
+            if (!BX_SELECTED_DRIVE(channel).hdimage->flush_cache()) {
+              BX_ERROR(("ata%d-%d: could not flush hard drive image", channel,
+                        BX_SLAVE_SELECTED(channel)));
+              command_aborted(channel, value);
+              break;
+            }
+          }
+          controller->status.busy = 0;
+          controller->status.drive_ready = 1;
+          controller->status.write_fault = 0;
+          controller->status.drq = 0;
+          raise_interrupt(channel);
+          break;
+
+        // power management stubs
+        case 0xE0: // STANDBY NOW
+        case 0xE1: // IDLE IMMEDIATE
           controller->status.busy = 0;
           controller->status.drive_ready = 1;
           controller->status.write_fault = 0;
@@ -2826,6 +2873,7 @@ void bx_hard_drive_c::write(Bit32u address, Bit32u value, unsigned io_len)
 
         // (mch) Set BSY, drive not ready
         for (int id = 0; id < 2; id++) {
+          bx_hdimage_ctl.aio_wait(&BX_DRIVE(channel, id).aio);
           BX_CONTROLLER(channel,id).status.busy           = 1;
           BX_CONTROLLER(channel,id).status.drive_ready    = 0;
           BX_CONTROLLER(channel,id).reset_in_progress     = 1;
@@ -2943,6 +2991,24 @@ bx_hard_drive_c::increment_address(Bit8u channel, Bit64s *sector)
   }
 }
 
+// Returns how many of 'count' sectors starting at 'sector' follow each other
+// in the image (at least 1). CHS addressing wraps at the end of the geometry.
+Bit32u bx_hard_drive_c::contiguous_sectors(Bit8u channel, Bit64s sector, Bit32u count)
+{
+  device_image_t *hdimage = BX_SELECTED_DRIVE(channel).hdimage;
+  Bit64s last;
+
+  if (BX_SELECTED_CONTROLLER(channel).lba_mode) {
+    last = hdimage->hd_size / BX_SELECTED_DRIVE(channel).sect_size;
+  } else {
+    last = (Bit64s)hdimage->cylinders * hdimage->heads * hdimage->spt;
+  }
+  if ((sector + count) > last) {
+    count = (last > sector) ? (Bit32u)(last - sector) : 1;
+  }
+  return count;
+}
+
 void bx_hard_drive_c::identify_ATAPI_drive(Bit8u channel)
 {
   unsigned i;
@@ -3274,6 +3340,9 @@ void bx_hard_drive_c::identify_drive(Bit8u channel)
   //           1 supports securite mode feature set
   //           0 support SMART feature set
   BX_SELECTED_DRIVE(channel).id_drive[82] = 1 << 14;
+  if (BX_SELECTED_DRIVE(channel).hdimage->get_capabilities() & HDIMAGE_WRITE_CACHE) {
+    BX_SELECTED_DRIVE(channel).id_drive[82] |= (1 << 5);
+  }
 
   // Word 83: 15 shall be ZERO
   //          14 shall be ONE
@@ -3293,7 +3362,11 @@ void bx_hard_drive_c::identify_drive(Bit8u channel)
   //           0 Download MicroCode supported
   BX_SELECTED_DRIVE(channel).id_drive[83] = (1 << 14) | (1 << 13) | (1 << 12) | (1 << 10);
   BX_SELECTED_DRIVE(channel).id_drive[84] = 1 << 14;
+  // Word 85: enabled features of word 82
   BX_SELECTED_DRIVE(channel).id_drive[85] = 1 << 14;
+  if (BX_SELECTED_DRIVE(channel).hdimage->get_write_cache()) {
+    BX_SELECTED_DRIVE(channel).id_drive[85] |= (1 << 5);
+  }
 
   // Word 86: 15 shall be ZERO
   //          14 shall be ONE
@@ -3654,7 +3727,33 @@ bool bx_hard_drive_c::bmdma_read_sector(Bit8u channel, Bit8u *buffer, Bit32u *se
   return 1;
 }
 
-bool bx_hard_drive_c::bmdma_write_sector(Bit8u channel, Bit8u *buffer)
+// Read the whole sectors fitting into '*size' bytes of the buffer with one
+// image access if possible. '*size' returns the number of bytes read, it is
+// 0 if no whole sector fits or the command is an ATAPI transfer.
+bool bx_hard_drive_c::bmdma_read_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size)
+{
+  controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
+
+  if ((controller->current_command != 0xC8) &&
+      (controller->current_command != 0x25)) {
+    *size = 0;
+    return 1;
+  }
+  if (controller->num_sectors == 0)
+    return 0;
+  unsigned sect_size = BX_SELECTED_DRIVE(channel).sect_size;
+  Bit32u count = *size / sect_size;
+  if (count > controller->num_sectors)
+    count = controller->num_sectors;
+  *size = count * sect_size;
+  if (count == 0)
+    return 1;
+  return ide_read_sector(channel, buffer, *size);
+}
+
+// Write the whole sectors found in '*size' bytes of the buffer, '*size'
+// returns the number of bytes written.
+bool bx_hard_drive_c::bmdma_write_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size)
 {
   controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
 
@@ -3666,10 +3765,14 @@ bool bx_hard_drive_c::bmdma_write_sector(Bit8u channel, Bit8u *buffer)
   }
   if (controller->num_sectors == 0)
     return 0;
-  if (!ide_write_sector(channel, buffer, BX_SELECTED_DRIVE(channel).sect_size)) {
-    return 0;
-  }
-  return 1;
+  unsigned sect_size = BX_SELECTED_DRIVE(channel).sect_size;
+  Bit32u count = *size / sect_size;
+  if (count > controller->num_sectors)
+    count = controller->num_sectors;
+  *size = count * sect_size;
+  if (count == 0)
+    return 1;
+  return ide_write_sector(channel, buffer, *size);
 }
 
 void bx_hard_drive_c::bmdma_complete(Bit8u channel)
@@ -3692,6 +3795,99 @@ void bx_hard_drive_c::bmdma_complete(Bit8u channel)
   }
   raise_interrupt(channel);
 }
+
+bool bx_hard_drive_c::bmdma_read_async(Bit8u channel, Bit8u *buffer, Bit32u size)
+{
+  controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
+
+  if ((controller->current_command != 0xC8) &&
+      (controller->current_command != 0x25)) {
+    return 0;
+  }
+  return ide_start_aio(channel, HDIMAGE_AIO_READ, buffer, size / BX_SELECTED_DRIVE(channel).sect_size);
+}
+
+bool bx_hard_drive_c::bmdma_write_async(Bit8u channel, Bit8u *buffer, Bit32u size)
+{
+  controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
+
+  if ((controller->current_command != 0xCA) &&
+      (controller->current_command != 0x35)) {
+    return 0;
+  }
+  return ide_start_aio(channel, HDIMAGE_AIO_WRITE, buffer, size / BX_SELECTED_DRIVE(channel).sect_size);
+}
+
+// Start an asynchronous transfer of up to 'sector_count' sectors. The task
+// file registers are updated immediately, the PCI IDE controller continues
+// the DMA transfer when the request has completed. Returns false if the
+// transfer has to be done with the synchronous functions.
+bool bx_hard_drive_c::ide_start_aio(Bit8u channel, unsigned op, Bit8u *buffer, Bit32u sector_count)
+{
+  controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
+  hdimage_aio_request_t *req = &BX_SELECTED_DRIVE(channel).aio;
+  Bit64s logical_sector, sector;
+
+  if ((controller->num_sectors == 0) || (sector_count == 0))
+    return 0;
+  if (sector_count > controller->num_sectors)
+    sector_count = controller->num_sectors;
+  bx_hdimage_ctl.aio_wait(req);
+  unsigned sect_size = BX_SELECTED_DRIVE(channel).sect_size;
+  if (!calculate_logical_address(channel, &logical_sector))
+    return 0;
+  sector_count = contiguous_sectors(channel, logical_sector, sector_count);
+  req->image = BX_SELECTED_DRIVE(channel).hdimage;
+  req->op = op;
+  req->offset = logical_sector * sect_size;
+  req->buf = buffer;
+  req->count = sector_count * sect_size;
+  req->complete = aio_complete_handler;
+  req->param = BX_HD_THIS_PTR;
+  if (!req->image->aio_submit(req)) {
+    return 0;
+  }
+  /* set status bar conditions for device */
+  bx_gui->statusbar_setitem(BX_SELECTED_DRIVE(channel).statusbar_id, 1, op == HDIMAGE_AIO_WRITE);
+  sector = logical_sector;
+  for (Bit32u i = 0; i < sector_count; i++) {
+    increment_address(channel, &sector);
+  }
+  BX_SELECTED_DRIVE(channel).next_lsector = sector;
+  return 1;
+}
+
+void bx_hard_drive_c::aio_complete_handler(hdimage_aio_request_t *req)
+{
+#if !BX_USE_HD_SMF
+  bx_hard_drive_c *class_ptr = (bx_hard_drive_c *) req->param;
+  class_ptr->aio_complete(req);
+}
+
+void bx_hard_drive_c::aio_complete(hdimage_aio_request_t *req)
+{
+#endif
+  Bit8u channel, device = 0;
+
+  for (channel = 0; channel < BX_MAX_ATA_CHANNEL; channel++) {
+    if (&BX_DRIVE(channel, 0).aio == req) break;
+    if (&BX_DRIVE(channel, 1).aio == req) {
+      device = 1;
+      break;
+    }
+  }
+  if (channel == BX_MAX_ATA_CHANNEL) return;
+  if (req->result != (ssize_t)req->count) {
+    BX_ERROR(("could not %s hard drive image file at byte " FMT_LL "d",
+              (req->op == HDIMAGE_AIO_READ) ? "read()" : "write()", req->offset));
+    if (BX_HD_THIS channels[channel].drive_select == device) {
+      command_aborted(channel, BX_SELECTED_CONTROLLER(channel).current_command);
+    }
+    DEV_ide_bmdma_aio_complete(channel, 0);
+  } else {
+    DEV_ide_bmdma_aio_complete(channel, (Bit32u)req->count);
+  }
+}
 #endif
 
 void bx_hard_drive_c::set_signature(Bit8u channel, Bit8u id)
@@ -3718,31 +3914,31 @@ bool bx_hard_drive_c::ide_read_sector(Bit8u channel, Bit8u *buffer, Bit32u buffe
   Bit64s ret;
 
   unsigned sect_size = BX_SELECTED_DRIVE(channel).sect_size;
-  int sector_count = (buffer_size / sect_size);
+  Bit32u sector_count = (buffer_size / sect_size), count;
   Bit8u *bufptr = buffer;
+  bx_hdimage_ctl.aio_wait(&BX_SELECTED_DRIVE(channel).aio);
   do {
     if (!calculate_logical_address(channel, &logical_sector)) {
       command_aborted(channel, controller->current_command);
       return 0;
     }
-    ret = BX_SELECTED_DRIVE(channel).hdimage->lseek(logical_sector * sect_size, SEEK_SET);
-    if (ret < 0) {
-      BX_ERROR(("could not lseek() hard drive image file"));
-      command_aborted(channel, controller->current_command);
-      return 0;
-    }
+    // read all sectors following each other in the image at once
+    count = contiguous_sectors(channel, logical_sector, sector_count);
     /* set status bar conditions for device */
     bx_gui->statusbar_setitem(BX_SELECTED_DRIVE(channel).statusbar_id, 1);
-    ret = BX_SELECTED_DRIVE(channel).hdimage->read((bx_ptr_t)bufptr, sect_size);
-    if (ret < sect_size) {
+    ret = BX_SELECTED_DRIVE(channel).hdimage->read_at(logical_sector * sect_size, (bx_ptr_t)bufptr, count * sect_size);
+    if (ret < (Bit64s)(count * sect_size)) {
       BX_ERROR(("could not read() hard drive image file at byte %lu", (unsigned long)logical_sector*sect_size));
       command_aborted(channel, controller->current_command);
       return 0;
     }
-    increment_address(channel, &logical_sector);
+    for (Bit32u i = 0; i < count; i++) {
+      increment_address(channel, &logical_sector);
+    }
     BX_SELECTED_DRIVE(channel).next_lsector = logical_sector;
-    bufptr += sect_size;
-  } while (--sector_count > 0);
+    bufptr += count * sect_size;
+    sector_count -= count;
+  } while (sector_count > 0);
 
   return 1;
 }
@@ -3755,31 +3951,31 @@ bool bx_hard_drive_c::ide_write_sector(Bit8u channel, Bit8u *buffer, Bit32u buff
   Bit64s ret;
 
   unsigned sect_size = BX_SELECTED_DRIVE(channel).sect_size;
-  int sector_count = (buffer_size / sect_size);
+  Bit32u sector_count = (buffer_size / sect_size), count;
   Bit8u *bufptr = buffer;
+  bx_hdimage_ctl.aio_wait(&BX_SELECTED_DRIVE(channel).aio);
   do {
     if (!calculate_logical_address(channel, &logical_sector)) {
       command_aborted(channel, controller->current_command);
       return 0;
     }
-    ret = BX_SELECTED_DRIVE(channel).hdimage->lseek(logical_sector * sect_size, SEEK_SET);
-    if (ret < 0) {
-      BX_ERROR(("could not lseek() hard drive image file at byte %lu", (unsigned long)logical_sector * sect_size));
-      command_aborted(channel, controller->current_command);
-      return 0;
-    }
+    // write all sectors following each other in the image at once
+    count = contiguous_sectors(channel, logical_sector, sector_count);
     /* set status bar conditions for device */
     bx_gui->statusbar_setitem(BX_SELECTED_DRIVE(channel).statusbar_id, 1, 1 /* write */);
-    ret = BX_SELECTED_DRIVE(channel).hdimage->write((bx_ptr_t)bufptr, sect_size);
-    if (ret < sect_size) {
+    ret = BX_SELECTED_DRIVE(channel).hdimage->write_at(logical_sector * sect_size, (bx_ptr_t)bufptr, count * sect_size);
+    if (ret < (Bit64s)(count * sect_size)) {
       BX_ERROR(("could not write() hard drive image file at byte %lu", (unsigned long)logical_sector*sect_size));
       command_aborted(channel, controller->current_command);
       return 0;
     }
-    increment_address(channel, &logical_sector);
+    for (Bit32u i = 0; i < count; i++) {
+      increment_address(channel, &logical_sector);
+    }
     BX_SELECTED_DRIVE(channel).next_lsector = logical_sector;
-    bufptr += sect_size;
-  } while (--sector_count > 0);
+    bufptr += count * sect_size;
+    sector_count -= count;
+  } while (sector_count > 0);
 
   return 1;
 }
@@ -174,8 +174,11 @@ public:
   virtual void     reset(unsigned type);
 #if BX_SUPPORT_PCI
   virtual bool     bmdma_read_sector(Bit8u channel, Bit8u *buffer, Bit32u *sector_size);
-  virtual bool     bmdma_write_sector(Bit8u channel, Bit8u *buffer);
+  virtual bool     bmdma_read_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size);
+  virtual bool     bmdma_write_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size);
   virtual void     bmdma_complete(Bit8u channel);
+  virtual bool     bmdma_read_async(Bit8u channel, Bit8u *buffer, Bit32u size);
+  virtual bool     bmdma_write_async(Bit8u channel, Bit8u *buffer, Bit32u size);
 #endif
   virtual void     register_state(void);
 
@@ -202,10 +205,18 @@ public:
   static void runtime_config_handler(void *);
   void runtime_config(void);
 
+#if BX_SUPPORT_PCI
+  static void aio_complete_handler(hdimage_aio_request_t *req);
+#if !BX_USE_HD_SMF
+  void aio_complete(hdimage_aio_request_t *req);
+#endif
+#endif
+
 private:
 
   BX_HD_SMF bool calculate_logical_address(Bit8u channel, Bit64s *sector) BX_CPP_AttrRegparmN(2);
   BX_HD_SMF void increment_address(Bit8u channel, Bit64s *sector) BX_CPP_AttrRegparmN(2);
+  BX_HD_SMF Bit32u contiguous_sectors(Bit8u channel, Bit64s sector, Bit32u count);
   BX_HD_SMF void identify_drive(Bit8u channel);
   BX_HD_SMF void identify_ATAPI_drive(Bit8u channel);
   BX_HD_SMF void command_aborted(Bit8u channel, unsigned command);
@@ -220,6 +231,9 @@ private:
   BX_HD_SMF void set_signature(Bit8u channel, Bit8u id);
   BX_HD_SMF bool ide_read_sector(Bit8u channel, Bit8u *buffer, Bit32u buffer_size);
   BX_HD_SMF bool ide_write_sector(Bit8u channel, Bit8u *buffer, Bit32u buffer_size);
+#if BX_SUPPORT_PCI
+  BX_HD_SMF bool ide_start_aio(Bit8u channel, unsigned op, Bit8u *buffer, Bit32u sector_count);
+#endif
   BX_HD_SMF void lba48_transform(controller_t *controller, bool lba48);
   BX_HD_SMF void start_seek(Bit8u channel);
 
@@ -251,6 +265,7 @@ private:
       Bit64s curr_lsector;
       Bit64s next_lsector;
       unsigned sect_size;
+      hdimage_aio_request_t aio; // asynchronous BM-DMA transfer
 
       Bit8u model_no[41];
       int statusbar_id;
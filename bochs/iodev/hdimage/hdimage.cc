@@ -29,6 +29,8 @@
 #include "gui/siminterface.h"
 #include "param_names.h"
 #include "plugin.h"
+#include "pc_system.h"
+#include "bxthread.h"
 #include "cdrom.h"
 #include "cdrom_amigaos.h"
 #include "cdrom_misc.h"
@@ -73,6 +75,9 @@ const char **hdimage_mode_names;
 bx_hdimage_ctl_c::bx_hdimage_ctl_c()
 {
   put("hdimage", "IMG");
+  aio_threads = 0;
+  aio_inflight = 0;
+  aio_timer_index = BX_NULL_TIMER_HANDLE;
 }
 
 void bx_hdimage_ctl_c::init(void)
@@ -135,6 +140,7 @@ void bx_hdimage_ctl_c::list_modules(void)
 
 void bx_hdimage_ctl_c::exit(void)
 {
+  aio_stop();
   free(hdimage_mode_names);
   hdimage_locator_c::cleanup();
 }
@@ -182,6 +188,255 @@ cdrom_base_c* bx_hdimage_ctl_c::init_cdrom(const char *dev)
 #endif
 }
 
+// Puts the block cache in front of the image if it is enabled
+device_image_t* bx_hdimage_ctl_c::init_cache(device_image_t *image)
+{
+  Bit32u size = SIM->get_param_num(BXPN_DISK_CACHE_SIZE)->get();
+
+  if ((image == NULL) || (size == 0)) {
+    return image;
+  }
+  return new cached_image_t(image, size << 20,
+                            SIM->get_param_num(BXPN_DISK_CACHE_READAHEAD)->get() << 10,
+                            SIM->get_param_num(BXPN_DISK_CACHE_WRITEBACK)->get() << 10);
+}
+
+// Asynchronous disk image requests are queued to a pool of worker threads.
+// The workers execute them with the synchronous image functions and move
+// them to the list of completed requests. The completion callbacks are
+// called from the emulation thread by a polling timer that is active as long
+// as requests are in flight.
+
+#define HDIMAGE_AIO_MAX_THREADS  16
+#define HDIMAGE_AIO_POLL_USEC    50
+
+static BX_MUTEX(aio_mutex);
+static bx_thread_sem_t aio_wakeup;
+static bx_thread_sem_t aio_done;
+static BX_THREAD_VAR(aio_thread_var[HDIMAGE_AIO_MAX_THREADS]);
+static bool aio_keep_alive = 0;
+static hdimage_aio_request_t *aio_queue_head = NULL, *aio_queue_tail = NULL;
+static hdimage_aio_request_t *aio_done_head = NULL, *aio_done_tail = NULL;
+
+BX_THREAD_FUNC(hdimage_aio_thread, indata)
+{
+  hdimage_aio_request_t *req;
+  ssize_t ret;
+  bool stop;
+
+  UNUSED(indata);
+  do {
+    bx_wait_sem(&aio_wakeup);
+    BX_LOCK(aio_mutex);
+    while (aio_keep_alive && (aio_queue_head != NULL)) {
+      req = aio_queue_head;
+      aio_queue_head = req->next;
+      if (aio_queue_head == NULL) {
+        aio_queue_tail = NULL;
+      } else {
+        // the semaphore may not count, pass the wakeup to the next worker
+        bx_set_sem(&aio_wakeup);
+      }
+      req->state = HDIMAGE_AIO_RUNNING;
+      BX_UNLOCK(aio_mutex);
+      if (req->op == HDIMAGE_AIO_READ) {
+        ret = req->image->read_at(req->offset, req->buf, req->count);
+      } else {
+        ret = req->image->write_at(req->offset, req->buf, req->count);
+      }
+      BX_LOCK(aio_mutex);
+      req->result = ret;
+      req->state = HDIMAGE_AIO_DONE;
+      req->next = NULL;
+      if (aio_done_tail != NULL) {
+        aio_done_tail->next = req;
+      } else {
+        aio_done_head = req;
+      }
+      aio_done_tail = req;
+      bx_set_sem(&aio_done);
+    }
+    stop = !aio_keep_alive;
+    BX_UNLOCK(aio_mutex);
+  } while (!stop);
+  // wake up the next worker to let it terminate too
+  bx_set_sem(&aio_wakeup);
+  BX_THREAD_EXIT;
+}
+
+void bx_hdimage_ctl_c::aio_start(void)
+{
+  unsigned threads = SIM->get_param_num(BXPN_DISK_AIO_THREADS)->get();
+
+  if (threads > HDIMAGE_AIO_MAX_THREADS) {
+    threads = HDIMAGE_AIO_MAX_THREADS;
+  }
+  if (threads == 0) return;
+  BX_INIT_MUTEX(aio_mutex);
+  bx_create_sem(&aio_wakeup);
+  bx_create_sem(&aio_done);
+  aio_keep_alive = 1;
+  for (aio_threads = 0; aio_threads < threads; aio_threads++) {
+    BX_THREAD_CREATE(hdimage_aio_thread, NULL, aio_thread_var[aio_threads]);
+  }
+  aio_timer_index =
+    DEV_register_timer(this, aio_timer_handler, HDIMAGE_AIO_POLL_USEC, 1, 0, "hdimage aio");
+  BX_INFO(("asynchronous disk image I/O started with %u worker threads", threads));
+}
+
+void bx_hdimage_ctl_c::aio_stop(void)
+{
+  hdimage_aio_request_t *req;
+  unsigned done;
+
+  if (aio_threads == 0) return;
+  // finish all requests in flight without calling the completion callbacks
+  BX_LOCK(aio_mutex);
+  while (1) {
+    done = 0;
+    for (req = aio_done_head; req != NULL; req = req->next) {
+      done++;
+    }
+    if (done == aio_inflight) break;
+    BX_UNLOCK(aio_mutex);
+    bx_wait_sem(&aio_done);
+    BX_LOCK(aio_mutex);
+  }
+  for (req = aio_done_head; req != NULL; req = req->next) {
+    req->state = HDIMAGE_AIO_IDLE;
+  }
+  aio_done_head = aio_done_tail = NULL;
+  aio_inflight = 0;
+  aio_keep_alive = 0;
+  BX_UNLOCK(aio_mutex);
+  bx_set_sem(&aio_wakeup);
+  for (unsigned i = 0; i < aio_threads; i++) {
+    BX_THREAD_JOIN(aio_thread_var[i]);
+  }
+  aio_threads = 0;
+  bx_destroy_sem(&aio_wakeup);
+  bx_destroy_sem(&aio_done);
+  BX_FINI_MUTEX(aio_mutex);
+  // the timers have already been removed by bx_pc_system.exit()
+  aio_timer_index = BX_NULL_TIMER_HANDLE;
+}
+
+bool bx_hdimage_ctl_c::aio_submit(hdimage_aio_request_t *req)
+{
+  if (aio_threads == 0) {
+    aio_start();
+    if (aio_threads == 0) return 0;
+  }
+  req->result = -1;
+  req->next = NULL;
+  BX_LOCK(aio_mutex);
+  req->state = HDIMAGE_AIO_QUEUED;
+  if (aio_queue_tail != NULL) {
+    aio_queue_tail->next = req;
+  } else {
+    aio_queue_head = req;
+  }
+  aio_queue_tail = req;
+  BX_UNLOCK(aio_mutex);
+  bx_set_sem(&aio_wakeup);
+  if (aio_inflight++ == 0) {
+    bx_pc_system.activate_timer(aio_timer_index, HDIMAGE_AIO_POLL_USEC, 1);
+  }
+  return 1;
+}
+
+bool bx_hdimage_ctl_c::aio_wait_done(hdimage_aio_request_t *req)
+{
+  hdimage_aio_request_t *prev = NULL, *curr;
+
+  // only the emulation thread moves requests from and to the idle state
+  if (req->state == HDIMAGE_AIO_IDLE) return 0;
+  BX_LOCK(aio_mutex);
+  while (req->state != HDIMAGE_AIO_DONE) {
+    BX_UNLOCK(aio_mutex);
+    bx_wait_sem(&aio_done);
+    BX_LOCK(aio_mutex);
+  }
+  for (curr = aio_done_head; curr != req; curr = curr->next) {
+    prev = curr;
+  }
+  if (prev != NULL) {
+    prev->next = req->next;
+  } else {
+    aio_done_head = req->next;
+  }
+  if (aio_done_tail == req) {
+    aio_done_tail = prev;
+  }
+  BX_UNLOCK(aio_mutex);
+  req->state = HDIMAGE_AIO_IDLE;
+  req->next = NULL;
+  if (--aio_inflight == 0) {
+    bx_pc_system.deactivate_timer(aio_timer_index);
+  }
+  return 1;
+}
+
+void bx_hdimage_ctl_c::aio_deliver(hdimage_aio_request_t *req)
+{
+  if (req->complete != NULL) {
+    req->complete(req);
+  }
+}
+
+void bx_hdimage_ctl_c::aio_wait(hdimage_aio_request_t *req)
+{
+  if (aio_wait_done(req)) {
+    aio_deliver(req);
+  }
+}
+
+void bx_hdimage_ctl_c::aio_cancel(hdimage_aio_request_t *req)
+{
+  aio_wait_done(req);
+}
+
+void bx_hdimage_ctl_c::aio_flush(void)
+{
+  while (aio_inflight > 0) {
+    BX_LOCK(aio_mutex);
+    while (aio_done_head == NULL) {
+      BX_UNLOCK(aio_mutex);
+      bx_wait_sem(&aio_done);
+      BX_LOCK(aio_mutex);
+    }
+    BX_UNLOCK(aio_mutex);
+    aio_timer();
+  }
+}
+
+void bx_hdimage_ctl_c::aio_timer_handler(void *this_ptr)
+{
+  ((bx_hdimage_ctl_c*)this_ptr)->aio_timer();
+}
+
+void bx_hdimage_ctl_c::aio_timer(void)
+{
+  hdimage_aio_request_t *req, *next;
+
+  BX_LOCK(aio_mutex);
+  req = aio_done_head;
+  aio_done_head = aio_done_tail = NULL;
+  BX_UNLOCK(aio_mutex);
+  while (req != NULL) {
+    next = req->next;
+    req->state = HDIMAGE_AIO_IDLE;
+    req->next = NULL;
+    aio_inflight--;
+    // the callback may submit a new request with the same structure
+    aio_deliver(req);
+    req = next;
+  }
+  if (aio_inflight == 0) {
+    bx_pc_system.deactivate_timer(aio_timer_index);
+  }
+}
+
 #endif // ifndef BXIMAGE
 
 hdimage_locator_c *hdimage_locator_c::all = NULL;
@@ -291,20 +546,30 @@ int bx_create_image_file(const char *filename)
 }
 #endif
 
+// Positional file access. With pread() / pwrite() the file position is not
+// used, so the image file can be accessed from several threads.
 int bx_read_image(int fd, Bit64s offset, void *buf, int count)
 {
+#if BX_HAVE_PREAD
+  return (int)pread(fd, buf, count, (off_t)offset);
+#else
   if (lseek(fd, offset, SEEK_SET) == -1) {
     return -1;
   }
   return read(fd, buf, count);
+#endif
 }
 
 int bx_write_image(int fd, Bit64s offset, void *buf, int count)
 {
+#if BX_HAVE_PREAD
+  return (int)pwrite(fd, buf, count, (off_t)offset);
+#else
   if (lseek(fd, offset, SEEK_SET) == -1) {
     return -1;
   }
   return write(fd, buf, count);
+#endif
 }
 
 int bx_close_image(int fd, const char *pathname)
@@ -633,6 +898,22 @@ int device_image_t::open(const char* _pathname)
   return open(_pathname, O_RDWR);
 }
 
+ssize_t device_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  if (lseek(offset, SEEK_SET) < 0) {
+    return -1;
+  }
+  return read(buf, count);
+}
+
+ssize_t device_image_t::write_at(Bit64s offset, const void* buf, size_t count)
+{
+  if (lseek(offset, SEEK_SET) < 0) {
+    return -1;
+  }
+  return write(buf, count);
+}
+
 Bit32u device_image_t::get_capabilities()
 {
   return (cylinders == 0) ? HDIMAGE_AUTO_GEOMETRY : 0;
@@ -649,6 +930,11 @@ void device_image_t::register_state(bx_list_c *parent)
   bx_param_bool_c *image = new bx_param_bool_c(parent, "image", NULL, NULL, 0);
   image->set_sr_handlers(this, hdimage_save_handler, hdimage_restore_handler);
 }
+
+bool device_image_t::aio_submit(hdimage_aio_request_t *req)
+{
+  return bx_hdimage_ctl.aio_submit(req);
+}
 #endif
 
 /*** flat_image_t function definitions ***/
@@ -689,6 +975,16 @@ ssize_t flat_image_t::write(const void* buf, size_t count)
   return ::write(fd, (char*) buf, count);
 }
 
+ssize_t flat_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  return bx_read_image(fd, offset, buf, (int)count);
+}
+
+ssize_t flat_image_t::write_at(Bit64s offset, const void* buf, size_t count)
+{
+  return bx_write_image(fd, offset, (void*)buf, (int)count);
+}
+
 int flat_image_t::check_format(int fd, Bit64u imgsize)
 {
   char buffer[512];
@@ -860,61 +1156,77 @@ Bit64s concat_image_t::lseek(Bit64s offset, int whence)
     BX_PANIC(("concat_image_t.lseek to byte %ld failed", (long)offset));
     return -1;
   }
-  return (Bit64s)::lseek(curr_fd, (off_t)offset, SEEK_SET);
+  return total_offset;
 }
 
 ssize_t concat_image_t::read(void* buf, size_t count)
 {
-  size_t readmax, count1 = count;
-  ssize_t ret = -1;
+  BX_DEBUG(("concat_image_t.read %ld bytes", (long)count));
+  ssize_t ret = read_at(total_offset, buf, count);
+  if (ret >= 0) {
+    total_offset += count;
+  }
+  return ret;
+}
+
+ssize_t concat_image_t::write(const void* buf, size_t count)
+{
+  BX_DEBUG(("concat_image_t.write %ld bytes", (long)count));
+  ssize_t ret = write_at(total_offset, buf, count);
+  if (ret >= 0) {
+    total_offset += count;
+  }
+  return ret;
+}
+
+// The requested range may span several image files, each part is read or
+// written with one positional access to the file containing it.
+ssize_t concat_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  size_t count1 = count, len;
   char *buf1 = (char*)buf;
+  int i = 0;
 
-  BX_DEBUG(("concat_image_t.read %ld bytes", (long)count));
-  do {
-    readmax = (size_t)(curr_max - total_offset + 1);
-    if (count1 > readmax) {
-      ret = ::read(curr_fd, buf1, readmax);
-      if (ret >= 0) {
-        buf1 += readmax;
-        count1 -= readmax;
-        ret = lseek(curr_max + 1, SEEK_SET);
-      }
-    } else {
-      ret = ::read(curr_fd, buf1, count1);
-      if (ret >= 0) {
-        ret = lseek(count1, SEEK_CUR);
-      }
-      break;
+  while (count1 > 0) {
+    while ((i < maxfd) && ((Bit64u)offset >= (start_offset_table[i] + length_table[i]))) i++;
+    if ((i == maxfd) || (offset < 0)) {
+      BX_ERROR(("concat_image_t.read_at byte " FMT_LL "d out of range", offset));
+      return -1;
     }
-  } while (ret > 0);
-  return (ret < 0) ? ret : count;
+    len = (size_t)(start_offset_table[i] + length_table[i] - offset);
+    if (len > count1) len = count1;
+    if (bx_read_image(fd_table[i], offset - start_offset_table[i], buf1, (int)len) != (int)len) {
+      return -1;
+    }
+    buf1 += len;
+    offset += len;
+    count1 -= len;
+  }
+  return count;
 }
 
-ssize_t concat_image_t::write(const void* buf, size_t count)
+ssize_t concat_image_t::write_at(Bit64s offset, const void* buf, size_t count)
 {
-  size_t writemax, count1 = count;
-  ssize_t ret = -1;
+  size_t count1 = count, len;
   char *buf1 = (char*)buf;
+  int i = 0;
 
-  BX_DEBUG(("concat_image_t.write %ld bytes", (long)count));
-  do {
-    writemax = (size_t)(curr_max - total_offset + 1);
-    if (count1 > writemax) {
-      ret = ::write(curr_fd, buf1, writemax);
-      if (ret >= 0) {
-        buf1 += writemax;
-        count1 -= writemax;
-        ret = lseek(curr_max + 1, SEEK_SET);
-      }
-    } else {
-      ret = ::write(curr_fd, buf1, count1);
-      if (ret >= 0) {
-        ret = lseek(count1, SEEK_CUR);
-      }
-      break;
+  while (count1 > 0) {
+    while ((i < maxfd) && ((Bit64u)offset >= (start_offset_table[i] + length_table[i]))) i++;
+    if ((i == maxfd) || (offset < 0)) {
+      BX_ERROR(("concat_image_t.write_at byte " FMT_LL "d out of range", offset));
+      return -1;
     }
-  } while (ret > 0);
-  return (ret < 0) ? ret : count;
+    len = (size_t)(start_offset_table[i] + length_table[i] - offset);
+    if (len > count1) len = count1;
+    if (bx_write_image(fd_table[i], offset - start_offset_table[i], buf1, (int)len) != (int)len) {
+      return -1;
+    }
+    buf1 += len;
+    offset += len;
+    count1 -= len;
+  }
+  return count;
 }
 
 #ifndef BXIMAGE
@@ -1034,7 +1346,7 @@ int sparse_image_t::read_header()
       panic("could not allocate memory for sparse disk block table");
     }
 
-    ret = ::read(fd, pagetable, sizeof(Bit32u) * numpages);
+    ret = bx_read_image(fd, sizeof(header), pagetable, sizeof(Bit32u) * numpages);
 
     if (ret < 0) {
       panic(strerror(errno));
@@ -1067,10 +1379,6 @@ int sparse_image_t::open(const char* pathname0, int flags)
   if ((pagesize % sect_size) != 0)
     panic("page size of sparse disk image is not multiple of sector size");
 
-  underlying_current_filepos = 0;
-  if (-1 == ::lseek(fd, 0, SEEK_SET))
-    panic("error while seeking to start of file");
-
   lseek(0, SEEK_SET);
 
   char * parentpathname = strdup(pathname);
@@ -1186,15 +1494,7 @@ ssize_t sparse_image_t::read_page_fragment(Bit32u read_virtual_page, Bit32u read
   {
     Bit64s physical_offset = get_physical_offset();
 
-    if (physical_offset != underlying_current_filepos)
-    {
-      off_t ret = ::lseek(fd, (off_t)physical_offset, SEEK_SET);
-      // underlying_current_filepos update deferred
-      if (ret == -1)
-        panic(strerror(errno));
-    }
-
-    ssize_t readret = ::read(fd, buf, read_size);
+    ssize_t readret = bx_read_image(fd, physical_offset, buf, (int)read_size);
 
     if (readret == -1)
     {
@@ -1205,8 +1505,6 @@ ssize_t sparse_image_t::read_page_fragment(Bit32u read_virtual_page, Bit32u read
     {
       panic("could not read block contents from file");
     }
-
-    underlying_current_filepos = physical_offset + read_size;
   }
 
   return read_size;
@@ -1317,11 +1615,7 @@ ssize_t sparse_image_t::write(const void* buf, size_t count)
           memcpy(dest_start, buf, can_write);
         }
 
-        int ret = (int)::lseek(fd, page_file_start, SEEK_SET);
-        // underlying_current_filepos update deferred
-        if (ret == -1) panic(strerror(errno));
-
-        ret = ::write(fd, writebuffer, pagesize);
+        int ret = bx_write_image(fd, page_file_start, writebuffer, pagesize);
         if (ret == -1) panic(strerror(errno));
 
         if (pagesize != (Bit32u)ret) panic("failed to write entire merged page to disk");
@@ -1337,34 +1631,22 @@ ssize_t sparse_image_t::write(const void* buf, size_t count)
         // We seek as close to the page end as possible, and then write a little
         // This produces a sparse file which has blanks
         // Also very quick, even when pagesize is massive
-        int ret = (int)::lseek(fd, page_file_start + pagesize - 4, SEEK_SET);
-        // underlying_current_filepos update deferred
-        if (ret == -1) panic(strerror(errno));
-
         Bit32u zero = 0;
-        ret = ::write(fd, &zero, 4);
+        int ret = bx_write_image(fd, page_file_start + pagesize - 4, &zero, 4);
         if (ret == -1) panic(strerror(errno));
 
         if (ret != 4) panic("failed to write entire blank page to disk");
       }
 
       update_pagetable_count = (position_virtual_page - update_pagetable_start) + 1;
-      underlying_filesize = underlying_current_filepos = page_file_start + pagesize;
+      underlying_filesize = page_file_start + pagesize;
     }
 
     BX_ASSERT(position_physical_page != SPARSE_PAGE_NOT_ALLOCATED);
 
     Bit64s physical_offset = get_physical_offset();
 
-    if (physical_offset != underlying_current_filepos)
-    {
-      off_t ret = ::lseek(fd, (off_t)physical_offset, SEEK_SET);
-      // underlying_current_filepos update deferred
-      if (ret == -1)
-        panic(strerror(errno));
-    }
-
-    ssize_t writeret = ::write(fd, buf, can_write);
+    ssize_t writeret = bx_write_image(fd, physical_offset, (void*)buf, (int)can_write);
 
     if (writeret == -1)
     {
@@ -1376,8 +1658,6 @@ ssize_t sparse_image_t::write(const void* buf, size_t count)
       panic("could not write block contents to file");
     }
 
-    underlying_current_filepos = physical_offset + can_write;
-
     total_written += can_write;
 
     position_page_offset += can_write;
@@ -1417,15 +1697,9 @@ ssize_t sparse_image_t::write(const void* buf, size_t count)
 
     if (!done)
     {
-      int ret = (int)::lseek(fd, pagetable_write_from, SEEK_SET);
-      // underlying_current_filepos update deferred
-      if (ret == -1) panic(strerror(errno));
-
-      ret = ::write(fd, &pagetable[update_pagetable_start], write_bytecount);
+      int ret = bx_write_image(fd, pagetable_write_from, &pagetable[update_pagetable_start], (int)write_bytecount);
       if (ret == -1) panic(strerror(errno));
       if ((size_t)ret != write_bytecount) panic("could not write entire updated block header");
-
-      underlying_current_filepos = pagetable_write_from + write_bytecount;
     }
   }
 
@@ -1436,7 +1710,7 @@ int sparse_image_t::check_format(int fd, Bit64u imgsize)
 {
   sparse_header_t temp_header;
 
-  int ret = ::read(fd, &temp_header, sizeof(temp_header));
+  int ret = bx_read_image(fd, 0, &temp_header, sizeof(temp_header));
   if (ret < 0) {
     return HDIMAGE_READ_ERROR;
   }
@@ -1957,6 +2231,7 @@ ssize_t redolog_t::read(void* buf, size_t count)
 
   if (dtoh32(catalog[extent_index]) == REDOLOG_PAGE_NOT_ALLOCATED) {
     // page not allocated
+    lseek(512, SEEK_CUR);
     return 0;
   }
 
@@ -1979,6 +2254,7 @@ ssize_t redolog_t::read(void* buf, size_t count)
     BX_DEBUG(("read not in redolog"));
 
     // bitmap says block not in redolog
+    lseek(512, SEEK_CUR);
     return 0;
   }
 
@@ -2015,20 +2291,13 @@ ssize_t redolog_t::write(const void* buf, size_t count)
 
     extent_next += 1;
 
-    char *zerobuffer = new char[512];
-    memset(zerobuffer, 0, 512);
-
-    // Write bitmap
+    // Write bitmap and extent with one access
+    i = 512 * (bitmap_blocks + extent_blocks);
+    char *zerobuffer = new char[i];
+    memset(zerobuffer, 0, i);
     bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
     bitmap_offset += (Bit64s)512 * dtoh32(catalog[extent_index]) * (extent_blocks + bitmap_blocks);
-    ::lseek(fd, (off_t)bitmap_offset, SEEK_SET);
-    for (i=0; i<bitmap_blocks; i++) {
-      ::write(fd, zerobuffer, 512);
-    }
-    // Write extent
-    for (i=0; i<extent_blocks; i++) {
-      ::write(fd, zerobuffer, 512);
-    }
+    bx_write_image(fd, (off_t)bitmap_offset, zerobuffer, i);
 
     delete [] zerobuffer;
 
@@ -2146,11 +2415,7 @@ int redolog_t::commit(device_image_t *base_image)
             base_offset  = (Bit64s)i * (dtoh32(header.specific.extent));
             base_offset += (Bit64s)512 * ((j * 8) + bit);
 
-            if (base_image->lseek(base_offset, SEEK_SET) < 0) {
-              ret = -1;
-              break;
-            }
-            if (base_image->write(buffer, 512) < 0) {
+            if (base_image->write_at(base_offset, buffer, 512) < 0) {
               ret = -1;
               break;
             }
@@ -2312,11 +2577,37 @@ bool coherency_check(device_image_t *ro_disk, redolog_t *redolog)
   return 1;
 }
 
+// Reads sectors of an image with a redolog on top of a read-only base disk.
+// The redolog is read sector by sector, the runs of sectors not found there
+// are read from the base disk at their own offset with one access.
+static ssize_t redolog_read_at(redolog_t *redolog, device_image_t *ro_disk,
+                               Bit64s offset, void* buf, size_t count)
+{
+  char *cbuf = (char*)buf;
+  size_t n, run_start = 0, run_len = 0;
+
+  if (redolog->lseek(offset, SEEK_SET) < 0) return -1;
+  for (n = 0; n < count; n += 512) {
+    if ((size_t)redolog->read(cbuf + n, 512) == 512) {
+      if ((run_len > 0) && (ro_disk->read_at(offset + run_start, cbuf + run_start, run_len) != (ssize_t)run_len))
+        return -1;
+      run_len = 0;
+    } else {
+      if (run_len == 0) run_start = n;
+      run_len += 512;
+    }
+  }
+  if ((run_len > 0) && (ro_disk->read_at(offset + run_start, cbuf + run_start, run_len) != (ssize_t)run_len))
+    return -1;
+  return count;
+}
+
 /*** undoable_image_t function definitions ***/
 
 undoable_image_t::undoable_image_t(const char* _redolog_name)
 {
   redolog = new redolog_t();
+  cur_offset = 0;
   redolog_name = NULL;
   if (_redolog_name != NULL) {
     if ((strlen(_redolog_name) > 0) && (strcmp(_redolog_name,"none") != 0)) {
@@ -2398,24 +2689,23 @@ void undoable_image_t::close()
 Bit64s undoable_image_t::lseek(Bit64s offset, int whence)
 {
   redolog->lseek(offset, whence);
-  return ro_disk->lseek(offset, whence);
+  cur_offset = ro_disk->lseek(offset, whence);
+  return cur_offset;
 }
 
 ssize_t undoable_image_t::read(void* buf, size_t count)
 {
-  char *cbuf = (char*)buf;
-  size_t n = 0;
-  ssize_t ret = 0;
+  ssize_t ret = read_at(cur_offset, buf, count);
 
-  while (n < count) {
-    if ((size_t)redolog->read(cbuf, 512) != 512) {
-      ret = ro_disk->read(cbuf, 512);
-      if (ret < 0) break;
-    }
-    cbuf += 512;
-    n += 512;
+  if (ret > 0) {
+    cur_offset += ret;
   }
-  return (ret < 0) ? ret : count;
+  return ret;
+}
+
+ssize_t undoable_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  return redolog_read_at(redolog, ro_disk, offset, buf, count);
 }
 
 ssize_t undoable_image_t::write(const void* buf, size_t count)
@@ -2430,6 +2720,7 @@ ssize_t undoable_image_t::write(const void* buf, size_t count)
     cbuf += 512;
     n += 512;
   }
+  cur_offset += n;
   return (ret < 0) ? ret : count;
 }
 
@@ -2469,6 +2760,7 @@ void undoable_image_t::restore_state(const char *backup_fname)
 volatile_image_t::volatile_image_t(const char* _redolog_name)
 {
   redolog = new redolog_t();
+  cur_offset = 0;
   redolog_temp = NULL;
   redolog_name = NULL;
   if (_redolog_name != NULL) {
@@ -2572,24 +2864,23 @@ void volatile_image_t::close()
 Bit64s volatile_image_t::lseek(Bit64s offset, int whence)
 {
   redolog->lseek(offset, whence);
-  return ro_disk->lseek(offset, whence);
+  cur_offset = ro_disk->lseek(offset, whence);
+  return cur_offset;
 }
 
 ssize_t volatile_image_t::read(void* buf, size_t count)
 {
-  char *cbuf = (char*)buf;
-  size_t n = 0;
-  ssize_t ret = 0;
+  ssize_t ret = read_at(cur_offset, buf, count);
 
-  while (n < count) {
-    if ((size_t)redolog->read(cbuf, 512) != 512) {
-      ret = ro_disk->read(cbuf, 512);
-      if (ret < 0) break;
-    }
-    cbuf += 512;
-    n += 512;
+  if (ret > 0) {
+    cur_offset += ret;
   }
-  return (ret < 0) ? ret : count;
+  return ret;
+}
+
+ssize_t volatile_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  return redolog_read_at(redolog, ro_disk, offset, buf, count);
 }
 
 ssize_t volatile_image_t::write(const void* buf, size_t count)
@@ -2604,6 +2895,7 @@ ssize_t volatile_image_t::write(const void* buf, size_t count)
     cbuf += 512;
     n += 512;
   }
+  cur_offset += n;
   return (ret < 0) ? ret : count;
 }
 
@@ -2642,3 +2934,592 @@ void volatile_image_t::restore_state(const char *backup_fname)
 #endif
 }
 #endif
+
+#ifndef BXIMAGE
+
+/*** cached_image_t function definitions ***/
+
+#define HDIMAGE_CACHE_NONE        0xffffffff
+#define HDIMAGE_CACHE_OFFSET_MASK (~(Bit64s)(HDIMAGE_CACHE_BLOCK_SIZE - 1))
+#define HDIMAGE_CACHE_SECTORS     (HDIMAGE_CACHE_BLOCK_SIZE / 512)
+
+// mask of the sectors covered by 'len' bytes at offset 'start' of a block
+static inline Bit8u cache_sector_mask(Bit32u start, Bit32u len)
+{
+  return (Bit8u)(((1 << (len >> 9)) - 1) << (start >> 9));
+}
+
+static int cache_offset_compare(const void *a, const void *b)
+{
+  Bit64s offset1 = *(const Bit64s*)a;
+  Bit64s offset2 = *(const Bit64s*)b;
+
+  return (offset1 < offset2) ? -1 : (offset1 > offset2);
+}
+
+cached_image_t::cached_image_t(device_image_t *_image, Bit32u cache_size,
+                               Bit32u readahead, Bit32u writeback)
+{
+  image = _image;
+  pathname = NULL;
+  cur_offset = 0;
+  last_read_end = -1;
+  nblocks = cache_size / HDIMAGE_CACHE_BLOCK_SIZE;
+  // a fill must not replace the blocks it has just reserved
+  if (nblocks < (2 * HDIMAGE_CACHE_MAX_IO / HDIMAGE_CACHE_BLOCK_SIZE)) {
+    nblocks = 2 * HDIMAGE_CACHE_MAX_IO / HDIMAGE_CACHE_BLOCK_SIZE;
+  }
+  readahead_blocks = readahead / HDIMAGE_CACHE_BLOCK_SIZE;
+  writeback_blocks = writeback / HDIMAGE_CACHE_BLOCK_SIZE;
+  if (writeback_blocks > (nblocks / 2)) {
+    writeback_blocks = nblocks / 2;
+  }
+  writeback_limit = writeback_blocks;
+  dirty_blocks = 0;
+  blocks = NULL;
+  data = NULL;
+  hash_table = NULL;
+  hash_mask = 0;
+  lru_head = lru_tail = HDIMAGE_CACHE_NONE;
+  flush_list = NULL;
+  io_buf = NULL;
+  stat_read_hits = 0;
+  stat_read_misses = 0;
+  stat_readahead = 0;
+  stat_writes = 0;
+  stat_written_back = 0;
+  stat_flushes = 0;
+}
+
+cached_image_t::~cached_image_t()
+{
+  delete image;
+}
+
+int cached_image_t::open(const char* _pathname, int flags)
+{
+  Bit32u i, hash_size;
+
+  pathname = _pathname;
+  // some image modes use the geometry from the configuration
+  image->cylinders = cylinders;
+  image->heads = heads;
+  image->spt = spt;
+  image->sect_size = sect_size;
+  if (image->open(pathname, flags) < 0) {
+    return -1;
+  }
+  cylinders = image->cylinders;
+  heads = image->heads;
+  spt = image->spt;
+  sect_size = image->sect_size;
+  hd_size = image->hd_size;
+
+  blocks = new cache_block_t[nblocks];
+  data = new Bit8u[(size_t)nblocks * HDIMAGE_CACHE_BLOCK_SIZE];
+  for (hash_size = 1; hash_size < nblocks; hash_size <<= 1);
+  hash_table = new Bit32u[hash_size];
+  hash_mask = hash_size - 1;
+  for (i = 0; i < hash_size; i++) {
+    hash_table[i] = HDIMAGE_CACHE_NONE;
+  }
+  for (i = 0; i < nblocks; i++) {
+    blocks[i].offset = -1;
+    blocks[i].prev = (i > 0) ? (i - 1) : HDIMAGE_CACHE_NONE;
+    blocks[i].next = (i < (nblocks - 1)) ? (i + 1) : HDIMAGE_CACHE_NONE;
+    blocks[i].hash_next = HDIMAGE_CACHE_NONE;
+    blocks[i].valid = 0;
+    blocks[i].dirty = 0;
+  }
+  lru_head = 0;
+  lru_tail = nblocks - 1;
+  flush_list = new Bit64s[nblocks];
+  io_buf = new Bit8u[HDIMAGE_CACHE_MAX_IO];
+  if (writeback_blocks > 0) {
+    BX_INFO(("disk cache for '%s': %u KB, read ahead %u KB, write-back %u KB", pathname,
+             nblocks * 4, readahead_blocks * 4, writeback_blocks * 4));
+  } else {
+    BX_INFO(("disk cache for '%s': %u KB, read ahead %u KB, write-through", pathname,
+             nblocks * 4, readahead_blocks * 4));
+  }
+  return 0;
+}
+
+void cached_image_t::close()
+{
+  Bit64u reads = stat_read_hits + stat_read_misses;
+
+  if (blocks != NULL) {
+    write_dirty();
+    BX_INFO(("disk cache for '%s': " FMT_LL "u read hits, " FMT_LL "u read misses (%u%% hits), "
+             FMT_LL "u blocks read ahead", pathname, stat_read_hits, stat_read_misses,
+             (reads > 0) ? (unsigned)(stat_read_hits * 100 / reads) : 0, stat_readahead));
+    BX_INFO(("disk cache for '%s': " FMT_LL "u blocks written, " FMT_LL "u written back, "
+             FMT_LL "u flushes", pathname, stat_writes, stat_written_back, stat_flushes));
+    delete [] blocks;
+    delete [] data;
+    delete [] hash_table;
+    delete [] flush_list;
+    delete [] io_buf;
+    blocks = NULL;
+  }
+  image->close();
+}
+
+Bit64s cached_image_t::lseek(Bit64s offset, int whence)
+{
+  if (whence == SEEK_SET) {
+    cur_offset = offset;
+  } else if (whence == SEEK_CUR) {
+    cur_offset += offset;
+  } else if (whence == SEEK_END) {
+    cur_offset = (Bit64s)hd_size + offset;
+  } else {
+    return -1;
+  }
+  return cur_offset;
+}
+
+ssize_t cached_image_t::read(void* buf, size_t count)
+{
+  ssize_t ret = read_at(cur_offset, buf, count);
+
+  if (ret > 0) {
+    cur_offset += ret;
+  }
+  return ret;
+}
+
+ssize_t cached_image_t::write(const void* buf, size_t count)
+{
+  ssize_t ret = write_at(cur_offset, buf, count);
+
+  if (ret > 0) {
+    cur_offset += ret;
+  }
+  return ret;
+}
+
+Bit32u cached_image_t::lookup(Bit64s offset)
+{
+  Bit32u index = hash_table[(Bit32u)(offset / HDIMAGE_CACHE_BLOCK_SIZE) & hash_mask];
+
+  while ((index != HDIMAGE_CACHE_NONE) && (blocks[index].offset != offset)) {
+    index = blocks[index].hash_next;
+  }
+  return index;
+}
+
+void cached_image_t::hash_remove(Bit32u index)
+{
+  Bit32u *link = &hash_table[(Bit32u)(blocks[index].offset / HDIMAGE_CACHE_BLOCK_SIZE) & hash_mask];
+
+  while (*link != index) {
+    link = &blocks[*link].hash_next;
+  }
+  *link = blocks[index].hash_next;
+}
+
+void cached_image_t::lru_unlink(Bit32u index)
+{
+  cache_block_t *block = &blocks[index];
+
+  if (block->prev != HDIMAGE_CACHE_NONE) {
+    blocks[block->prev].next = block->next;
+  } else {
+    lru_head = block->next;
+  }
+  if (block->next != HDIMAGE_CACHE_NONE) {
+    blocks[block->next].prev = block->prev;
+  } else {
+    lru_tail = block->prev;
+  }
+}
+
+void cached_image_t::lru_touch(Bit32u index)
+{
+  if (index == lru_head) return;
+  lru_unlink(index);
+  blocks[index].prev = HDIMAGE_CACHE_NONE;
+  blocks[index].next = lru_head;
+  blocks[lru_head].prev = index;
+  lru_head = index;
+}
+
+// Takes the least recently used block for the image block at 'offset'. A
+// modified block is written to the image before it is replaced.
+Bit32u cached_image_t::alloc_block(Bit64s offset)
+{
+  Bit32u index = lru_tail, hash;
+
+  if (blocks[index].offset >= 0) {
+    if (blocks[index].dirty != 0) {
+      write_back(index);
+    }
+    hash_remove(index);
+  }
+  blocks[index].offset = offset;
+  blocks[index].valid = 0;
+  blocks[index].dirty = 0;
+  hash = (Bit32u)(offset / HDIMAGE_CACHE_BLOCK_SIZE) & hash_mask;
+  blocks[index].hash_next = hash_table[hash];
+  hash_table[hash] = index;
+  lru_touch(index);
+  return index;
+}
+
+// sectors of the block at 'offset' that are inside the image
+Bit8u cached_image_t::block_mask(Bit64s offset)
+{
+  Bit64s len = (Bit64s)hd_size - offset;
+
+  if (len >= HDIMAGE_CACHE_BLOCK_SIZE) {
+    return (Bit8u)((1 << HDIMAGE_CACHE_SECTORS) - 1);
+  }
+  return cache_sector_mask(0, (Bit32u)len);
+}
+
+// Reads the block at 'offset' and the following ones up to the end of the
+// request at 'req_end' with one image access, plus the read ahead blocks if
+// the guest reads sequentially. Returns the end of the range read or -1.
+Bit64s cached_image_t::fill(Bit64s offset, Bit64s req_end, bool sequential)
+{
+  Bit64s end, off;
+  Bit32u index, len, s;
+  Bit8u mask, *block_data, *src;
+
+  end = (req_end + HDIMAGE_CACHE_BLOCK_SIZE - 1) & HDIMAGE_CACHE_OFFSET_MASK;
+  if (sequential) {
+    end += (Bit64s)readahead_blocks * HDIMAGE_CACHE_BLOCK_SIZE;
+  }
+  if (end > (offset + HDIMAGE_CACHE_MAX_IO)) {
+    end = offset + HDIMAGE_CACHE_MAX_IO;
+  }
+  if (end > (Bit64s)hd_size) {
+    end = hd_size;
+  }
+  // Stop at the next block that is completely cached. The blocks are
+  // reserved before the read, so a modified block replaced here is on the
+  // image before its data is read again.
+  for (off = offset; off < end; off += HDIMAGE_CACHE_BLOCK_SIZE) {
+    index = lookup(off);
+    if (index == HDIMAGE_CACHE_NONE) {
+      alloc_block(off);
+    } else if ((off > offset) && (blocks[index].valid == block_mask(off))) {
+      end = off;
+      break;
+    } else {
+      lru_touch(index);
+    }
+  }
+  len = (Bit32u)(end - offset);
+  if (image->read_at(offset, io_buf, len) != (ssize_t)len) {
+    BX_ERROR(("disk cache: could not read %u bytes at offset " FMT_LL "d", len, offset));
+    return -1;
+  }
+  for (off = offset; off < end; off += HDIMAGE_CACHE_BLOCK_SIZE) {
+    index = lookup(off);
+    block_data = data + (size_t)index * HDIMAGE_CACHE_BLOCK_SIZE;
+    src = io_buf + (off - offset);
+    mask = block_mask(off);
+    if (blocks[index].dirty == 0) {
+      memcpy(block_data, src, ((end - off) < HDIMAGE_CACHE_BLOCK_SIZE) ?
+             (size_t)(end - off) : HDIMAGE_CACHE_BLOCK_SIZE);
+    } else {
+      // keep the modified sectors
+      for (s = 0; s < HDIMAGE_CACHE_SECTORS; s++) {
+        if ((mask & ~blocks[index].dirty) & (1 << s)) {
+          memcpy(block_data + (s << 9), src + (s << 9), 512);
+        }
+      }
+    }
+    blocks[index].valid = mask;
+    if (off < req_end) {
+      stat_read_misses++;
+    } else {
+      stat_readahead++;
+    }
+  }
+  return end;
+}
+
+bool cached_image_t::write_run(Bit64s offset, const Bit8u *buf, Bit32u len)
+{
+  if (image->write_at(offset, buf, len) != (ssize_t)len) {
+    BX_ERROR(("disk cache: could not write %u bytes at offset " FMT_LL "d", len, offset));
+    return 0;
+  }
+  return 1;
+}
+
+// writes the modified sectors of a single block
+bool cached_image_t::write_back(Bit32u index)
+{
+  cache_block_t *block = &blocks[index];
+  Bit8u *block_data = data + (size_t)index * HDIMAGE_CACHE_BLOCK_SIZE;
+  Bit32u s = 0, n;
+  bool ret = 1;
+
+  while (s < HDIMAGE_CACHE_SECTORS) {
+    if ((block->dirty & (1 << s)) == 0) {
+      s++;
+      continue;
+    }
+    for (n = 1; ((s + n) < HDIMAGE_CACHE_SECTORS) && (block->dirty & (1 << (s + n))); n++);
+    if (!write_run(block->offset + (s << 9), block_data + (s << 9), n << 9)) {
+      ret = 0;
+    }
+    s += n;
+  }
+  block->dirty = 0;
+  dirty_blocks--;
+  stat_written_back++;
+  return ret;
+}
+
+// Writes all modified blocks in image order. Adjacent modified sectors are
+// collected in the I/O buffer and written with one image access.
+bool cached_image_t::write_dirty()
+{
+  Bit32u i, n = 0, index, s, len = 0;
+  Bit64s offset, run_offset = 0;
+  Bit8u *block_data;
+  bool ret = 1;
+
+  if (dirty_blocks == 0) {
+    return 1;
+  }
+  for (i = 0; i < nblocks; i++) {
+    if (blocks[i].dirty != 0) {
+      flush_list[n++] = blocks[i].offset;
+    }
+  }
+  qsort(flush_list, n, sizeof(Bit64s), cache_offset_compare);
+  for (i = 0; i < n; i++) {
+    index = lookup(flush_list[i]);
+    block_data = data + (size_t)index * HDIMAGE_CACHE_BLOCK_SIZE;
+    for (s = 0; s < HDIMAGE_CACHE_SECTORS; s++) {
+      if ((blocks[index].dirty & (1 << s)) == 0) continue;
+      offset = blocks[index].offset + (s << 9);
+      if ((len > 0) && (((run_offset + len) != offset) || (len == HDIMAGE_CACHE_MAX_IO))) {
+        if (!write_run(run_offset, io_buf, len)) {
+          ret = 0;
+        }
+        len = 0;
+      }
+      if (len == 0) {
+        run_offset = offset;
+      }
+      memcpy(io_buf + len, block_data + (s << 9), 512);
+      len += 512;
+    }
+    blocks[index].dirty = 0;
+    stat_written_back++;
+  }
+  if ((len > 0) && !write_run(run_offset, io_buf, len)) {
+    ret = 0;
+  }
+  dirty_blocks = 0;
+  stat_flushes++;
+  return ret;
+}
+
+// drops the cached blocks in the range (no modified data expected)
+void cached_image_t::invalidate(Bit64s offset, Bit64s end)
+{
+  Bit32u index;
+
+  for (offset &= HDIMAGE_CACHE_OFFSET_MASK; offset < end; offset += HDIMAGE_CACHE_BLOCK_SIZE) {
+    index = lookup(offset);
+    if (index == HDIMAGE_CACHE_NONE) continue;
+    hash_remove(index);
+    blocks[index].offset = -1;
+    blocks[index].valid = 0;
+    blocks[index].dirty = 0;
+    // unused blocks are taken first
+    if (index != lru_tail) {
+      lru_unlink(index);
+      blocks[index].prev = lru_tail;
+      blocks[index].next = HDIMAGE_CACHE_NONE;
+      blocks[lru_tail].next = index;
+      lru_tail = index;
+    }
+  }
+}
+
+ssize_t cached_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  Bit8u *cbuf = (Bit8u*)buf;
+  Bit64s end = offset + count, block_offset, filled_end = -1;
+  Bit32u index, start, len;
+  Bit8u mask;
+  bool sequential = (offset == last_read_end);
+
+  if (((offset | (Bit64s)count) & 511) || (offset < 0) || (end > (Bit64s)hd_size)) {
+    // not handled by the cache, the image must be up to date
+    if (!write_dirty()) return -1;
+    return image->read_at(offset, buf, count);
+  }
+  last_read_end = end;
+  while (offset < end) {
+    block_offset = offset & HDIMAGE_CACHE_OFFSET_MASK;
+    start = (Bit32u)(offset - block_offset);
+    len = HDIMAGE_CACHE_BLOCK_SIZE - start;
+    if ((Bit64s)len > (end - offset)) {
+      len = (Bit32u)(end - offset);
+    }
+    mask = cache_sector_mask(start, len);
+    index = lookup(block_offset);
+    if ((index != HDIMAGE_CACHE_NONE) && ((blocks[index].valid & mask) == mask)) {
+      if (block_offset >= filled_end) {
+        stat_read_hits++;
+      }
+      lru_touch(index);
+    } else {
+      filled_end = fill(block_offset, end, sequential);
+      if (filled_end < 0) return -1;
+      index = lookup(block_offset);
+    }
+    memcpy(cbuf, data + (size_t)index * HDIMAGE_CACHE_BLOCK_SIZE + start, len);
+    cbuf += len;
+    offset += len;
+  }
+  return count;
+}
+
+ssize_t cached_image_t::write_at(Bit64s offset, const void* buf, size_t count)
+{
+  const Bit8u *cbuf = (const Bit8u*)buf;
+  Bit64s end = offset + count, block_offset;
+  Bit32u index, start, len;
+  Bit8u mask;
+  ssize_t ret;
+  bool write_through;
+
+  if (((offset | (Bit64s)count) & 511) || (offset < 0) || (end > (Bit64s)hd_size)) {
+    // not handled by the cache, write the modified data first
+    if (!write_dirty()) return -1;
+    invalidate(offset, end);
+    return image->write_at(offset, buf, count);
+  }
+  // requests larger than the write-back buffer go to the image directly
+  // and only update the blocks already cached
+  write_through = (count > ((size_t)writeback_blocks * HDIMAGE_CACHE_BLOCK_SIZE));
+  if (write_through) {
+    ret = image->write_at(offset, buf, count);
+    if (ret != (ssize_t)count) {
+      // the cached copy may differ from the image now, but modified
+      // sectors not covered by the request must not get lost
+      for (block_offset = offset & HDIMAGE_CACHE_OFFSET_MASK; block_offset < end;
+           block_offset += HDIMAGE_CACHE_BLOCK_SIZE) {
+        index = lookup(block_offset);
+        if ((index != HDIMAGE_CACHE_NONE) && (blocks[index].dirty != 0)) {
+          write_back(index);
+        }
+      }
+      invalidate(offset, end);
+      return ret;
+    }
+  }
+  while (offset < end) {
+    block_offset = offset & HDIMAGE_CACHE_OFFSET_MASK;
+    start = (Bit32u)(offset - block_offset);
+    len = HDIMAGE_CACHE_BLOCK_SIZE - start;
+    if ((Bit64s)len > (end - offset)) {
+      len = (Bit32u)(end - offset);
+    }
+    mask = cache_sector_mask(start, len);
+    index = lookup(block_offset);
+    if (index != HDIMAGE_CACHE_NONE) {
+      lru_touch(index);
+    } else if (!write_through) {
+      index = alloc_block(block_offset);
+    }
+    if (index != HDIMAGE_CACHE_NONE) {
+      memcpy(data + (size_t)index * HDIMAGE_CACHE_BLOCK_SIZE + start, cbuf, len);
+      blocks[index].valid |= mask;
+      if (write_through) {
+        if (blocks[index].dirty != 0) {
+          blocks[index].dirty &= ~mask;
+          if (blocks[index].dirty == 0) dirty_blocks--;
+        }
+      } else {
+        if (blocks[index].dirty == 0) dirty_blocks++;
+        blocks[index].dirty |= mask;
+      }
+    }
+    stat_writes++;
+    cbuf += len;
+    offset += len;
+  }
+  if ((dirty_blocks > writeback_blocks) && !write_dirty()) {
+    return -1;
+  }
+  return count;
+}
+
+// the image may buffer data itself
+bool cached_image_t::flush_cache()
+{
+  bool ret = write_dirty();
+
+  return image->flush_cache() && ret;
+}
+
+bool cached_image_t::set_write_cache(bool enable)
+{
+  if (writeback_limit == 0) {
+    return 0;
+  }
+  if (enable) {
+    writeback_blocks = writeback_limit;
+  } else {
+    // no modified data must be left in the cache
+    if (!flush_cache()) return 0;
+    writeback_blocks = 0;
+  }
+  return 1;
+}
+
+bool cached_image_t::get_write_cache()
+{
+  return (writeback_blocks > 0);
+}
+
+Bit32u cached_image_t::get_capabilities()
+{
+  Bit32u caps = image->get_capabilities();
+
+  if (writeback_limit > 0) {
+    caps |= HDIMAGE_WRITE_CACHE;
+  }
+  return caps;
+}
+
+Bit32u cached_image_t::get_timestamp()
+{
+  return image->get_timestamp();
+}
+
+bool cached_image_t::save_state(const char *backup_fname)
+{
+  if (!flush_cache()) return 0;
+  return image->save_state(backup_fname);
+}
+
+void cached_image_t::restore_state(const char *backup_fname)
+{
+  Bit32u i;
+
+  // the cached data is replaced by the restored image
+  for (i = 0; i < nblocks; i++) {
+    if (blocks[i].offset >= 0) {
+      invalidate(blocks[i].offset, blocks[i].offset + 1);
+    }
+  }
+  dirty_blocks = 0;
+  last_read_end = -1;
+  image->restore_state(backup_fname);
+}
+
+#endif
@@ -30,6 +30,7 @@
 #define HDIMAGE_READONLY      1
 #define HDIMAGE_HAS_GEOMETRY  2
 #define HDIMAGE_AUTO_GEOMETRY 4
+#define HDIMAGE_WRITE_CACHE   8
 
 // hdimage format check return values
 #define HDIMAGE_FORMAT_OK      0
@@ -163,6 +164,37 @@ Bit16u fat_datetime(time_t time, int return_time);
 Bit16u BOCHSAPI_MSVCONLY fat_datetime(FILETIME time, int return_time);
 #endif
 
+#ifndef BXIMAGE
+// Asynchronous request to a disk image. The request is executed by a worker
+// thread with the synchronous read_at() / write_at() functions of the
+// image and the completion callback is called later from the emulation
+// thread. The image must not be accessed until the request has completed.
+// The state of a new request structure must be HDIMAGE_AIO_IDLE.
+#define HDIMAGE_AIO_READ  0
+#define HDIMAGE_AIO_WRITE 1
+
+#define HDIMAGE_AIO_IDLE    0
+#define HDIMAGE_AIO_QUEUED  1
+#define HDIMAGE_AIO_RUNNING 2
+#define HDIMAGE_AIO_DONE    3
+
+typedef struct hdimage_aio_request hdimage_aio_request_t;
+typedef void (*hdimage_aio_complete_t)(hdimage_aio_request_t *req);
+
+struct hdimage_aio_request {
+  device_image_t *image;
+  unsigned op;
+  Bit64s offset;
+  void *buf;
+  size_t count;
+  hdimage_aio_complete_t complete;
+  void *param;
+  ssize_t result;          // set on completion
+  unsigned state;
+  hdimage_aio_request_t *next;
+};
+#endif
+
 // base class
 class BOCHSAPI_MSVCONLY device_image_t
 {
@@ -192,12 +224,34 @@ class BOCHSAPI_MSVCONLY device_image_t
       // written (count).
       virtual ssize_t write(const void* buf, size_t count) = 0;
 
+      // Read count bytes at byte offset 'offset' of the image to the
+      // buffer buf. Return the number of bytes read (count). The default
+      // implementation positions the image with lseek() first, images
+      // on a host file override it with positional I/O that doesn't change
+      // the current position.
+      virtual ssize_t read_at(Bit64s offset, void* buf, size_t count);
+
+      // Write count bytes from buf at byte offset 'offset' of the image.
+      // Return the number of bytes written (count).
+      virtual ssize_t write_at(Bit64s offset, const void* buf, size_t count);
+
       // Get image capabilities
       virtual Bit32u get_capabilities();
 
       // Get modification time in FAT format
       virtual Bit32u get_timestamp();
 
+      // Write data buffered by the image to the underlying file(s).
+      // Returns false on error.
+      virtual bool flush_cache() {return 1;}
+
+      // Enable or disable holding written data in a volatile cache (images
+      // with the HDIMAGE_WRITE_CACHE capability). Returns false on error.
+      virtual bool set_write_cache(bool enable) {return 0;}
+
+      // Returns true if written data is held in a volatile cache
+      virtual bool get_write_cache() {return 0;}
+
       // Check image format
       static int check_format(int fd, Bit64u imgsize) {return HDIMAGE_NO_SIGNATURE;}
 
@@ -209,6 +263,11 @@ class BOCHSAPI_MSVCONLY device_image_t
       virtual void register_state(bx_list_c *parent);
       virtual bool save_state(const char *backup_fname) {return 0;}
       virtual void restore_state(const char *backup_fname) {}
+
+      // Start an asynchronous request (see hdimage_aio_request_t). Returns
+      // false if the request cannot be started, the caller then has to use
+      // the synchronous functions.
+      virtual bool aio_submit(hdimage_aio_request_t *req);
 #endif
 
       unsigned cylinders;
@@ -246,6 +305,10 @@ class flat_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Positional read / write
+      ssize_t read_at(Bit64s offset, void* buf, size_t count);
+      ssize_t write_at(Bit64s offset, const void* buf, size_t count);
+
       // Check image format
       static int check_format(int fd, Bit64u imgsize);
 
@@ -285,6 +348,10 @@ class concat_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Positional read / write
+      ssize_t read_at(Bit64s offset, void* buf, size_t count);
+      ssize_t write_at(Bit64s offset, const void* buf, size_t count);
+
 #ifndef BXIMAGE
       // Save/restore support
       bool save_state(const char *backup_fname);
@@ -388,8 +455,6 @@ class sparse_image_t : public device_image_t
     Bit32u position_physical_page;
     Bit32u position_page_offset;
 
-    Bit64s underlying_current_filepos;
-
     Bit64s total_size;
 
     void panic(const char * message);
@@ -548,6 +613,10 @@ class undoable_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Positional read, sectors not found in the redolog are read from
+      // the base disk at their own offset
+      ssize_t read_at(Bit64s offset, void* buf, size_t count);
+
       // Get image capabilities
       virtual Bit32u get_capabilities() {return caps;}
 
@@ -560,6 +629,7 @@ class undoable_image_t : public device_image_t
   private:
       redolog_t       *redolog;       // Redolog instance
       device_image_t  *ro_disk;       // Read-only base disk instance
+      Bit64s          cur_offset;     // Current position for read() / write()
       char            *redolog_name;  // Redolog name
       Bit32u          caps;
 };
@@ -591,6 +661,10 @@ class volatile_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Positional read, sectors not found in the redolog are read from
+      // the base disk at their own offset
+      ssize_t read_at(Bit64s offset, void* buf, size_t count);
+
       // Get image capabilities
       virtual Bit32u get_capabilities() {return caps;}
 
@@ -603,6 +677,7 @@ class volatile_image_t : public device_image_t
   private:
       redolog_t       *redolog;       // Redolog instance
       device_image_t  *ro_disk;       // Read-only base disk instance
+      Bit64s          cur_offset;     // Current position for read() / write()
       char            *redolog_name;  // Redolog name
       char            *redolog_temp;  // Redolog temporary file name
       Bit32u          caps;
@@ -611,8 +686,115 @@ class volatile_image_t : public device_image_t
 
 #ifndef BXIMAGE
 
+// BLOCK CACHE
+// Wraps an image of any mode. Data is cached in blocks of 4 KB that are
+// replaced in least recently used order. Sequential reads fetch the
+// following blocks in advance. Writes are held in the cache until the
+// amount of modified data exceeds the write-back limit, the image is
+// flushed or the block is replaced (with a limit of 0 the cache is
+// write-through).
+#define HDIMAGE_CACHE_BLOCK_SIZE   4096
+#define HDIMAGE_CACHE_MAX_IO       (256 * 1024) // largest single image access
+
+class cached_image_t : public device_image_t
+{
+  public:
+      // The cache takes ownership of 'image', sizes are in bytes
+      cached_image_t(device_image_t *image, Bit32u cache_size, Bit32u readahead,
+                     Bit32u writeback);
+      virtual ~cached_image_t();
+
+      // Open an image with specific flags. Returns non-negative if successful.
+      int open(const char* pathname, int flags);
+
+      // Close the image.
+      void close();
+
+      // Position ourselves. Return the resulting offset from the
+      // beginning of the file.
+      Bit64s lseek(Bit64s offset, int whence);
+
+      // Read count bytes to the buffer buf. Return the number of
+      // bytes read (count).
+      ssize_t read(void* buf, size_t count);
+
+      // Write count bytes from buf. Return the number of bytes
+      // written (count).
+      ssize_t write(const void* buf, size_t count);
+
+      // Positional read / write
+      ssize_t read_at(Bit64s offset, void* buf, size_t count);
+      ssize_t write_at(Bit64s offset, const void* buf, size_t count);
+
+      // Get image capabilities
+      Bit32u get_capabilities();
+
+      // Get modification time in FAT format
+      Bit32u get_timestamp();
+
+      // Write all modified blocks, then flush the buffers of the image
+      bool flush_cache();
+
+      // Switch between write-back and write-through mode
+      bool set_write_cache(bool enable);
+      bool get_write_cache();
+
+      // Save/restore support
+      bool save_state(const char *backup_fname);
+      void restore_state(const char *backup_fname);
+
+  private:
+      Bit32u lookup(Bit64s offset);
+      Bit32u alloc_block(Bit64s offset);
+      void lru_unlink(Bit32u index);
+      void lru_touch(Bit32u index);
+      void hash_remove(Bit32u index);
+      Bit8u block_mask(Bit64s offset);
+      Bit64s fill(Bit64s offset, Bit64s req_end, bool sequential);
+      bool write_back(Bit32u index);
+      bool write_dirty();
+      bool write_run(Bit64s offset, const Bit8u *buf, Bit32u len);
+      void invalidate(Bit64s offset, Bit64s end);
+
+      device_image_t *image;
+      const char *pathname;
+      Bit64s cur_offset;
+      Bit64s last_read_end;   // used to detect sequential reads
+
+      typedef struct {
+        Bit64s offset;        // image offset of the block, -1 if unused
+        Bit32u prev, next;    // LRU list, most recently used first
+        Bit32u hash_next;
+        Bit8u  valid;         // one bit per 512 byte sector
+        Bit8u  dirty;
+      } cache_block_t;
+
+      Bit32u nblocks;
+      cache_block_t *blocks;
+      Bit8u *data;
+      Bit32u *hash_table;
+      Bit32u hash_mask;
+      Bit32u lru_head, lru_tail;
+      Bit64s *flush_list;
+      Bit8u *io_buf;
+
+      Bit32u readahead_blocks;
+      Bit32u writeback_blocks;
+      Bit32u writeback_limit; // configured write-back size
+      Bit32u dirty_blocks;
+
+      // statistics, reported in the log when the image is closed
+      Bit64u stat_read_hits;
+      Bit64u stat_read_misses;
+      Bit64u stat_readahead;
+      Bit64u stat_writes;
+      Bit64u stat_written_back;
+      Bit64u stat_flushes;
+};
+
 #define DEV_hdimage_init_image(a,b,c) bx_hdimage_ctl.init_image(a,b,c)
 #define DEV_hdimage_init_cdrom(a)     bx_hdimage_ctl.init_cdrom(a)
+#define DEV_hdimage_init_cache(a)     bx_hdimage_ctl.init_cache(a)
 
 class BOCHSAPI bx_hdimage_ctl_c : public logfunctions {
 public:
@@ -625,6 +807,25 @@ public:
   void exit(void);
   device_image_t *init_image(const char *image_mode, Bit64u disk_size, const char *journal);
   cdrom_base_c *init_cdrom(const char *dev);
+  device_image_t *init_cache(device_image_t *image);
+
+  // asynchronous disk image requests
+  bool aio_submit(hdimage_aio_request_t *req);
+  void aio_wait(hdimage_aio_request_t *req);
+  void aio_cancel(hdimage_aio_request_t *req);
+  void aio_flush(void);
+  void aio_stop(void);
+
+private:
+  static void aio_timer_handler(void *this_ptr);
+  void aio_timer(void);
+  void aio_start(void);
+  bool aio_wait_done(hdimage_aio_request_t *req);
+  void aio_deliver(hdimage_aio_request_t *req);
+
+  unsigned aio_threads;    // number of worker threads, 0 if not started
+  unsigned aio_inflight;   // submitted requests not yet delivered
+  int aio_timer_index;
 };
 
 BOCHSAPI extern bx_hdimage_ctl_c bx_hdimage_ctl;
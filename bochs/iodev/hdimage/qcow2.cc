@@ -0,0 +1,845 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (C) 2026  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+// QEMU copy-on-write disk image support (qcow2 version 2 and 3)
+//
+// The guest disk is split into clusters (64k by default). A two-level table
+// maps guest clusters to clusters of the image file: the L1 table is kept in
+// memory, the L2 tables are loaded on demand into a small LRU cache. Clusters
+// not allocated in the image are read from the backing file (if any) or
+// return zeros. Compressed clusters (deflate) can be read if Bochs is built
+// with zlib, writing to a compressed or unallocated cluster allocates a new
+// cluster at the end of the image file.
+//
+// Limitations: encrypted images and images with an external data file are
+// not supported. Images with internal snapshots and images with a refcount
+// width other than 16 bits can only be opened read-only (e.g. as the base of
+// an undoable disk). Clusters replaced by a write are not freed, 'qemu-img
+// check -r leaks' can be used to reclaim them.
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#ifdef BXIMAGE
+#include "config.h"
+#include "misc/bxcompat.h"
+#include "osdep.h"
+#include "misc/bswap.h"
+#else
+#include "bochs.h"
+#include "plugin.h"
+#endif
+#include "hdimage.h"
+#include "qcow2.h"
+
+#if BX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define LOG_THIS bx_hdimage_ctl.
+
+#ifndef BXIMAGE
+
+// disk image plugin entry point
+
+PLUGIN_ENTRY_FOR_IMG_MODULE(qcow2)
+{
+  if (mode == PLUGIN_PROBE) {
+    return (int)PLUGTYPE_IMG;
+  }
+  return 0; // Success
+}
+
+#endif
+
+//
+// Define the static class that registers the derived device image class,
+// and allocates one on request.
+//
+class bx_qcow2_locator_c : public hdimage_locator_c {
+public:
+  bx_qcow2_locator_c(void) : hdimage_locator_c("qcow2") {}
+protected:
+  device_image_t *allocate(Bit64u disk_size, const char *journal) {
+    return (new qcow2_image_t());
+  }
+  int check_format(int fd, Bit64u disk_size) {
+    return (qcow2_image_t::check_format(fd, disk_size));
+  }
+} bx_qcow2_match;
+
+qcow2_image_t::qcow2_image_t()
+  : fd(-1),
+  pathname(NULL),
+  cur_offset(0),
+  chain_depth(0),
+  l1_table(NULL),
+  refcount_table(NULL),
+  l2_cache_counter(0),
+  cluster_buf(NULL),
+  compressed_buf(NULL),
+  decompressed_buf(NULL),
+  backing(NULL),
+  backing_path(NULL)
+{
+  memset(l2_cache, 0, sizeof(l2_cache));
+}
+
+qcow2_image_t::~qcow2_image_t()
+{
+  close();
+}
+
+int qcow2_image_t::check_format(int fd, Bit64u imgsize)
+{
+  qcow2_header_t header;
+
+  if (imgsize < QCOW2_HEADER_V2_SIZE) {
+    return HDIMAGE_NO_SIGNATURE;
+  }
+  if (bx_read_image(fd, 0, &header, QCOW2_HEADER_V2_SIZE) != QCOW2_HEADER_V2_SIZE) {
+    return HDIMAGE_READ_ERROR;
+  }
+  if (qcow2_be32(header.magic) != QCOW2_MAGIC) {
+    return HDIMAGE_NO_SIGNATURE;
+  }
+  if ((qcow2_be32(header.version) != 2) && (qcow2_be32(header.version) != 3)) {
+    return HDIMAGE_VERSION_ERROR;
+  }
+  return HDIMAGE_FORMAT_OK;
+}
+
+int qcow2_image_t::open(const char* _pathname, int flags)
+{
+  qcow2_header_t header;
+  Bit64u imgsize = 0, l1_needed, refcount_bytes;
+  Bit32u version, i;
+  bool read_only = ((flags & O_ACCMODE) == O_RDONLY);
+  char *backing_name;
+
+  pathname = _pathname;
+  if ((fd = hdimage_open_file(pathname, flags, &imgsize, &mtime)) < 0) {
+    BX_ERROR(("QCOW2: cannot open hdimage file '%s'", pathname));
+    return -1;
+  }
+
+  switch (check_format(fd, imgsize)) {
+    case HDIMAGE_READ_ERROR:
+      BX_ERROR(("QCOW2: cannot read image file header of '%s'", pathname));
+      close();
+      return -1;
+    case HDIMAGE_NO_SIGNATURE:
+      BX_ERROR(("QCOW2: signature missed in file '%s'", pathname));
+      close();
+      return -1;
+    case HDIMAGE_VERSION_ERROR:
+      BX_ERROR(("QCOW2: unsupported version in file '%s'", pathname));
+      close();
+      return -1;
+  }
+
+  memset(&header, 0, sizeof(header));
+  version = 2;
+  bx_read_image(fd, 0, &header, QCOW2_HEADER_V2_SIZE);
+  if (qcow2_be32(header.version) == 3) {
+    if (bx_read_image(fd, 0, &header, QCOW2_HEADER_V3_SIZE) != QCOW2_HEADER_V3_SIZE) {
+      BX_ERROR(("QCOW2: cannot read image file header of '%s'", pathname));
+      close();
+      return -1;
+    }
+    version = 3;
+  } else {
+    header.refcount_order = qcow2_be32(4);
+  }
+
+  cluster_bits = qcow2_be32(header.cluster_bits);
+  if ((cluster_bits < QCOW2_MIN_CLUSTER_BITS) || (cluster_bits > QCOW2_MAX_CLUSTER_BITS)) {
+    BX_ERROR(("QCOW2: unsupported cluster size (%d bits)", cluster_bits));
+    close();
+    return -1;
+  }
+  if (qcow2_be32(header.crypt_method) != 0) {
+    BX_ERROR(("QCOW2: encrypted images are not supported"));
+    close();
+    return -1;
+  }
+  if (qcow2_be64(header.incompatible_features) & ~(Bit64u)QCOW2_INCOMPAT_DIRTY) {
+    BX_ERROR(("QCOW2: unsupported incompatible features 0x" FMT_LL "x",
+              qcow2_be64(header.incompatible_features)));
+    close();
+    return -1;
+  }
+  if (!read_only) {
+    if (qcow2_be32(header.nb_snapshots) != 0) {
+      BX_ERROR(("QCOW2: images with internal snapshots can only be opened read-only"));
+      close();
+      return -1;
+    }
+    if (qcow2_be32(header.refcount_order) != 4) {
+      BX_ERROR(("QCOW2: images with %d bit refcounts can only be opened read-only",
+                1 << qcow2_be32(header.refcount_order)));
+      close();
+      return -1;
+    }
+  }
+
+  cluster_size = 1 << cluster_bits;
+  l2_bits = cluster_bits - 3;
+  hd_size = qcow2_be64(header.size);
+  sect_size = 512;
+  l1_size = qcow2_be32(header.l1_size);
+  l1_table_offset = qcow2_be64(header.l1_table_offset);
+  l1_needed = (hd_size + ((Bit64u)1 << (cluster_bits + l2_bits)) - 1) >> (cluster_bits + l2_bits);
+  if ((l1_size < l1_needed) || (l1_size > 0x2000000)) {
+    BX_ERROR(("QCOW2: invalid L1 table size %d", l1_size));
+    close();
+    return -1;
+  }
+  l1_table = new Bit64u[l1_size];
+  if (bx_read_image(fd, l1_table_offset, l1_table, l1_size * 8) != (int)(l1_size * 8)) {
+    BX_ERROR(("QCOW2: cannot read L1 table of '%s'", pathname));
+    close();
+    return -1;
+  }
+  for (i = 0; i < l1_size; i++) {
+    l1_table[i] = qcow2_be64(l1_table[i]);
+  }
+
+  refcount_table_offset = qcow2_be64(header.refcount_table_offset);
+  refcount_bytes = (Bit64u)qcow2_be32(header.refcount_table_clusters) << cluster_bits;
+  if ((refcount_bytes == 0) || (refcount_bytes > 0x10000000) || (refcount_bytes > imgsize) ||
+      (refcount_table_offset > (imgsize - refcount_bytes))) {
+    BX_ERROR(("QCOW2: invalid refcount table size %d clusters", qcow2_be32(header.refcount_table_clusters)));
+    close();
+    return -1;
+  }
+  refcount_table_size = (Bit32u)(refcount_bytes >> 3);
+  if (!read_only) {
+    refcount_table = new Bit64u[refcount_table_size];
+    if (bx_read_image(fd, refcount_table_offset, refcount_table, refcount_table_size * 8) !=
+        (int)(refcount_table_size * 8)) {
+      BX_ERROR(("QCOW2: cannot read refcount table of '%s'", pathname));
+      close();
+      return -1;
+    }
+    for (i = 0; i < refcount_table_size; i++) {
+      refcount_table[i] = qcow2_be64(refcount_table[i]);
+    }
+    // features we don't know about must be marked invalid when writing
+    if ((version == 3) && (header.autoclear_features != 0)) {
+      Bit64u autoclear = 0;
+      bx_write_image(fd, offsetof(qcow2_header_t, autoclear_features), &autoclear, 8);
+    }
+  }
+  next_free_offset = (imgsize + cluster_size - 1) & ~((Bit64u)cluster_size - 1);
+
+  for (i = 0; i < QCOW2_L2_CACHE_SIZE; i++) {
+    l2_cache[i].offset = 0;
+    l2_cache[i].lru = 0;
+    l2_cache[i].table = new Bit64u[1 << l2_bits];
+  }
+  cluster_buf = new Bit8u[cluster_size];
+  compressed_buf = new Bit8u[2 * cluster_size];
+  decompressed_buf = new Bit8u[cluster_size];
+  decompressed_offset = 0;
+
+  if (header.backing_file_offset != 0) {
+    Bit32u len = qcow2_be32(header.backing_file_size);
+    if ((len == 0) || (len > 1023)) {
+      BX_ERROR(("QCOW2: invalid backing file name length %d", len));
+      close();
+      return -1;
+    }
+    backing_name = new char[len + 1];
+    if (bx_read_image(fd, qcow2_be64(header.backing_file_offset), backing_name, len) != (int)len) {
+      BX_ERROR(("QCOW2: cannot read backing file name of '%s'", pathname));
+      delete [] backing_name;
+      close();
+      return -1;
+    }
+    backing_name[len] = 0;
+    if (!open_backing_file(backing_name)) {
+      delete [] backing_name;
+      close();
+      return -1;
+    }
+    delete [] backing_name;
+  }
+  cur_offset = 0;
+
+  BX_INFO(("'qcow2' disk image opened: path is '%s', version %d, cluster size %d",
+           pathname, version, cluster_size));
+  return 0;
+}
+
+void qcow2_image_t::close()
+{
+  if (backing != NULL) {
+    backing->close();
+    delete backing;
+    backing = NULL;
+  }
+  delete [] backing_path;
+  backing_path = NULL;
+  for (int i = 0; i < QCOW2_L2_CACHE_SIZE; i++) {
+    delete [] l2_cache[i].table;
+    l2_cache[i].table = NULL;
+    l2_cache[i].offset = 0;
+  }
+  delete [] l1_table;
+  l1_table = NULL;
+  delete [] refcount_table;
+  refcount_table = NULL;
+  delete [] cluster_buf;
+  cluster_buf = NULL;
+  delete [] compressed_buf;
+  compressed_buf = NULL;
+  delete [] decompressed_buf;
+  decompressed_buf = NULL;
+  if (fd > -1) {
+    bx_close_image(fd, pathname);
+    fd = -1;
+  }
+}
+
+// The backing file name is relative to the directory of the image. The
+// backing file is either another qcow2 image or a raw (flat) image.
+bool qcow2_image_t::open_backing_file(const char *name)
+{
+  char *path;
+  const char *sep;
+  Bit64u size = 0;
+  int bfd;
+
+  if (chain_depth >= QCOW2_MAX_BACKING_DEPTH) {
+    BX_ERROR(("QCOW2: backing file chain of '%s' is too long", pathname));
+    return false;
+  }
+  sep = strrchr(pathname, '/');
+#ifdef WIN32
+  const char *sep2 = strrchr(pathname, '\\');
+  if ((sep2 != NULL) && ((sep == NULL) || (sep2 > sep))) sep = sep2;
+  bool absolute = (name[0] == '/') || (name[0] == '\\') || ((name[0] != 0) && (name[1] == ':'));
+#else
+  bool absolute = (name[0] == '/');
+#endif
+  if (absolute || (sep == NULL)) {
+    path = new char[strlen(name) + 1];
+    strcpy(path, name);
+  } else {
+    path = new char[(sep - pathname + 1) + strlen(name) + 1];
+    sprintf(path, "%.*s%s", (int)(sep - pathname + 1), pathname, name);
+  }
+  backing_path = path;
+
+  if ((bfd = hdimage_open_file(path, O_RDONLY, &size, NULL)) < 0) {
+    BX_ERROR(("QCOW2: cannot open backing file '%s'", path));
+    return false;
+  }
+  if (check_format(bfd, size) == HDIMAGE_FORMAT_OK) {
+    qcow2_image_t *image = new qcow2_image_t();
+    image->chain_depth = chain_depth + 1;
+    backing = image;
+  } else {
+    backing = new flat_image_t();
+  }
+  ::close(bfd);
+  if (backing->open(path, O_RDONLY) < 0) {
+    BX_ERROR(("QCOW2: cannot open backing file '%s'", path));
+    delete backing;
+    backing = NULL;
+    return false;
+  }
+  BX_INFO(("QCOW2: using backing file '%s'", path));
+  return true;
+}
+
+Bit64s qcow2_image_t::lseek(Bit64s offset, int whence)
+{
+  if (whence == SEEK_SET) {
+    cur_offset = offset;
+  } else if (whence == SEEK_CUR) {
+    cur_offset += offset;
+  } else {
+    BX_ERROR(("lseek: mode not supported yet"));
+    return -1;
+  }
+  if ((cur_offset < 0) || ((Bit64u)cur_offset > hd_size))
+    return -1;
+  return cur_offset;
+}
+
+ssize_t qcow2_image_t::read(void* buf, size_t count)
+{
+  ssize_t ret = read_at(cur_offset, buf, count);
+  if (ret > 0) {
+    cur_offset += ret;
+  }
+  return ret;
+}
+
+ssize_t qcow2_image_t::write(const void* buf, size_t count)
+{
+  ssize_t ret = write_at(cur_offset, buf, count);
+  if (ret > 0) {
+    cur_offset += ret;
+  }
+  return ret;
+}
+
+ssize_t qcow2_image_t::read_at(Bit64s offset, void* buf, size_t count)
+{
+  char *cbuf = (char*)buf;
+  size_t total = count, n;
+  Bit32u in_cluster;
+  Bit64u l2_entry, next, host;
+
+  if ((offset < 0) || ((Bit64u)offset + count > hd_size)) {
+    return -1;
+  }
+  while (count > 0) {
+    in_cluster = (Bit32u)(offset & (cluster_size - 1));
+    n = cluster_size - in_cluster;
+    if (n > count) n = count;
+    if (!get_l2_entry(offset, &l2_entry)) {
+      return -1;
+    }
+    if (l2_entry & QCOW2_OFLAG_COMPRESSED) {
+      if (!read_compressed_cluster(l2_entry)) {
+        return -1;
+      }
+      memcpy(cbuf, decompressed_buf + in_cluster, n);
+    } else if (l2_entry & QCOW2_OFLAG_ZERO) {
+      memset(cbuf, 0, n);
+    } else if ((l2_entry & QCOW2_OFFSET_MASK) == 0) {
+      if (!read_backing(offset, cbuf, n)) {
+        return -1;
+      }
+    } else {
+      // merge the following clusters if they are contiguous in the image file
+      host = (l2_entry & QCOW2_OFFSET_MASK) + in_cluster;
+      while (n < count) {
+        if (!get_l2_entry(offset + n, &next)) {
+          return -1;
+        }
+        if ((next & (QCOW2_OFLAG_COMPRESSED | QCOW2_OFLAG_ZERO)) ||
+            ((next & QCOW2_OFFSET_MASK) != host + n)) {
+          break;
+        }
+        n += (count - n > cluster_size) ? cluster_size : count - n;
+      }
+      if (bx_read_image(fd, host, cbuf, (int)n) != (int)n) {
+        return -1;
+      }
+    }
+    offset += n;
+    cbuf += n;
+    count -= n;
+  }
+  return total;
+}
+
+ssize_t qcow2_image_t::write_at(Bit64s offset, const void* buf, size_t count)
+{
+  char *cbuf = (char*)buf;
+  size_t total = count, n;
+  Bit32u in_cluster;
+  Bit64u l2_entry, next, host;
+
+  if ((offset < 0) || ((Bit64u)offset + count > hd_size) || (refcount_table == NULL)) {
+    return -1;
+  }
+  while (count > 0) {
+    in_cluster = (Bit32u)(offset & (cluster_size - 1));
+    n = cluster_size - in_cluster;
+    if (n > count) n = count;
+    if (!get_l2_entry(offset, &l2_entry)) {
+      return -1;
+    }
+    if (((l2_entry & (QCOW2_OFLAG_COPIED | QCOW2_OFLAG_COMPRESSED | QCOW2_OFLAG_ZERO)) == QCOW2_OFLAG_COPIED) &&
+        ((l2_entry & QCOW2_OFFSET_MASK) != 0)) {
+      // cluster owned by this image: write in place, merging the following
+      // clusters if they are contiguous in the image file
+      host = (l2_entry & QCOW2_OFFSET_MASK) + in_cluster;
+      while (n < count) {
+        if (!get_l2_entry(offset + n, &next)) {
+          return -1;
+        }
+        if (((next & (QCOW2_OFLAG_COPIED | QCOW2_OFLAG_COMPRESSED | QCOW2_OFLAG_ZERO)) != QCOW2_OFLAG_COPIED) ||
+            ((next & QCOW2_OFFSET_MASK) != host + n)) {
+          break;
+        }
+        n += (count - n > cluster_size) ? cluster_size : count - n;
+      }
+      if (bx_write_image(fd, host, cbuf, (int)n) != (int)n) {
+        return -1;
+      }
+    } else if (!write_new_cluster(offset, cbuf, (Bit32u)n)) {
+      return -1;
+    }
+    offset += n;
+    cbuf += n;
+    count -= n;
+  }
+  return total;
+}
+
+bool qcow2_image_t::read_backing(Bit64u offset, void *buf, size_t count)
+{
+  size_t n = 0;
+
+  if ((backing != NULL) && (offset < backing->hd_size)) {
+    n = count;
+    if (offset + n > backing->hd_size) {
+      n = (size_t)(backing->hd_size - offset);
+    }
+    if (backing->read_at(offset, buf, n) != (ssize_t)n) {
+      return false;
+    }
+  }
+  memset((Bit8u*)buf + n, 0, count - n);
+  return true;
+}
+
+// Returns a pointer to the cached L2 table at 'l2_offset' of the image file,
+// the table is loaded into the least recently used cache entry on a miss.
+Bit64u *qcow2_image_t::l2_cache_load(Bit64u l2_offset)
+{
+  int i, victim = 0;
+
+  for (i = 0; i < QCOW2_L2_CACHE_SIZE; i++) {
+    if (l2_cache[i].offset == l2_offset) {
+      l2_cache[i].lru = ++l2_cache_counter;
+      return l2_cache[i].table;
+    }
+    if (l2_cache[i].lru < l2_cache[victim].lru) {
+      victim = i;
+    }
+  }
+  if (bx_read_image(fd, l2_offset, l2_cache[victim].table, cluster_size) != (int)cluster_size) {
+    BX_ERROR(("QCOW2: cannot read L2 table at offset 0x" FMT_LL "x", l2_offset));
+    l2_cache[victim].offset = 0;
+    l2_cache[victim].lru = 0;
+    return NULL;
+  }
+  l2_cache[victim].offset = l2_offset;
+  l2_cache[victim].lru = ++l2_cache_counter;
+  return l2_cache[victim].table;
+}
+
+// Looks up the L2 entry of the guest cluster containing 'offset', the
+// entry is 0 if there is no L2 table for this cluster.
+bool qcow2_image_t::get_l2_entry(Bit64u offset, Bit64u *l2_entry)
+{
+  Bit64u l1_index = offset >> (cluster_bits + l2_bits);
+  Bit32u l2_index = (Bit32u)(offset >> cluster_bits) & ((1 << l2_bits) - 1);
+  Bit64u l2_offset, *table;
+
+  *l2_entry = 0;
+  if (l1_index >= l1_size) {
+    return true;
+  }
+  l2_offset = l1_table[l1_index] & QCOW2_OFFSET_MASK;
+  if (l2_offset == 0) {
+    return true;
+  }
+  if ((table = l2_cache_load(l2_offset)) == NULL) {
+    return false;
+  }
+  *l2_entry = qcow2_be64(table[l2_index]);
+  return true;
+}
+
+bool qcow2_image_t::set_l2_entry(Bit64u l2_offset, Bit32u index, Bit64u l2_entry)
+{
+  Bit64u *table = l2_cache_load(l2_offset);
+
+  if (table == NULL) {
+    return false;
+  }
+  table[index] = qcow2_be64(l2_entry);
+  return (bx_write_image(fd, l2_offset + index * 8, &table[index], 8) == 8);
+}
+
+// Returns the offset of an L2 table owned by this image for the guest
+// cluster containing 'offset'. A missing table is allocated, a shared one
+// is copied.
+bool qcow2_image_t::get_l2_table_for_write(Bit64u offset, Bit64u *l2_offset)
+{
+  Bit64u l1_index = offset >> (cluster_bits + l2_bits);
+  Bit64u l1_entry = l1_table[l1_index];
+  Bit64u old_offset = l1_entry & QCOW2_OFFSET_MASK, new_offset, *table;
+
+  if ((old_offset != 0) && (l1_entry & QCOW2_OFLAG_COPIED)) {
+    *l2_offset = old_offset;
+    return true;
+  }
+  if (old_offset != 0) {
+    if ((table = l2_cache_load(old_offset)) == NULL) {
+      return false;
+    }
+    memcpy(cluster_buf, table, cluster_size);
+  } else {
+    memset(cluster_buf, 0, cluster_size);
+  }
+  if ((new_offset = alloc_clusters(1)) == 0) {
+    return false;
+  }
+  if (bx_write_image(fd, new_offset, cluster_buf, cluster_size) != (int)cluster_size) {
+    return false;
+  }
+  l1_table[l1_index] = new_offset | QCOW2_OFLAG_COPIED;
+  l1_entry = qcow2_be64(l1_table[l1_index]);
+  if (bx_write_image(fd, l1_table_offset + l1_index * 8, &l1_entry, 8) != 8) {
+    return false;
+  }
+  *l2_offset = new_offset;
+  return true;
+}
+
+// Writes 'count' bytes at guest 'offset' to a newly allocated cluster. The
+// rest of the cluster is filled with the current contents (backing file,
+// compressed data or zeros).
+bool qcow2_image_t::write_new_cluster(Bit64u offset, const void *buf, Bit32u count)
+{
+  Bit64u cluster_start = offset & ~((Bit64u)cluster_size - 1);
+  Bit32u in_cluster = (Bit32u)(offset - cluster_start);
+  Bit32u l2_index = (Bit32u)(offset >> cluster_bits) & ((1 << l2_bits) - 1);
+  Bit64u l2_offset, host;
+  size_t n;
+  const void *data = buf;
+
+  if (!get_l2_table_for_write(offset, &l2_offset)) {
+    return false;
+  }
+  if (count < cluster_size) {
+    n = cluster_size;
+    if (cluster_start + n > hd_size) {
+      n = (size_t)(hd_size - cluster_start);
+    }
+    memset(cluster_buf, 0, cluster_size);
+    if (read_at(cluster_start, cluster_buf, n) != (ssize_t)n) {
+      return false;
+    }
+    memcpy(cluster_buf + in_cluster, buf, count);
+    data = cluster_buf;
+  }
+  if ((host = alloc_clusters(1)) == 0) {
+    return false;
+  }
+  if (bx_write_image(fd, host, (void*)data, cluster_size) != (int)cluster_size) {
+    return false;
+  }
+  return set_l2_entry(l2_offset, l2_index, host | QCOW2_OFLAG_COPIED);
+}
+
+bool qcow2_image_t::read_compressed_cluster(Bit64u l2_entry)
+{
+  Bit32u x = 62 - (cluster_bits - 8);
+  Bit64u coffset = l2_entry & (((Bit64u)1 << x) - 1);
+  Bit32u nb_sectors = (Bit32u)((l2_entry >> x) & ((1 << (cluster_bits - 8)) - 1)) + 1;
+  int csize = nb_sectors * 512 - (int)(coffset & 511);
+
+  if (coffset == decompressed_offset) {
+    return true;
+  }
+#if BX_HAVE_ZLIB
+  z_stream strm;
+  int ret;
+
+  // the compressed data may end before the last sector of the image file
+  ret = bx_read_image(fd, coffset, compressed_buf, csize);
+  if (ret <= 0) {
+    BX_ERROR(("QCOW2: cannot read compressed cluster at offset 0x" FMT_LL "x", coffset));
+    return false;
+  }
+  memset(&strm, 0, sizeof(strm));
+  strm.next_in = compressed_buf;
+  strm.avail_in = ret;
+  strm.next_out = decompressed_buf;
+  strm.avail_out = cluster_size;
+  if (inflateInit2(&strm, -12) != Z_OK) {
+    return false;
+  }
+  ret = inflate(&strm, Z_FINISH);
+  inflateEnd(&strm);
+  if (((ret != Z_STREAM_END) && (ret != Z_BUF_ERROR)) || (strm.avail_out != 0)) {
+    BX_ERROR(("QCOW2: cannot decompress cluster at offset 0x" FMT_LL "x", coffset));
+    decompressed_offset = 0;
+    return false;
+  }
+  decompressed_offset = coffset;
+  return true;
+#else
+  BX_ERROR(("QCOW2: compressed clusters not supported (Bochs built without zlib)"));
+  return false;
+#endif
+}
+
+// Allocates 'count' clusters at the end of the image file and sets their
+// refcounts. Returns the offset of the first cluster or 0 on error.
+Bit64u qcow2_image_t::alloc_clusters(unsigned count)
+{
+  Bit64u offset = next_free_offset;
+
+  next_free_offset += (Bit64u)count << cluster_bits;
+  for (unsigned i = 0; i < count; i++) {
+    if (!set_refcount(offset + ((Bit64u)i << cluster_bits), 1)) {
+      return 0;
+    }
+  }
+  return offset;
+}
+
+bool qcow2_image_t::set_refcount(Bit64u host_offset, Bit16u refcount)
+{
+  Bit64u cluster_index = host_offset >> cluster_bits;
+  Bit64u block_index = cluster_index >> (cluster_bits - 1);
+  Bit64u block, entry;
+  Bit16u value;
+
+  if (block_index >= refcount_table_size) {
+    BX_ERROR(("QCOW2: refcount table of '%s' is full", pathname));
+    return false;
+  }
+  block = refcount_table[block_index] & QCOW2_REFT_OFFSET_MASK;
+  if (block == 0) {
+    // allocate a new refcount block, it may describe its own cluster
+    Bit8u *zero = new Bit8u[cluster_size];
+    memset(zero, 0, cluster_size);
+    block = next_free_offset;
+    next_free_offset += cluster_size;
+    int ret = bx_write_image(fd, block, zero, cluster_size);
+    delete [] zero;
+    if (ret != (int)cluster_size) {
+      return false;
+    }
+    refcount_table[block_index] = block;
+    entry = qcow2_be64(block);
+    if (bx_write_image(fd, refcount_table_offset + block_index * 8, &entry, 8) != 8) {
+      return false;
+    }
+    if (!set_refcount(block, 1)) {
+      return false;
+    }
+  }
+  value = qcow2_be16(refcount);
+  return (bx_write_image(fd, block + (cluster_index & ((1 << (cluster_bits - 1)) - 1)) * 2, &value, 2) == 2);
+}
+
+#ifdef BXIMAGE
+int qcow2_image_t::create_image(const char *pathname, Bit64u size)
+{
+  qcow2_header_t header;
+  Bit32u cluster_size = 1 << QCOW2_DEFAULT_CLUSTER_BITS;
+  Bit32u l1_size, l1_clusters, i, meta_clusters;
+  Bit64u entry;
+  Bit16u refcount;
+  Bit8u *buf;
+  int fd;
+
+  // header, refcount table, refcount block and L1 table
+  l1_size = (Bit32u)((size + ((Bit64u)cluster_size << (QCOW2_DEFAULT_CLUSTER_BITS - 3)) - 1) >>
+                     (2 * QCOW2_DEFAULT_CLUSTER_BITS - 3));
+  l1_clusters = (l1_size * 8 + cluster_size - 1) / cluster_size;
+  meta_clusters = 3 + l1_clusters;
+
+  memset(&header, 0, sizeof(header));
+  header.magic = qcow2_be32(QCOW2_MAGIC);
+  header.version = qcow2_be32(3);
+  header.cluster_bits = qcow2_be32(QCOW2_DEFAULT_CLUSTER_BITS);
+  header.size = qcow2_be64(size);
+  header.l1_size = qcow2_be32(l1_size);
+  header.l1_table_offset = qcow2_be64((Bit64u)3 * cluster_size);
+  header.refcount_table_offset = qcow2_be64((Bit64u)cluster_size);
+  header.refcount_table_clusters = qcow2_be32(1);
+  header.refcount_order = qcow2_be32(4);
+  header.header_length = qcow2_be32(QCOW2_HEADER_V3_SIZE);
+
+  buf = new Bit8u[cluster_size];
+  fd = bx_create_image_file(pathname);
+  if (fd < 0)
+    BX_FATAL(("ERROR: failed to create qcow2 image file"));
+  memset(buf, 0, cluster_size);
+  memcpy(buf, &header, sizeof(header));
+  if (bx_write_image(fd, 0, buf, cluster_size) != (int)cluster_size) {
+    ::close(fd);
+    BX_FATAL(("ERROR: The disk image is not complete - could not write header!"));
+  }
+  memset(buf, 0, cluster_size);
+  entry = qcow2_be64((Bit64u)2 * cluster_size);
+  memcpy(buf, &entry, 8);
+  if (bx_write_image(fd, cluster_size, buf, cluster_size) != (int)cluster_size) {
+    ::close(fd);
+    BX_FATAL(("ERROR: The disk image is not complete - could not write refcount table!"));
+  }
+  memset(buf, 0, cluster_size);
+  refcount = qcow2_be16(1);
+  for (i = 0; i < meta_clusters; i++) {
+    memcpy(buf + i * 2, &refcount, 2);
+  }
+  if (bx_write_image(fd, 2 * cluster_size, buf, cluster_size) != (int)cluster_size) {
+    ::close(fd);
+    BX_FATAL(("ERROR: The disk image is not complete - could not write refcount block!"));
+  }
+  memset(buf, 0, cluster_size);
+  for (i = 0; i < l1_clusters; i++) {
+    if (bx_write_image(fd, (Bit64u)(3 + i) * cluster_size, buf, cluster_size) != (int)cluster_size) {
+      ::close(fd);
+      BX_FATAL(("ERROR: The disk image is not complete - could not write L1 table!"));
+    }
+  }
+  delete [] buf;
+  ::close(fd);
+  return 0;
+}
+#else
+bool qcow2_image_t::save_state(const char *backup_fname)
+{
+  return hdimage_backup_file(fd, backup_fname);
+}
+
+void qcow2_image_t::restore_state(const char *backup_fname)
+{
+  int temp_fd;
+  Bit64u imgsize;
+
+  if ((temp_fd = hdimage_open_file(backup_fname, O_RDONLY, &imgsize, NULL)) < 0) {
+    BX_PANIC(("cannot open qcow2 image backup '%s'", backup_fname));
+    return;
+  }
+  if (check_format(temp_fd, imgsize) < HDIMAGE_FORMAT_OK) {
+    ::close(temp_fd);
+    BX_PANIC(("Could not detect qcow2 image header"));
+    return;
+  }
+  ::close(temp_fd);
+  close();
+  if (!hdimage_copy_file(backup_fname, pathname)) {
+    BX_PANIC(("Failed to restore qcow2 image '%s'", pathname));
+    return;
+  }
+  device_image_t::open(pathname);
+}
+#endif
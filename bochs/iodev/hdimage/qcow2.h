@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//   Copyright (C) 2026  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+// QEMU copy-on-write disk image format version 2 and 3 (qcow2)
+
+#ifndef BX_QCOW2IMG_H
+#define BX_QCOW2IMG_H
+
+#define QCOW2_MAGIC               0x514649fb // 'Q' 'F' 'I' 0xfb
+#define QCOW2_HEADER_V2_SIZE      72
+#define QCOW2_HEADER_V3_SIZE      104
+
+#define QCOW2_MIN_CLUSTER_BITS    9
+#define QCOW2_MAX_CLUSTER_BITS    21
+#define QCOW2_DEFAULT_CLUSTER_BITS 16
+
+// L1 / L2 table entry flags and masks
+#define QCOW2_OFLAG_COPIED        BX_CONST64(0x8000000000000000)
+#define QCOW2_OFLAG_COMPRESSED    BX_CONST64(0x4000000000000000)
+#define QCOW2_OFLAG_ZERO          BX_CONST64(0x0000000000000001)
+#define QCOW2_OFFSET_MASK         BX_CONST64(0x00fffffffffffe00)
+#define QCOW2_REFT_OFFSET_MASK    BX_CONST64(0xfffffffffffffe00)
+
+// incompatible feature bits (version 3)
+#define QCOW2_INCOMPAT_DIRTY      1
+
+// number of L2 tables kept in memory
+#define QCOW2_L2_CACHE_SIZE       16
+// maximum length of a backing file chain
+#define QCOW2_MAX_BACKING_DEPTH   16
+
+// qcow2 header fields are big-endian
+#if defined (BX_LITTLE_ENDIAN)
+#define qcow2_be16(val) bx_bswap16(val)
+#define qcow2_be32(val) bx_bswap32(val)
+#define qcow2_be64(val) bx_bswap64(val)
+#else
+#define qcow2_be16(val) (val)
+#define qcow2_be32(val) (val)
+#define qcow2_be64(val) (val)
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER<1300)
+#pragma pack(push, 1)
+#elif defined(__MWERKS__) && defined(macintosh)
+#pragma options align=packed
+#endif
+
+typedef
+#if defined(_MSC_VER) && (_MSC_VER>=1300)
+__declspec(align(1))
+#endif
+struct qcow2_header_t {
+    Bit32u  magic;
+    Bit32u  version;
+    Bit64u  backing_file_offset;
+    Bit32u  backing_file_size;
+    Bit32u  cluster_bits;
+    Bit64u  size; // in bytes
+    Bit32u  crypt_method;
+    Bit32u  l1_size;
+    Bit64u  l1_table_offset;
+    Bit64u  refcount_table_offset;
+    Bit32u  refcount_table_clusters;
+    Bit32u  nb_snapshots;
+    Bit64u  snapshots_offset;
+
+    // version 3 only
+    Bit64u  incompatible_features;
+    Bit64u  compatible_features;
+    Bit64u  autoclear_features;
+    Bit32u  refcount_order;
+    Bit32u  header_length;
+}
+#if !defined(_MSC_VER)
+GCC_ATTRIBUTE((packed))
+#endif
+qcow2_header_t;
+
+#if defined(_MSC_VER) && (_MSC_VER<1300)
+#pragma pack(pop)
+#elif defined(__MWERKS__) && defined(macintosh)
+#pragma options align=reset
+#endif
+
+class qcow2_image_t : public device_image_t
+{
+  public:
+    qcow2_image_t();
+    virtual ~qcow2_image_t();
+
+    int open(const char* pathname, int flags);
+    void close();
+    Bit64s lseek(Bit64s offset, int whence);
+    ssize_t read(void* buf, size_t count);
+    ssize_t write(const void* buf, size_t count);
+    ssize_t read_at(Bit64s offset, void* buf, size_t count);
+    ssize_t write_at(Bit64s offset, const void* buf, size_t count);
+
+    static int check_format(int fd, Bit64u imgsize);
+
+#ifdef BXIMAGE
+    int create_image(const char *pathname, Bit64u size);
+#else
+    bool save_state(const char *backup_fname);
+    void restore_state(const char *backup_fname);
+#endif
+
+  private:
+    bool open_backing_file(const char *name);
+    bool read_backing(Bit64u offset, void *buf, size_t count);
+    Bit64u *l2_cache_load(Bit64u l2_offset);
+    bool get_l2_entry(Bit64u offset, Bit64u *l2_entry);
+    bool set_l2_entry(Bit64u l2_offset, Bit32u index, Bit64u l2_entry);
+    bool get_l2_table_for_write(Bit64u offset, Bit64u *l2_offset);
+    bool read_compressed_cluster(Bit64u l2_entry);
+    bool write_new_cluster(Bit64u offset, const void *buf, Bit32u count);
+    Bit64u alloc_clusters(unsigned count);
+    bool set_refcount(Bit64u host_offset, Bit16u refcount);
+
+    int fd;
+    const char *pathname;
+    Bit64s cur_offset;
+    unsigned chain_depth;
+
+    Bit32u cluster_bits;
+    Bit32u cluster_size;
+    Bit32u l2_bits;
+    Bit64u l1_table_offset;
+    Bit32u l1_size;
+    Bit64u *l1_table;         // host byte order
+    Bit64u refcount_table_offset;
+    Bit32u refcount_table_size;
+    Bit64u *refcount_table;   // host byte order
+    Bit64u next_free_offset;  // new clusters are appended to the image file
+
+    // L2 tables are cached in disk (big-endian) byte order, the least
+    // recently used entry is replaced on a miss
+    struct {
+      Bit64u offset;
+      Bit64u lru;
+      Bit64u *table;
+    } l2_cache[QCOW2_L2_CACHE_SIZE];
+    Bit64u l2_cache_counter;
+
+    Bit8u *cluster_buf;       // scratch buffer for partial cluster writes
+    Bit8u *compressed_buf;
+    Bit8u *decompressed_buf;  // last decompressed cluster
+    Bit64u decompressed_offset;
+
+    device_image_t *backing;
+    char *backing_path;
+};
+
+#endif
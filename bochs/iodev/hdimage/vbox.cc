@@ -357,6 +357,13 @@ off_t vbox_image_t::perform_seek()
   }
 }
 
+// writes the block map if it has been modified
+bool vbox_image_t::flush_cache()
+{
+  flush();
+  return 1;
+}
+
 void vbox_image_t::flush()
 {
   if (!is_dirty)
@@ -497,6 +497,12 @@ bool vmware3_image_t::sync()
     return true;
 }
 
+// writes the loaded tlb of the current COW file if it has been modified
+bool vmware3_image_t::flush_cache()
+{
+  return sync();
+}
+
 ssize_t vmware3_image_t::write(const void * buf, size_t count)
 {
   char *cbuf = (char*)buf;
@@ -43,6 +43,7 @@ class vmware3_image_t : public device_image_t
       ssize_t write(const void* buf, size_t count);
 
       Bit32u get_capabilities();
+      bool flush_cache();
       static int check_format(int fd, Bit64u imgsize);
 
 #ifndef BXIMAGE
@@ -75,6 +75,7 @@ class vmware4_image_t : public device_image_t
         ssize_t write(const void* buf, size_t count);
 
         Bit32u get_capabilities();
+        bool flush_cache();
         static int check_format(int fd, Bit64u imgsize);
 
 #ifdef BXIMAGE
@@ -100,6 +101,7 @@ class vmware4_image_t : public device_image_t
         VM4_Header header;
         Bit8u* tlb;
         off_t tlb_offset;
+        off_t tlb_file_offset;  // position of the loaded tlb in the file
         off_t current_offset;
         bool is_dirty;
         const char *pathname;
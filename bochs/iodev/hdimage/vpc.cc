@@ -300,10 +300,10 @@ ssize_t vpc_image_t::read(void* buf, size_t count)
     }
 
     if (offset == -1) {
-      memset(buf, 0, 512);
+      memset(cbuf, 0, (size_t)sectors * 512);
     } else {
       ret = bx_read_image(fd, offset, cbuf, (int)sectors * 512);
-      if (ret != 512) {
+      if (ret != sectors * 512) {
         return -1;
       }
     }
@@ -208,12 +208,21 @@ public:
   virtual bool bmdma_read_sector(Bit8u channel, Bit8u *buffer, Bit32u *sector_size) {
     STUBFUNC(HD, bmdma_read_sector); return 0;
   }
-  virtual bool bmdma_write_sector(Bit8u channel, Bit8u *buffer) {
-    STUBFUNC(HD, bmdma_write_sector); return 0;
+  virtual bool bmdma_read_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size) {
+    STUBFUNC(HD, bmdma_read_sectors); return 0;
+  }
+  virtual bool bmdma_write_sectors(Bit8u channel, Bit8u *buffer, Bit32u *size) {
+    STUBFUNC(HD, bmdma_write_sectors); return 0;
   }
   virtual void bmdma_complete(Bit8u channel) {
     STUBFUNC(HD, bmdma_complete);
   }
+  virtual bool bmdma_read_async(Bit8u channel, Bit8u *buffer, Bit32u size) {
+    return 0;
+  }
+  virtual bool bmdma_write_async(Bit8u channel, Bit8u *buffer, Bit32u size) {
+    return 0;
+  }
 };
 
 class BOCHSAPI bx_cmos_stub_c : public bx_devmodel_c {
@@ -346,6 +355,7 @@ public:
   }
   virtual void bmdma_start_transfer(Bit8u channel) {}
   virtual void bmdma_set_irq(Bit8u channel) {}
+  virtual void bmdma_aio_complete(Bit8u channel, Bit32u bytes) {}
 };
 
 class BOCHSAPI bx_acpi_ctrl_stub_c : public bx_pci_device_c {
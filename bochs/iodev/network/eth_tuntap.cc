@@ -201,7 +201,8 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
       BX_ERROR(("execute script '%s' on %s failed", script, intname));
   }
 
-  // Start the rx poll
+  // Start the rx poll, incoming packets also end the idle sleep
+  bx_pc_system.register_idle_fd(fd);
   this->rx_timer_index =
     DEV_register_timer(this, this->rx_timer_handler, 1000, 1, 1,
                        "eth_tuntap"); // continuous, active
@@ -240,6 +241,7 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
 
 bx_tuntap_pktmover_c::~bx_tuntap_pktmover_c()
 {
+  bx_pc_system.unregister_idle_fd(fd);
 #if BX_ETH_TUNTAP_LOGGING
   fclose(txlog);
   fclose(txlog_txt);
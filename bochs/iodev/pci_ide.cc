@@ -34,6 +34,7 @@
 
 #include "pci.h"
 #include "pci_ide.h"
+#include "hdimage/hdimage.h"
 
 #define LOG_THIS thePciIdeController->
 
@@ -136,6 +137,11 @@ void bx_pci_ide_c::reset(unsigned type)
     BX_PIDE_THIS s.bmdma[i].buffer_top = BX_PIDE_THIS s.bmdma[i].buffer;
     BX_PIDE_THIS s.bmdma[i].buffer_idx = BX_PIDE_THIS s.bmdma[i].buffer;
     BX_PIDE_THIS s.bmdma[i].data_ready = 0;
+    BX_PIDE_THIS s.bmdma[i].prd_done = 0;
+    BX_PIDE_THIS s.bmdma[i].aio_pending = 0;
+    BX_PIDE_THIS s.bmdma[i].aio_direct = 0;
+    BX_PIDE_THIS s.bmdma[i].aio_addr = 0;
+    BX_PIDE_THIS s.bmdma[i].aio_len = 0;
   }
 }
 
@@ -164,6 +170,7 @@ void bx_pci_ide_c::register_state(void)
     BXRS_PARAM_SPECIAL32(ctrl, buffer_idx,
        BX_PIDE_THIS param_save_handler, BX_PIDE_THIS param_restore_handler);
     BXRS_PARAM_BOOL(ctrl, data_ready, BX_PIDE_THIS s.bmdma[i].data_ready);
+    BXRS_HEX_PARAM_FIELD(ctrl, prd_done, BX_PIDE_THIS s.bmdma[i].prd_done);
   }
 }
 
@@ -234,16 +241,46 @@ void bx_pci_ide_c::bmdma_set_irq(Bit8u channel)
   }
 }
 
+// called when the asynchronous disk request started by timer() has completed
+void bx_pci_ide_c::bmdma_aio_complete(Bit8u channel, Bit32u bytes)
+{
+  if ((channel > 1) || !BX_PIDE_THIS s.bmdma[channel].aio_pending) {
+    return;
+  }
+  BX_PIDE_THIS s.bmdma[channel].aio_pending = 0;
+  if (bytes == 0) {
+    DEV_hd_bmdma_complete(channel);
+    return;
+  }
+  if (BX_PIDE_THIS s.bmdma[channel].aio_direct) {
+    // the guest may have changed the PRD table meanwhile, use the address
+    // the request was submitted with
+    if (BX_PIDE_THIS s.bmdma[channel].cmd_rwcon) {
+      if (bytes > BX_PIDE_THIS s.bmdma[channel].aio_len)
+        bytes = BX_PIDE_THIS s.bmdma[channel].aio_len;
+      BX_MEM(0)->dmaWriteDone(BX_PIDE_THIS s.bmdma[channel].aio_addr, bytes);
+    }
+    BX_PIDE_THIS s.bmdma[channel].prd_done += bytes;
+  } else if (BX_PIDE_THIS s.bmdma[channel].cmd_rwcon) {
+    BX_PIDE_THIS s.bmdma[channel].buffer_top += bytes;
+  } else {
+    BX_PIDE_THIS s.bmdma[channel].buffer_idx += bytes;
+  }
+  bx_pc_system.activate_timer(BX_PIDE_THIS s.bmdma[channel].timer_index, 1, 0);
+}
+
 void bx_pci_ide_c::timer_handler(void *this_ptr)
 {
   bx_pci_ide_c *class_ptr = (bx_pci_ide_c *) this_ptr;
   class_ptr->timer();
 }
 
+// Transfers all entries of the PRD table, the loop only stops while an
+// asynchronous disk request is pending or after an error.
 void bx_pci_ide_c::timer()
 {
   int count;
-  Bit32u size, sector_size;
+  Bit32u size;
   struct {
     Bit32u addr;
     Bit32u size;
@@ -254,60 +291,37 @@ void bx_pci_ide_c::timer()
       (BX_PIDE_THIS s.bmdma[channel].prd_current == 0)) {
     return;
   }
+  if (BX_PIDE_THIS s.bmdma[channel].aio_pending) {
+    // the transfer continues in bmdma_aio_complete()
+    return;
+  }
   if (BX_PIDE_THIS s.bmdma[channel].cmd_rwcon &&
       !BX_PIDE_THIS s.bmdma[channel].data_ready) {
     bx_pc_system.activate_timer(BX_PIDE_THIS s.bmdma[channel].timer_index, 1, 0);
     return;
   }
-  DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current, 4, (Bit8u *)&prd.addr);
-  DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current+4, 4, (Bit8u *)&prd.size);
-  size = prd.size & 0xfffe;
-  if (size == 0) {
-    size = 0x10000;
-  }
-  if (BX_PIDE_THIS s.bmdma[channel].cmd_rwcon) {
-    BX_DEBUG(("READ DMA to addr=0x%08x, size=0x%08x", prd.addr, size));
-    count = (int)(size - (BX_PIDE_THIS s.bmdma[channel].buffer_top - BX_PIDE_THIS s.bmdma[channel].buffer_idx));
-    while (count > 0) {
-      sector_size = count;
-      if (DEV_hd_bmdma_read_sector(channel, BX_PIDE_THIS s.bmdma[channel].buffer_top, &sector_size)) {
-        BX_PIDE_THIS s.bmdma[channel].buffer_top += sector_size;
-        count -= sector_size;
-      } else {
-        break;
-      }
-    };
-    if (count > 0) {
-      DEV_hd_bmdma_complete(channel);
-      return;
+  while (1) {
+    DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current, 4, (Bit8u *)&prd.addr);
+    DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current+4, 4, (Bit8u *)&prd.size);
+    size = prd.size & 0xfffe;
+    if (size == 0) {
+      size = 0x10000;
+    }
+    if (BX_PIDE_THIS s.bmdma[channel].cmd_rwcon) {
+      if (!bmdma_read_prd(channel, prd.addr, size))
+        return;
     } else {
-      DEV_MEM_WRITE_PHYSICAL_DMA(prd.addr, size, BX_PIDE_THIS s.bmdma[channel].buffer_idx);
-      BX_PIDE_THIS s.bmdma[channel].buffer_idx += size;
+      if (!bmdma_write_prd(channel, prd.addr, size))
+        return;
     }
-  } else {
-    BX_DEBUG(("WRITE DMA from addr=0x%08x, size=0x%08x", prd.addr, size));
-    DEV_MEM_READ_PHYSICAL_DMA(prd.addr, size, BX_PIDE_THIS s.bmdma[channel].buffer_top);
-    BX_PIDE_THIS s.bmdma[channel].buffer_top += size;
-    count = (int)(BX_PIDE_THIS s.bmdma[channel].buffer_top - BX_PIDE_THIS s.bmdma[channel].buffer_idx);
-    while (count > 511) {
-      if (DEV_hd_bmdma_write_sector(channel, BX_PIDE_THIS s.bmdma[channel].buffer_idx)) {
-        BX_PIDE_THIS s.bmdma[channel].buffer_idx += 512;
-        count -= 512;
-      } else {
-        break;
-      }
-    };
-    if (count >= 512) {
+    BX_PIDE_THIS s.bmdma[channel].prd_done = 0;
+    if (prd.size & 0x80000000) {
+      BX_PIDE_THIS s.bmdma[channel].status &= ~0x01;
+      BX_PIDE_THIS s.bmdma[channel].status |= 0x04;
+      BX_PIDE_THIS s.bmdma[channel].prd_current = 0;
       DEV_hd_bmdma_complete(channel);
       return;
     }
-  }
-  if (prd.size & 0x80000000) {
-    BX_PIDE_THIS s.bmdma[channel].status &= ~0x01;
-    BX_PIDE_THIS s.bmdma[channel].status |= 0x04;
-    BX_PIDE_THIS s.bmdma[channel].prd_current = 0;
-    DEV_hd_bmdma_complete(channel);
-  } else {
     // To avoid buffer overflow reset buffer pointers and copy data if necessary
     count = (int)(BX_PIDE_THIS s.bmdma[channel].buffer_top - BX_PIDE_THIS s.bmdma[channel].buffer_idx);
     if (count > 0) {
@@ -317,16 +331,134 @@ void bx_pci_ide_c::timer()
     BX_PIDE_THIS s.bmdma[channel].buffer_idx = BX_PIDE_THIS s.bmdma[channel].buffer;
     // Prepare for next PRD
     BX_PIDE_THIS s.bmdma[channel].prd_current += 8;
-    DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current, 4, (Bit8u *)&prd.addr);
-    DEV_MEM_READ_PHYSICAL(BX_PIDE_THIS s.bmdma[channel].prd_current+4, 4, (Bit8u *)&prd.size);
-    size = prd.size & 0xfffe;
-    if (size == 0) {
-      size = 0x10000;
+    if ((BX_PIDE_THIS s.bmdma[channel].prd_current & 0xffff) == 0) {
+      // the PRD table must not cross a 64K boundary, don't let a table
+      // without end of table marker block the simulation
+      bx_pc_system.activate_timer(BX_PIDE_THIS s.bmdma[channel].timer_index, 1, 0);
+      return;
     }
-    bx_pc_system.activate_timer(BX_PIDE_THIS s.bmdma[channel].timer_index, (size >> 4) | 0x10, 0);
   }
 }
 
+// Transfer the data of one PRD from the disk to memory. Whole sectors are
+// read into the guest memory directly if it is contiguous in host memory,
+// the rest goes through the bounce buffer. Returns false if the transfer
+// was suspended for an asynchronous request or has been aborted.
+bool bx_pci_ide_c::bmdma_read_prd(Bit8u channel, Bit32u addr, Bit32u size)
+{
+  int count;
+  Bit32u len, sector_size;
+  Bit8u *host;
+
+  BX_DEBUG(("READ DMA to addr=0x%08x, size=0x%08x", addr, size));
+  if ((BX_PIDE_THIS s.bmdma[channel].prd_done < size) &&
+      (BX_PIDE_THIS s.bmdma[channel].buffer_top == BX_PIDE_THIS s.bmdma[channel].buffer_idx)) {
+    len = size - BX_PIDE_THIS s.bmdma[channel].prd_done;
+    host = BX_MEM(0)->dmaGetHostMemAddr(addr + BX_PIDE_THIS s.bmdma[channel].prd_done, len, BX_WRITE);
+    if (host != NULL) {
+      if (DEV_hd_bmdma_read_async(channel, host, len)) {
+        BX_PIDE_THIS s.bmdma[channel].aio_pending = 1;
+        BX_PIDE_THIS s.bmdma[channel].aio_direct = 1;
+        BX_PIDE_THIS s.bmdma[channel].aio_addr = addr + BX_PIDE_THIS s.bmdma[channel].prd_done;
+        BX_PIDE_THIS s.bmdma[channel].aio_len = len;
+        return 0;
+      }
+      if (!DEV_hd_bmdma_read_sectors(channel, host, &len)) {
+        DEV_hd_bmdma_complete(channel);
+        return 0;
+      }
+      BX_MEM(0)->dmaWriteDone(addr + BX_PIDE_THIS s.bmdma[channel].prd_done, len);
+      BX_PIDE_THIS s.bmdma[channel].prd_done += len;
+    }
+  }
+  count = (int)(size - BX_PIDE_THIS s.bmdma[channel].prd_done) -
+          (int)(BX_PIDE_THIS s.bmdma[channel].buffer_top - BX_PIDE_THIS s.bmdma[channel].buffer_idx);
+  if (count > 0) {
+    if (DEV_hd_bmdma_read_async(channel, BX_PIDE_THIS s.bmdma[channel].buffer_top, count)) {
+      BX_PIDE_THIS s.bmdma[channel].aio_pending = 1;
+      BX_PIDE_THIS s.bmdma[channel].aio_direct = 0;
+      return 0;
+    }
+    len = count;
+    if (!DEV_hd_bmdma_read_sectors(channel, BX_PIDE_THIS s.bmdma[channel].buffer_top, &len)) {
+      DEV_hd_bmdma_complete(channel);
+      return 0;
+    }
+    BX_PIDE_THIS s.bmdma[channel].buffer_top += len;
+    count -= len;
+  }
+  // partial sectors and ATAPI data
+  while (count > 0) {
+    sector_size = count;
+    if (DEV_hd_bmdma_read_sector(channel, BX_PIDE_THIS s.bmdma[channel].buffer_top, &sector_size)) {
+      BX_PIDE_THIS s.bmdma[channel].buffer_top += sector_size;
+      count -= sector_size;
+    } else {
+      break;
+    }
+  };
+  if (count > 0) {
+    DEV_hd_bmdma_complete(channel);
+    return 0;
+  }
+  len = size - BX_PIDE_THIS s.bmdma[channel].prd_done;
+  DEV_MEM_WRITE_PHYSICAL_DMA(addr + BX_PIDE_THIS s.bmdma[channel].prd_done, len, BX_PIDE_THIS s.bmdma[channel].buffer_idx);
+  BX_PIDE_THIS s.bmdma[channel].buffer_idx += len;
+  return 1;
+}
+
+// Transfer the data of one PRD from memory to the disk, directly from the
+// guest memory if possible. Returns false if the transfer was suspended for
+// an asynchronous request or has been aborted.
+bool bx_pci_ide_c::bmdma_write_prd(Bit8u channel, Bit32u addr, Bit32u size)
+{
+  int count;
+  Bit32u len;
+  Bit8u *host;
+
+  BX_DEBUG(("WRITE DMA from addr=0x%08x, size=0x%08x", addr, size));
+  if ((BX_PIDE_THIS s.bmdma[channel].prd_done < size) &&
+      (BX_PIDE_THIS s.bmdma[channel].buffer_top == BX_PIDE_THIS s.bmdma[channel].buffer_idx)) {
+    len = size - BX_PIDE_THIS s.bmdma[channel].prd_done;
+    host = BX_MEM(0)->dmaGetHostMemAddr(addr + BX_PIDE_THIS s.bmdma[channel].prd_done, len, BX_READ);
+    if (host != NULL) {
+      if (DEV_hd_bmdma_write_async(channel, host, len)) {
+        BX_PIDE_THIS s.bmdma[channel].aio_pending = 1;
+        BX_PIDE_THIS s.bmdma[channel].aio_direct = 1;
+        BX_PIDE_THIS s.bmdma[channel].aio_addr = addr + BX_PIDE_THIS s.bmdma[channel].prd_done;
+        BX_PIDE_THIS s.bmdma[channel].aio_len = len;
+        return 0;
+      }
+      if (!DEV_hd_bmdma_write_sectors(channel, host, &len)) {
+        DEV_hd_bmdma_complete(channel);
+        return 0;
+      }
+      BX_PIDE_THIS s.bmdma[channel].prd_done += len;
+    }
+  }
+  if (BX_PIDE_THIS s.bmdma[channel].prd_done < size) {
+    len = size - BX_PIDE_THIS s.bmdma[channel].prd_done;
+    DEV_MEM_READ_PHYSICAL_DMA(addr + BX_PIDE_THIS s.bmdma[channel].prd_done, len, BX_PIDE_THIS s.bmdma[channel].buffer_top);
+    BX_PIDE_THIS s.bmdma[channel].buffer_top += len;
+    BX_PIDE_THIS s.bmdma[channel].prd_done = size;
+  }
+  count = (int)(BX_PIDE_THIS s.bmdma[channel].buffer_top - BX_PIDE_THIS s.bmdma[channel].buffer_idx);
+  if (count > 511) {
+    if (DEV_hd_bmdma_write_async(channel, BX_PIDE_THIS s.bmdma[channel].buffer_idx, count)) {
+      BX_PIDE_THIS s.bmdma[channel].aio_pending = 1;
+      BX_PIDE_THIS s.bmdma[channel].aio_direct = 0;
+      return 0;
+    }
+    len = count;
+    if (!DEV_hd_bmdma_write_sectors(channel, BX_PIDE_THIS s.bmdma[channel].buffer_idx, &len)) {
+      DEV_hd_bmdma_complete(channel);
+      return 0;
+    }
+    BX_PIDE_THIS s.bmdma[channel].buffer_idx += len;
+  }
+  return 1;
+}
+
 
 // static IO port read callback handler
 // redirects to non-static class handler to avoid virtual functions
@@ -393,6 +525,11 @@ void bx_pci_ide_c::write(Bit32u address, Bit32u value, unsigned io_len)
   switch (offset) {
     case 0x00:
       BX_DEBUG(("BM-DMA write command register, channel %d, value = 0x%02x", channel, value));
+      if (BX_PIDE_THIS s.bmdma[channel].aio_pending) {
+        // finish the disk request before the transfer state changes
+        bx_hdimage_ctl.aio_flush();
+        BX_PIDE_THIS s.bmdma[channel].aio_pending = 0;
+      }
       BX_PIDE_THIS s.bmdma[channel].cmd_rwcon = (value >> 3) & 1;
       if ((value & 0x01) && !BX_PIDE_THIS s.bmdma[channel].cmd_ssbm) {
         BX_PIDE_THIS s.bmdma[channel].cmd_ssbm = 1;
@@ -400,6 +537,7 @@ void bx_pci_ide_c::write(Bit32u address, Bit32u value, unsigned io_len)
         BX_PIDE_THIS s.bmdma[channel].prd_current = BX_PIDE_THIS s.bmdma[channel].dtpr;
         BX_PIDE_THIS s.bmdma[channel].buffer_top = BX_PIDE_THIS s.bmdma[channel].buffer;
         BX_PIDE_THIS s.bmdma[channel].buffer_idx = BX_PIDE_THIS s.bmdma[channel].buffer;
+        BX_PIDE_THIS s.bmdma[channel].prd_done = 0;
         bx_pc_system.activate_timer(BX_PIDE_THIS s.bmdma[channel].timer_index, 1, 0);
       } else if (!(value & 0x01) && BX_PIDE_THIS s.bmdma[channel].cmd_ssbm) {
         BX_PIDE_THIS s.bmdma[channel].cmd_ssbm = 0;
@@ -40,6 +40,7 @@ public:
   virtual bool bmdma_present(void);
   virtual void bmdma_start_transfer(Bit8u channel);
   virtual void bmdma_set_irq(Bit8u channel);
+  virtual void bmdma_aio_complete(Bit8u channel, Bit32u bytes);
   virtual void register_state(void);
   virtual void after_restore_state(void);
   static Bit64s param_save_handler(void *devptr, bx_param_c *param);
@@ -53,6 +54,8 @@ public:
 
   static void timer_handler(void *);
   BX_PIDE_SMF void timer(void);
+  BX_PIDE_SMF bool bmdma_read_prd(Bit8u channel, Bit32u addr, Bit32u size);
+  BX_PIDE_SMF bool bmdma_write_prd(Bit8u channel, Bit32u addr, Bit32u size);
 
 private:
 
@@ -69,6 +72,11 @@ private:
       Bit8u *buffer_top;
       Bit8u *buffer_idx;
       bool data_ready;
+      Bit32u prd_done;    // bytes of the current PRD already transferred
+      bool aio_pending;   // asynchronous disk request in flight
+      bool aio_direct;    // request transfers from/to guest memory directly
+      Bit32u aio_addr;    // guest physical address of a direct request
+      Bit32u aio_len;     // length of a direct request
     } bmdma[2];
   } s;
 
@@ -212,6 +212,7 @@ bx_serial_c::~bx_serial_c(void)
 #if defined(SERIAL_ENABLE) && !defined(BX_SER_WIN32)
           if (s[i].tty_id >= 0) {
             tcsetattr(s[i].tty_id, TCSAFLUSH, &s[i].term_orig);
+            bx_pc_system.unregister_idle_fd(s[i].tty_id);
           }
 #endif
           break;
@@ -222,7 +223,10 @@ bx_serial_c::~bx_serial_c(void)
           break;
         case BX_SER_MODE_SOCKET_CLIENT:
         case BX_SER_MODE_SOCKET_SERVER:
-          if (BX_SER_THIS s[i].socket_id >= 0) closesocket(BX_SER_THIS s[i].socket_id);
+          if (BX_SER_THIS s[i].socket_id >= 0) {
+            bx_pc_system.unregister_idle_fd((int)BX_SER_THIS s[i].socket_id);
+            closesocket(BX_SER_THIS s[i].socket_id);
+          }
 #ifdef BX_SER_WIN32
           if (winsock_init) {
             WSACleanup();
@@ -407,6 +411,7 @@ bx_serial_c::init(void)
           } else {
             BX_SER_THIS s[i].io_mode = BX_SER_MODE_TERM;
             BX_DEBUG(("com%d tty_id: %d", i+1, BX_SER_THIS s[i].tty_id));
+            bx_pc_system.register_idle_fd(BX_SER_THIS s[i].tty_id);
             tcgetattr(BX_SER_THIS s[i].tty_id, &BX_SER_THIS s[i].term_orig);
             memcpy(&BX_SER_THIS s[i].term_orig, &BX_SER_THIS s[i].term_new, sizeof(struct termios));
             BX_SER_THIS s[i].term_new.c_iflag &= ~(IGNBRK|BRKINT|PARMRK|ISTRIP|INLCR|IGNCR|ICRNL|IXON);
@@ -533,6 +538,7 @@ bx_serial_c::init(void)
           BX_INFO(("com%d - inet %s - socket_id: %d, ip:%s, port:%d",
                    i+1, server ? "server" : "client", socket, host, port));
           BX_SER_THIS s[i].io_mode = mode;
+          bx_pc_system.register_idle_fd((int)socket);
         }
       } else if ((mode == BX_SER_MODE_PIPE_CLIENT) ||
                  (mode == BX_SER_MODE_PIPE_SERVER)) {
@@ -1801,17 +1801,8 @@ void scsi_device_t::seek_complete(SCSIRequest *r)
         return;
       }
     } else {
-      ret = (int) hdimage->lseek(r->sector * block_size, SEEK_SET);
-      if (ret < 0) {
-        BX_ERROR(("could not lseek() hard drive image file"));
-        scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR, 0, 0);
-        return;
-      }
-      i = 0;
-      do {
-        ret = (int) hdimage->read((bx_ptr_t) (r->dma_buf + (i * block_size)), block_size);
-      } while ((++i < n) && (ret == block_size));
-      if (ret != block_size) {
+      ret = (int) hdimage->read_at(r->sector * block_size, (bx_ptr_t) r->dma_buf, n * block_size);
+      if (ret != (int)(n * block_size)) {
         BX_ERROR(("could not read() hard drive image file"));
         scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR, 0, 0);
         return;
@@ -1824,17 +1815,8 @@ void scsi_device_t::seek_complete(SCSIRequest *r)
     bx_gui->statusbar_setitem(statusbar_id, 1, 1);
     n = r->buf_len / block_size;
     if (n) {
-      ret = (int)hdimage->lseek(r->sector * block_size, SEEK_SET);
-      if (ret < 0) {
-        BX_ERROR(("could not lseek() hard drive image file"));
-        scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR, 0, 0);
-      }
-      i = 0;
-      do {
-        ret = (int) hdimage->write((bx_ptr_t) (r->dma_buf + (i * block_size)),
-                                  block_size);
-      } while ((++i < n) && (ret == block_size));
-      if (ret != block_size) {
+      ret = (int) hdimage->write_at(r->sector * block_size, (bx_ptr_t) r->dma_buf, n * block_size);
+      if (ret != (int)(n * block_size)) {
         BX_ERROR(("could not write() hard drive image file"));
         scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR, 0, 0);
         return;
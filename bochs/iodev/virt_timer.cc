@@ -544,3 +544,20 @@ void bx_virt_timer_c::set_realtime_delay()
 {
   real_time_delay = GET_VIRT_REALTIME64_USEC() - last_real_time;
 }
+
+Bit64u bx_virt_timer_c::time_to_next_realtime_event()
+{
+#if BX_HAVE_REALTIME_USEC
+  if (!init_done) return 0;
+
+  // host time not yet accounted by timer_handler()
+  Bit64u real_time_delta = GET_VIRT_REALTIME64_USEC() - last_real_time;
+  if (real_time_delta < real_time_delay) return 0;
+  real_time_delta -= real_time_delay;
+
+  if (real_time_delta >= s[1].virtual_next_event_time) return 0;
+  return s[1].virtual_next_event_time - real_time_delta;
+#else
+  return 0;
+#endif
+}
@@ -150,6 +150,9 @@ public:
   //Determine the real time elapsed during runtime config or between save and
   //restore.
   void set_realtime_delay(void);
+
+  //Get the host time in usec until the next realtime timer is due.
+  Bit64u time_to_next_realtime_event(void);
 };
 
 BOCHSAPI extern bx_virt_timer_c bx_virt_timer;
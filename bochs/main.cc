@@ -22,6 +22,7 @@
 #include "bxversion.h"
 #include "param_names.h"
 #include "cpu/cpu.h"
+#include "cpu/profile.h"
 #include "iodev/iodev.h"
 #include "iodev/hdimage/hdimage.h"
 #if BX_NETWORKING
@@ -36,6 +37,11 @@
 
 #include "bx_debug/debug.h"
 
+#if BX_SUPPORT_SMP
+#include "bxthread.h"
+#include "cpu/apic.h"
+#endif
+
 #ifdef HAVE_LOCALE_H
 #include <locale.h>
 #endif
@@ -96,6 +102,7 @@ typedef BX_CPU_C *BX_CPU_C_PTR;
 #if BX_SUPPORT_SMP
 // multiprocessor simulation, we need an array of cpus
 BOCHSAPI BX_CPU_C_PTR *bx_cpu_array = NULL;
+thread_local BX_CPU_C *bx_smp_thread_cpu = NULL;
 #else
 // single processor simulation, so there's one of everything
 BOCHSAPI BX_CPU_C bx_cpu;
@@ -260,19 +267,21 @@ void print_tree(bx_param_c *node, int level, bool xml)
 #endif
 
 #if BX_ENABLE_STATISTICS
-void print_statistics_tree(bx_param_c *node, int level)
+void print_statistics_tree(bx_param_c *node, int level, FILE *fp)
 {
-  for (int i=0; i<level; i++)
-    printf("  ");
+  if (fp != NULL) {
+    for (int i=0; i<level; i++)
+      fprintf(fp, "  ");
+  }
   if (node == NULL) {
-      printf("NULL pointer\n");
+      if (fp != NULL) fprintf(fp, "NULL pointer\n");
       return;
   }
   switch (node->get_type()) {
     case BXT_PARAM_NUM:
       {
         bx_param_num_c* param = (bx_param_num_c*) node;
-        printf("%s = " FMT_LL "d\n", node->get_name(), param->get64());
+        if (fp != NULL) fprintf(fp, "%s = " FMT_LL "d\n", node->get_name(), param->get64());
         param->set(0); // clear the statistic
       }
       break;
@@ -289,9 +298,9 @@ void print_statistics_tree(bx_param_c *node, int level)
       {
         bx_list_c *list = (bx_list_c*)node;
         if (list->get_size() > 0) {
-          printf("%s = \n", node->get_name());
+          if (fp != NULL) fprintf(fp, "%s = \n", node->get_name());
           for (int i=0; i < list->get_size(); i++) {
-            print_statistics_tree(list->get(i), level+1);
+            print_statistics_tree(list->get(i), level+1, fp);
           }
         }
         break;
@@ -766,7 +775,10 @@ int bx_init_main(int argc, char *argv[])
 #if BX_ENABLE_STATISTICS
     else if (!strcmp("-dumpstats", argv[arg])) {
       if (++arg >= argc) BX_PANIC(("-dumpstats must be followed by a number"));
-      else SIM->get_param_num(BXPN_DUMP_STATS)->set(atoi(argv[arg]));
+      else {
+        SIM->get_param_bool(BXPN_STATISTICS_ENABLED)->set(1);
+        SIM->get_param_num(BXPN_STATISTICS_PERIOD)->set(atoi(argv[arg]));
+      }
     }
 #endif
     else if (!strcmp("-r", argv[arg])) {
@@ -1007,6 +1019,151 @@ bool load_and_init_display_lib(void)
   return (bx_gui != NULL);
 }
 
+#if BX_SUPPORT_SMP
+
+// Multi-threaded SMP simulation: each processor executes its quantum in its
+// own host thread. The main thread waits until all processors complete the
+// quantum and advances the emulated time while they are stopped, so timer
+// handlers and GUI updates are always called from the main thread.
+
+static bx_thread_barrier_t smp_barrier;
+static Bit32u smp_quantum;
+static bool smp_threads_quit;
+
+BX_THREAD_FUNC(smp_cpu_thread, indata)
+{
+  BX_CPU_C *cpu = (BX_CPU_C *) indata;
+
+  bx_smp_thread_cpu = cpu;
+
+  while (1) {
+    bx_wait_barrier(&smp_barrier); // wait for the start of the quantum
+    if (smp_threads_quit) break;
+    cpu->cpu_run_quantum(smp_quantum);
+    bx_wait_barrier(&smp_barrier); // quantum done
+  }
+
+  BX_THREAD_EXIT;
+}
+
+static void bx_smp_threads_loop(void)
+{
+  BX_THREAD_VAR(threads[BX_MAX_SMP_THREADS_SUPPORTED]);
+  Bit32u executed = 0;
+  unsigned n;
+
+  smp_quantum = SIM->get_param_num(BXPN_SMP_HOST_QUANTUM)->get();
+  smp_threads_quit = 0;
+  bx_create_barrier(&smp_barrier, BX_SMP_PROCESSORS + 1);
+
+  for (n=0; n<BX_SMP_PROCESSORS; n++) {
+    BX_CPU(n)->sync_icount();
+    BX_THREAD_CREATE(smp_cpu_thread, BX_CPU(n), threads[n]);
+  }
+
+  BX_INFO(("SMP simulation: running %d processors in host threads", BX_SMP_PROCESSORS));
+
+  while (1) {
+    bx_pc_system.smp_threads_running = 1;
+    bx_wait_barrier(&smp_barrier); // start the quantum
+    bx_wait_barrier(&smp_barrier); // wait for all processors
+    bx_pc_system.smp_threads_running = 0;
+
+    // see how many instructions were executed, a halted CPU is charged
+    // the whole quantum
+    unsigned idle = 0;
+    for (n=0; n<BX_SMP_PROCESSORS; n++) {
+      Bit32u delta = (Bit32u)(BX_CPU(n)->get_icount() - BX_CPU(n)->get_icount_last_sync());
+      executed += delta ? delta : smp_quantum;
+      BX_CPU(n)->sync_icount();
+      if (BX_CPU(n)->is_idle()) idle++;
+    }
+
+    if (idle == BX_SMP_PROCESSORS) {
+      // all processors wait for interrupt, skip to the next timer event
+      bx_pc_system.idle();
+      executed = 0;
+    }
+    else {
+      BX_TICKN(executed / BX_SMP_PROCESSORS);
+      executed %= BX_SMP_PROCESSORS;
+    }
+
+    if (bx_pc_system.kill_bochs_request)
+      break;
+  }
+
+  // release the processor threads and let them quit
+  smp_threads_quit = 1;
+  bx_wait_barrier(&smp_barrier);
+  for (n=0; n<BX_SMP_PROCESSORS; n++) {
+    BX_THREAD_JOIN(threads[n]);
+  }
+  bx_destroy_barrier(&smp_barrier);
+}
+
+// Adaptive round-robin SMP scheduler: every processor runs a time slice which
+// grows while it executes straight-line user code and shrinks back to the
+// configured quantum around IPI traffic or spin-wait loops (PAUSE). Idle
+// processors (halted or waiting in MWAIT without pending wakeup event) are
+// skipped until an interrupt or IPI arrives.
+
+#define BX_SMP_SLICE_MAX_USER    2048
+#define BX_SMP_SLICE_MAX_KERNEL   256
+
+static Bit32u smp_slice[BX_MAX_SMP_THREADS_SUPPORTED];
+
+// returns false if the processor was idle and didn't run
+static bool bx_smp_run_slice(unsigned processor, Bit32u quantum)
+{
+  BX_CPU_C *cpu = BX_CPU(processor);
+
+  if (cpu->is_idle()) {
+    smp_slice[processor] = quantum;
+    return false;
+  }
+
+  // never run past the next timer event, it could be an interrupt for
+  // another processor
+  Bit32u slice = smp_slice[processor];
+  Bit32u ticks_left = bx_pc_system.getNumCpuTicksLeftNextEvent();
+  if (slice > ticks_left)
+    slice = (ticks_left > quantum) ? ticks_left : quantum;
+
+  Bit32u ipi_count = apic_ipi_count;
+  cpu->spin_wait_hint = 0;
+
+  Bit64u icount, prev_icount = cpu->get_icount();
+  while (1) {
+    cpu->cpu_run_trace();
+    icount = cpu->get_icount();
+    if (icount == prev_icount || (icount - cpu->icount_last_sync) >= slice)
+      break;
+    if (cpu->spin_wait_hint || ipi_count != apic_ipi_count || bx_pc_system.kill_bochs_request)
+      break;
+    prev_icount = icount;
+  }
+
+  // adjust the next time slice
+  if (ipi_count != apic_ipi_count) {
+    // interprocessor communication - give all processors short slices
+    for (unsigned n=0; n<BX_SMP_PROCESSORS; n++)
+      smp_slice[n] = quantum;
+  }
+  else if (cpu->spin_wait_hint) {
+    smp_slice[processor] = quantum;
+  }
+  else if ((icount - cpu->icount_last_sync) >= slice) {
+    Bit32u max_slice = cpu->user_pl ? BX_SMP_SLICE_MAX_USER : BX_SMP_SLICE_MAX_KERNEL;
+    if (max_slice < quantum) max_slice = quantum;
+    smp_slice[processor] = (slice * 2 < max_slice) ? slice * 2 : max_slice;
+  }
+
+  return true;
+}
+
+#endif
+
 int bx_begin_simulation(int argc, char *argv[])
 {
   bx_user_quit = 0;
@@ -1093,27 +1250,42 @@ int bx_begin_simulation(int argc, char *argv[])
         // that kill_bochs_request was set by the GUI interface.
       }
 #if BX_SUPPORT_SMP
+      else if (SIM->get_param_bool(BXPN_SMP_HOST_THREADS)->get()) {
+        bx_smp_threads_loop();
+      }
       else {
         // SMP simulation: do a few instructions on each processor, then switch
         // to another.  Increasing quantum speeds up overall performance, but
         // reduces granularity of synchronization between processors.
-        // Current implementation uses dynamic quantum, each processor will
-        // execute exactly one trace then quit the cpu_loop and switch to
-        // the next processor.
+        // Current implementation uses adaptive time slices (see
+        // bx_smp_run_slice), the quantum is the shortest slice a processor
+        // gets. When all processors are idle, the emulated time is advanced
+        // directly to the next timer event.
 
-        static int quantum = SIM->get_param_num(BXPN_SMP_QUANTUM)->get();
-        Bit32u executed = 0, processor = 0;
+        static Bit32u quantum = SIM->get_param_num(BXPN_SMP_QUANTUM)->get();
+        static Bit32u processor, executed = 0, idle = 0;
         bool run = true;
 
-        if (setjmp(BX_CPU_C::jmp_buf_env)) {
-          // can get here only from exception function or VMEXIT
-          BX_CPU(processor)->icount++;
-          run = false;
+        for (processor = 0; processor < BX_SMP_PROCESSORS; processor++)
+          smp_slice[processor] = quantum;
+
+        // every processor has its own exception return point, all of them
+        // lead here and the simulation continues from the faulting processor
+        for (processor = 0; processor < BX_SMP_PROCESSORS; processor++) {
+          if (setjmp(BX_CPU(processor)->jmp_buf_env)) {
+            // can get here only from exception function or VMEXIT
+            BX_CPU(processor)->icount++;
+            run = false;
+            break;
+          }
         }
+        if (run) processor = 0;
+
         while (1) {
           // do some instructions in each processor
-          if (run)
-            BX_CPU(processor)->cpu_run_trace();
+          if (run) {
+            if (! bx_smp_run_slice(processor, quantum)) idle++;
+          }
           else
             run = true;
 
@@ -1124,8 +1296,16 @@ int bx_begin_simulation(int argc, char *argv[])
 
            if (++processor == BX_SMP_PROCESSORS) {
              processor = 0;
-             BX_TICKN(executed / BX_SMP_PROCESSORS);
-             executed %= BX_SMP_PROCESSORS;
+             if (idle == BX_SMP_PROCESSORS) {
+               // nothing to run until the next timer event
+               bx_pc_system.idle();
+               executed = 0;
+             }
+             else {
+               BX_TICKN(executed / BX_SMP_PROCESSORS);
+               executed %= BX_SMP_PROCESSORS;
+             }
+             idle = 0;
            }
 
            BX_CPU(processor)->icount_last_sync = BX_CPU(processor)->get_icount();
@@ -1162,6 +1342,7 @@ void bx_sr_after_restore_state(void)
     BX_CPU(i)->after_restore_state();
   }
 #endif
+  bx_pc_system.after_restore_state();
   DEV_after_restore_state();
 }
 
@@ -1228,7 +1409,10 @@ void bx_init_hardware()
   BX_INFO(("IPS is set to %d", (Bit32u) SIM->get_param_num(BXPN_IPS)->get()));
   BX_INFO(("CPU configuration"));
 #if BX_SUPPORT_SMP
-  BX_INFO(("  SMP support: yes, quantum=%d", SIM->get_param_num(BXPN_SMP_QUANTUM)->get()));
+  if (SIM->get_param_bool(BXPN_SMP_HOST_THREADS)->get())
+    BX_INFO(("  SMP support: yes, host threads, quantum=%d", SIM->get_param_num(BXPN_SMP_HOST_QUANTUM)->get()));
+  else
+    BX_INFO(("  SMP support: yes, quantum=%d", SIM->get_param_num(BXPN_SMP_QUANTUM)->get()));
 #else
   BX_INFO(("  SMP support: no"));
 #endif
@@ -1289,13 +1473,13 @@ void bx_init_hardware()
   }
 
 #if BX_ENABLE_STATISTICS
-  // set periodic timer for dumping statistics collected during Bochs run
-  int dumpstats = SIM->get_param_num(BXPN_DUMP_STATS)->get();
-  if (dumpstats) {
-    BX_INFO(("Dump statistics every %d millions of ticks", dumpstats));
-    bx_pc_system.register_timer_ticks(&bx_pc_system, bx_pc_system_c::dumpStatsTimer,
-        (Bit64u) dumpstats * 1000000, 1 /* continuous */, 1, "dumpstats.timer");
-  }
+  // set periodic timer for dumping statistics collected during Bochs run,
+  // the dump can be enabled and disabled at runtime
+  Bit32u dumpstats = SIM->get_param_num(BXPN_STATISTICS_PERIOD)->get();
+  if (SIM->get_param_bool(BXPN_STATISTICS_ENABLED)->get())
+    BX_INFO(("Dump statistics every %u millions of ticks", dumpstats));
+  bx_pc_system.register_timer_ticks(&bx_pc_system, bx_pc_system_c::dumpStatsTimer,
+      (Bit64u) dumpstats * 1000000, 1 /* continuous */, 1, "dumpstats.timer");
 #endif
 
   // set up memory and CPU objects
@@ -1435,6 +1619,9 @@ int bx_atexit(void)
   for (int cpu=0; cpu<BX_SMP_PROCESSORS; cpu++)
     if (BX_CPU(cpu)) BX_CPU(cpu)->atexit();
 
+  saveTraceFile();
+  writeProfile();
+
   BX_MEM(0)->cleanup_memory();
 
   bx_pc_system.exit();
@@ -51,8 +51,17 @@ protected:
   Bit8u  **blocks;
   Bit8u   *rom;      // 512k BIOS rom space + 128k expansion rom space
   Bit8u   *bogus;    // 4k for unexisting memory
+  Bit64u  mapped_len;      // size of the host mapping, 0 if allocated from heap
 
   Bit32u used_blocks;
+  unsigned hugepages;      // host huge pages backing the guest RAM
+  bool     numa_bind;
+  int      ram_image_fd;   // saved state RAM image mapped over the vector, -1 if none
+  // Dirty page log, one entry per 4K page of guest memory. Pages written via
+  // host pointers are marked when the pointer is handed out for writing, so
+  // the stores hitting in the TLB don't pay for it. Byte entries are used as
+  // bits set by processors running in parallel host threads would race.
+  Bit8u   *dirty_pages;
 #if BX_LARGE_RAMFILE
   static Bit8u * const swapped_out; // NULL; // (NULL - sizeof(Bit8u));
   Bit32u  next_swapout_idx;
@@ -86,6 +95,19 @@ public:
   BX_MEM_SMF Bit64u get_memory_len(void);
   BX_MEM_SMF void allocate_block(Bit32u index);
   BX_MEM_SMF Bit8u* alloc_vector_aligned(Bit64u bytes, Bit64u alignment);
+  BX_MEM_SMF Bit8u* alloc_vector_mapped(Bit64u bytes);
+  BX_MEM_SMF void free_vector(void);
+  BX_MEM_SMF void prepare_block(Bit8u *block);
+  BX_MEM_SMF bool map_ram_image(const char *path);
+  BX_MEM_SMF bool save_ram_image(const char *path);
+
+  BX_MEM_SMF BX_CPP_INLINE void mark_dirty_page(bx_phy_address a20addr);
+  BX_MEM_SMF void mark_dirty_range(bx_phy_address a20addr, Bit64u len);
+  // Copy dirty page log of the guest memory range to bitmap (bit per 4K page,
+  // page 'addr' in bit 0 of the first word) and clear it. Must be called
+  // while no processor is executing (timer handler or GUI). Returns number
+  // of dirty pages.
+  BX_MEM_SMF Bit64u fetch_and_clear_dirty_log(bx_phy_address addr, Bit64u len, Bit64u *bitmap);
 
 #if BX_SUPPORT_MONITOR_MWAIT
   BX_MEM_SMF bool is_monitor(bx_phy_address begin_addr, unsigned len);
@@ -179,6 +201,13 @@ public:
 
   BX_MEM_SMF void    dmaReadPhysicalPage(bx_phy_address addr, unsigned len, Bit8u *data);
   BX_MEM_SMF void    dmaWritePhysicalPage(bx_phy_address addr, unsigned len, Bit8u *data);
+  // Host pointer for a DMA transfer of 'len' bytes to or from guest RAM, the
+  // range may span pages. Returns NULL if the range is not contiguous host
+  // memory or direct access is vetoed, the caller has to use the page based
+  // functions then. After writing through the pointer dmaWriteDone() must be
+  // called to invalidate the translated code of the range.
+  BX_MEM_SMF Bit8u*  dmaGetHostMemAddr(bx_phy_address addr, unsigned len, unsigned rw);
+  BX_MEM_SMF void    dmaWriteDone(bx_phy_address addr, unsigned len);
 
   BX_MEM_SMF bool    load_flash_data(const char *path);
   BX_MEM_SMF bool    save_flash_data(const char *path);
@@ -206,6 +235,9 @@ public:
 
 #if BX_LARGE_RAMFILE
   friend void ramfile_save_handler(void *devptr, FILE *fp);
+#else
+  friend bool ram_save_handler(void *devptr, const char *path);
+  friend bool ram_restore_handler(void *devptr, const char *path);
 #endif
   friend Bit64s memory_param_save_handler(void *devptr, bx_param_c *param);
   friend void memory_param_restore_handler(void *devptr, bx_param_c *param, Bit64s val);
@@ -213,4 +245,10 @@ public:
 
 BOCHSAPI extern BX_MEM_C bx_mem;
 
+BX_CPP_INLINE void BX_MEMORY_STUB_C::mark_dirty_page(bx_phy_address a20addr)
+{
+  if (a20addr < BX_MEM_THIS len)
+    BX_MEM_THIS dirty_pages[a20addr >> 12] = 1;
+}
+
 #endif
@@ -70,16 +70,21 @@ void BX_MEM_C::writePhysicalPage(BX_CPU_C *cpu, bx_phy_address addr, unsigned le
   }
 
   memory_handler = BX_MEM_THIS memory_handlers[a20addr >> 20];
-  while (memory_handler) {
-    if (memory_handler->write_handler != NULL) {
-      if (memory_handler->begin <= a20addr &&
-          memory_handler->end >= a20addr &&
-          memory_handler->write_handler(a20addr, len, data, memory_handler->param))
-      {
-        return;
+  if (memory_handler) {
+    BX_LOCK_DEVICES();
+    while (memory_handler) {
+      if (memory_handler->write_handler != NULL) {
+        if (memory_handler->begin <= a20addr &&
+            memory_handler->end >= a20addr &&
+            memory_handler->write_handler(a20addr, len, data, memory_handler->param))
+        {
+          BX_UNLOCK_DEVICES();
+          return;
+        }
       }
+      memory_handler = memory_handler->next;
     }
-    memory_handler = memory_handler->next;
+    BX_UNLOCK_DEVICES();
   }
 
 mem_write:
@@ -100,6 +105,7 @@ mem_write:
 #endif
 
     pageWriteStampTable.decWriteStamp(a20addr);
+    BX_MEM_THIS mark_dirty_page(a20addr);
 
     // addr must be in range 000A0000 .. 000FFFFF
     for(unsigned i=0; i<len; i++) {
@@ -204,25 +210,31 @@ void BX_MEM_C::readPhysicalPage(BX_CPU_C *cpu, bx_phy_address addr, unsigned len
   }
 
   memory_handler = BX_MEM_THIS memory_handlers[a20addr >> 20];
-  while (memory_handler) {
-    if (memory_handler->begin <= a20addr &&
-          memory_handler->end >= a20addr &&
-          memory_handler->read_handler(a20addr, len, data, memory_handler->param))
-    {
+  if (memory_handler) {
+    BX_LOCK_DEVICES();
+    while (memory_handler) {
+      if (memory_handler->begin <= a20addr &&
+            memory_handler->end >= a20addr &&
+            memory_handler->read_handler(a20addr, len, data, memory_handler->param))
+      {
 #if BX_SUPPORT_PCI
-      if (BX_MEM_THIS pci_enabled && ((a20addr & 0xfffc0000) == 0x000c0000)) {
-        unsigned area = (unsigned)(a20addr >> 14) & 0x0f;
-        if (area > BX_MEM_AREA_F0000) area = BX_MEM_AREA_F0000;
-        if (BX_MEM_THIS memory_type[area][0] == 0) { // Read from ROM
+        if (BX_MEM_THIS pci_enabled && ((a20addr & 0xfffc0000) == 0x000c0000)) {
+          unsigned area = (unsigned)(a20addr >> 14) & 0x0f;
+          if (area > BX_MEM_AREA_F0000) area = BX_MEM_AREA_F0000;
+          if (BX_MEM_THIS memory_type[area][0] == 0) { // Read from ROM
+            BX_UNLOCK_DEVICES();
+            return;
+          }
+        } else
+#endif
+        {
+          BX_UNLOCK_DEVICES();
           return;
         }
-      } else
-#endif
-      {
-        return;
       }
+      memory_handler = memory_handler->next;
     }
-    memory_handler = memory_handler->next;
+    BX_UNLOCK_DEVICES();
   }
 
 mem_read:
@@ -351,6 +363,46 @@ void BX_MEM_C::dmaReadPhysicalPage(bx_phy_address addr, unsigned len, Bit8u *dat
   }
 }
 
+Bit8u *BX_MEM_C::dmaGetHostMemAddr(bx_phy_address addr, unsigned len, unsigned rw)
+{
+  if ((len == 0) || ((addr + len) > BX_MEM_THIS len) ||
+      (A20ADDR(addr) != addr) || (A20ADDR(addr + len - 1) != (addr + len - 1)))
+    return NULL;
+  // VGA memory, ROMs and shadow RAM are handled page by page
+  if ((addr < 0x00100000) && ((addr + len) > 0x000a0000))
+    return NULL;
+#if BX_LARGE_RAMFILE
+  // blocks may be swapped out while the transfer is in progress
+  if (BX_MEM_THIS allocated < BX_MEM_THIS len)
+    return NULL;
+#endif
+
+  Bit8u *host = getHostMemAddr(NULL, addr, rw);
+  if (host == NULL)
+    return NULL;
+  bx_phy_address page = (addr | 0xfff) + 1;
+  while (page < (addr + len)) {
+    if (getHostMemAddr(NULL, page, rw) != (host + (page - addr)))
+      return NULL;
+    page += 0x1000;
+  }
+  return host;
+}
+
+void BX_MEM_C::dmaWriteDone(bx_phy_address addr, unsigned len)
+{
+  while (len > 0) {
+    unsigned remainingInPage = 0x1000 - (addr & 0xfff);
+    if (len < remainingInPage) remainingInPage = len;
+    pageWriteStampTable.decWriteStamp(addr, remainingInPage);
+    // the page was marked dirty when the transfer was submitted, but it
+    // might be harvested from the dirty page log before the data arrived
+    BX_MEM_THIS mark_dirty_page(addr);
+    addr += remainingInPage;
+    len -= remainingInPage;
+  }
+}
+
 void BX_MEM_C::dmaWritePhysicalPage(bx_phy_address addr, unsigned len, Bit8u *data)
 {
   // Note: accesses should always be contained within a single page
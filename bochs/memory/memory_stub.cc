@@ -23,10 +23,19 @@
 #include "bochs.h"
 #include "pc_system.h"
 #include "param_names.h"
+#include "gui/siminterface.h"
 #include "cpu/cpu.h"
 #include "memory/memory-bochs.h"
 #define LOG_THIS BX_MEM(0)->
 
+#if BX_HAVE_SYS_MMAN_H && defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define BX_MEM_HOST_MAPPING 1
+#else
+#define BX_MEM_HOST_MAPPING 0
+#endif
+
 // block size must be power of two
 BX_CPP_INLINE bool is_power_of_2(Bit64u x)
 {
@@ -36,6 +45,12 @@ BX_CPP_INLINE bool is_power_of_2(Bit64u x)
 // alignment of memory vector, must be a power of 2
 #define BX_MEM_VECTOR_ALIGN 4096
 
+// host huge page size, mapped memory vector is aligned to it
+#define BX_MEM_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// memory policy mode from <linux/mempolicy.h>
+#define BX_MEM_MPOL_BIND 2
+
 #if BX_LARGE_RAMFILE
 Bit8u* const BX_MEMORY_STUB_C::swapped_out = ((Bit8u*)NULL - sizeof(Bit8u));
 #endif
@@ -53,8 +68,13 @@ BX_MEMORY_STUB_C::BX_MEMORY_STUB_C()
   rom    = NULL;
   bogus  = NULL;
   len    = 0;
+  mapped_len  = 0;
   used_blocks = 0;
   allocated   = 0;
+  hugepages   = BX_MEM_HUGEPAGES_NONE;
+  numa_bind   = false;
+  ram_image_fd = -1;
+  dirty_pages = NULL;
 
 #if BX_LARGE_RAMFILE
   next_swapout_idx = 0;
@@ -79,7 +99,27 @@ Bit64u BX_MEMORY_STUB_C::get_memory_len(void)
 
 Bit8u* BX_MEMORY_STUB_C::alloc_vector_aligned(Bit64u bytes, Bit64u alignment)
 {
+  if (BX_MEM_THIS hugepages != BX_MEM_HUGEPAGES_NONE || BX_MEM_THIS numa_bind) {
+#if BX_MEM_HOST_MAPPING
+    Bit8u *vector = alloc_vector_mapped(bytes);
+    if (vector != NULL) return vector;
+#else
+    BX_ERROR(("huge pages and NUMA binding of guest RAM are not supported on this host"));
+#endif
+    BX_MEM_THIS hugepages = BX_MEM_HUGEPAGES_NONE;
+    BX_MEM_THIS numa_bind = false;
+  }
+#if BX_MEM_HOST_MAPPING
+  else if (SIM->get_param_bool(BXPN_RESTORE_FLAG)->get()) {
+    // the RAM image of the saved state is mapped over the memory vector,
+    // it can't replace a heap allocation
+    Bit8u *vector = alloc_vector_mapped(bytes);
+    if (vector != NULL) return vector;
+  }
+#endif
+
   Bit64u test_mask = alignment - 1;
+  BX_MEM_THIS mapped_len = 0;
   BX_MEM_THIS actual_vector = new Bit8u [(Bit32u)(bytes + test_mask)];
   if (BX_MEM_THIS actual_vector == 0) {
     BX_PANIC(("alloc_vector_aligned: unable to allocate host RAM !"));
@@ -96,6 +136,299 @@ Bit8u* BX_MEMORY_STUB_C::alloc_vector_aligned(Bit64u bytes, Bit64u alignment)
   return vector;
 }
 
+// Map the memory vector directly from the host kernel. Only address space is
+// reserved here, host memory is taken when a block is used (see prepare_block).
+Bit8u* BX_MEMORY_STUB_C::alloc_vector_mapped(Bit64u bytes)
+{
+#if BX_MEM_HOST_MAPPING
+  void *ptr = MAP_FAILED;
+  Bit64u map_len = 0;
+  Bit8u *vector = NULL;
+
+  if (BX_MEM_THIS hugepages == BX_MEM_HUGEPAGES_HUGETLBFS) {
+    // huge pages are reserved from the hugetlbfs pool for the whole mapping
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    flags |= (21 << MAP_HUGE_SHIFT); // 2M pages
+#endif
+    map_len = (bytes + BX_MEM_HUGE_PAGE_SIZE - 1) & ~(Bit64u)(BX_MEM_HUGE_PAGE_SIZE - 1);
+    ptr = mmap(NULL, (size_t) map_len, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+      BX_ERROR(("not enough hugetlbfs pages for %u MB, using transparent huge pages",
+        (unsigned)(map_len >> 20)));
+      BX_MEM_THIS hugepages = BX_MEM_HUGEPAGES_THP;
+    }
+    vector = (Bit8u *) ptr;
+  }
+
+  if (ptr == MAP_FAILED) {
+    // map one huge page more to align the vector to huge page boundary
+    map_len = bytes + BX_MEM_HUGE_PAGE_SIZE;
+    ptr = mmap(NULL, (size_t) map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED) {
+      BX_ERROR(("alloc_vector_mapped: unable to map host RAM, using heap"));
+      return NULL;
+    }
+    vector = (Bit8u *)(((Bit64u) ptr + BX_MEM_HUGE_PAGE_SIZE - 1) & ~(Bit64u)(BX_MEM_HUGE_PAGE_SIZE - 1));
+    if (BX_MEM_THIS hugepages == BX_MEM_HUGEPAGES_THP) {
+#ifdef MADV_HUGEPAGE
+      if (madvise(vector, (size_t) bytes, MADV_HUGEPAGE) != 0)
+#endif
+      {
+        BX_ERROR(("transparent huge pages are not available"));
+        BX_MEM_THIS hugepages = BX_MEM_HUGEPAGES_NONE;
+      }
+    }
+  }
+
+  BX_MEM_THIS actual_vector = (Bit8u *) ptr;
+  BX_MEM_THIS mapped_len = map_len;
+
+  static const char *hugepages_names[] = { "no huge pages", "transparent huge pages", "hugetlbfs pages" };
+  BX_INFO(("guest RAM mapped with %s%s", hugepages_names[BX_MEM_THIS hugepages],
+    BX_MEM_THIS numa_bind ? ", bound to NUMA node on first use" : ""));
+  return vector;
+#else
+  return NULL;
+#endif
+}
+
+void BX_MEMORY_STUB_C::free_vector(void)
+{
+#if BX_MEM_HOST_MAPPING
+  if (BX_MEM_THIS mapped_len != 0) {
+    munmap(BX_MEM_THIS actual_vector, (size_t) BX_MEM_THIS mapped_len);
+    BX_MEM_THIS mapped_len = 0;
+  }
+  else
+#endif
+    delete [] BX_MEM_THIS actual_vector;
+
+  BX_MEM_THIS actual_vector = NULL;
+
+#if BX_MEM_HOST_MAPPING
+  if (BX_MEM_THIS ram_image_fd >= 0) {
+    close(BX_MEM_THIS ram_image_fd);
+    BX_MEM_THIS ram_image_fd = -1;
+  }
+#endif
+}
+
+// Block of mapped memory vector is taken into use: bind it to the NUMA node
+// of the host CPU running the current thread and fault it in at once, so the
+// host kernel backs it with huge pages instead of faulting it page by page.
+void BX_MEMORY_STUB_C::prepare_block(Bit8u *block)
+{
+#if BX_MEM_HOST_MAPPING
+  if (BX_MEM_THIS mapped_len == 0) return;
+
+  if (BX_MEM_THIS numa_bind) {
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < 64) {
+      // huge page can be bound only as a whole
+      Bit64u start = (Bit64u) block & ~(Bit64u)(BX_MEM_HUGE_PAGE_SIZE - 1);
+      Bit64u end = ((Bit64u) block + BX_MEM_THIS block_size + BX_MEM_HUGE_PAGE_SIZE - 1) & ~(Bit64u)(BX_MEM_HUGE_PAGE_SIZE - 1);
+      Bit64u map_end = (Bit64u) BX_MEM_THIS actual_vector + BX_MEM_THIS mapped_len;
+      if (start < (Bit64u) BX_MEM_THIS actual_vector) start = (Bit64u) BX_MEM_THIS actual_vector;
+      if (end > map_end) end = map_end;
+      unsigned long nodemask = 1UL << node;
+      if (syscall(SYS_mbind, (void *) start, (unsigned long)(end - start), BX_MEM_MPOL_BIND,
+              &nodemask, (unsigned long)(sizeof(nodemask) * 8), 0) != 0) {
+        BX_ERROR(("prepare_block: unable to bind memory to NUMA node %u", node));
+        BX_MEM_THIS numa_bind = false;
+      }
+    }
+  }
+
+  if (BX_MEM_THIS ram_image_fd >= 0) {
+    // RAM image is mapped copy-on-write, write faults would copy the pages
+    // and break the sharing with the page cache of the image
+#ifdef MADV_POPULATE_READ
+    madvise(block, BX_MEM_THIS block_size, MADV_POPULATE_READ);
+#endif
+    return;
+  }
+
+#ifdef MADV_POPULATE_WRITE
+  if (madvise(block, BX_MEM_THIS block_size, MADV_POPULATE_WRITE) == 0) return;
+#endif
+  // older host kernel: touch every page of the block
+  volatile Bit8u *p = block;
+  for (Bit32u offset = 0; offset < BX_MEM_THIS block_size; offset += 4096)
+    p[offset] = p[offset];
+#endif
+}
+
+#if BX_MEM_HOST_MAPPING
+
+// /proc/self/pagemap entry flags
+#define BX_PAGEMAP_FILE    (BX_CONST64(1) << 61)
+#define BX_PAGEMAP_SWAP    (BX_CONST64(1) << 62)
+#define BX_PAGEMAP_PRESENT (BX_CONST64(1) << 63)
+
+static bool write_image_data(int fd, const Bit8u *data, Bit64u len, Bit64u offset)
+{
+  while (len > 0) {
+    ssize_t ret = pwrite(fd, data, (size_t) BX_MIN(len, BX_CONST64(0x40000000)), (off_t) offset);
+    if (ret <= 0) return false;
+    data += ret;
+    offset += ret;
+    len -= ret;
+  }
+  return true;
+}
+
+static bool copy_image_data(int dst, int src, Bit64u len)
+{
+#ifdef SYS_copy_file_range
+  // let the host kernel copy (or share) the file extents
+  loff_t off_in = 0, off_out = 0;
+  while (len > 0) {
+    long ret = syscall(SYS_copy_file_range, src, &off_in, dst, &off_out, (size_t) BX_MIN(len, BX_CONST64(0x40000000)), 0);
+    if (ret <= 0) break;
+    len -= ret;
+  }
+  if (len == 0) return true;
+  Bit64u offset = (Bit64u) off_in;
+#else
+  Bit64u offset = 0;
+#endif
+  Bit8u *buffer = new Bit8u[0x100000];
+  while (len > 0) {
+    ssize_t ret = pread(src, buffer, (size_t) BX_MIN(len, 0x100000), (off_t) offset);
+    if (ret <= 0 || !write_image_data(dst, buffer, ret, offset)) break;
+    offset += ret;
+    len -= ret;
+  }
+  delete [] buffer;
+  return (len == 0);
+}
+
+#endif
+
+// The guest RAM image of a saved state is mapped copy-on-write over the memory
+// vector instead of reading it: pages are read from the file when the guest
+// touches them first and simulations restored from the same image share the
+// unmodified pages in the host page cache. The image must not be modified
+// while it is mapped.
+bool BX_MEMORY_STUB_C::map_ram_image(const char *path)
+{
+#if BX_MEM_HOST_MAPPING
+  struct stat st;
+
+  // only the memory vector mapped from the host kernel can be replaced by
+  // the file mapping, the heap one is read from the image instead
+  if (BX_MEM_THIS mapped_len == 0)
+    return false;
+
+  if ((BX_MEM_THIS allocated & 0xfff) != 0 || ((Bit64u) BX_MEM_THIS vector & 0xfff) != 0)
+    return false;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+  if (fstat(fd, &st) != 0 || (Bit64u) st.st_size != BX_MEM_THIS allocated) {
+    close(fd);
+    return false;
+  }
+  if (mmap(BX_MEM_THIS vector, (size_t) BX_MEM_THIS allocated, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    BX_ERROR(("map_ram_image: unable to map '%s'", path));
+    close(fd);
+    return false;
+  }
+  if (BX_MEM_THIS ram_image_fd >= 0)
+    close(BX_MEM_THIS ram_image_fd);
+  BX_MEM_THIS ram_image_fd = fd;
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Save the guest RAM image. If the memory vector is mapped from an image, the
+// old image is copied and only the pages written by the guest since it was
+// mapped are stored: the host kernel reports all other pages as not present
+// or still shared with the page cache of the image file. The new image is
+// mapped after saving, so the next checkpoint is incremental again.
+bool BX_MEMORY_STUB_C::save_ram_image(const char *path)
+{
+#if BX_MEM_HOST_MAPPING
+  char tmppath[BX_PATHNAME_LEN+5];
+  Bit64u entries[512];
+  Bit64u num_pages = BX_MEM_THIS allocated >> 12, written = 0;
+  int pagemap = -1;
+  bool ok = true;
+
+  if ((BX_MEM_THIS allocated & 0xfff) != 0)
+    return false;
+
+  // the old image may be in use by other simulations, never overwrite it
+  snprintf(tmppath, sizeof(tmppath), "%s.tmp", path);
+  int fd = open(tmppath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+
+  if (BX_MEM_THIS ram_image_fd >= 0) {
+    pagemap = open("/proc/self/pagemap", O_RDONLY);
+    if (pagemap >= 0 && !copy_image_data(fd, BX_MEM_THIS ram_image_fd, BX_MEM_THIS allocated)) {
+      close(pagemap);
+      pagemap = -1;
+    }
+  }
+
+  if (pagemap < 0) {
+    ok = write_image_data(fd, BX_MEM_THIS vector, BX_MEM_THIS allocated, 0);
+    written = num_pages;
+  }
+  else {
+    // write runs of modified pages
+    Bit64u run_start = 0, run_len = 0;
+    Bit64u first_entry = (Bit64u) BX_MEM_THIS vector >> 12;
+    for (Bit64u page = 0; ok && page < num_pages; page += 512) {
+      unsigned n = (unsigned) BX_MIN(num_pages - page, 512);
+      ssize_t size = n * sizeof(Bit64u);
+      if (pread(pagemap, entries, size, (off_t)((first_entry + page) * sizeof(Bit64u))) != size) {
+        ok = false;
+        break;
+      }
+      for (unsigned i = 0; i <= n; i++) {
+        bool dirty = false;
+        if (i < n) {
+          Bit64u entry = entries[i];
+          dirty = (entry & (BX_PAGEMAP_PRESENT | BX_PAGEMAP_SWAP)) != 0 && (entry & BX_PAGEMAP_FILE) == 0;
+          if (dirty) {
+            if (run_len == 0) run_start = page + i;
+            run_len++;
+            continue;
+          }
+        }
+        else if (page + n < num_pages) {
+          break; // the run may continue in the next batch
+        }
+        if (run_len > 0) {
+          ok &= write_image_data(fd, BX_MEM_THIS vector + (run_start << 12), run_len << 12, run_start << 12);
+          written += run_len;
+          run_len = 0;
+        }
+      }
+    }
+    close(pagemap);
+  }
+
+  if (close(fd) != 0 || !ok || rename(tmppath, path) != 0) {
+    BX_ERROR(("save_ram_image: unable to write '%s'", path));
+    unlink(tmppath);
+    return false;
+  }
+
+  BX_INFO(("guest RAM saved: " FMT_LL "u of " FMT_LL "u pages written", written, num_pages));
+
+  map_ram_image(path);
+  return true;
+#else
+  return false;
+#endif
+}
+
 void BX_MEMORY_STUB_C::init_memory(Bit64u guest, Bit64u host, Bit32u block_size)
 {
   // accept only memory size which is multiply of 1M
@@ -108,8 +441,7 @@ void BX_MEMORY_STUB_C::init_memory(Bit64u guest, Bit64u host, Bit32u block_size)
 
   if (BX_MEM_THIS actual_vector != NULL) {
     BX_INFO(("freeing existing memory vector"));
-    delete [] BX_MEM_THIS actual_vector;
-    BX_MEM_THIS actual_vector = NULL;
+    free_vector();
     BX_MEM_THIS vector = NULL;
     BX_MEM_THIS blocks = NULL;
   }
@@ -119,6 +451,9 @@ void BX_MEMORY_STUB_C::init_memory(Bit64u guest, Bit64u host, Bit32u block_size)
 
   BX_MEM_THIS len = guest;
   BX_MEM_THIS allocated = host;
+  delete [] BX_MEM_THIS dirty_pages;
+  BX_MEM_THIS dirty_pages = new Bit8u[(size_t)(guest >> 12)];
+  memset(BX_MEM_THIS dirty_pages, 0, (size_t)(guest >> 12));
   BX_MEM_THIS rom   = &BX_MEM_THIS vector[host];
   BX_MEM_THIS bogus = &BX_MEM_THIS vector[host + BIOSROMSZ + EXROMSIZE];
   memset(BX_MEM_THIS rom, 0xff, BIOSROMSZ + EXROMSIZE + 4096);
@@ -227,6 +562,7 @@ void BX_MEMORY_STUB_C::allocate_block(Bit32u block)
   }
   else {
     BX_MEM_THIS blocks[block] = BX_MEM_THIS vector + (BX_MEM_THIS used_blocks++ * BX_MEM_THIS block_size);
+    prepare_block(BX_MEM_THIS blocks[block]);
     BX_DEBUG(("allocate_block: block=0x%x used 0x%x of 0x%x",
           block, BX_MEM_THIS used_blocks, max_blocks));
   }
@@ -238,21 +574,57 @@ void BX_MEMORY_STUB_C::allocate_block(Bit32u block)
   else {
     BX_MEM_THIS blocks[block] = BX_MEM_THIS vector + (BX_MEM_THIS used_blocks * BX_MEM_THIS block_size);
     BX_MEM_THIS used_blocks++;
+    prepare_block(BX_MEM_THIS blocks[block]);
   }
   BX_DEBUG(("allocate_block: used_blocks=0x%x of 0x%x", BX_MEM_THIS used_blocks, max_blocks));
 #endif
 }
 
+void BX_MEMORY_STUB_C::mark_dirty_range(bx_phy_address a20addr, Bit64u len)
+{
+  if (len == 0 || a20addr >= BX_MEM_THIS len) return;
+  bx_phy_address end = BX_MIN(a20addr + len - 1, BX_MEM_THIS len - 1);
+  memset(BX_MEM_THIS dirty_pages + (a20addr >> 12), 1, (size_t)((end >> 12) - (a20addr >> 12) + 1));
+}
+
+Bit64u BX_MEMORY_STUB_C::fetch_and_clear_dirty_log(bx_phy_address addr, Bit64u len, Bit64u *bitmap)
+{
+  Bit64u first = addr >> 12, num_pages = (len + 0xfff) >> 12, dirty = 0;
+
+  memset(bitmap, 0, (size_t)(((num_pages + 63) >> 6) * sizeof(Bit64u)));
+  if (first >= (BX_MEM_THIS len >> 12)) return 0;
+  num_pages = BX_MIN(num_pages, (BX_MEM_THIS len >> 12) - first);
+
+  const Bit8u *log = BX_MEM_THIS dirty_pages + first;
+  for (Bit64u n = 0; n < num_pages; n++) {
+    if (log[n]) {
+      bitmap[n >> 6] |= BX_CONST64(1) << (n & 63);
+      dirty++;
+    }
+  }
+  if (dirty == 0) return 0;
+  memset(BX_MEM_THIS dirty_pages + first, 0, (size_t) num_pages);
+
+  // the following writes through host pointers must mark the pages again
+  bx_phy_address start = (bx_phy_address) first << 12;
+  bx_phy_address end = start + ((bx_phy_address) num_pages << 12);
+  for (unsigned i=0; i<BX_SMP_PROCESSORS; i++)
+    BX_CPU(i)->TLB_flushWritable(start, end);
+
+  return dirty;
+}
+
 void BX_MEMORY_STUB_C::cleanup_memory()
 {
   if (BX_MEM_THIS vector != NULL) {
-    delete [] BX_MEM_THIS actual_vector;
-    BX_MEM_THIS actual_vector = NULL;
+    free_vector();
     BX_MEM_THIS vector = NULL;
     BX_MEM_THIS rom = NULL;
     BX_MEM_THIS bogus = NULL;
     delete [] BX_MEM_THIS blocks;
     BX_MEM_THIS blocks = NULL;
+    delete [] BX_MEM_THIS dirty_pages;
+    BX_MEM_THIS dirty_pages = NULL;
     BX_MEM_THIS used_blocks = 0;
     BX_MEM_THIS allocated = 0;
     BX_MEM_THIS len = 0;
@@ -294,6 +666,7 @@ bool BX_MEMORY_STUB_C::dbg_set_mem(BX_CPU_C *cpu, bx_phy_address addr, unsigned
     return false; // error, beyond limits of memory
   }
 
+  BX_MEM_THIS mark_dirty_range(a20addr, len);
   for (; len>0; len--) {
     *(BX_MEM_THIS get_vector(a20addr)) = *buf;
     buf++;
@@ -363,6 +736,7 @@ Bit8u *BX_MEMORY_STUB_C::getHostMemAddr(BX_CPU_C *cpu, bx_phy_address addr, unsi
   { // op == {BX_WRITE, BX_RW}
     if (a20addr >= BX_MEM_THIS len)
       return(NULL); // Error, requested addr is out of bounds.
+    BX_MEM_THIS mark_dirty_page(a20addr);
     return BX_MEM_THIS get_vector(a20addr);
   }
 }
@@ -384,6 +758,7 @@ void BX_MEMORY_STUB_C::writePhysicalPage(BX_CPU_C *cpu, bx_phy_address addr, uns
   // all memory access fits in single 4K page
   if (a20addr < BX_MEM_THIS len) {
     // all of data is within limits of physical memory
+    BX_MEM_THIS mark_dirty_page(a20addr);
     if (len == 8) {
       pageWriteStampTable.decWriteStamp(a20addr, 8);
       WriteHostQWordToLittleEndian((Bit64u*) BX_MEM_THIS get_vector(a20addr), *(Bit64u*)data);
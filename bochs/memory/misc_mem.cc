@@ -53,6 +53,9 @@ void BX_MEM_C::init_memory(Bit64u guest, Bit64u host, Bit32u block_size)
 {
   unsigned idx, i;
 
+  BX_MEM_THIS hugepages = SIM->get_param_enum(BXPN_MEM_HUGEPAGES)->get();
+  BX_MEM_THIS numa_bind = SIM->get_param_bool(BXPN_MEM_NUMA_BIND)->get();
+
   BX_MEMORY_STUB_C::init_memory(guest, host, block_size);
 
   BX_MEM_THIS smram_available = false;
@@ -96,6 +99,17 @@ void ramfile_save_handler(void *devptr, FILE *fp)
     }
   }
 }
+#else
+// RAM image is mapped on restore and saved incrementally if possible
+bool ram_save_handler(void *devptr, const char *path)
+{
+  return BX_MEM(0)->save_ram_image(path);
+}
+
+bool ram_restore_handler(void *devptr, const char *path)
+{
+  return BX_MEM(0)->map_ram_image(path);
+}
 #endif
 
 // Note: This must be called before the memory file save handler is called.
@@ -155,6 +169,7 @@ void memory_param_restore_handler(void *devptr, bx_param_c *param, Bit64s val)
         return;
       }
       BX_MEM(0)->blocks[blk_index] = BX_MEM(0)->vector + val * BX_MEM_THIS block_size;
+      BX_MEM(0)->mark_dirty_range((bx_phy_address) blk_index * BX_MEM_THIS block_size, BX_MEM_THIS block_size);
 #if BX_LARGE_RAMFILE
       BX_MEM(0)->read_block(blk_index);
 #endif
@@ -184,7 +199,8 @@ void BX_MEM_C::register_state()
   ramfile->set_sr_handlers(this, ramfile_save_handler, (filedata_restore_handler)NULL);
   BXRS_DEC_PARAM_FIELD(list, next_swapout_idx, BX_MEM_THIS next_swapout_idx);
 #else
-  new bx_shadow_data_c(list, "ram", BX_MEM_THIS vector, BX_MEM_THIS allocated);
+  bx_shadow_data_c *ram = new bx_shadow_data_c(list, "ram", BX_MEM_THIS vector, BX_MEM_THIS allocated);
+  ram->set_sr_handlers(this, ram_save_handler, ram_restore_handler);
 #endif
   BXRS_DEC_PARAM_FIELD(list, used_blocks, BX_MEM_THIS used_blocks);
 
@@ -496,6 +512,7 @@ void BX_MEM_C::load_RAM(const char *path, bx_phy_address ramaddress)
   size = (unsigned long)stat_buf.st_size;
 
   offset = (unsigned long)ramaddress;
+  BX_MEM_THIS mark_dirty_range(offset, size);
   while (size > 0) {
     ret = read(fd, (bx_ptr_t) BX_MEM_THIS get_vector(offset), size);
     if (ret <= 0) {
@@ -650,6 +667,7 @@ bool BX_MEM_C::dbg_set_mem(BX_CPU_C *cpu, bx_phy_address addr, unsigned len, Bit
       if (area > BX_MEM_AREA_F0000) area = BX_MEM_AREA_F0000;
       if (BX_MEM_THIS memory_type[area][1] == true) {
         // Write to ShadowRAM
+        BX_MEM_THIS mark_dirty_page(a20addr);
         *(BX_MEM_THIS get_vector(a20addr)) = *buf;
       } else {
         // Ignore write to ROM
@@ -658,6 +676,7 @@ bool BX_MEM_C::dbg_set_mem(BX_CPU_C *cpu, bx_phy_address addr, unsigned len, Bit
 #endif  // #if BX_SUPPORT_PCI
     else if ((a20addr < 0x000c0000 || a20addr >= 0x00100000) && !is_bios)
     {
+      BX_MEM_THIS mark_dirty_page(a20addr);
       *(BX_MEM_THIS get_vector(a20addr)) = *buf;
     }
     buf++;
@@ -776,6 +795,7 @@ Bit8u *BX_MEM_C::getHostMemAddr(BX_CPU_C *cpu, bx_phy_address addr, unsigned rw)
     else
     {
       if (a20addr < 0x000c0000 || a20addr >= 0x00100000) {
+        BX_MEM_THIS mark_dirty_page(a20addr);
         return BX_MEM_THIS get_vector(a20addr);
       }
       else {
@@ -0,0 +1,479 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2024  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA B 02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+//
+// bxdecode: the instruction decoder (cpu/decoder) built standalone
+//
+//   bxdecode [-16|-32|-64] [-n iterations] bench file...
+//     decode throughput over the code sections of ELF and PE files
+//     (other files are decoded as raw code)
+//   bxdecode [-16|-32|-64] [-n iterations] [-s size] evex
+//     decode throughput over a synthetic stream of valid EVEX instructions
+//   objdump -d -M intel --insn-width=15 file | bxdecode [-16|-32|-64] [-v] diff
+//     compare instruction lengths and mnemonics with the objdump listing
+//
+// Built by "make bxdecode". With BX_DECODER_FUZZER defined the file
+// provides the libFuzzer entry point instead of main(), "make bxdecode_fuzz"
+// builds the fuzzer with clang.
+//
+/////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "config.h"
+#include "cpu/decoder/instr.h"
+#include "cpu/decoder/ia_opcodes.h"
+
+extern int fetchDecode32(const Bit8u *iptr, bool is_32, bxInstruction_c *i, unsigned remainingInPage);
+#if BX_SUPPORT_X86_64
+extern int fetchDecode64(const Bit8u *iptr, bxInstruction_c *i, unsigned remainingInPage);
+#endif
+extern char* disasm(char *disbufptr, const bxInstruction_c *i, bx_address cs_base, bx_address rip, BxDisasmStyle style);
+
+static int decode(const Bit8u *iptr, unsigned mode, bxInstruction_c *i, unsigned remain)
+{
+#if BX_SUPPORT_X86_64
+  if (mode == 64)
+    return fetchDecode64(iptr, i, remain);
+#endif
+  return fetchDecode32(iptr, mode == 32, i, remain);
+}
+
+#ifdef BX_DECODER_FUZZER
+
+// The first input byte selects the decoder mode, the rest are the
+// instruction bytes. The decoder must not read beyond the bytes it gets,
+// decoding exactly the length of a valid instruction must give the same
+// instruction and the disassembler must be able to print everything decoded.
+extern "C" int LLVMFuzzerTestOneInput(const Bit8u *data, size_t size)
+{
+  static const unsigned modes[3] = { 16, 32, 64 };
+
+  if (size < 2) return 0;
+
+  unsigned mode = modes[data[0] % 3];
+#if BX_SUPPORT_X86_64 == 0
+  if (mode == 64) mode = 32;
+#endif
+  unsigned len = (size - 1 > 15) ? 15 : unsigned(size - 1);
+
+  // exact size heap copy, so that ASAN catches reads past the end
+  Bit8u *code = new Bit8u[len];
+  memcpy(code, data + 1, len);
+
+  bxInstruction_c i, j;
+  if (decode(code, mode, &i, len) >= 0) {
+    if (i.ilen() == 0 || i.ilen() > len) abort();
+
+    // the length of an undefined opcode doesn't matter, it raises #UD
+    if (i.getIaOpcode() != BX_IA_ERROR) {
+      if (decode(code, mode, &j, i.ilen()) < 0) abort();
+      if (j.ilen() != i.ilen() || j.getIaOpcode() != i.getIaOpcode()) abort();
+    }
+
+    char disbuf[256];
+    disasm(disbuf, &i, 0, 0, BX_DISASM_INTEL);
+    disasm(disbuf, &i, 0, 0, BX_DISASM_GAS);
+  }
+
+  delete [] code;
+  return 0;
+}
+
+#else
+
+#define BX_MAX_CODE_REGIONS 64
+
+struct code_region_t {
+  const Bit8u *code;
+  Bit32u size;
+  unsigned mode;
+};
+
+static code_region_t regions[BX_MAX_CODE_REGIONS];
+static unsigned num_regions = 0;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static Bit16u get16(const Bit8u *p) { return p[0] | (p[1] << 8); }
+static Bit32u get32(const Bit8u *p) { return get16(p) | (Bit32u(get16(p+2)) << 16); }
+static Bit64u get64(const Bit8u *p) { return get32(p) | (Bit64u(get32(p+4)) << 32); }
+
+static void add_region(const Bit8u *code, Bit64u size, unsigned mode)
+{
+  if (num_regions == BX_MAX_CODE_REGIONS || size == 0) return;
+  regions[num_regions].code = code;
+  regions[num_regions].size = (Bit32u) size;
+  regions[num_regions].mode = mode;
+  num_regions++;
+}
+
+// add the executable sections of an ELF or PE file, or the whole file
+static void add_file_regions(const Bit8u *buf, Bit64u size, unsigned mode)
+{
+  if (size >= 64 && !memcmp(buf, "\177ELF", 4)) {
+    bool elf64 = (buf[4] == 2);
+    Bit64u shoff = elf64 ? get64(buf + 0x28) : get32(buf + 0x20);
+    unsigned shentsize = get16(buf + (elf64 ? 0x3a : 0x2e));
+    unsigned shnum = get16(buf + (elf64 ? 0x3c : 0x30));
+    if (! mode) mode = elf64 ? 64 : 32;
+    for (unsigned n=0; n < shnum; n++) {
+      if (shoff + Bit64u(n + 1) * shentsize > size) break;
+      const Bit8u *sh = buf + shoff + n * shentsize;
+      Bit64u flags = elf64 ? get64(sh + 8) : get32(sh + 8);
+      Bit64u offset = elf64 ? get64(sh + 0x18) : get32(sh + 0x10);
+      Bit64u len = elf64 ? get64(sh + 0x20) : get32(sh + 0x14);
+      // SHT_PROGBITS with SHF_EXECINSTR
+      if (get32(sh + 4) == 1 && (flags & 0x4) && offset + len <= size)
+        add_region(buf + offset, len, mode);
+    }
+    return;
+  }
+
+  if (size >= 64 && buf[0] == 'M' && buf[1] == 'Z') {
+    Bit32u pe = get32(buf + 0x3c);
+    if (pe + 24 <= size && !memcmp(buf + pe, "PE\0\0", 4)) {
+      unsigned machine = get16(buf + pe + 4);
+      unsigned nsect = get16(buf + pe + 6);
+      Bit32u sect = pe + 24 + get16(buf + pe + 20);
+      if (! mode) mode = (machine == 0x8664) ? 64 : 32;
+      for (unsigned n=0; n < nsect; n++, sect += 40) {
+        if (sect + 40 > size) break;
+        Bit32u len = get32(buf + sect + 16), offset = get32(buf + sect + 20);
+        // IMAGE_SCN_CNT_CODE
+        if ((get32(buf + sect + 36) & 0x20) && Bit64u(offset) + len <= size)
+          add_region(buf + offset, len, mode);
+      }
+      return;
+    }
+  }
+
+  add_region(buf, size, mode ? mode : 64);
+}
+
+static Bit8u *load_file(const char *path, Bit64u *size)
+{
+  FILE *fd = fopen(path, "rb");
+  if (! fd) {
+    fprintf(stderr, "cannot open '%s'\n", path);
+    exit(1);
+  }
+  fseek(fd, 0, SEEK_END);
+  long len = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  Bit8u *buf = new Bit8u[len + 16];
+  memset(buf + len, 0, 16);
+  if (fread(buf, 1, len, fd) != (size_t) len) {
+    fprintf(stderr, "cannot read '%s'\n", path);
+    exit(1);
+  }
+  fclose(fd);
+  *size = len;
+  return buf;
+}
+
+// decode all regions from start to end, skipping one byte if the
+// decoding fails
+static void bench(unsigned iterations)
+{
+  Bit64u insns = 0, bytes = 0, failed = 0, checksum = 0;
+  bxInstruction_c i;
+
+  double start = now();
+  for (unsigned iter=0; iter < iterations; iter++) {
+    for (unsigned r=0; r < num_regions; r++) {
+      const Bit8u *code = regions[r].code;
+      Bit32u size = regions[r].size, pos = 0;
+      unsigned mode = regions[r].mode;
+      while (pos < size) {
+        unsigned remain = (size - pos > 15) ? 15 : (size - pos);
+        if (decode(code + pos, mode, &i, remain) < 0) {
+          failed++;
+          pos++;
+          continue;
+        }
+        checksum += i.getIaOpcode();
+        pos += i.ilen();
+        insns++;
+      }
+      bytes += size;
+    }
+  }
+  double elapsed = now() - start;
+
+  printf("%u region(s) of %.1f MB decoded %u times: %llu instructions, %llu decode failures (checksum %llx)\n",
+      num_regions, bytes / 1e6 / iterations, iterations, (unsigned long long) insns,
+      (unsigned long long) failed, (unsigned long long) checksum);
+  printf("%.2f M instructions/s, %.1f ns/instruction, %.1f MB/s\n",
+      insns / elapsed / 1e6, elapsed * 1e9 / insns, bytes / elapsed / 1e6);
+}
+
+// a stream of random EVEX instructions the decoder accepts
+static Bit8u *make_evex_stream(Bit32u size, unsigned mode)
+{
+  static const Bit8u maps[5] = { 1, 2, 3, 5, 6 };
+  Bit8u *buf = new Bit8u[size + 16];
+  Bit32u pos = 0, seed = 1;
+  bxInstruction_c i;
+
+  while (pos < size) {
+    Bit8u insn[16];
+    for (unsigned n=0; n < 16; n++) {
+      seed = seed * 1103515245 + 12345;
+      insn[n] = seed >> 16;
+    }
+    insn[0] = 0x62;
+    insn[1] = (insn[1] & 0xf0) | maps[insn[1] % 5];
+    if (mode != 64) insn[1] |= 0xc0; // otherwise it is BOUND
+    insn[2] |= 0x04;
+    if (decode(insn, mode, &i, 15) < 0 || i.getIaOpcode() == BX_IA_ERROR)
+      continue;
+    unsigned len = i.ilen();
+    if (pos + len > size) break;
+    memcpy(buf + pos, insn, len);
+    pos += len;
+  }
+
+  add_region(buf, pos, mode);
+  return buf;
+}
+
+// first word of a disassembly line which is not a prefix, lower case
+static void get_mnemonic(const char *p, char *name, unsigned size)
+{
+  static const char *prefixes[] = {
+    "lock", "rep", "repe", "repz", "repne", "repnz", "data16", "data32", "addr16", "addr32",
+    "bnd", "notrack", "xacquire", "xrelease", "cs", "ds", "es", "fs", "gs", "ss", NULL
+  };
+
+  for (;;) {
+    while (*p == ' ' || *p == '\t') p++;
+    unsigned len = 0;
+    while (p[len] && !isspace(p[len]) && len < size - 1) {
+      name[len] = tolower(p[len]);
+      len++;
+    }
+    name[len] = 0;
+    p += len;
+    if (!strncmp(name, "rex", 3) || name[0] == '{') continue;
+    bool prefix = false;
+    for (unsigned n=0; prefixes[n]; n++)
+      if (!strcmp(name, prefixes[n])) prefix = true;
+    if (! prefix || ! *p) break;
+  }
+
+  // objdump and bochs use different names for the same condition codes
+  static const char *cond_names[][2] = {
+    { "e", "z" }, { "ne", "nz" }, { "a", "nbe" }, { "ae", "nb" }, { "nae", "b" }, { "c", "b" },
+    { "nc", "nb" }, { "na", "be" }, { "g", "nle" }, { "ge", "nl" }, { "nge", "l" }, { "ng", "le" },
+    { "pe", "p" }, { "po", "np" }, { NULL, NULL }
+  };
+  static const char *cond_insns[] = { "j", "set", "cmov", NULL };
+
+  if (!strcmp(name, "movabs")) name[3] = 0;
+  for (unsigned n=0; cond_insns[n]; n++) {
+    unsigned len = strlen(cond_insns[n]);
+    if (strncmp(name, cond_insns[n], len)) continue;
+    for (unsigned c=0; cond_names[c][0]; c++) {
+      if (!strcmp(name + len, cond_names[c][0]) && len + strlen(cond_names[c][1]) < size) {
+        strcpy(name + len, cond_names[c][1]);
+        break;
+      }
+    }
+  }
+}
+
+// compare with an objdump listing, the instruction bytes of the listing
+// are collected for contiguous code so that the decoder also sees the
+// bytes after the instruction as it would in memory
+#define BX_DIFF_CODE_SIZE (1 << 24)
+#define BX_DIFF_MAX_INSNS (1 << 22)
+
+static Bit8u diff_code[BX_DIFF_CODE_SIZE];
+static Bit32u diff_start[BX_DIFF_MAX_INSNS];
+static char diff_name[BX_DIFF_MAX_INSNS][16];
+
+static Bit64u diff_compared = 0, diff_len = 0, diff_names = 0, diff_unknown = 0;
+
+static void diff_code_block(unsigned ninsns, Bit32u size, unsigned mode, bool verbose)
+{
+  bxInstruction_c i;
+  char disbuf[256], name[16];
+
+  for (unsigned n=0; n < ninsns; n++) {
+    Bit32u start = diff_start[n];
+    Bit32u len = ((n + 1 < ninsns) ? diff_start[n+1] : size) - start;
+    unsigned remain = (size - start > 15) ? 15 : (size - start);
+    diff_compared++;
+
+    if (decode(diff_code + start, mode, &i, remain) < 0) {
+      printf("+%06x: objdump '%s' length %u, bochs decode failed\n", start, diff_name[n], len);
+      diff_len++;
+      continue;
+    }
+    if (i.ilen() != len) {
+      disasm(disbuf, &i, 0, 0, BX_DISASM_INTEL);
+      printf("+%06x: objdump '%s' length %u, bochs '%s' length %u\n", start, diff_name[n], len, disbuf, i.ilen());
+      diff_len++;
+      continue;
+    }
+    disasm(disbuf, &i, 0, 0, BX_DISASM_INTEL);
+    get_mnemonic(disbuf, name, sizeof(name));
+    if (strcmp(name, diff_name[n])) {
+      // many instructions have several names, only count them
+      if (verbose)
+        printf("+%06x: objdump '%s', bochs '%s'\n", start, diff_name[n], disbuf);
+      diff_names++;
+    }
+  }
+}
+
+static int diff(FILE *in, unsigned mode, bool verbose)
+{
+  char line[1024];
+  unsigned ninsns = 0;
+  Bit32u size = 0;
+  Bit64u next_addr = 0;
+  bool mode_set = (mode != 0);
+
+  if (! mode) mode = 64;
+
+  while (fgets(line, sizeof(line), in)) {
+    if (! mode_set) {
+      if (strstr(line, "file format elf32-i386") || strstr(line, "file format pei-i386")) mode = 32;
+      if (strstr(line, "file format elf64-x86-64") || strstr(line, "file format pei-x86-64")) mode = 64;
+    }
+
+    // instruction lines are "address:<tab>bytes<tab>mnemonic operands",
+    // long instructions continue with more bytes on the following line
+    char *p = line, *end;
+    while (*p == ' ') p++;
+    Bit64u addr = strtoull(p, &end, 16);
+    if (end == p || end[0] != ':' || end[1] != '\t') continue;
+    p = end + 2;
+
+    if (addr != next_addr || size + 16 > BX_DIFF_CODE_SIZE || ninsns == BX_DIFF_MAX_INSNS) {
+      diff_code_block(ninsns, size, mode, verbose);
+      ninsns = size = 0;
+    }
+
+    Bit32u start = size;
+    while (isxdigit(p[0]) && isxdigit(p[1]) && (p[2] == ' ' || p[2] == '\t' || p[2] == '\n')) {
+      diff_code[size++] = (Bit8u) strtoul(p, NULL, 16);
+      p += 2;
+      while (*p == ' ') p++;
+    }
+    next_addr = addr + (size - start);
+
+    while (*p == '\t' || *p == ' ') p++;
+    if (! *p || *p == '\n')
+      continue; // continuation line
+
+    if (strstr(p, "(bad)")) {
+      // objdump can't decode it, don't compare from here on
+      diff_code_block(ninsns, start, mode, verbose);
+      ninsns = size = 0;
+      next_addr = 0;
+      diff_unknown++;
+      continue;
+    }
+
+    diff_start[ninsns] = start;
+    get_mnemonic(p, diff_name[ninsns], sizeof(diff_name[0]));
+    ninsns++;
+  }
+  diff_code_block(ninsns, size, mode, verbose);
+
+  printf("%llu instructions compared: %llu length differences, %llu named differently, %llu unknown to objdump\n",
+      (unsigned long long) diff_compared, (unsigned long long) diff_len,
+      (unsigned long long) diff_names, (unsigned long long) diff_unknown);
+
+  return (diff_len != 0);
+}
+
+static void usage(void)
+{
+  fprintf(stderr,
+    "Usage: bxdecode [-16|-32|-64] [-n iterations] bench file...\n"
+    "       bxdecode [-16|-32|-64] [-n iterations] [-s size] evex\n"
+    "       bxdecode [-16|-32|-64] [-v] diff [objdump listing]\n");
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned mode = 0, iterations = 10;
+  Bit32u stream_size = 1 << 20;
+  bool verbose = false;
+  int n = 1;
+
+  for (; n < argc && argv[n][0] == '-'; n++) {
+    if (!strcmp(argv[n], "-16")) mode = 16;
+    else if (!strcmp(argv[n], "-32")) mode = 32;
+    else if (!strcmp(argv[n], "-64")) mode = 64;
+    else if (!strcmp(argv[n], "-v")) verbose = true;
+    else if (!strcmp(argv[n], "-n") && n + 1 < argc) iterations = atoi(argv[++n]);
+    else if (!strcmp(argv[n], "-s") && n + 1 < argc) stream_size = atoi(argv[++n]);
+    else usage();
+  }
+#if BX_SUPPORT_X86_64 == 0
+  if (mode == 64) {
+    fprintf(stderr, "64-bit mode is not supported by this configuration\n");
+    exit(1);
+  }
+#endif
+  if (n == argc) usage();
+
+  if (!strcmp(argv[n], "bench") && n + 1 < argc) {
+    for (n++; n < argc; n++) {
+      Bit64u size;
+      Bit8u *buf = load_file(argv[n], &size);
+      add_file_regions(buf, size, mode);
+    }
+    bench(iterations);
+  }
+  else if (!strcmp(argv[n], "evex") && n + 1 == argc) {
+    make_evex_stream(stream_size, mode ? mode : 64);
+    bench(iterations);
+  }
+  else if (!strcmp(argv[n], "diff") && n + 2 >= argc) {
+    FILE *in = stdin;
+    if (n + 1 < argc && !(in = fopen(argv[n+1], "r"))) {
+      fprintf(stderr, "cannot open '%s'\n", argv[n+1]);
+      exit(1);
+    }
+    return diff(in, mode, verbose);
+  }
+  else usage();
+
+  return 0;
+}
+
+#endif
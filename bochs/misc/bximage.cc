@@ -45,6 +45,7 @@
 #include "iodev/hdimage/vmware4.h"
 #include "iodev/hdimage/vpc.h"
 #include "iodev/hdimage/vbox.h"
+#include "iodev/hdimage/qcow2.h"
 
 #define BXIMAGE_FUNC_NULL            0
 #define BXIMAGE_FUNC_CREATE_IMAGE    1
@@ -99,9 +100,9 @@ const unsigned fdsize_sectors[] = { 320, 360, 640, 720, 1440, 2400, 2880, 3360,
 int fdsize_n_choices = 10;
 
 // menu data for choosing disk mode
-const char *hdmode_menu = "\nWhat kind of image should I create?\nPlease type flat, sparse, growing, vpc or vmware4. ";
-const char *hdmode_choices[] = {"flat", "sparse", "growing", "vpc", "vmware4" };
-int hdmode_n_choices = 5;
+const char *hdmode_menu = "\nWhat kind of image should I create?\nPlease type flat, sparse, growing, vpc, vmware4 or qcow2. ";
+const char *hdmode_choices[] = {"flat", "sparse", "growing", "vpc", "vmware4", "qcow2" };
+int hdmode_n_choices = 6;
 
 // menu data for choosing hard disk sector size
 const char *sectsize_menu = "\nChoose the size of hard disk sectors.\nPlease type 512, 1024 or 4096. ";
@@ -338,6 +339,8 @@ device_image_t* init_image(const char *imgmode)
     hdimage = new vpc_image_t();
   } else if (!strcmp(imgmode, "vbox")) {
     hdimage = new vbox_image_t();
+  } else if (!strcmp(imgmode, "qcow2")) {
+    hdimage = new qcow2_image_t();
   } else {
     fatal("unsupported disk image mode");
   }
@@ -420,6 +423,8 @@ device_image_t* create_hard_disk_image(const char *filename, const char *imgmode
     hdimage->create_image(filename, size);
   } else if(!strcmp(imgmode, "vmware4")) {
     hdimage->create_image(filename, size);
+  } else if(!strcmp(imgmode, "qcow2")) {
+    hdimage->create_image(filename, size);
   } else {
     fatal("image mode not implemented yet");
   }
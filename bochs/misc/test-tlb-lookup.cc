@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////
+//
+// test-tlb-lookup.cc
+// $Id$
+//
+// Microbenchmark for the TLB lookup done by the memory access fast paths
+// in cpu/access.cc and cpu/access2.cc. It times the hit path comparing the
+// plain linear page frame against the entry lpf (as the code did before the
+// TLB entries were tagged with the translation context) and the hit path
+// comparing the linear page frame combined with the context tag, which is
+// what the emulator does now. Both should run at the same speed. It also
+// times the O(size) invalidation of the whole TLB, which a TLB flush does
+// not need anymore.
+//
+// Compile with:
+//   c++ -O2 -I. -Iinstrument/stubs -o test-tlb-lookup misc/test-tlb-lookup.cc
+// Then run "test-tlb-lookup [iterations]".
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <bochs.h>
+#include <time.h>
+
+#include "cpu/tlb.h"
+
+#define BX_DTLB_SIZE 2048
+
+#define TEST_PAGES   512
+#define TEST_ADDRS   4096
+
+#ifdef __GNUC__
+#define NOINLINE __attribute__ ((noinline))
+#else
+#define NOINLINE
+#endif
+
+struct {
+  TLB<BX_DTLB_SIZE> DTLB;
+  bx_address tlb_context_tag;
+#if BX_SUPPORT_PKEYS
+  Bit32u rd_pkey[16];
+  Bit32u wr_pkey[16];
+#endif
+} test_cpu;
+
+#define BX_CPU_THIS_PTR test_cpu.
+
+static Bit8u *test_memory;
+static bx_address test_addr[TEST_ADDRS];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill_tlb(bx_address tag)
+{
+  BX_CPU_THIS_PTR DTLB.flush();
+  BX_CPU_THIS_PTR tlb_context_tag = tag;
+
+  for (unsigned n=0; n < TEST_PAGES; n++) {
+    bx_address laddr = bx_address(n) << 12;
+    bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 0);
+    tlbEntry->lpf = LPFOf(laddr) | tag;
+    tlbEntry->ppf = laddr;
+    tlbEntry->hostPageAddr = (bx_hostpageaddr_t) (test_memory + (n << 12));
+    tlbEntry->accessBits = TLB_SysReadOK | TLB_UserReadOK | TLB_SysWriteOK | TLB_UserWriteOK;
+#if BX_SUPPORT_PKEYS
+    tlbEntry->pkey = 0;
+#endif
+    tlbEntry->lpf_mask = 0xfff;
+  }
+}
+
+// the hit path of read_virtual_dword before the TLB context tag
+static Bit32u NOINLINE read_dword_untagged(bx_address laddr)
+{
+  bx_address lpf = AlignedAccessLPFOf(laddr, 0);
+  bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
+  if (tlbEntry->lpf == lpf) {
+    if (isReadOK(tlbEntry, 0)) {
+      Bit32u pageOffset = PAGE_OFFSET(laddr);
+      return *(Bit32u*) (tlbEntry->hostPageAddr | pageOffset);
+    }
+  }
+  return 0;
+}
+
+// the hit path of read_virtual_dword with the TLB context tag
+static Bit32u NOINLINE read_dword_tagged(bx_address laddr)
+{
+  bx_address lpf = BX_TLB_AlignedAccessLPFOf(laddr, 0);
+  bx_TLB_entry *tlbEntry = BX_DTLB_ENTRY_OF(laddr, 3);
+  if (tlbEntry->lpf == lpf) {
+    if (isReadOK(tlbEntry, 0)) {
+      Bit32u pageOffset = PAGE_OFFSET(laddr);
+      return *(Bit32u*) (tlbEntry->hostPageAddr | pageOffset);
+    }
+  }
+  return 0;
+}
+
+static double run(Bit32u (*read_dword)(bx_address), unsigned iterations, Bit32u *sum)
+{
+  double start = now();
+  Bit32u s = 0;
+  for (unsigned i=0; i < iterations; i++) {
+    for (unsigned n=0; n < TEST_ADDRS; n++)
+      s += read_dword(test_addr[n]);
+  }
+  *sum = s;
+  return (now() - start) * 1e9 / (double(iterations) * TEST_ADDRS);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+
+  test_memory = new Bit8u[TEST_PAGES << 12];
+  for (unsigned n=0; n < (TEST_PAGES << 12); n++)
+    test_memory[n] = (Bit8u) n;
+
+#if BX_SUPPORT_PKEYS
+  for (unsigned n=0; n < 16; n++)
+    BX_CPU_THIS_PTR rd_pkey[n] = BX_CPU_THIS_PTR wr_pkey[n] = 0xffffffff;
+#endif
+
+  Bit32u seed = 1;
+  for (unsigned n=0; n < TEST_ADDRS; n++) {
+    seed = seed * 1103515245 + 12345;
+    test_addr[n] = (bx_address(seed >> 8) % (TEST_PAGES << 12)) & ~bx_address(3);
+  }
+
+  Bit32u sum_untagged, sum_tagged;
+  double ns_untagged = 0, ns_tagged = 0;
+
+  // alternate the runs to even out frequency scaling and cache effects
+  for (unsigned round=0; round < 5; round++) {
+    fill_tlb(0);
+    ns_untagged += run(read_dword_untagged, iterations, &sum_untagged);
+    fill_tlb((BX_TLB_CONTEXTS-1) << TLB_ContextShift);
+    ns_tagged += run(read_dword_tagged, iterations, &sum_tagged);
+  }
+
+  printf("TLB hit, untagged lpf:     %6.3f ns/lookup\n", ns_untagged / 5);
+  printf("TLB hit, context tag:      %6.3f ns/lookup\n", ns_tagged / 5);
+  if (sum_untagged != sum_tagged)
+    printf("MISMATCH: %08x != %08x\n", sum_untagged, sum_tagged);
+
+  double start = now();
+  for (unsigned i=0; i < iterations; i++)
+    BX_CPU_THIS_PTR DTLB.flush();
+  printf("DTLB invalidation of %d entries: %6.1f ns (avoided by TLB flush)\n",
+      BX_DTLB_SIZE, (now() - start) * 1e9 / iterations);
+
+  delete [] test_memory;
+  return (sum_untagged != sum_tagged);
+}
@@ -29,7 +29,6 @@
 #define BXPN_SEL_CONFIG_INTERFACE        "general.config_interface"
 #define BXPN_BOCHS_START                 "general.start_mode"
 #define BXPN_BOCHS_BENCHMARK             "general.benchmark"
-#define BXPN_DUMP_STATS                  "general.dumpstats"
 #define BXPN_RESTORE_FLAG                "general.restore"
 #define BXPN_RESTORE_PATH                "general.restore_path"
 #define BXPN_DEBUG_RUNNING               "general.debug_running"
@@ -43,6 +42,13 @@
 #define BXPN_CPU_EXCLUDE_FEATURES        "cpu.exclude_features"
 #define BXPN_IPS                         "cpu.ips"
 #define BXPN_SMP_QUANTUM                 "cpu.quantum"
+#define BXPN_SMP_HOST_THREADS            "cpu.host_threads"
+#define BXPN_SMP_HOST_QUANTUM            "cpu.host_quantum"
+#define BXPN_ICACHE_SIZE                 "cpu.icache_size"
+#define BXPN_ICACHE_WAYS                 "cpu.icache_ways"
+#define BXPN_ICACHE_FILE                 "cpu.icache_file"
+#define BXPN_SUPERBLOCKS                 "cpu.superblocks"
+#define BXPN_JIT                         "cpu.jit"
 #define BXPN_RESET_ON_TRIPLE_FAULT       "cpu.reset_on_triple_fault"
 #define BXPN_IGNORE_BAD_MSRS             "cpu.ignore_bad_msrs"
 #define BXPN_CONFIGURABLE_MSRS_PATH      "cpu.msrs"
@@ -53,6 +59,8 @@
 #define BXPN_MEM_SIZE                    "memory.standard.ram.guest"
 #define BXPN_HOST_MEM_SIZE               "memory.standard.ram.host"
 #define BXPN_MEM_BLOCK_SIZE              "memory.standard.ram.block_size"
+#define BXPN_MEM_HUGEPAGES               "memory.standard.ram.hugepages"
+#define BXPN_MEM_NUMA_BIND               "memory.standard.ram.numa_bind"
 #define BXPN_ROMIMAGE                    "memory.standard.rom"
 #define BXPN_ROM_PATH                    "memory.standard.rom.file"
 #define BXPN_ROM_ADDRESS                 "memory.standard.rom.address"
@@ -65,6 +73,7 @@
 #define BXPN_CLOCK_SYNC                  "clock_cmos.clock_sync"
 #define BXPN_CLOCK_TIME0                 "clock_cmos.time0"
 #define BXPN_CLOCK_RTC_SYNC              "clock_cmos.rtc_sync"
+#define BXPN_CLOCK_IDLE                  "clock_cmos.idle"
 #define BXPN_CMOSIMAGE_ENABLED           "clock_cmos.cmosimage.enabled"
 #define BXPN_CMOSIMAGE_PATH              "clock_cmos.cmosimage.path"
 #define BXPN_CMOSIMAGE_RTC_INIT          "clock_cmos.cmosimage.rtc_init"
@@ -162,6 +171,21 @@
 #define BXPN_PORT_E9_HACK_ALL_RINGS      "misc.port_e9_hack.all_rings"
 #define BXPN_IODEBUG_ALL_RINGS           "misc.iodebug_all_rings"
 #define BXPN_GDBSTUB                     "misc.gdbstub"
+#define BXPN_PROFILE_ROOT                "misc.profile"
+#define BXPN_PROFILE_ENABLED             "misc.profile.enabled"
+#define BXPN_PROFILE_PERIOD              "misc.profile.period"
+#define BXPN_PROFILE_FILE                "misc.profile.file"
+#define BXPN_PROFILE_SCRIPT              "misc.profile.script"
+#define BXPN_STATISTICS_ROOT             "misc.statistics"
+#define BXPN_STATISTICS_ENABLED          "misc.statistics.enabled"
+#define BXPN_STATISTICS_PERIOD           "misc.statistics.period"
+#define BXPN_STATISTICS_FILE             "misc.statistics.file"
+#define BXPN_DISK_AIO_ROOT               "misc.disk_aio"
+#define BXPN_DISK_AIO_THREADS            "misc.disk_aio.threads"
+#define BXPN_DISK_CACHE_ROOT             "misc.disk_cache"
+#define BXPN_DISK_CACHE_SIZE             "misc.disk_cache.size"
+#define BXPN_DISK_CACHE_READAHEAD        "misc.disk_cache.readahead"
+#define BXPN_DISK_CACHE_WRITEBACK        "misc.disk_cache.writeback"
 #define BXPN_LOG_FILENAME                "log.filename"
 #define BXPN_LOG_PREFIX                  "log.prefix"
 #define BXPN_DEBUGGER_LOG_FILENAME       "log.debugger_filename"
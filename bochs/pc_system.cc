@@ -23,9 +23,20 @@
 #include "bochs.h"
 #include "cpu/cpu.h"
 #include "iodev/iodev.h"
+#include "iodev/virt_timer.h"
 #include "bx_debug/debug.h"
+#if BX_HAVE_SELECT && !defined(WIN32)
+#include <sys/select.h>
+#endif
+#if BX_SUPPORT_SMP
+#include "bxthread.h"
+#endif
 #define LOG_THIS bx_pc_system.
 
+#if BX_ENABLE_STATISTICS
+static FILE *statsFile = NULL;
+#endif
+
 #if defined(PROVIDE_M_IPS)
 double     m_ips; // Millions of Instructions Per Second
 #endif
@@ -36,8 +47,16 @@ double     m_ips; // Millions of Instructions Per Second
 #define SpewPeriodicTimerInfo 0
 #define MinAllowableTimerPeriod 1
 
+// Longest host sleep while the guest is idle, keeps the gui responsive
+#define MaxIdleSleepUsec 10000
+
 const Bit64u bx_pc_system_c::NullTimerInterval = 0xffffffff;
 
+#if BX_SUPPORT_SMP
+// serializes device access when processors run in separate host threads
+static BX_MUTEX(devices_mutex);
+#endif
+
   // constructor
 bx_pc_system_c::bx_pc_system_c()
 {
@@ -49,19 +68,31 @@ bx_pc_system_c::bx_pc_system_c()
   // case here.  It should never be turned off or modified, and its
   // duration should always remain the same.
   ticksTotal = 0; // Reset ticks since emulator started.
+  timer.grow();
+  timerHeap = new unsigned[timer.capacity()];
+  timerHeapSize = 0;
   timer[0].inUse      = 1;
   timer[0].period     = NullTimerInterval;
+  timer[0].timeToFire = NullTimerInterval;
   timer[0].active     = 1;
   timer[0].continuous = 1;
   timer[0].funct      = nullTimer;
   timer[0].this_ptr   = this;
+  heap_insert(0);
   numTimers = 1; // So far, only the nullTimer.
+  numIdleFds = 0;
+
+#if BX_SUPPORT_SMP
+  smp_threads_running = 0;
+  BX_INIT_RECURSIVE_MUTEX(devices_mutex);
+#endif
 }
 
 void bx_pc_system_c::initialize(Bit32u ips)
 {
   ticksTotal = 0;
   timer[0].timeToFire = NullTimerInterval;
+  heap_rebuild();
   currCountdown       = NullTimerInterval;
   currCountdownPeriod = NullTimerInterval;
   lastTimeUsec = 0;
@@ -73,6 +104,14 @@ void bx_pc_system_c::initialize(Bit32u ips)
   // parameter 'ips' is the processor speed in Instructions-Per-Second
   m_ips = double(ips) / 1000000.0L;
 
+  int clock_sync = SIM->get_param_enum(BXPN_CLOCK_SYNC)->get();
+  idleSkip = SIM->get_param_bool(BXPN_CLOCK_IDLE)->get();
+  idleSleep = idleSkip &&
+      ((clock_sync == BX_CLOCK_SYNC_REALTIME) || (clock_sync == BX_CLOCK_SYNC_BOTH));
+  if (idleSkip) {
+    BX_INFO(("idle time is skipped%s", idleSleep ? ", host sleeps while idle" : ""));
+  }
+
   BX_DEBUG(("ips = %u", (unsigned) ips));
 }
 
@@ -120,6 +159,18 @@ bx_pc_system_c::outp(Bit16u addr, Bit32u value, unsigned io_len)
   bx_devices.outp(addr, value, io_len);
 }
 
+#if BX_SUPPORT_SMP
+void bx_pc_system_c::lock_devices(void)
+{
+  BX_LOCK(devices_mutex);
+}
+
+void bx_pc_system_c::unlock_devices(void)
+{
+  BX_UNLOCK(devices_mutex);
+}
+#endif
+
 void bx_pc_system_c::set_enable_a20(bool value)
 {
 #if BX_SUPPORT_A20
@@ -212,7 +263,19 @@ Bit8u bx_pc_system_c::IAC(void)
 void bx_pc_system_c::exit(void)
 {
   // delete all registered timers (exception: null timer and APIC timer)
+  for (unsigned i = 1 + BX_SUPPORT_APIC; i < numTimers; i++) {
+    if (timer[i].active) {
+      heap_remove(i);
+      timer[i].active = 0;
+    }
+  }
   numTimers = 1 + BX_SUPPORT_APIC;
+#if BX_ENABLE_STATISTICS
+  if (statsFile != NULL) {
+    fclose(statsFile);
+    statsFile = NULL;
+  }
+#endif
   bx_devices.exit();
   if (bx_gui) {
     bx_gui->cleanup();
@@ -246,6 +309,12 @@ void bx_pc_system_c::register_state(void)
   }
 }
 
+void bx_pc_system_c::after_restore_state(void)
+{
+  // the active flags and the fire times were restored, re-create the heap
+  heap_rebuild();
+}
+
 // ================================================
 // Bochs internal timer delivery framework features
 // ================================================
@@ -278,9 +347,13 @@ int bx_pc_system_c::register_timer_ticks(void* this_ptr, bx_timer_handler_t func
       break;
   }
 
-  if (numTimers >= BX_MAX_TIMERS) {
-    BX_PANIC(("register_timer: too many registered timers"));
-    return -1;
+  if (i == timer.capacity()) {
+    // all timer slots are in use, allocate another block of timers
+    timer.grow();
+    unsigned *new_heap = new unsigned[timer.capacity()];
+    memcpy(new_heap, timerHeap, sizeof(unsigned) * timerHeapSize);
+    delete [] timerHeap;
+    timerHeap = new_heap;
   }
 #if BX_TIMER_DEBUG
   if (this_ptr == NULL)
@@ -301,6 +374,7 @@ int bx_pc_system_c::register_timer_ticks(void* this_ptr, bx_timer_handler_t func
   timer[i].param      = 0;
 
   if (active) {
+    heap_insert(i);
     if (ticks < Bit64u(currCountdown)) {
       // This new timer needs to fire before the current countdown.
       // Skew the current countdown and countdown period to be smaller
@@ -321,9 +395,8 @@ int bx_pc_system_c::register_timer_ticks(void* this_ptr, bx_timer_handler_t func
 
 void bx_pc_system_c::countdownEvent(void)
 {
-  unsigned i, first = numTimers, last = 0;
-  Bit64u   minTimeToFire;
-  bool  triggered[BX_MAX_TIMERS];
+  unsigned i, n, numTriggered = 0;
+  unsigned triggeredLocal[BX_TIMER_BLOCK_SIZE], *triggered = triggeredLocal;
 
   // The countdown decremented to 0.  We need to service all the active
   // timers, and invoke callbacks from those timers which have fired.
@@ -335,36 +408,37 @@ void bx_pc_system_c::countdownEvent(void)
   // Increment global ticks counter by number of ticks which have
   // elapsed since the last update.
   ticksTotal += Bit64u(currCountdownPeriod);
-  minTimeToFire = (Bit64u) -1;
 
-  for (i = 0; i < numTimers; i++) {
-    triggered[i] = 0; // Reset triggered flag.
-    if (timer[i].active) {
+  // The callbacks may register or activate timers (and even advance the
+  // time recursively), so the list of fired timers is collected first.
+  if (timerHeapSize > BX_TIMER_BLOCK_SIZE)
+    triggered = new unsigned[timerHeapSize];
+
+  // The null timer is always active, so the heap is never empty.
+  while (timer[timerHeap[0]].timeToFire <= ticksTotal) {
+    i = timerHeap[0];
 #if BX_TIMER_DEBUG
-      if (ticksTotal > timer[i].timeToFire)
-        BX_PANIC(("countdownEvent: ticksTotal > timeToFire[%u], D " FMT_LL "u", i,
-                  timer[i].timeToFire-ticksTotal));
+    if (ticksTotal > timer[i].timeToFire)
+      BX_PANIC(("countdownEvent: ticksTotal > timeToFire[%u], D " FMT_LL "u", i,
+                timer[i].timeToFire-ticksTotal));
 #endif
-      if (ticksTotal == timer[i].timeToFire) {
-        // This timer is ready to fire.
-        triggered[i] = 1;
-
-        if (timer[i].continuous==0) {
-          // If triggered timer is one-shot, deactive.
-          timer[i].active = 0;
-        } else {
-          // Continuous timer, increment time-to-fire by period.
-          timer[i].timeToFire += timer[i].period;
-          if (timer[i].timeToFire < minTimeToFire)
-            minTimeToFire = timer[i].timeToFire;
-        }
-        if (i < first) first = i;
-        last = i;
-      } else {
-        // This timer is not ready to fire yet.
-        if (timer[i].timeToFire < minTimeToFire)
-          minTimeToFire = timer[i].timeToFire;
-      }
+    heap_remove(i);
+    // This timer is ready to fire, keep the list ordered by timer index
+    // so the callbacks are invoked in the same order as they always were.
+    for (n = numTriggered++; n > 0 && triggered[n-1] > i; n--)
+      triggered[n] = triggered[n-1];
+    triggered[n] = i;
+  }
+
+  for (n = 0; n < numTriggered; n++) {
+    i = triggered[n];
+    if (timer[i].continuous==0) {
+      // If triggered timer is one-shot, deactive.
+      timer[i].active = 0;
+    } else {
+      // Continuous timer, increment time-to-fire by period.
+      timer[i].timeToFire += timer[i].period;
+      heap_insert(i);
     }
   }
 
@@ -372,17 +446,108 @@ void bx_pc_system_c::countdownEvent(void)
   // any of the callbacks, as they may call timer features, which need
   // to be advanced to the next countdown cycle.
   currCountdown = currCountdownPeriod =
-      Bit32u(minTimeToFire - ticksTotal);
+      Bit32u(timer[timerHeap[0]].timeToFire - ticksTotal);
 
-  for (i = first; i <= last; i++) {
+  for (n = 0; n < numTriggered; n++) {
     // Call requested timer function.  It may request a different
     // timer period or deactivate etc.
-    if (triggered[i] && (timer[i].funct != NULL)) {
+    i = triggered[n];
+    if (timer[i].funct != NULL) {
       triggeredTimer = i;
       timer[i].funct(timer[i].this_ptr);
       triggeredTimer = 0;
     }
   }
+
+  if (triggered != triggeredLocal)
+    delete [] triggered;
+}
+
+// ===============================
+// Timer heap management
+// ===============================
+
+void bx_pc_system_c::timer_table_c::grow(void)
+{
+  bx_timer_t **new_block = new bx_timer_t*[numBlocks + 1];
+  for (unsigned n = 0; n < numBlocks; n++)
+    new_block[n] = block[n];
+  new_block[numBlocks] = new bx_timer_t[BX_TIMER_BLOCK_SIZE];
+  memset(new_block[numBlocks], 0, sizeof(bx_timer_t) * BX_TIMER_BLOCK_SIZE);
+  delete [] block;
+  block = new_block;
+  numBlocks++;
+}
+
+void bx_pc_system_c::heap_sift_up(unsigned pos)
+{
+  unsigned i = timerHeap[pos];
+  Bit64u timeToFire = timer[i].timeToFire;
+
+  while (pos > 0) {
+    unsigned parent = (pos - 1) / 2;
+    unsigned p = timerHeap[parent];
+    if (timer[p].timeToFire <= timeToFire) break;
+    timerHeap[pos] = p;
+    timer[p].heapIndex = pos;
+    pos = parent;
+  }
+
+  timerHeap[pos] = i;
+  timer[i].heapIndex = pos;
+}
+
+void bx_pc_system_c::heap_sift_down(unsigned pos)
+{
+  unsigned i = timerHeap[pos];
+  Bit64u timeToFire = timer[i].timeToFire;
+
+  for (;;) {
+    unsigned child = pos * 2 + 1;
+    if (child >= timerHeapSize) break;
+    if (child + 1 < timerHeapSize &&
+        timer[timerHeap[child+1]].timeToFire < timer[timerHeap[child]].timeToFire)
+      child++;
+    unsigned c = timerHeap[child];
+    if (timeToFire <= timer[c].timeToFire) break;
+    timerHeap[pos] = c;
+    timer[c].heapIndex = pos;
+    pos = child;
+  }
+
+  timerHeap[pos] = i;
+  timer[i].heapIndex = pos;
+}
+
+void bx_pc_system_c::heap_insert(unsigned i)
+{
+  unsigned pos = timerHeapSize++;
+  timerHeap[pos] = i;
+  heap_sift_up(pos);
+}
+
+void bx_pc_system_c::heap_remove(unsigned i)
+{
+  unsigned pos = timer[i].heapIndex;
+#if BX_TIMER_DEBUG
+  if (pos >= timerHeapSize || timerHeap[pos] != i)
+    BX_PANIC(("heap_remove: timer %u is not in the timer heap", i));
+#endif
+  unsigned last = timerHeap[--timerHeapSize];
+  if (pos != timerHeapSize) {
+    timerHeap[pos] = last;
+    heap_sift_up(pos);
+    heap_sift_down(timer[last].heapIndex);
+  }
+}
+
+void bx_pc_system_c::heap_rebuild(void)
+{
+  timerHeapSize = 0;
+  for (unsigned i = 0; i < numTimers; i++) {
+    if (timer[i].active)
+      heap_insert(i);
+  }
 }
 
 void bx_pc_system_c::nullTimer(void* this_ptr)
@@ -421,9 +586,29 @@ void bx_pc_system_c::benchmarkTimer(void* this_ptr)
 #if BX_ENABLE_STATISTICS
 void bx_pc_system_c::dumpStatsTimer(void* this_ptr)
 {
-  printf("=== statistics dump " FMT_LL "u ===\n", bx_pc_system.time_ticks());
-  print_statistics_tree(SIM->get_statistics_root());
-  fflush(stdout);
+  // when disabled only clear the statistics, next dump after enabling
+  // covers a single period
+  if (! SIM->get_param_bool(BXPN_STATISTICS_ENABLED)->get()) {
+    print_statistics_tree(SIM->get_statistics_root(), 0, NULL);
+    return;
+  }
+
+  FILE *fp = stdout;
+  const char *fname = SIM->get_param_string(BXPN_STATISTICS_FILE)->getptr();
+  if (fname[0] != 0) {
+    if (statsFile == NULL) {
+      statsFile = fopen(fname, "w");
+      if (statsFile == NULL) {
+        BX_ERROR(("could not open statistics file '%s', dumping to stdout", fname));
+        SIM->get_param_string(BXPN_STATISTICS_FILE)->set("");
+      }
+    }
+    if (statsFile != NULL) fp = statsFile;
+  }
+
+  fprintf(fp, "=== statistics dump " FMT_LL "u ===\n", bx_pc_system.time_ticks());
+  print_statistics_tree(SIM->get_statistics_root(), 0, fp);
+  fflush(fp);
 }
 #endif
 
@@ -493,8 +678,15 @@ void bx_pc_system_c::activate_timer_ticks(unsigned i, Bit64u ticks, bool continu
 
   timer[i].period = ticks;
   timer[i].timeToFire = (ticksTotal + Bit64u(currCountdownPeriod-currCountdown)) + ticks;
-  timer[i].active     = 1;
   timer[i].continuous = continuous;
+  if (timer[i].active) {
+    // already queued, move the timer to its new position in the heap
+    heap_sift_up(timer[i].heapIndex);
+    heap_sift_down(timer[i].heapIndex);
+  } else {
+    timer[i].active = 1;
+    heap_insert(i);
+  }
 
   if (ticks < Bit64u(currCountdown)) {
     // This new timer needs to fire before the current countdown.
@@ -569,7 +761,10 @@ void bx_pc_system_c::deactivate_timer(unsigned i)
     BX_PANIC(("deactivate_timer: timer 0 is the nullTimer!"));
 #endif
 
-  timer[i].active = 0;
+  if (timer[i].active) {
+    heap_remove(i);
+    timer[i].active = 0;
+  }
 }
 
 bool bx_pc_system_c::unregisterTimer(unsigned timerIndex)
@@ -618,3 +813,67 @@ void bx_pc_system_c::isa_bus_delay(void)
     tickn((Bit32u)(m_ips * 2.0));
   }
 }
+
+// ================================================
+// Idle mode
+// ================================================
+
+void bx_pc_system_c::idle(void)
+{
+  // With the realtime synchronization the realtime timers are due after
+  // a given amount of host time, nothing can happen in the guest before.
+  // With the slowdown synchronization the slowdown timer sleeps on its own
+  // once the skipped time gets ahead of the host time.
+  if (idleSleep) {
+    Bit64u usec = bx_virt_timer.time_to_next_realtime_event();
+    if (usec > 0)
+      idle_wait((usec < MaxIdleSleepUsec) ? usec : MaxIdleSleepUsec);
+  }
+
+  // No processor runs, skip to the next timer event.
+  tickn(currCountdown);
+}
+
+void bx_pc_system_c::idle_wait(Bit64u usec)
+{
+#if BX_HAVE_SELECT && !defined(WIN32)
+  // Wait for host input (network, serial) or timeout, whichever is first.
+  struct timeval tval;
+  fd_set fds;
+  int max_fd = -1;
+
+  FD_ZERO(&fds);
+  for (unsigned n = 0; n < numIdleFds; n++) {
+    FD_SET(idleFd[n], &fds);
+    if (idleFd[n] > max_fd) max_fd = idleFd[n];
+  }
+  tval.tv_sec  = 0;
+  tval.tv_usec = (long) usec;
+  select(max_fd + 1, &fds, NULL, NULL, &tval);
+#elif defined(WIN32)
+  Sleep((DWORD)((usec + 999) / 1000));
+#elif BX_HAVE_USLEEP
+  usleep((useconds_t) usec);
+#endif
+}
+
+void bx_pc_system_c::register_idle_fd(int fd)
+{
+  if (fd < 0) return;
+
+  if (numIdleFds >= BX_MAX_IDLE_FDS) {
+    BX_ERROR(("register_idle_fd: too many host descriptors, fd %d not watched", fd));
+    return;
+  }
+  idleFd[numIdleFds++] = fd;
+}
+
+void bx_pc_system_c::unregister_idle_fd(int fd)
+{
+  for (unsigned n = 0; n < numIdleFds; n++) {
+    if (idleFd[n] == fd) {
+      idleFd[n] = idleFd[--numIdleFds];
+      return;
+    }
+  }
+}
@@ -23,7 +23,13 @@
 #ifndef BX_PCSYS_H
 #define BX_PCSYS_H
 
-#define BX_MAX_TIMERS 64
+// Timers are allocated in blocks of BX_TIMER_BLOCK_SIZE entries. The blocks
+// are never moved once allocated, so the save/restore parameters can point
+// directly into the timer fields.
+#define BX_TIMER_BLOCK_SIZE 64
+
+// Maximum number of host file descriptors watched while the guest is idle
+#define BX_MAX_IDLE_FDS 16
 #define BX_NULL_TIMER_HANDLE 10000
 
 typedef void (*bx_timer_handler_t)(void *);
@@ -41,7 +47,7 @@ private:
   // Timer oriented private features
   // ===============================
 
-  struct {
+  struct bx_timer_t {
     bool inUse;      // Timer slot is in-use (currently registered).
     Bit64u  period;     // Timer periodocity in cpu ticks.
     Bit64u  timeToFire; // Time to fire next (in absolute ticks).
@@ -54,7 +60,34 @@ private:
 #define BxMaxTimerIDLen 32
     char id[BxMaxTimerIDLen];  // String ID of timer.
     Bit32u param;              // Device-specific value assigned to timer (optional)
-  } timer[BX_MAX_TIMERS];
+    unsigned heapIndex;        // Position in the timer heap (if active).
+  };
+
+  // The timers are grown on demand, there is no fixed limit on the number
+  // of registered timers.
+  class timer_table_c {
+    bx_timer_t **block;
+    unsigned numBlocks;
+  public:
+    timer_table_c(): block(NULL), numBlocks(0) {}
+    BX_CPP_INLINE bx_timer_t& operator[] (unsigned i) {
+      return block[i / BX_TIMER_BLOCK_SIZE][i % BX_TIMER_BLOCK_SIZE];
+    }
+    unsigned capacity(void) const { return numBlocks * BX_TIMER_BLOCK_SIZE; }
+    void grow(void);
+  } timer;
+
+  // Active timers are kept in a binary min-heap ordered by timeToFire, so
+  // the next timer to fire is always timerHeap[0] and activating or
+  // deactivating a timer costs O(log n) instead of a scan of all timers.
+  unsigned  *timerHeap;
+  unsigned   timerHeapSize;
+
+  void   heap_insert(unsigned i);
+  void   heap_remove(unsigned i);
+  void   heap_sift_up(unsigned pos);
+  void   heap_sift_down(unsigned pos);
+  void   heap_rebuild(void);
 
   unsigned   numTimers;  // Number of currently allocated timers.
   unsigned   triggeredTimer;  // ID of the actually triggered timer.
@@ -64,6 +97,14 @@ private:
   Bit64u     lastTimeUsec; // Last sequentially read time in usec.
   Bit64u     usecSinceLast; // Number of useconds claimed since then.
 
+  // Idle mode (clock: idle=1): the time while all processors are halted
+  // is skipped, with realtime sync the host sleeps until the next event.
+  bool       idleSkip;
+  bool       idleSleep;
+  int        idleFd[BX_MAX_IDLE_FDS]; // Host input which ends the sleep.
+  unsigned   numIdleFds;
+  void   idle_wait(Bit64u usec);
+
   // A special null timer is always inserted in the timer[0] slot.  This
   // make sure that at least one timer is always active, and that the
   // duration is always less than a maximum 32-bit integer, so a 32-bit
@@ -144,6 +185,15 @@ public:
 #endif
   void isa_bus_delay(void);
 
+  // Called when all processors wait for an interrupt and nothing can
+  // happen before the next timer event.
+  void idle(void);
+  bool idle_enabled(void) const { return idleSkip; }
+  // Devices polling host input register the descriptor to wake up the
+  // idle sleep when data arrives.
+  void register_idle_fd(int fd);
+  void unregister_idle_fd(int fd);
+
   // ===========================
   // Non-timer oriented features
   // ===========================
@@ -167,6 +217,14 @@ public:
 
   volatile bool kill_bochs_request;
 
+#if BX_SUPPORT_SMP
+  // Set while the processors are running in parallel host threads. In this
+  // mode all accesses to I/O devices are serialized using device lock.
+  volatile bool smp_threads_running;
+  void lock_devices(void);
+  void unlock_devices(void);
+#endif
+
   void set_HRQ(bool val);  // set the Hold ReQuest line
 
   void raise_INTR(void);
@@ -186,6 +244,7 @@ public:
   void    invlpg(bx_address addr);    // flush TLB page in all CPUs
   void    exit(void);
   void    register_state(void);
+  void    after_restore_state(void);
 };
 
 #define BX_TICK1()                  bx_pc_system.tick1()
@@ -195,6 +254,16 @@ public:
 #define BX_CLEAR_INTR()             bx_pc_system.clear_INTR()
 #define BX_HRQ                      bx_pc_system.HRQ
 
+#if BX_SUPPORT_SMP
+#define BX_LOCK_DEVICES() \
+  do { if (bx_pc_system.smp_threads_running) bx_pc_system.lock_devices(); } while (0)
+#define BX_UNLOCK_DEVICES() \
+  do { if (bx_pc_system.smp_threads_running) bx_pc_system.unlock_devices(); } while (0)
+#else
+#define BX_LOCK_DEVICES()
+#define BX_UNLOCK_DEVICES()
+#endif
+
 #define BX_SET_ENABLE_A20(enabled)  bx_pc_system.set_enable_a20(enabled)
 #define BX_GET_ENABLE_A20()         bx_pc_system.get_enable_a20()
 
@@ -1141,6 +1141,7 @@ plugin_t bx_builtin_plugins[] = {
   BUILTIN_USB_PLUGIN_ENTRY(usb_msd),
   BUILTIN_USB_PLUGIN_ENTRY(usb_printer),
 #endif
+  BUILTIN_IMG_PLUGIN_ENTRY(qcow2),
   BUILTIN_IMG_PLUGIN_ENTRY(vmware3),
   BUILTIN_IMG_PLUGIN_ENTRY(vmware4),
   BUILTIN_IMG_PLUGIN_ENTRY(vbox),
@@ -181,8 +181,11 @@ extern "C" {
 #define DEV_hd_write_handler(a, b, c, d) \
     (bx_devices.pluginHardDrive->virt_write_handler(b, c, d))
 #define DEV_hd_bmdma_read_sector(a,b,c) bx_devices.pluginHardDrive->bmdma_read_sector(a,b,c)
-#define DEV_hd_bmdma_write_sector(a,b) bx_devices.pluginHardDrive->bmdma_write_sector(a,b)
+#define DEV_hd_bmdma_read_sectors(a,b,c) bx_devices.pluginHardDrive->bmdma_read_sectors(a,b,c)
+#define DEV_hd_bmdma_write_sectors(a,b,c) bx_devices.pluginHardDrive->bmdma_write_sectors(a,b,c)
 #define DEV_hd_bmdma_complete(a) bx_devices.pluginHardDrive->bmdma_complete(a)
+#define DEV_hd_bmdma_read_async(a,b,c) bx_devices.pluginHardDrive->bmdma_read_async(a,b,c)
+#define DEV_hd_bmdma_write_async(a,b,c) bx_devices.pluginHardDrive->bmdma_write_async(a,b,c)
 
 #define DEV_bulk_io_quantum_requested() (bx_devices.bulkIOQuantumsRequested)
 #define DEV_bulk_io_quantum_transferred() (bx_devices.bulkIOQuantumsTransferred)
@@ -234,6 +237,8 @@ extern "C" {
 #define DEV_ide_bmdma_set_irq(a) bx_devices.pluginPciIdeController->bmdma_set_irq(a)
 #define DEV_ide_bmdma_start_transfer(a) \
   bx_devices.pluginPciIdeController->bmdma_start_transfer(a)
+#define DEV_ide_bmdma_aio_complete(a,b) \
+  bx_devices.pluginPciIdeController->bmdma_aio_complete(a,b)
 #define DEV_acpi_generate_smi(a) bx_devices.pluginACPIController->generate_smi(a)
 #define DEV_agp_present() (bx_devices.is_agp_present())
 
@@ -487,6 +492,7 @@ PLUGIN_ENTRY_FOR_MODULE(usb_hub);
 PLUGIN_ENTRY_FOR_MODULE(usb_msd);
 PLUGIN_ENTRY_FOR_MODULE(usb_printer);
 // disk image plugins
+PLUGIN_ENTRY_FOR_IMG_MODULE(qcow2);
 PLUGIN_ENTRY_FOR_IMG_MODULE(vmware3);
 PLUGIN_ENTRY_FOR_IMG_MODULE(vmware4);
 PLUGIN_ENTRY_FOR_IMG_MODULE(vbox);